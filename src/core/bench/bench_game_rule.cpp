@@ -0,0 +1,66 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+// GameRule::VerifyShot のベンチマーク
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <benchmark/benchmark.h>
+#include "digitalcurling/digitalcurling.hpp"
+
+namespace {
+
+using namespace digitalcurling;
+
+// フリーガードゾーンに `guard_count` 個ずつ, ハウスに残りのストーンを配置した盤面を作成する
+StoneCoordinate MakeStones(std::size_t guard_count, float offset_x)
+{
+    std::array<std::array<std::optional<Stone>, 8>, 2> stones;
+    for (std::size_t team = 0; team < 2; ++team) {
+        for (std::size_t i = 0; i < 8; ++i) {
+            auto const x = offset_x + 0.3f * i - 1.2f + 0.15f * team;
+            auto const y = i < guard_count ? coordinate::kHogLineY + 2.f : coordinate::kTeeLineY + 0.2f * team;
+            stones[team][i] = Stone(Vector2(x, y), 0.f);
+        }
+    }
+    return StoneCoordinate(stones);
+}
+
+GameRule MakeRule()
+{
+    GameRule rule;
+    rule.type = GameRuleType::kStandard;
+    rule.free_guard_zone = rules::FreeGuardZoneRule(true);
+    rule.no_tick_shot = rules::NoTickShotRule(true);
+    return rule;
+}
+
+// 違反の無いショット (全てのルールを検証する)
+void BM_GameRuleVerifyShot(benchmark::State& bm)
+{
+    auto const rule = MakeRule();
+    auto const guards = static_cast<std::size_t>(bm.range(0));
+    auto const before = MakeStones(guards, 0.f);
+    auto const after = before;
+    for (auto _ : bm) {
+        auto result = rule.VerifyShot(3, Team::k0, before, after);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_GameRuleVerifyShot)->Arg(0)->Arg(4)->Arg(8);
+
+// フリーガードゾーンのストーンを動かしたショット (違反を検出する)
+void BM_GameRuleVerifyShotViolation(benchmark::State& bm)
+{
+    auto const rule = MakeRule();
+    auto const before = MakeStones(4, 0.f);
+    auto const after = MakeStones(4, 0.05f);
+    for (auto _ : bm) {
+        auto result = rule.VerifyShot(3, Team::k0, before, after);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_GameRuleVerifyShotViolation);
+
+} // unnamed namespace
@@ -0,0 +1,95 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+// 試合状態の JSON テキスト形式とバイナリ形式 (MessagePack, CBOR) の変換のベンチマーク
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+#include "digitalcurling/digitalcurling.hpp"
+
+namespace {
+
+using namespace digitalcurling;
+
+// 全てのストーンが配置された試合状態を作成する
+GameState MakeState()
+{
+    GameState state(GameSetting{});
+    state.end = 5;
+    state.shot = 15;
+    std::array<std::array<std::optional<Stone>, 8>, 2> stones;
+    for (std::size_t team = 0; team < 2; ++team) {
+        for (std::size_t i = 0; i < 8; ++i) {
+            stones[team][i] = Stone(Vector2(0.123456f * i - 0.5f * team, 38.405f + 0.0371f * i), 0.017f * i);
+        }
+    }
+    state.stones = StoneCoordinate(stones);
+    return state;
+}
+
+void BM_GameStateToJsonText(benchmark::State& bm)
+{
+    auto const state = MakeState();
+    for (auto _ : bm) {
+        auto text = nlohmann::json(state).dump();
+        benchmark::DoNotOptimize(text);
+    }
+    bm.counters["bytes"] = static_cast<double>(nlohmann::json(state).dump().size());
+}
+BENCHMARK(BM_GameStateToJsonText);
+
+void BM_GameStateFromJsonText(benchmark::State& bm)
+{
+    auto const text = nlohmann::json(MakeState()).dump();
+    for (auto _ : bm) {
+        auto state = nlohmann::json::parse(text).get<GameState>();
+        benchmark::DoNotOptimize(state);
+    }
+}
+BENCHMARK(BM_GameStateFromJsonText);
+
+void BM_GameStateToBinary(benchmark::State& bm)
+{
+    auto const state = MakeState();
+    auto const format = static_cast<BinaryFormat>(bm.range(0));
+    for (auto _ : bm) {
+        auto data = ToBinary(state, format);
+        benchmark::DoNotOptimize(data);
+    }
+    bm.SetLabel(format == BinaryFormat::kMessagePack ? "msgpack" : "cbor");
+    bm.counters["bytes"] = static_cast<double>(ToBinary(state, format).size());
+}
+BENCHMARK(BM_GameStateToBinary)
+    ->Arg(static_cast<int>(BinaryFormat::kMessagePack))
+    ->Arg(static_cast<int>(BinaryFormat::kCbor));
+
+void BM_GameStateFromBinary(benchmark::State& bm)
+{
+    auto const format = static_cast<BinaryFormat>(bm.range(0));
+    auto const data = ToBinary(MakeState(), format);
+    for (auto _ : bm) {
+        auto state = FromBinary<GameState>(data);
+        benchmark::DoNotOptimize(state);
+    }
+    bm.SetLabel(format == BinaryFormat::kMessagePack ? "msgpack" : "cbor");
+}
+BENCHMARK(BM_GameStateFromBinary)
+    ->Arg(static_cast<int>(BinaryFormat::kMessagePack))
+    ->Arg(static_cast<int>(BinaryFormat::kCbor));
+
+void BM_ShotJsonRoundTrip(benchmark::State& bm)
+{
+    moves::Move const move = moves::Shot(2.345f, 1.5708f, 1.62f);
+    for (auto _ : bm) {
+        auto copy = nlohmann::json::parse(nlohmann::json(move).dump()).get<moves::Move>();
+        benchmark::DoNotOptimize(copy);
+    }
+}
+BENCHMARK(BM_ShotJsonRoundTrip);
+
+} // unnamed namespace
@@ -0,0 +1,138 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// @brief バイナリ形式への変換関数を定義
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "digitalcurling/common.hpp"
+#include "digitalcurling/plugins/i_plugin_object.hpp"
+
+namespace digitalcurling {
+
+
+/// @brief バイナリ形式の種類
+enum class BinaryFormat : std::uint8_t {
+    /// @brief MessagePack
+    kMessagePack = 1,
+    /// @brief CBOR
+    kCbor = 2,
+};
+
+/// @brief バイナリ形式のバージョン
+///
+/// バイナリ形式の内容は JSON 形式と同じ構造を持ちます。
+/// 構造に互換性のない変更を加えた場合はこの値を増やします。
+inline constexpr std::uint8_t kBinaryFormatVersion = 1;
+
+/// @brief バイナリデータの先頭に付与されるヘッダーのバイト数
+///
+/// ヘッダーは識別子 `'D', 'C'`, バージョン, 形式 の4バイトです。
+inline constexpr std::size_t kBinaryHeaderSize = 4;
+
+
+/// @brief JSON をバイナリ形式に変換する
+/// @param j 変換する JSON
+/// @param format バイナリ形式の種類
+/// @returns ヘッダー付きのバイナリデータ
+/// @throws std::invalid_argument `format` が無効な場合
+inline std::vector<std::uint8_t> ToBinary(nlohmann::json const& j, BinaryFormat format = BinaryFormat::kMessagePack)
+{
+    std::vector<std::uint8_t> data{ 'D', 'C', kBinaryFormatVersion, static_cast<std::uint8_t>(format) };
+    switch (format) {
+        case BinaryFormat::kMessagePack:
+            nlohmann::json::to_msgpack(j, data);
+            break;
+        case BinaryFormat::kCbor:
+            nlohmann::json::to_cbor(j, data);
+            break;
+        default:
+            throw std::invalid_argument("ToBinary: invalid binary format.");
+    }
+    return data;
+}
+
+/// @brief 値をバイナリ形式に変換する
+///
+/// JSON に変換可能な型 (`GameState`, `Move` など) と、
+/// Factory / Storage (`plugins::IPluginObjectCreator` の派生クラス) に対応しています。
+/// @tparam T 変換する値の型
+/// @param value 変換する値
+/// @param format バイナリ形式の種類
+/// @returns ヘッダー付きのバイナリデータ
+template <typename T>
+std::vector<std::uint8_t> ToBinary(T const& value, BinaryFormat format = BinaryFormat::kMessagePack)
+{
+    if constexpr (std::is_base_of_v<plugins::IPluginObjectCreator, T>) {
+        return ToBinary(value.ToJson(), format);
+    } else {
+        return ToBinary(nlohmann::json(value), format);
+    }
+}
+
+/// @brief バイナリデータを JSON に変換する
+///
+/// Factory / Storage は、この関数で得た JSON からプラグインを通じて復元します。
+/// @param data バイナリデータ
+/// @param size `data` のバイト数
+/// @returns 変換された JSON
+/// @throws std::invalid_argument ヘッダーが不正な場合やバージョンが異なる場合
+/// @throws nlohmann::json::parse_error データが不正な場合
+inline nlohmann::json JsonFromBinary(std::uint8_t const* data, std::size_t size)
+{
+    if (size < kBinaryHeaderSize || data[0] != 'D' || data[1] != 'C') {
+        throw std::invalid_argument("JsonFromBinary: invalid header.");
+    }
+    if (data[2] != kBinaryFormatVersion) {
+        throw std::invalid_argument("JsonFromBinary: unsupported version.");
+    }
+
+    auto const* begin = data + kBinaryHeaderSize;
+    auto const* end = data + size;
+    switch (static_cast<BinaryFormat>(data[3])) {
+        case BinaryFormat::kMessagePack:
+            return nlohmann::json::from_msgpack(begin, end);
+        case BinaryFormat::kCbor:
+            return nlohmann::json::from_cbor(begin, end);
+        default:
+            throw std::invalid_argument("JsonFromBinary: invalid binary format.");
+    }
+}
+
+/// @brief バイナリデータを JSON に変換する
+/// @param data バイナリデータ
+/// @returns 変換された JSON
+inline nlohmann::json JsonFromBinary(std::vector<std::uint8_t> const& data)
+{
+    return JsonFromBinary(data.data(), data.size());
+}
+
+/// @brief バイナリデータを値に変換する
+/// @tparam T 変換後の値の型 (JSON から変換可能である必要があります)
+/// @param data バイナリデータ
+/// @param size `data` のバイト数
+/// @returns 変換された値
+template <typename T>
+T FromBinary(std::uint8_t const* data, std::size_t size)
+{
+    return JsonFromBinary(data, size).get<T>();
+}
+
+/// @brief バイナリデータを値に変換する
+/// @tparam T 変換後の値の型 (JSON から変換可能である必要があります)
+/// @param data バイナリデータ
+/// @returns 変換された値
+template <typename T>
+T FromBinary(std::vector<std::uint8_t> const& data)
+{
+    return FromBinary<T>(data.data(), data.size());
+}
+
+} // namespace digitalcurling
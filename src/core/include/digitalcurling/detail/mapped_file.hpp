@@ -0,0 +1,72 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// @brief MappedFile を定義
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <utility>
+
+/// @cond Doxygen_Suppress
+namespace digitalcurling::detail {
+
+// ファイル全体をメモリにマップする
+// writable が true の場合は書き込み可能な共有マップとし, 書き込みは同じファイルをマップした他のプロセスからも見える
+class MappedFile {
+public:
+    MappedFile() = default;
+    // マップできない場合は std::runtime_error を送出する
+    explicit MappedFile(std::filesystem::path const& path, bool writable = false);
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+    MappedFile(MappedFile&& other) noexcept { Swap(other); }
+    MappedFile& operator=(MappedFile&& other) noexcept
+    {
+        MappedFile tmp(std::move(other));
+        Swap(tmp);
+        return *this;
+    }
+    ~MappedFile() { Close(); }
+
+    std::uint8_t const* data() const { return data_; }
+    // 書き込み可能として開いた場合のみ書き込める
+    std::uint8_t* mutable_data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+    // 順次読み込みを行うことを OS に通知する
+    void AdviseSequential() const;
+
+private:
+#ifdef _WIN32
+    // ファイルとファイルマッピングの HANDLE (windows.h を公開ヘッダーに含めないため void* で保持する. 開いていない場合は nullptr)
+    void* file_ = nullptr;
+    void* mapping_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+    std::uint8_t* data_ = nullptr;
+    std::size_t size_ = 0;
+
+    [[noreturn]] void Fail(std::filesystem::path const& path);
+    void Close() noexcept;
+
+    void Swap(MappedFile& other) noexcept
+    {
+#ifdef _WIN32
+        std::swap(file_, other.file_);
+        std::swap(mapping_, other.mapping_);
+#else
+        std::swap(fd_, other.fd_);
+#endif
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+    }
+};
+
+} // namespace digitalcurling::detail
+/// @endcond
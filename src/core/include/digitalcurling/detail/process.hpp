@@ -0,0 +1,22 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// @brief プロセスの識別と生存確認の関数を宣言
+
+#pragma once
+
+#include <cstdint>
+
+/// @cond Doxygen_Suppress
+namespace digitalcurling::detail {
+
+// このプロセスの ID
+std::uint32_t CurrentProcessId();
+
+// 指定した ID のプロセスが存在するか
+// 存在を確認できない場合 (権限が無い場合など) は存在するものとして扱う
+bool IsProcessAlive(std::uint32_t pid);
+
+} // namespace digitalcurling::detail
+/// @endcond
@@ -20,6 +20,8 @@
 #include "digitalcurling/simulators/i_simulator.hpp"
 #include "digitalcurling/simulators/i_simulator_factory.hpp"
 #include "digitalcurling/simulators/i_simulator_storage.hpp"
+#include "digitalcurling/simulators/simulator_stats.hpp"
+#include "digitalcurling/binary.hpp"
 #include "digitalcurling/common.hpp"
 #include "digitalcurling/coordinate.hpp"
 #include "digitalcurling/game_scores.hpp"
@@ -0,0 +1,321 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// @brief 棋譜ログのレコード形式を定義
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <type_traits>
+#include <vector>
+#include "digitalcurling/game_result.hpp"
+#include "digitalcurling/game_rule.hpp"
+#include "digitalcurling/game_setting.hpp"
+#include "digitalcurling/moves/move.hpp"
+#include "digitalcurling/moves/shot.hpp"
+#include "digitalcurling/rules/i_additional_rule.hpp"
+#include "digitalcurling/stone.hpp"
+#include "digitalcurling/stone_coordinate.hpp"
+#include "digitalcurling/team.hpp"
+#include "digitalcurling/simulators/i_simulator.hpp"
+
+/// @brief 棋譜ログ
+///
+/// 棋譜ログは、試合ごとのヘッダー (GameRecordHeader) とショットごとの固定長レコード (ShotRecord) を追記していくバイナリファイルです。
+/// 各試合の開始位置はサイドカーのインデックスファイル (GetGameRecordIndexPath()) に記録され、
+/// GameRecordReader で試合・ショットを指定して直接参照できます。
+///
+/// 値はホストのバイト順・表現のまま書き込まれます。
+/// 異なる環境間での受け渡しには JSON 形式を使用してください。
+namespace digitalcurling::records {
+
+
+/// @brief 棋譜ログの形式のバージョン
+///
+/// レコードの構造に互換性のない変更を加えた場合はこの値を増やします。
+inline constexpr std::uint32_t kGameRecordVersion = 1;
+
+/// @brief 値が存在しないことを表すスコア
+inline constexpr std::uint8_t kNoScore = 0xFF;
+
+
+/// @brief 盤面上の1つのストーン
+struct RecordStone {
+    /// @brief 位置 x
+    float x;
+    /// @brief 位置 y
+    float y;
+    /// @brief 角度 (rad)
+    float angle;
+    /// @brief ストーンが盤面に存在する場合は 1
+    std::uint32_t present;
+};
+
+/// @brief 盤面 (インデックスは StoneCoordinate::GetAllStones() と同じ順序)
+using RecordBoard = std::array<RecordStone, StoneCoordinate::kStoneMax>;
+
+/// @brief ショット (moves::Shot と同じ値)
+struct RecordShot {
+    /// @brief 初速 (m/s)
+    float translational_velocity;
+    /// @brief 初期角速度 (rad/s)
+    float angular_velocity;
+    /// @brief リリース角度 (rad)
+    float release_angle;
+};
+
+/// @brief 行動の種類
+enum class RecordMoveType : std::uint8_t {
+    /// @brief ショット
+    kShot = 0,
+    /// @brief コンシード
+    kConcede = 1,
+};
+
+/// @brief ルール判定の結果
+enum class RecordVerdict : std::uint8_t {
+    /// @brief 違反なし
+    kNone = 0,
+    /// @brief フリーガードゾーン違反
+    kFreeGuardZone = 1,
+    /// @brief ノーティックショット違反
+    kNoTickShot = 2,
+};
+
+
+/// @brief ファイルの先頭に書き込まれるヘッダー
+struct GameRecordFileHeader {
+    /// @brief 識別子 (`"DCGR"`)
+    std::array<char, 4> magic;
+    /// @brief 形式のバージョン (kGameRecordVersion)
+    std::uint32_t version;
+    /// @brief GameRecordHeader のバイト数
+    std::uint32_t game_header_size;
+    /// @brief ShotRecord のバイト数
+    std::uint32_t shot_record_size;
+};
+
+/// @brief 試合ごとのヘッダー
+///
+/// 直後に `shot_count` 個の ShotRecord が続きます。
+struct GameRecordHeader {
+    /// @brief 識別子 (`"DCGH"`)
+    std::array<char, 4> magic;
+    /// @brief ショットレコードの数
+    std::uint32_t shot_count;
+    /// @brief ファイル内での試合の番号 (0 から始まる)
+    std::uint64_t game_index;
+    /// @brief 試合設定のエンド数
+    std::uint8_t max_end;
+    /// @brief 試合ルールの種類 (GameRuleType)
+    std::uint8_t rule_type;
+    /// @brief 第1エンドのハンマー (Team)
+    std::int8_t first_hammer;
+    /// @brief 勝利チーム (Team, 試合が終了していない場合は Team::kInvalid)
+    std::int8_t winner;
+    /// @brief 勝敗の理由 (GameResult::Reason, 試合が終了していない場合は 0xFF)
+    std::uint8_t reason;
+    /// @brief 予約領域
+    std::array<std::uint8_t, 3> reserved;
+    /// @brief アイスシートの横幅
+    float sheet_width;
+};
+
+/// @brief ショットごとの固定長レコード
+struct ShotRecord {
+    /// @brief エンド
+    std::uint8_t end;
+    /// @brief エンド内のショット番号 (0～15)
+    std::uint8_t shot;
+    /// @brief ショットしたチーム (Team)
+    std::int8_t team;
+    /// @brief 現在のエンドのハンマー (Team)
+    std::int8_t hammer;
+    /// @brief 行動の種類
+    RecordMoveType move_type;
+    /// @brief ルール判定の結果
+    RecordVerdict verdict;
+    /// @brief ショット後の現在のエンドのスコア (未確定の場合は kNoScore)
+    std::array<std::uint8_t, 2> score;
+    /// @brief プレイヤーが選択したショット
+    RecordShot shot_value;
+    /// @brief 実際に投げられたショット (ノイズ付加後)
+    RecordShot noisy_shot;
+    /// @brief ショット前の盤面
+    RecordBoard before;
+    /// @brief ショット後の盤面
+    RecordBoard after;
+
+    /// @brief ショット前の盤面を取得する
+    /// @returns ショット前の盤面
+    StoneCoordinate GetBefore() const;
+    /// @brief ショット後の盤面を取得する
+    /// @returns ショット後の盤面
+    StoneCoordinate GetAfter() const;
+    /// @brief 行動を取得する
+    /// @returns 行動 (コンシードの場合は moves::Concede)
+    moves::Move GetMove() const;
+    /// @brief 実際に投げられたショットを取得する
+    /// @returns 実際に投げられたショット
+    moves::Shot GetNoisyShot() const;
+    /// @brief ルール違反の種類を取得する
+    /// @returns 違反したルールの種類 (違反がない場合は `std::nullopt`)
+    std::optional<rules::AdditionalRuleTypes> GetViolation() const;
+};
+
+/// @brief インデックスファイルの1要素
+struct GameRecordIndexEntry {
+    /// @brief 棋譜ログ内での GameRecordHeader の位置 (バイト)
+    std::uint64_t offset;
+    /// @brief ショットレコードの数
+    std::uint64_t shot_count;
+};
+
+/// @cond Doxygen_Suppress
+static_assert(std::is_trivially_copyable_v<GameRecordFileHeader> && sizeof(GameRecordFileHeader) == 16);
+static_assert(std::is_trivially_copyable_v<GameRecordHeader> && sizeof(GameRecordHeader) == 32);
+static_assert(std::is_trivially_copyable_v<ShotRecord> && sizeof(ShotRecord) == 544);
+static_assert(std::is_trivially_copyable_v<GameRecordIndexEntry> && sizeof(GameRecordIndexEntry) == 16);
+/// @endcond
+
+
+/// @brief 棋譜ログに対応するインデックスファイルのパスを取得する
+/// @param path 棋譜ログのパス
+/// @returns インデックスファイルのパス (`path` に `.idx` を付加したもの)
+inline std::filesystem::path GetGameRecordIndexPath(std::filesystem::path const& path)
+{
+    auto index_path = path;
+    index_path += ".idx";
+    return index_path;
+}
+
+/// @brief 盤面をレコード形式に変換する
+/// @param stones 盤面
+/// @returns レコード形式の盤面
+inline RecordBoard ToRecordBoard(StoneCoordinate const& stones)
+{
+    RecordBoard board{};
+    auto const all = stones.GetAllStones();
+    for (std::size_t i = 0; i < all.size(); ++i) {
+        if (all[i]) board[i] = RecordStone{ all[i]->position.x, all[i]->position.y, all[i]->angle, 1 };
+    }
+    return board;
+}
+
+/// @brief シミュレーターのストーンの状態をレコード形式に変換する
+/// @param stones シミュレーターのストーンの状態 (速度は記録されません)
+/// @returns レコード形式の盤面
+inline RecordBoard ToRecordBoard(simulators::ISimulator::AllStones const& stones)
+{
+    RecordBoard board{};
+    for (std::size_t i = 0; i < stones.size(); ++i) {
+        if (stones[i]) board[i] = RecordStone{ stones[i]->position.x, stones[i]->position.y, stones[i]->angle, 1 };
+    }
+    return board;
+}
+
+/// @brief レコード形式の盤面を変換する
+/// @param board レコード形式の盤面
+/// @returns 盤面
+inline StoneCoordinate FromRecordBoard(RecordBoard const& board)
+{
+    std::array<std::optional<Stone>, StoneCoordinate::kStoneMax> stones;
+    for (std::size_t i = 0; i < board.size(); ++i) {
+        if (board[i].present) stones[i] = Stone(Vector2(board[i].x, board[i].y), board[i].angle);
+    }
+    return StoneCoordinate(stones);
+}
+
+/// @brief ショットをレコード形式に変換する
+/// @param shot ショット
+/// @returns レコード形式のショット
+inline RecordShot ToRecordShot(moves::Shot const& shot)
+{
+    return RecordShot{ shot.translational_velocity, shot.angular_velocity, shot.release_angle };
+}
+
+/// @brief ルール違反の種類をレコード形式に変換する
+/// @param violation 違反したルールの種類
+/// @returns ルール判定の結果
+inline RecordVerdict ToRecordVerdict(std::optional<rules::AdditionalRuleTypes> const& violation)
+{
+    if (!violation) return RecordVerdict::kNone;
+    switch (*violation) {
+        case rules::AdditionalRuleTypes::kFreeGuardZone: return RecordVerdict::kFreeGuardZone;
+        case rules::AdditionalRuleTypes::kNoTickShot: return RecordVerdict::kNoTickShot;
+    }
+    return RecordVerdict::kNone;
+}
+
+
+/// @brief 棋譜ログのファイルヘッダーを作成する
+/// @returns ファイルヘッダー
+inline GameRecordFileHeader MakeGameRecordFileHeader()
+{
+    return GameRecordFileHeader{ { 'D', 'C', 'G', 'R' }, kGameRecordVersion, sizeof(GameRecordHeader), sizeof(ShotRecord) };
+}
+
+/// @brief 棋譜ログのファイルヘッダーが有効かを確認する
+/// @param header ファイルヘッダー
+/// @returns 識別子・バージョン・レコードのサイズが一致する場合は `true`
+inline bool IsValidGameRecordFileHeader(GameRecordFileHeader const& header)
+{
+    auto const expected = MakeGameRecordFileHeader();
+    return header.magic == expected.magic && header.version == expected.version &&
+        header.game_header_size == expected.game_header_size && header.shot_record_size == expected.shot_record_size;
+}
+
+/// @brief 棋譜ログを先頭から走査してインデックスを作成する
+///
+/// 末尾に書き込みが完了していない試合がある場合、その試合は含まれません。
+/// @param data 棋譜ログの内容 (ファイルヘッダーを含む)
+/// @param size `data` のバイト数
+/// @returns 完全な試合のインデックス
+inline std::vector<GameRecordIndexEntry> ScanGameRecords(std::uint8_t const* data, std::size_t size)
+{
+    std::vector<GameRecordIndexEntry> entries;
+    std::size_t offset = sizeof(GameRecordFileHeader);
+    while (size - offset >= sizeof(GameRecordHeader)) {
+        GameRecordHeader header;
+        std::memcpy(&header, data + offset, sizeof(header));
+        if (header.magic != std::array<char, 4>{ 'D', 'C', 'G', 'H' }) break;
+        if ((size - offset - sizeof(GameRecordHeader)) / sizeof(ShotRecord) < header.shot_count) break;
+        entries.push_back(GameRecordIndexEntry{ offset, header.shot_count });
+        offset += sizeof(GameRecordHeader) + sizeof(ShotRecord) * header.shot_count;
+    }
+    return entries;
+}
+
+
+/// @cond Doxygen_Suppress
+inline StoneCoordinate ShotRecord::GetBefore() const { return FromRecordBoard(before); }
+inline StoneCoordinate ShotRecord::GetAfter() const { return FromRecordBoard(after); }
+
+inline moves::Move ShotRecord::GetMove() const
+{
+    if (move_type == RecordMoveType::kConcede) return moves::Concede();
+    return moves::Shot(shot_value.translational_velocity, shot_value.angular_velocity, shot_value.release_angle);
+}
+
+inline moves::Shot ShotRecord::GetNoisyShot() const
+{
+    return moves::Shot(noisy_shot.translational_velocity, noisy_shot.angular_velocity, noisy_shot.release_angle);
+}
+
+inline std::optional<rules::AdditionalRuleTypes> ShotRecord::GetViolation() const
+{
+    switch (verdict) {
+        case RecordVerdict::kFreeGuardZone: return rules::AdditionalRuleTypes::kFreeGuardZone;
+        case RecordVerdict::kNoTickShot: return rules::AdditionalRuleTypes::kNoTickShot;
+        default: return std::nullopt;
+    }
+}
+/// @endcond
+
+} // namespace digitalcurling::records
@@ -0,0 +1,182 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// @brief GameRecordReader を定義
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "digitalcurling/detail/mapped_file.hpp"
+#include "digitalcurling/records/game_record.hpp"
+
+namespace digitalcurling::records {
+
+
+/// @brief 棋譜ログをメモリにマップして読み込むクラス
+///
+/// 試合・ショットを指定した直接参照と、複数スレッドによる全試合の走査に対応しています。
+/// 返されるヘッダーやレコードはマップされたファイルを直接指すため、このオブジェクトが破棄されるまで有効です。
+/// インデックスが存在しないか古い場合は、棋譜ログを走査してメモリ上にインデックスを作成します。
+/// @note 読み込み中に書き込まれた試合は、開き直すまで参照できません。
+class GameRecordReader {
+public:
+    /// @brief 棋譜ログを開く
+    /// @param path 棋譜ログのパス
+    /// @throws std::runtime_error ファイルを開けない場合や、棋譜ログの形式でない場合
+    explicit GameRecordReader(std::filesystem::path const& path)
+        : log_(path)
+    {
+        GameRecordFileHeader header{};
+        if (log_.size() >= sizeof(header)) std::memcpy(&header, log_.data(), sizeof(header));
+        if (log_.size() < sizeof(header) || !IsValidGameRecordFileHeader(header))
+            throw std::runtime_error("GameRecordReader: \"" + path.string() + "\" is not a game record file.");
+
+        if (!TryLoadIndex(GetGameRecordIndexPath(path))) {
+            scanned_ = ScanGameRecords(log_.data(), log_.size());
+            entries_ = scanned_.data();
+            game_count_ = scanned_.size();
+        }
+    }
+
+    GameRecordReader(GameRecordReader const&) = delete;
+    GameRecordReader& operator=(GameRecordReader const&) = delete;
+
+    /// @brief 試合の数を取得する
+    /// @returns 試合の数
+    std::size_t GetGameCount() const { return game_count_; }
+
+    /// @brief 試合のヘッダーを取得する
+    /// @param game 試合の番号
+    /// @returns 試合のヘッダー
+    /// @throws std::out_of_range `game` が範囲外の場合
+    GameRecordHeader const& GetGameHeader(std::size_t game) const
+    {
+        return *reinterpret_cast<GameRecordHeader const*>(log_.data() + GetEntry(game).offset);
+    }
+
+    /// @brief 試合のショットの数を取得する
+    /// @param game 試合の番号
+    /// @returns ショットの数
+    /// @throws std::out_of_range `game` が範囲外の場合
+    std::size_t GetShotCount(std::size_t game) const
+    {
+        return static_cast<std::size_t>(GetEntry(game).shot_count);
+    }
+
+    /// @brief 試合のショットのレコードを取得する
+    /// @param game 試合の番号
+    /// @returns 先頭のショットのレコードへのポインタ (GetShotCount() 個が連続して格納されています)
+    /// @throws std::out_of_range `game` が範囲外の場合
+    ShotRecord const* GetShots(std::size_t game) const
+    {
+        return reinterpret_cast<ShotRecord const*>(log_.data() + GetEntry(game).offset + sizeof(GameRecordHeader));
+    }
+
+    /// @brief ショットのレコードを取得する
+    /// @param game 試合の番号
+    /// @param shot 試合内のショットの番号
+    /// @returns ショットのレコード
+    /// @throws std::out_of_range `game` または `shot` が範囲外の場合
+    ShotRecord const& GetShot(std::size_t game, std::size_t shot) const
+    {
+        if (shot >= GetShotCount(game)) throw std::out_of_range("GameRecordReader: shot index is out of range.");
+        return GetShots(game)[shot];
+    }
+
+    /// @brief 全ての試合を複数のスレッドで走査する
+    ///
+    /// 試合は連続した範囲ごとにスレッドに割り当てられ、各スレッド内では先頭から順に処理されます。
+    /// `func` は `func(std::size_t game, GameRecordHeader const& header, ShotRecord const* shots, std::size_t shot_count)` の形式で呼び出されます。
+    /// @tparam TFunc 関数の型
+    /// @param func 試合ごとに呼び出す関数 (複数のスレッドから同時に呼び出されます)
+    /// @param thread_count スレッド数 (0 の場合はハードウェアの並列数)
+    /// @throws いずれかの呼び出しで送出された最初の例外
+    template <typename TFunc>
+    void ForEachGame(TFunc&& func, unsigned int thread_count = 0) const
+    {
+        if (thread_count == 0) thread_count = std::max(1u, std::thread::hardware_concurrency());
+        thread_count = static_cast<unsigned int>(std::min<std::size_t>(thread_count, std::max<std::size_t>(game_count_, 1)));
+        log_.AdviseSequential();
+
+        auto scan = [&](std::size_t begin, std::size_t end) {
+            for (std::size_t game = begin; game < end; ++game) {
+                func(game, GetGameHeader(game), GetShots(game), GetShotCount(game));
+            }
+        };
+        if (thread_count == 1) {
+            scan(0, game_count_);
+            return;
+        }
+
+        std::exception_ptr error;
+        std::mutex error_mutex;
+        std::vector<std::thread> threads;
+        threads.reserve(thread_count);
+        for (unsigned int i = 0; i < thread_count; ++i) {
+            auto const begin = game_count_ * i / thread_count;
+            auto const end = game_count_ * (i + 1) / thread_count;
+            threads.emplace_back([&, begin, end] {
+                try {
+                    scan(begin, end);
+                } catch (...) {
+                    std::lock_guard lock(error_mutex);
+                    if (!error) error = std::current_exception();
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        if (error) std::rethrow_exception(error);
+    }
+
+private:
+    detail::MappedFile log_;
+    detail::MappedFile index_;
+    std::vector<GameRecordIndexEntry> scanned_;
+    GameRecordIndexEntry const* entries_ = nullptr;
+    std::size_t game_count_ = 0;
+
+    GameRecordIndexEntry const& GetEntry(std::size_t game) const
+    {
+        if (game >= game_count_) throw std::out_of_range("GameRecordReader: game index is out of range.");
+        return entries_[game];
+    }
+
+    // インデックスの最後の試合がファイルの末尾と一致すれば, インデックスを使用する
+    bool TryLoadIndex(std::filesystem::path const& index_path)
+    {
+        std::error_code ec;
+        if (!std::filesystem::exists(index_path, ec)) return false;
+        try {
+            index_ = detail::MappedFile(index_path);
+        } catch (std::runtime_error const&) {
+            return false;
+        }
+        if (index_.size() % sizeof(GameRecordIndexEntry) != 0) return false;
+
+        auto const count = index_.size() / sizeof(GameRecordIndexEntry);
+        auto const* entries = reinterpret_cast<GameRecordIndexEntry const*>(index_.data());
+        if (count == 0) {
+            if (log_.size() != sizeof(GameRecordFileHeader)) return false;
+        } else {
+            auto const& last = entries[count - 1];
+            if (last.offset > log_.size() || log_.size() - last.offset != sizeof(GameRecordHeader) + sizeof(ShotRecord) * last.shot_count) return false;
+        }
+
+        entries_ = entries;
+        game_count_ = count;
+        return true;
+    }
+};
+
+} // namespace digitalcurling::records
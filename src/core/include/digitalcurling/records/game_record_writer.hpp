@@ -0,0 +1,215 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// @brief GameRecordWriter を定義
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "digitalcurling/detail/mapped_file.hpp"
+#include "digitalcurling/game_state.hpp"
+#include "digitalcurling/records/game_record.hpp"
+
+namespace digitalcurling::records {
+
+
+/// @brief 棋譜ログに試合を追記するクラス
+///
+/// 試合は BeginGame() で開始し、AppendShot() でショットを追加して、EndGame() でファイルに書き込みます。
+/// 試合は EndGame() でまとめて書き込まれるため、書き込み中にプロセスが終了しても、ファイルには完全な試合のみが残ります。
+/// 既存のファイルを開いた場合は末尾に追記します (インデックスが古い場合は再作成し、末尾の不完全な試合は切り捨てます)。
+/// @note スレッドセーフではありません。
+class GameRecordWriter {
+public:
+    /// @brief 棋譜ログを開く
+    /// @param path 棋譜ログのパス (存在しない場合は作成する)
+    /// @throws std::runtime_error ファイルを開けない場合や、棋譜ログの形式でない場合
+    explicit GameRecordWriter(std::filesystem::path const& path)
+        : path_(path), index_path_(GetGameRecordIndexPath(path)), game_count_(0), end_offset_(sizeof(GameRecordFileHeader))
+    {
+        std::error_code ec;
+        auto const exists = std::filesystem::exists(path_, ec) && std::filesystem::file_size(path_, ec) > 0;
+        if (exists) Recover();
+
+        log_.open(path_, std::ios::binary | std::ios::app);
+        index_.open(index_path_, std::ios::binary | std::ios::app);
+        if (!log_ || !index_) throw std::runtime_error("GameRecordWriter: failed to open \"" + path_.string() + "\".");
+
+        if (!exists) {
+            auto const header = MakeGameRecordFileHeader();
+            log_.write(reinterpret_cast<char const*>(&header), sizeof(header));
+            log_.flush();
+            if (!log_) throw std::runtime_error("GameRecordWriter: failed to write \"" + path_.string() + "\".");
+        }
+    }
+
+    GameRecordWriter(GameRecordWriter const&) = delete;
+    GameRecordWriter& operator=(GameRecordWriter const&) = delete;
+
+    /// @brief 試合を開始する
+    ///
+    /// 書き込まれていない試合がある場合、その試合は破棄されます。
+    /// @param setting 試合設定
+    /// @param rule 試合ルール
+    /// @param initial_state 試合開始時の状態
+    void BeginGame(GameSetting const& setting, GameRule const& rule, GameState const& initial_state)
+    {
+        header_ = GameRecordHeader{};
+        header_->magic = { 'D', 'C', 'G', 'H' };
+        header_->game_index = game_count_;
+        header_->max_end = setting.max_end;
+        header_->rule_type = static_cast<std::uint8_t>(rule.type);
+        header_->first_hammer = static_cast<std::int8_t>(initial_state.hammer);
+        header_->winner = static_cast<std::int8_t>(Team::kInvalid);
+        header_->reason = 0xFF;
+        header_->sheet_width = setting.sheet_width;
+        shots_.clear();
+    }
+
+    /// @brief ショットを追加する
+    /// @param before ショット前の試合の状態
+    /// @param move プレイヤーが選択した行動
+    /// @param noisy_shot 実際に投げられたショット (ノイズ付加後)
+    /// @param after_stones シミュレーション後のストーンの状態
+    /// @param violation 違反したルールの種類 (違反がない場合は `std::nullopt`)
+    /// @param after ショット後の試合の状態
+    /// @throws std::logic_error 試合が開始されていない場合
+    void AppendShot(
+        GameState const& before,
+        moves::Move const& move,
+        moves::Shot const& noisy_shot,
+        simulators::ISimulator::AllStones const& after_stones,
+        std::optional<rules::AdditionalRuleTypes> const& violation,
+        GameState const& after)
+    {
+        ShotRecord record{};
+        record.end = before.end;
+        record.shot = before.shot;
+        record.team = static_cast<std::int8_t>(before.GetNextTeam());
+        record.hammer = static_cast<std::int8_t>(before.hammer);
+        record.verdict = ToRecordVerdict(violation);
+        for (auto team : { Team::k0, Team::k1 }) {
+            auto const& scores = after.scores[team];
+            auto const score = before.end < scores.size() ? scores[before.end] : std::nullopt;
+            record.score[static_cast<std::size_t>(team)] = score ? *score : kNoScore;
+        }
+        if (auto const* shot = std::get_if<moves::Shot>(&move)) {
+            record.move_type = RecordMoveType::kShot;
+            record.shot_value = ToRecordShot(*shot);
+            record.noisy_shot = ToRecordShot(noisy_shot);
+        } else {
+            record.move_type = RecordMoveType::kConcede;
+        }
+        record.before = ToRecordBoard(before.stones);
+        record.after = ToRecordBoard(after_stones);
+        AppendShot(record);
+    }
+
+    /// @brief ショットのレコードを追加する
+    /// @param record ショットのレコード
+    /// @throws std::logic_error 試合が開始されていない場合
+    void AppendShot(ShotRecord const& record)
+    {
+        if (!header_) throw std::logic_error("GameRecordWriter: game is not started.");
+        shots_.push_back(record);
+    }
+
+    /// @brief 試合を終了してファイルに書き込む
+    /// @param result 試合結果 (試合が終了していない場合は `std::nullopt`)
+    /// @returns 書き込んだ試合の番号
+    /// @throws std::logic_error 試合が開始されていない場合
+    /// @throws std::runtime_error 書き込みに失敗した場合
+    std::uint64_t EndGame(std::optional<GameResult> const& result)
+    {
+        if (!header_) throw std::logic_error("GameRecordWriter: game is not started.");
+        if (result) {
+            header_->winner = static_cast<std::int8_t>(result->winner);
+            header_->reason = static_cast<std::uint8_t>(result->reason);
+        }
+        header_->shot_count = static_cast<std::uint32_t>(shots_.size());
+
+        GameRecordIndexEntry const entry{ end_offset_, shots_.size() };
+        log_.write(reinterpret_cast<char const*>(&*header_), sizeof(GameRecordHeader));
+        log_.write(reinterpret_cast<char const*>(shots_.data()), static_cast<std::streamsize>(sizeof(ShotRecord) * shots_.size()));
+        log_.flush();
+        index_.write(reinterpret_cast<char const*>(&entry), sizeof(entry));
+        index_.flush();
+        if (!log_ || !index_) throw std::runtime_error("GameRecordWriter: failed to write \"" + path_.string() + "\".");
+
+        end_offset_ += sizeof(GameRecordHeader) + sizeof(ShotRecord) * shots_.size();
+        header_.reset();
+        shots_.clear();
+        return game_count_++;
+    }
+
+    /// @brief ファイルに書き込まれた試合の数を取得する
+    /// @returns 試合の数
+    std::uint64_t GetGameCount() const { return game_count_; }
+
+private:
+    std::filesystem::path path_;
+    std::filesystem::path index_path_;
+    std::ofstream log_;
+    std::ofstream index_;
+    std::uint64_t game_count_;
+    // ファイルの末尾 (次の試合を書き込む位置)
+    std::uint64_t end_offset_;
+    std::optional<GameRecordHeader> header_;
+    std::vector<ShotRecord> shots_;
+
+    // 既存のファイルを検証し, インデックスが古い場合は再作成して不完全な試合を切り捨てる
+    void Recover()
+    {
+        std::vector<GameRecordIndexEntry> entries;
+        {
+            detail::MappedFile file(path_);
+            GameRecordFileHeader header{};
+            if (file.size() >= sizeof(header)) std::memcpy(&header, file.data(), sizeof(header));
+            if (file.size() < sizeof(header) || !IsValidGameRecordFileHeader(header))
+                throw std::runtime_error("GameRecordWriter: \"" + path_.string() + "\" is not a game record file.");
+
+            if (auto count = GetIndexedGameCount(file)) {
+                game_count_ = *count;
+                end_offset_ = file.size();
+                return;
+            }
+            entries = ScanGameRecords(file.data(), file.size());
+        }
+
+        end_offset_ = entries.empty() ? sizeof(GameRecordFileHeader) : entries.back().offset + sizeof(GameRecordHeader) + sizeof(ShotRecord) * entries.back().shot_count;
+        game_count_ = entries.size();
+        std::filesystem::resize_file(path_, end_offset_);
+        std::ofstream index(index_path_, std::ios::binary | std::ios::trunc);
+        index.write(reinterpret_cast<char const*>(entries.data()), static_cast<std::streamsize>(sizeof(GameRecordIndexEntry) * entries.size()));
+        if (!index) throw std::runtime_error("GameRecordWriter: failed to write \"" + index_path_.string() + "\".");
+    }
+
+    // インデックスの最後の試合がファイルの末尾と一致すれば, インデックスの試合数を返す
+    std::optional<std::uint64_t> GetIndexedGameCount(detail::MappedFile const& file) const
+    {
+        std::error_code ec;
+        auto const size = std::filesystem::file_size(index_path_, ec);
+        if (ec || size % sizeof(GameRecordIndexEntry) != 0) return std::nullopt;
+        if (size == 0) return file.size() == sizeof(GameRecordFileHeader) ? std::make_optional<std::uint64_t>(0) : std::nullopt;
+
+        detail::MappedFile index(index_path_);
+        GameRecordIndexEntry last;
+        std::memcpy(&last, index.data() + size - sizeof(last), sizeof(last));
+        if (last.offset > file.size() || file.size() - last.offset != sizeof(GameRecordHeader) + sizeof(ShotRecord) * last.shot_count) return std::nullopt;
+
+        GameRecordHeader header;
+        std::memcpy(&header, file.data() + last.offset, sizeof(header));
+        if (header.magic != std::array<char, 4>{ 'D', 'C', 'G', 'H' } || header.shot_count != last.shot_count) return std::nullopt;
+        return size / sizeof(GameRecordIndexEntry);
+    }
+};
+
+} // namespace digitalcurling::records
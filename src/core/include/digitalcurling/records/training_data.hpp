@@ -0,0 +1,299 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// @brief 学習データの列形式を定義
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string_view>
+#include <vector>
+#include "digitalcurling/game_state.hpp"
+#include "digitalcurling/moves/shot.hpp"
+#include "digitalcurling/records/game_record.hpp"
+#include "digitalcurling/simulators/i_simulator.hpp"
+#include "digitalcurling/stone_coordinate.hpp"
+
+namespace digitalcurling::records {
+
+
+/// @brief 学習データファイルの形式のバージョン
+///
+/// ファイルの形式を変更した場合に更新します。
+inline constexpr std::uint32_t kTrainingDataVersion = 1;
+
+/// @brief 学習データの列の要素の型
+enum class TrainingDataType : std::uint8_t {
+    /// @brief 32ビット浮動小数点数
+    kFloat32 = 1,
+    /// @brief 8ビット符号なし整数
+    kUInt8 = 2,
+};
+
+/// @brief 要素の型のバイト数を取得する
+/// @param type 要素の型
+/// @returns バイト数
+inline constexpr std::size_t GetTrainingDataTypeSize(TrainingDataType type)
+{
+    return type == TrainingDataType::kFloat32 ? sizeof(float) : sizeof(std::uint8_t);
+}
+
+/// @brief 学習データの列
+///
+/// 列は次の順に並びます。盤面は StoneCoordinate::GetAllStones() の順の 16 個のストーンについて (x, y, present) を並べたものです (ストーンが無い場合は 0, 0, 0)。
+enum class TrainingDataColumnId : std::size_t {
+    /// @brief ショット前の盤面 (float32 × 48)
+    kBefore,
+    /// @brief ショット (並進速度, 角速度, 角度) (float32 × 3)
+    kShot,
+    /// @brief ショット後の盤面 (float32 × 48)
+    kAfter,
+    /// @brief エンド番号 (uint8 × 1)
+    kEnd,
+    /// @brief エンド内のショット番号 (uint8 × 1)
+    kShotNumber,
+    /// @brief 左右反転で生成された行なら 1 (uint8 × 1)
+    kMirrored,
+};
+
+/// @brief 学習データの列の数
+inline constexpr std::size_t kTrainingDataColumnCount = 6;
+
+/// @brief 盤面の列の要素数
+inline constexpr std::uint32_t kTrainingDataBoardWidth = StoneCoordinate::kStoneMax * 3;
+
+/// @brief 学習データファイルのヘッダー
+///
+/// ファイルは、このヘッダー、列の定義 (TrainingDataColumn) の配列、チャンクの並びで構成されます。
+struct TrainingDataFileHeader {
+    /// @brief マジックナンバー "DCTD"
+    std::array<char, 4> magic;
+    /// @brief 形式のバージョン (kTrainingDataVersion)
+    std::uint32_t version;
+    /// @brief 列の数
+    std::uint32_t column_count;
+    /// @brief 予約
+    std::uint32_t reserved;
+};
+static_assert(sizeof(TrainingDataFileHeader) == 16);
+
+/// @brief 学習データの列の定義
+struct TrainingDataColumn {
+    /// @brief 列名 (NUL 終端)
+    std::array<char, 24> name;
+    /// @brief 要素の型
+    TrainingDataType type;
+    /// @brief 予約
+    std::array<std::uint8_t, 3> reserved;
+    /// @brief 1行あたりの要素数
+    std::uint32_t width;
+
+    /// @brief 列名を取得する
+    /// @returns 列名
+    std::string_view GetName() const
+    {
+        std::string_view const view(name.data(), name.size());
+        return view.substr(0, view.find('\0'));
+    }
+    /// @brief 1行あたりのバイト数を取得する
+    /// @returns バイト数
+    std::size_t GetRowSize() const { return GetTrainingDataTypeSize(type) * width; }
+};
+static_assert(sizeof(TrainingDataColumn) == 32);
+
+/// @brief 学習データのチャンクのヘッダー
+///
+/// ヘッダーの後に、列の定義の順に各列のデータ (`row_count` × 1行あたりのバイト数) が続きます。
+/// 各列のデータは 8 バイト境界に揃えられます。
+struct TrainingDataChunkHeader {
+    /// @brief マジックナンバー "DCTC"
+    std::array<char, 4> magic;
+    /// @brief 行数
+    std::uint32_t row_count;
+    /// @brief ヘッダーを除いたチャンクのバイト数
+    std::uint64_t payload_size;
+};
+static_assert(sizeof(TrainingDataChunkHeader) == 16);
+
+/// @brief 列のデータの境界
+inline constexpr std::size_t kTrainingDataAlignment = 8;
+
+/// @brief 列のデータのバイト数を境界に揃える
+/// @param size バイト数
+/// @returns 境界に揃えたバイト数
+inline constexpr std::size_t AlignTrainingDataSize(std::size_t size)
+{
+    return (size + kTrainingDataAlignment - 1) / kTrainingDataAlignment * kTrainingDataAlignment;
+}
+
+/// @brief 学習データの列の定義を取得する
+/// @returns 列の定義 (TrainingDataColumnId の順)
+inline std::array<TrainingDataColumn, kTrainingDataColumnCount> const& GetTrainingDataSchema()
+{
+    static auto const schema = [] {
+        auto make = [](char const* name, TrainingDataType type, std::uint32_t width) {
+            TrainingDataColumn column{};
+            std::strncpy(column.name.data(), name, column.name.size() - 1);
+            column.type = type;
+            column.width = width;
+            return column;
+        };
+        return std::array<TrainingDataColumn, kTrainingDataColumnCount>{
+            make("before", TrainingDataType::kFloat32, kTrainingDataBoardWidth),
+            make("shot", TrainingDataType::kFloat32, 3),
+            make("after", TrainingDataType::kFloat32, kTrainingDataBoardWidth),
+            make("end", TrainingDataType::kUInt8, 1),
+            make("shot_number", TrainingDataType::kUInt8, 1),
+            make("mirrored", TrainingDataType::kUInt8, 1),
+        };
+    }();
+    return schema;
+}
+
+
+/// @brief 学習データの行をまとめたチャンク
+///
+/// 行は列ごとの配列に追加され、TrainingDataWriter::WriteChunk() でまとめてファイルに書き込まれます。
+/// @note スレッドセーフではありません。複数のスレッドから書き込む場合は、スレッドごとにチャンクを用意してください。
+class TrainingDataChunk {
+public:
+    /// @brief コンストラクタ
+    /// @param mirror `true` の場合、各行について左右反転した行も追加する
+    explicit TrainingDataChunk(bool mirror = false) : mirror_(mirror), row_count_(0) {}
+
+    /// @brief 行を追加する
+    /// @param before ショット前の盤面
+    /// @param shot ショット
+    /// @param after ショット後の盤面
+    /// @param end エンド番号
+    /// @param shot_number エンド内のショット番号
+    void Add(StoneCoordinate const& before, moves::Shot const& shot, StoneCoordinate const& after,
+        std::uint8_t end = 0, std::uint8_t shot_number = 0)
+    {
+        Add(ToRecordBoard(before), shot, ToRecordBoard(after), end, shot_number);
+    }
+
+    /// @brief 行を追加する
+    /// @param before ショット前の盤面 (シミュレーターの入力)
+    /// @param shot ショット
+    /// @param after ショット後の盤面 (シミュレーターの出力)
+    /// @param end エンド番号
+    /// @param shot_number エンド内のショット番号
+    void Add(simulators::ISimulator::AllStones const& before, moves::Shot const& shot, simulators::ISimulator::AllStones const& after,
+        std::uint8_t end = 0, std::uint8_t shot_number = 0)
+    {
+        Add(ToRecordBoard(before), shot, ToRecordBoard(after), end, shot_number);
+    }
+
+    /// @brief 行を追加する
+    /// @param before ショット前の試合の状態
+    /// @param shot ショット
+    /// @param after ショット後の試合の状態
+    void Add(GameState const& before, moves::Shot const& shot, GameState const& after)
+    {
+        Add(before.stones, shot, after.stones, before.end, before.shot);
+    }
+
+    /// @brief 棋譜ログのショットから行を追加する
+    ///
+    /// ショットには実際に投げられたショット (ノイズ付加後) を使用します。コンシードの記録は無視します。
+    /// @param record ショットのレコード
+    void Add(ShotRecord const& record)
+    {
+        if (record.move_type != RecordMoveType::kShot) return;
+        Add(record.before, record.GetNoisyShot(), record.after, record.end, record.shot);
+    }
+
+    /// @brief 行を追加する
+    /// @param before ショット前の盤面
+    /// @param shot ショット
+    /// @param after ショット後の盤面
+    /// @param end エンド番号
+    /// @param shot_number エンド内のショット番号
+    void Add(RecordBoard const& before, moves::Shot const& shot, RecordBoard const& after, std::uint8_t end, std::uint8_t shot_number)
+    {
+        AddRow(before, shot, after, end, shot_number, false);
+        if (mirror_) AddRow(before, shot, after, end, shot_number, true);
+    }
+
+    /// @brief 行数を取得する
+    /// @returns 行数
+    std::size_t GetRowCount() const { return row_count_; }
+
+    /// @brief 左右反転した行も追加するか
+    /// @returns 追加する場合 `true`
+    bool IsMirrored() const { return mirror_; }
+
+    /// @brief 列のデータを取得する
+    /// @param column 列
+    /// @returns 列のデータ (`GetRowCount()` × 1行あたりのバイト数)
+    std::vector<std::uint8_t> const& GetColumnData(TrainingDataColumnId column) const
+    {
+        return columns_[static_cast<std::size_t>(column)];
+    }
+
+    /// @brief 全ての行を削除する
+    ///
+    /// 確保したメモリは再利用されます。
+    void Clear()
+    {
+        for (auto& column : columns_) column.clear();
+        row_count_ = 0;
+    }
+
+    /// @brief 左右反転したショットを得る
+    /// @param shot ショット
+    /// @returns x 軸を反転したショット
+    static moves::Shot MirrorShot(moves::Shot const& shot)
+    {
+        return moves::Shot(shot.translational_velocity, -shot.angular_velocity, kPi - shot.release_angle);
+    }
+
+private:
+    static constexpr float kPi = 3.14159265358979323846f;
+
+    bool mirror_;
+    std::size_t row_count_;
+    std::array<std::vector<std::uint8_t>, kTrainingDataColumnCount> columns_;
+
+    template <typename T, std::size_t N>
+    void Push(TrainingDataColumnId column, std::array<T, N> const& values)
+    {
+        auto& data = columns_[static_cast<std::size_t>(column)];
+        auto const offset = data.size();
+        data.resize(offset + sizeof(values));
+        std::memcpy(data.data() + offset, values.data(), sizeof(values));
+    }
+
+    static std::array<float, kTrainingDataBoardWidth> FlattenBoard(RecordBoard const& board, bool mirror)
+    {
+        std::array<float, kTrainingDataBoardWidth> values{};
+        for (std::size_t i = 0; i < board.size(); ++i) {
+            if (!board[i].present) continue;
+            values[i * 3 + 0] = mirror ? -board[i].x : board[i].x;
+            values[i * 3 + 1] = board[i].y;
+            values[i * 3 + 2] = 1.f;
+        }
+        return values;
+    }
+
+    void AddRow(RecordBoard const& before, moves::Shot const& shot, RecordBoard const& after,
+        std::uint8_t end, std::uint8_t shot_number, bool mirror)
+    {
+        auto const s = mirror ? MirrorShot(shot) : shot;
+        Push(TrainingDataColumnId::kBefore, FlattenBoard(before, mirror));
+        Push(TrainingDataColumnId::kShot, std::array<float, 3>{ s.translational_velocity, s.angular_velocity, s.release_angle });
+        Push(TrainingDataColumnId::kAfter, FlattenBoard(after, mirror));
+        Push(TrainingDataColumnId::kEnd, std::array<std::uint8_t, 1>{ end });
+        Push(TrainingDataColumnId::kShotNumber, std::array<std::uint8_t, 1>{ shot_number });
+        Push(TrainingDataColumnId::kMirrored, std::array<std::uint8_t, 1>{ static_cast<std::uint8_t>(mirror ? 1 : 0) });
+        ++row_count_;
+    }
+};
+
+} // namespace digitalcurling::records
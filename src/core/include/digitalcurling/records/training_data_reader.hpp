@@ -0,0 +1,169 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// @brief TrainingDataReader を定義
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "digitalcurling/detail/mapped_file.hpp"
+#include "digitalcurling/records/training_data.hpp"
+
+namespace digitalcurling::records {
+
+
+/// @brief 列形式の学習データファイルを読み込むクラス
+///
+/// ファイルはメモリマップされ、各チャンクの列のデータはコピーせずに参照できます。
+/// @note 読み込み専用のため、複数のスレッドから同時に呼び出せます。
+class TrainingDataReader {
+public:
+    /// @brief 学習データファイルを開く
+    /// @param path ファイルのパス
+    /// @throws std::runtime_error ファイルを開けない場合や、学習データファイルの形式でない場合
+    explicit TrainingDataReader(std::filesystem::path const& path)
+        : file_(path), row_count_(0)
+    {
+        auto const* data = file_.data();
+        auto const size = file_.size();
+
+        TrainingDataFileHeader header;
+        if (size < sizeof(header)) Fail(path);
+        std::memcpy(&header, data, sizeof(header));
+        if (header.magic != std::array<char, 4>{ 'D', 'C', 'T', 'D' } || header.version != kTrainingDataVersion) Fail(path);
+
+        auto offset = sizeof(header);
+        if ((size - offset) / sizeof(TrainingDataColumn) < header.column_count) Fail(path);
+        columns_.resize(header.column_count);
+        std::memcpy(columns_.data(), data + offset, sizeof(TrainingDataColumn) * header.column_count);
+        offset += sizeof(TrainingDataColumn) * header.column_count;
+
+        while (offset < size) {
+            TrainingDataChunkHeader chunk;
+            if (size - offset < sizeof(chunk)) Fail(path);
+            std::memcpy(&chunk, data + offset, sizeof(chunk));
+            offset += sizeof(chunk);
+            if (chunk.magic != std::array<char, 4>{ 'D', 'C', 'T', 'C' } || size - offset < chunk.payload_size) Fail(path);
+
+            Chunk entry{ chunk.row_count, {} };
+            auto column_offset = offset;
+            for (auto const& column : columns_) {
+                entry.column_offsets.push_back(column_offset);
+                column_offset += AlignTrainingDataSize(column.GetRowSize() * chunk.row_count);
+            }
+            if (column_offset - offset != chunk.payload_size) Fail(path);
+            offset = column_offset;
+            row_count_ += chunk.row_count;
+            chunks_.push_back(std::move(entry));
+        }
+    }
+
+    /// @brief 列の定義を取得する
+    /// @returns 列の定義
+    std::vector<TrainingDataColumn> const& GetColumns() const { return columns_; }
+
+    /// @brief 列を名前で探す
+    /// @param name 列名
+    /// @returns 列のインデックス (見つからない場合は `std::nullopt`)
+    std::optional<std::size_t> FindColumn(std::string_view name) const
+    {
+        for (std::size_t i = 0; i < columns_.size(); ++i) {
+            if (columns_[i].GetName() == name) return i;
+        }
+        return std::nullopt;
+    }
+
+    /// @brief 全チャンクの行数の合計を取得する
+    /// @returns 行数
+    std::size_t GetRowCount() const { return row_count_; }
+
+    /// @brief チャンクの数を取得する
+    /// @returns チャンクの数
+    std::size_t GetChunkCount() const { return chunks_.size(); }
+
+    /// @brief チャンクの行数を取得する
+    /// @param chunk チャンクのインデックス
+    /// @returns 行数
+    /// @throws std::out_of_range インデックスが範囲外の場合
+    std::size_t GetChunkRowCount(std::size_t chunk) const { return GetChunk(chunk).row_count; }
+
+    /// @brief チャンクの列のデータを取得する
+    /// @tparam T 要素の型 (列の型と一致する必要があります)
+    /// @param chunk チャンクのインデックス
+    /// @param column 列のインデックス
+    /// @returns 列のデータの先頭 (行数 × 列の要素数)
+    /// @throws std::out_of_range インデックスが範囲外の場合
+    /// @throws std::invalid_argument 要素の型が一致しない場合
+    template <typename T>
+    T const* GetColumnData(std::size_t chunk, std::size_t column) const
+    {
+        auto const& entry = GetChunk(chunk);
+        CheckType<T>(column);
+        return reinterpret_cast<T const*>(file_.data() + entry.column_offsets[column]);
+    }
+
+    /// @brief 全チャンクの列のデータを連結して取得する
+    /// @tparam T 要素の型 (列の型と一致する必要があります)
+    /// @param column 列のインデックス
+    /// @returns 列のデータ (行数 × 列の要素数)
+    /// @throws std::out_of_range インデックスが範囲外の場合
+    /// @throws std::invalid_argument 要素の型が一致しない場合
+    template <typename T>
+    std::vector<T> ReadColumn(std::size_t column) const
+    {
+        CheckType<T>(column);
+        auto const width = columns_[column].width;
+        std::vector<T> values(row_count_ * width);
+        auto* dest = values.data();
+        for (auto const& entry : chunks_) {
+            auto const n = entry.row_count * width;
+            std::memcpy(dest, file_.data() + entry.column_offsets[column], n * sizeof(T));
+            dest += n;
+        }
+        return values;
+    }
+
+private:
+    struct Chunk {
+        std::size_t row_count;
+        std::vector<std::size_t> column_offsets;
+    };
+
+    detail::MappedFile file_;
+    std::vector<TrainingDataColumn> columns_;
+    std::vector<Chunk> chunks_;
+    std::size_t row_count_;
+
+    Chunk const& GetChunk(std::size_t chunk) const
+    {
+        if (chunk >= chunks_.size()) throw std::out_of_range("TrainingDataReader: chunk index is out of range.");
+        return chunks_[chunk];
+    }
+
+    template <typename T>
+    void CheckType(std::size_t column) const
+    {
+        if (column >= columns_.size()) throw std::out_of_range("TrainingDataReader: column index is out of range.");
+        auto const type = columns_[column].type;
+        auto const expected = std::is_same_v<T, float> ? TrainingDataType::kFloat32
+            : std::is_same_v<T, std::uint8_t> ? TrainingDataType::kUInt8 : TrainingDataType{};
+        if (type != expected) throw std::invalid_argument("TrainingDataReader: element type does not match the column type.");
+    }
+
+    [[noreturn]] static void Fail(std::filesystem::path const& path)
+    {
+        throw std::runtime_error("TrainingDataReader: \"" + path.string() + "\" is not a valid training data file.");
+    }
+};
+
+} // namespace digitalcurling::records
@@ -0,0 +1,181 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// @brief TrainingDataWriter を定義
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "digitalcurling/moves/shot.hpp"
+#include "digitalcurling/records/training_data.hpp"
+#include "digitalcurling/simulators/i_simulator.hpp"
+
+namespace digitalcurling::records {
+
+
+/// @brief 学習データを列形式のファイルに書き込むクラス
+///
+/// 行は TrainingDataChunk にまとめて、WriteChunk() でチャンク単位に書き込みます。
+/// 各チャンクは独立しているため、チャンクの順序は意味を持ちません。
+/// @note WriteChunk(), WriteBatch() はスレッドセーフです。
+class TrainingDataWriter {
+public:
+    /// @brief 1チャンクあたりの既定の行数
+    static constexpr std::size_t kDefaultChunkRows = 4096;
+
+    /// @brief 学習データファイルを作成する
+    /// @param path ファイルのパス (存在する場合は上書きする)
+    /// @throws std::runtime_error ファイルを開けない場合
+    explicit TrainingDataWriter(std::filesystem::path const& path)
+        : path_(path), row_count_(0)
+    {
+        stream_.open(path_, std::ios::binary | std::ios::trunc);
+        if (!stream_) throw std::runtime_error("TrainingDataWriter: failed to open \"" + path_.string() + "\".");
+
+        auto const& schema = GetTrainingDataSchema();
+        TrainingDataFileHeader header{};
+        header.magic = { 'D', 'C', 'T', 'D' };
+        header.version = kTrainingDataVersion;
+        header.column_count = static_cast<std::uint32_t>(schema.size());
+        stream_.write(reinterpret_cast<char const*>(&header), sizeof(header));
+        stream_.write(reinterpret_cast<char const*>(schema.data()), sizeof(TrainingDataColumn) * schema.size());
+        Check();
+    }
+
+    TrainingDataWriter(TrainingDataWriter const&) = delete;
+    TrainingDataWriter& operator=(TrainingDataWriter const&) = delete;
+
+    /// @brief チャンクを書き込む
+    ///
+    /// 書き込んだ後、チャンクは空になります。空のチャンクは書き込みません。
+    /// @param chunk 書き込むチャンク
+    /// @throws std::runtime_error 書き込みに失敗した場合
+    void WriteChunk(TrainingDataChunk& chunk)
+    {
+        auto const rows = chunk.GetRowCount();
+        if (rows == 0) return;
+
+        auto const& schema = GetTrainingDataSchema();
+        TrainingDataChunkHeader header{};
+        header.magic = { 'D', 'C', 'T', 'C' };
+        header.row_count = static_cast<std::uint32_t>(rows);
+        for (auto const& column : schema) header.payload_size += AlignTrainingDataSize(column.GetRowSize() * rows);
+
+        static constexpr char kPadding[kTrainingDataAlignment] = {};
+        {
+            std::lock_guard lock(mutex_);
+            stream_.write(reinterpret_cast<char const*>(&header), sizeof(header));
+            for (std::size_t i = 0; i < schema.size(); ++i) {
+                auto const& data = chunk.GetColumnData(static_cast<TrainingDataColumnId>(i));
+                stream_.write(reinterpret_cast<char const*>(data.data()), static_cast<std::streamsize>(data.size()));
+                stream_.write(kPadding, static_cast<std::streamsize>(AlignTrainingDataSize(data.size()) - data.size()));
+            }
+            Check();
+            row_count_ += rows;
+        }
+        chunk.Clear();
+    }
+
+    /// @brief 一括シミュレーションの結果をまとめて書き込む
+    ///
+    /// 要素をチャンクに分割し、複数のスレッドで並列に変換して書き込みます。
+    /// @param before 各要素のショット前の盤面
+    /// @param shots 各要素のショット
+    /// @param after 各要素のショット後の盤面
+    /// @param mirror `true` の場合、左右反転した行も書き込む
+    /// @param thread_count スレッド数 (0 の場合はハードウェアの並列数)
+    /// @param chunk_rows 1チャンクあたりの要素数
+    /// @throws std::invalid_argument 配列の長さが一致しない場合
+    /// @throws std::runtime_error 書き込みに失敗した場合
+    void WriteBatch(
+        std::vector<simulators::ISimulator::AllStones> const& before,
+        std::vector<moves::Shot> const& shots,
+        std::vector<simulators::ISimulator::AllStones> const& after,
+        bool mirror = false,
+        unsigned int thread_count = 0,
+        std::size_t chunk_rows = kDefaultChunkRows)
+    {
+        if (before.size() != shots.size() || before.size() != after.size()) {
+            throw std::invalid_argument("TrainingDataWriter: size of before, shots and after must be equal.");
+        }
+        if (chunk_rows == 0) throw std::invalid_argument("TrainingDataWriter: chunk_rows must be positive.");
+
+        auto const count = before.size();
+        auto const chunk_count = (count + chunk_rows - 1) / chunk_rows;
+        if (thread_count == 0) thread_count = std::max(1u, std::thread::hardware_concurrency());
+        thread_count = static_cast<unsigned int>(std::min<std::size_t>(thread_count, std::max<std::size_t>(chunk_count, 1)));
+
+        std::atomic<std::size_t> next = 0;
+        auto work = [&] {
+            TrainingDataChunk chunk(mirror);
+            for (std::size_t c = next++; c < chunk_count; c = next++) {
+                auto const end = std::min(count, (c + 1) * chunk_rows);
+                for (std::size_t i = c * chunk_rows; i < end; ++i) chunk.Add(before[i], shots[i], after[i]);
+                WriteChunk(chunk);
+            }
+        };
+        if (thread_count == 1) {
+            work();
+            return;
+        }
+
+        std::exception_ptr error;
+        std::mutex error_mutex;
+        std::vector<std::thread> threads;
+        threads.reserve(thread_count);
+        for (unsigned int i = 0; i < thread_count; ++i) {
+            threads.emplace_back([&] {
+                try {
+                    work();
+                } catch (...) {
+                    std::lock_guard lock(error_mutex);
+                    if (!error) error = std::current_exception();
+                    next = chunk_count;
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        if (error) std::rethrow_exception(error);
+    }
+
+    /// @brief バッファをファイルに書き出す
+    /// @throws std::runtime_error 書き込みに失敗した場合
+    void Flush()
+    {
+        std::lock_guard lock(mutex_);
+        stream_.flush();
+        Check();
+    }
+
+    /// @brief 書き込んだ行数を取得する
+    /// @returns 行数
+    std::size_t GetRowCount() const
+    {
+        std::lock_guard lock(mutex_);
+        return row_count_;
+    }
+
+private:
+    std::filesystem::path path_;
+    std::ofstream stream_;
+    std::size_t row_count_;
+    mutable std::mutex mutex_;
+
+    void Check()
+    {
+        if (!stream_) throw std::runtime_error("TrainingDataWriter: failed to write \"" + path_.string() + "\".");
+    }
+};
+
+} // namespace digitalcurling::records
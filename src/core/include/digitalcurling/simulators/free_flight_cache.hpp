@@ -0,0 +1,474 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// @brief FreeFlightCache を定義
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "digitalcurling/coordinate.hpp"
+#include "digitalcurling/moves/shot.hpp"
+#include "digitalcurling/stone.hpp"
+#include "digitalcurling/stone_coordinate.hpp"
+#include "digitalcurling/vector2.hpp"
+#include "digitalcurling/simulators/i_simulator.hpp"
+#include "digitalcurling/simulators/i_simulator_factory.hpp"
+#include "digitalcurling/simulators/shot_outcome_cache.hpp"
+
+namespace digitalcurling::simulators {
+
+
+/// @brief FreeFlightCache の設定
+struct FreeFlightCacheOptions {
+    /// @brief 量子化せず、ショットが完全に一致する場合のみ軌跡を再利用する
+    ///
+    /// 量子化する場合、分解能の格子の中心のショットの軌跡を使用するため、結果は格子の中心のショットのものになります。
+    bool exact = false;
+    /// @brief ショットの速度の分解能(m/s)
+    float velocity_resolution = 0.001f;
+    /// @brief ショットの投球角度と角速度の分解能(rad, rad/s)
+    float angle_resolution = 0.001f;
+    /// @brief 保持する軌跡の最大数
+    std::size_t capacity = 256;
+    /// @brief 状態を保存するフレームの間隔
+    ///
+    /// 再開できるのはこの間隔のフレームのみです。小さくすると再開を遅らせられますが、メモリの使用量が増えます。
+    std::size_t checkpoint_interval = 16;
+    /// @brief 他のストーンに近づいたとみなす距離に 2×`Stone::kRadius` から加える余裕(m)
+    float margin = 0.01f;
+    /// @brief 軌跡を記録する最大のフレーム数
+    ///
+    /// これを超えても停止しないショットは、記録した範囲のみを再利用します。
+    std::size_t max_frames = 1u << 20;
+};
+
+
+/// @brief 空のシートでショットのストーンのみを進めた軌跡
+struct FreeFlightTrajectory {
+    /// @brief 中心の範囲
+    struct Bounds {
+        /// @brief 最小の座標
+        Vector2 min;
+        /// @brief 最大の座標
+        Vector2 max;
+    };
+
+    /// @brief シミュレーションしたショット
+    moves::Shot shot;
+    /// @brief 状態を保存したフレームの間隔
+    std::size_t checkpoint_interval = 1;
+    /// @brief 保存した状態
+    ///
+    /// `checkpoints[i]` は `GetCheckpointFrame(i)` フレーム後の状態です。最初の要素はショットの初期状態です。
+    std::vector<ISimulator::StoneState> checkpoints;
+    /// @brief `checkpoints[i]` から `checkpoints[i + 1]` までの全フレームの中心の範囲
+    std::vector<Bounds> segments;
+    /// @brief 記録したフレーム数
+    std::size_t frames = 0;
+    /// @brief 記録の最後のフレームでストーンが停止したか
+    bool stopped = false;
+
+    /// @brief 保存した状態のフレームを得る
+    /// @param[in] i `checkpoints` のインデックス
+    /// @returns ショットを投げてからのフレーム数
+    std::size_t GetCheckpointFrame(std::size_t i) const { return std::min(i * checkpoint_interval, frames); }
+};
+
+
+/// @brief シミュレーションを再開する位置
+struct FreeFlightResumePoint {
+    /// @brief シミュレーションを再開する盤面
+    ///
+    /// `completed` が `true` の場合はショットの結果です。
+    ISimulator::AllStones stones;
+    /// @brief 省略したフレーム数
+    std::size_t skipped_frames = 0;
+    /// @brief ショットのストーンが他のストーンに近づかずに停止した (またはシートの外に出た) か
+    bool completed = false;
+};
+
+
+/// @brief FreeFlightCache の統計情報
+///
+/// キャッシュの生成時 (または `FreeFlightCache::Clear()` の呼び出し時) からの累積値です。
+struct FreeFlightCacheStats {
+    /// @brief キャッシュにあった軌跡の検索の数
+    std::uint64_t hits = 0;
+    /// @brief キャッシュになく、軌跡をシミュレーションした検索の数
+    std::uint64_t misses = 0;
+    /// @brief 容量を超えたため取り除いた軌跡の数
+    std::uint64_t evictions = 0;
+    /// @brief 途中から再開した盤面の数
+    std::uint64_t resumed_shots = 0;
+    /// @brief 他のストーンに近づかないため、シミュレーションせずに結果が決まった盤面の数
+    std::uint64_t completed_shots = 0;
+    /// @brief 最初からシミュレーションする必要があった盤面の数
+    std::uint64_t full_shots = 0;
+    /// @brief 省略したフレーム数の合計
+    std::uint64_t skipped_frames = 0;
+    /// @brief 現在保持している軌跡の数
+    std::uint64_t entries = 0;
+};
+
+
+/// @brief ショットごとの自由走行の軌跡のキャッシュ
+///
+/// 同じショットであれば、ショットのストーンが他のストーンに初めて近づくまでの軌跡は盤面によらず同じです。
+/// このクラスはショットを量子化したキーごとに空のシートでの軌跡を保持し、盤面が与えられると、
+/// 軌跡が他のストーンの 2×`Stone::kRadius` (+`FreeFlightCacheOptions::margin`) 以内に初めて入る直前に保存した状態から
+/// シミュレーションを再開します。
+///
+/// ショットのストーン以外が静止している盤面のみが対象です。他のストーンが動いている場合は最初からシミュレーションします。
+/// ストーン同士が接触によってのみ影響し合うシミュレーターを前提とします。
+///
+/// @note 全てのメンバー関数はスレッドセーフです。
+/// 軌跡がない場合のシミュレーションは呼び出し元のスレッドで行い、シミュレーターはスレッド間で使い回します。
+/// @note 途中から再開したシミュレーションは、シミュレーター内部の状態 (FCV1 では Box2D の接触の情報など) を引き継がないため、
+/// 衝突後の結果が最初から進めた場合とビット単位で一致するとは限りません。
+class FreeFlightCache {
+public:
+    /// @brief コンストラクタ
+    /// @param[in] factory シミュレーターのファクトリー (複製して保持する)
+    /// @param[in] options 設定
+    /// @throws std::invalid_argument 設定が不正な場合
+    explicit FreeFlightCache(ISimulatorFactory const& factory, FreeFlightCacheOptions const& options = FreeFlightCacheOptions())
+        : factory_(factory.Clone())
+        , options_(options)
+    {
+        if (options_.capacity == 0)
+            throw std::invalid_argument("FreeFlightCache: capacity must be positive");
+        if (options_.checkpoint_interval == 0)
+            throw std::invalid_argument("FreeFlightCache: checkpoint_interval must be positive");
+        if (!(options_.margin >= 0.f))
+            throw std::invalid_argument("FreeFlightCache: margin must be non-negative");
+        if (!options_.exact && !(options_.velocity_resolution > 0.f && options_.angle_resolution > 0.f))
+            throw std::invalid_argument("FreeFlightCache: resolutions must be positive");
+    }
+
+    FreeFlightCache(FreeFlightCache const&) = delete;
+    FreeFlightCache & operator = (FreeFlightCache const&) = delete;
+
+    /// @brief ショットの結果を得る
+    ///
+    /// `FindResumePoint()` で求めた盤面から、全てのストーンが停止するまでシミュレーションします。
+    /// @param[in] stones ショット前の盤面
+    /// @param[in] shot ショット
+    /// @param[in] shot_stone_index ショットのストーンのインデックス
+    /// @param[in] sheet_width シートの幅(m) (0 の場合はシートの外に出たストーンを取り除かない)
+    /// @param[in] record_collisions 衝突したストーンを記録する (省略したフレームでは衝突は起こらない)
+    /// @returns ショットの結果
+    /// @throws std::out_of_range `shot_stone_index` が範囲外の場合
+    ShotOutcome Simulate(ISimulator::AllStones const& stones, moves::Shot const& shot, std::size_t shot_stone_index, float sheet_width, bool record_collisions = true)
+    {
+        auto resume = FindResumePoint(stones, shot, shot_stone_index, sheet_width);
+        if (resume.completed) {
+            ShotOutcome outcome;
+            outcome.stones = std::move(resume.stones);
+            return outcome;
+        }
+
+        auto simulator = AcquireSimulator();
+        auto outcome = SimulateUntilStopped(*simulator, resume.stones, sheet_width, record_collisions);
+        ReleaseSimulator(std::move(simulator));
+        return outcome;
+    }
+
+    /// @brief シミュレーションを再開する盤面を求める
+    ///
+    /// ショットの軌跡 (なければシミュレーションしてキャッシュに追加する) を保存した状態ごとの区間に分け、
+    /// 他のストーンから 2×`Stone::kRadius` + `margin` 以内に入る最初の区間の始点の状態にショットのストーンを置いた盤面を返します。
+    /// どの区間も他のストーンに近づかず、ストーンが停止するかシートの外に出る場合は、ショットの結果を返します。
+    /// 最初の区間から再開する場合や他のストーンが動いている場合は、量子化したショットではなく `shot` の初期状態を置きます。
+    /// @param[in] stones ショット前の盤面 (ショットのストーンのインデックスの値は無視する)
+    /// @param[in] shot ショット
+    /// @param[in] shot_stone_index ショットのストーンのインデックス
+    /// @param[in] sheet_width シートの幅(m) (0 の場合はシートの外に出たストーンを取り除かない)
+    /// @returns 再開する位置
+    /// @throws std::out_of_range `shot_stone_index` が範囲外の場合
+    FreeFlightResumePoint FindResumePoint(ISimulator::AllStones const& stones, moves::Shot const& shot, std::size_t shot_stone_index, float sheet_width)
+    {
+        if (shot_stone_index >= StoneCoordinate::kStoneMax)
+            throw std::out_of_range("FreeFlightCache: shot_stone_index is out of range");
+
+        auto const trajectory = GetTrajectory(shot);
+
+        FreeFlightResumePoint resume;
+        resume.stones = stones;
+        auto const resume_at = [&](std::size_t checkpoint) {
+            if (checkpoint == 0) {
+                // 量子化する場合, 軌跡の初期状態は量子化したショットのものになるため, 引数のショットの初期状態から始める
+                resume.stones[shot_stone_index] = ISimulator::StoneState(Vector2(), 0.f, shot.ToVector2(), shot.angular_velocity);
+            } else {
+                resume.stones[shot_stone_index] = trajectory->checkpoints[checkpoint];
+            }
+            resume.skipped_frames = trajectory->GetCheckpointFrame(checkpoint);
+        };
+
+        // 他のストーンが動いている場合, その軌跡と交わるかは分からない
+        bool const others_stationary = std::none_of(stones.begin(), stones.end(), [&](auto const& stone) {
+            return stone && &stone != &stones[shot_stone_index]
+                && (stone->translational_velocity.x != 0.f || stone->translational_velocity.y != 0.f || stone->angular_velocity != 0.f);
+        });
+        if (!others_stationary) {
+            resume_at(0);
+            RecordResume(resume);
+            return resume;
+        }
+
+        float const clearance = 2.f * Stone::kRadius + options_.margin;
+        float const x_limit = sheet_width / 2.f - Stone::kRadius;
+        constexpr float y_limit = coordinate::kBackBoardY - Stone::kRadius;
+
+        for (std::size_t i = 0; i < trajectory->segments.size(); ++i) {
+            auto const& bounds = trajectory->segments[i];
+            for (std::size_t j = 0; j < stones.size(); ++j) {
+                if (!stones[j] || j == shot_stone_index) continue;
+                auto const& p = stones[j]->position;
+                if (p.x >= bounds.min.x - clearance && p.x <= bounds.max.x + clearance
+                    && p.y >= bounds.min.y - clearance && p.y <= bounds.max.y + clearance) {
+                    resume_at(i);
+                    RecordResume(resume);
+                    return resume;
+                }
+            }
+
+            // 他のストーンに近づく前にシートの外に出た場合, ショットのストーンが取り除かれるだけで他のストーンは動かない
+            if (sheet_width > 0.f && (std::max(-bounds.min.x, bounds.max.x) > x_limit || bounds.max.y > y_limit || bounds.min.y < 0.f)) {
+                resume.stones[shot_stone_index] = std::nullopt;
+                resume.skipped_frames = trajectory->GetCheckpointFrame(i + 1);
+                resume.completed = true;
+                RecordResume(resume);
+                return resume;
+            }
+        }
+
+        resume_at(trajectory->checkpoints.size() - 1);
+        resume.completed = trajectory->stopped;
+        RecordResume(resume);
+        return resume;
+    }
+
+    /// @brief ショットの軌跡を得る
+    ///
+    /// キャッシュになければ、ショットのストーンのみを置いた盤面で停止するまでシミュレーションしてキャッシュに追加します。
+    /// @param[in] shot ショット
+    /// @returns 軌跡 (量子化する場合は、量子化したショットの軌跡)
+    std::shared_ptr<FreeFlightTrajectory const> GetTrajectory(moves::Shot const& shot)
+    {
+        auto const key = MakeKey(shot);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto const it = index_.find(key);
+            if (it != index_.end()) {
+                ++stats_.hits;
+                entries_.splice(entries_.begin(), entries_, it->second);
+                return it->second->second;
+            }
+            ++stats_.misses;
+        }
+
+        std::shared_ptr<FreeFlightTrajectory const> trajectory = SimulateTrajectory(QuantizeShot(shot));
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto const it = index_.find(key);
+        if (it != index_.end()) {
+            // 他のスレッドが先に追加した
+            entries_.splice(entries_.begin(), entries_, it->second);
+            return it->second->second;
+        }
+        entries_.emplace_front(key, trajectory);
+        index_.emplace(key, entries_.begin());
+        if (entries_.size() > options_.capacity) {
+            index_.erase(entries_.back().first);
+            entries_.pop_back();
+            ++stats_.evictions;
+        }
+        return trajectory;
+    }
+
+    /// @brief 軌跡のシミュレーションに使用するショットを得る
+    /// @param[in] shot ショット
+    /// @returns 量子化したショット (`exact` の場合は `shot` そのもの)
+    moves::Shot QuantizeShot(moves::Shot const& shot) const
+    {
+        if (options_.exact) return shot;
+        return moves::Shot(
+            Dequantize(Quantize(shot.translational_velocity, options_.velocity_resolution), options_.velocity_resolution),
+            Dequantize(Quantize(shot.angular_velocity, options_.angle_resolution), options_.angle_resolution),
+            Dequantize(Quantize(shot.release_angle, options_.angle_resolution), options_.angle_resolution));
+    }
+
+    /// @brief 全ての軌跡と統計情報を破棄する
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        index_.clear();
+        entries_.clear();
+        stats_ = FreeFlightCacheStats();
+    }
+
+    /// @brief 統計情報を得る
+    /// @returns 統計情報
+    FreeFlightCacheStats GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto stats = stats_;
+        stats.entries = entries_.size();
+        return stats;
+    }
+
+    /// @brief シミュレーターのファクトリーを得る
+    /// @returns ファクトリー
+    ISimulatorFactory const& GetFactory() const { return *factory_; }
+
+    /// @brief 設定を得る
+    /// @returns 設定
+    FreeFlightCacheOptions const& GetOptions() const { return options_; }
+
+private:
+    // 量子化したショット (速度, 角速度, 投球角度)
+    using Key = std::array<std::int32_t, 3>;
+
+    struct KeyHash {
+        std::size_t operator () (Key const& key) const noexcept
+        {
+            // FNV-1a
+            std::uint64_t h = 14695981039346656037ull;
+            for (auto const word : key) {
+                h ^= static_cast<std::uint32_t>(word);
+                h *= 1099511628211ull;
+            }
+            return static_cast<std::size_t>(h);
+        }
+    };
+
+    using Entry = std::pair<Key, std::shared_ptr<FreeFlightTrajectory const>>;
+
+    std::unique_ptr<ISimulatorFactory> factory_;
+    FreeFlightCacheOptions options_;
+
+    mutable std::mutex mutex_;
+    std::list<Entry> entries_;  // 先頭ほど最近使用した
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index_;
+    FreeFlightCacheStats stats_;
+
+    std::mutex simulators_mutex_;
+    std::vector<std::unique_ptr<ISimulator>> idle_simulators_;
+
+    Key MakeKey(moves::Shot const& shot) const
+    {
+        return Key{
+            Quantize(shot.translational_velocity, options_.velocity_resolution),
+            Quantize(shot.angular_velocity, options_.angle_resolution),
+            Quantize(shot.release_angle, options_.angle_resolution),
+        };
+    }
+
+    std::int32_t Quantize(float value, float resolution) const
+    {
+        if (options_.exact) {
+            if (value == 0.f) value = 0.f;  // -0 と +0 を同じキーにする
+            std::int32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+        double const q = std::round(static_cast<double>(value) / static_cast<double>(resolution));
+        return static_cast<std::int32_t>(std::clamp(q,
+            static_cast<double>(std::numeric_limits<std::int32_t>::min()),
+            static_cast<double>(std::numeric_limits<std::int32_t>::max())));
+    }
+
+    static float Dequantize(std::int32_t q, float resolution)
+    {
+        return static_cast<float>(static_cast<double>(q) * static_cast<double>(resolution));
+    }
+
+    std::shared_ptr<FreeFlightTrajectory> SimulateTrajectory(moves::Shot const& shot)
+    {
+        auto trajectory = std::make_shared<FreeFlightTrajectory>();
+        trajectory->shot = shot;
+        trajectory->checkpoint_interval = options_.checkpoint_interval;
+
+        ISimulator::AllStones stones;
+        stones[0] = ISimulator::StoneState(Vector2(), 0.f, shot.ToVector2(), shot.angular_velocity);
+        trajectory->checkpoints.push_back(*stones[0]);
+        FreeFlightTrajectory::Bounds bounds{ stones[0]->position, stones[0]->position };
+
+        auto simulator = AcquireSimulator();
+        simulator->SetStones(stones);
+        std::size_t frame = 0;
+        while (!simulator->AreAllStonesStopped() && frame < options_.max_frames) {
+            simulator->Step();
+            ++frame;
+
+            auto const& stone = simulator->GetStones()[0];
+            if (!stone) break;
+            bounds.min = Vector2(std::min(bounds.min.x, stone->position.x), std::min(bounds.min.y, stone->position.y));
+            bounds.max = Vector2(std::max(bounds.max.x, stone->position.x), std::max(bounds.max.y, stone->position.y));
+            if (frame % options_.checkpoint_interval == 0 || simulator->AreAllStonesStopped()) {
+                trajectory->checkpoints.push_back(*stone);
+                trajectory->segments.push_back(bounds);
+                bounds = FreeFlightTrajectory::Bounds{ stone->position, stone->position };
+            }
+        }
+        trajectory->frames = std::min(frame, (trajectory->checkpoints.size() - 1) * options_.checkpoint_interval);
+        trajectory->stopped = simulator->AreAllStonesStopped() && simulator->GetStones()[0].has_value();
+        ReleaseSimulator(std::move(simulator));
+        return trajectory;
+    }
+
+    void RecordResume(FreeFlightResumePoint const& resume)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (resume.completed) {
+            ++stats_.completed_shots;
+        } else if (resume.skipped_frames > 0) {
+            ++stats_.resumed_shots;
+        } else {
+            ++stats_.full_shots;
+        }
+        stats_.skipped_frames += resume.skipped_frames;
+    }
+
+    std::unique_ptr<ISimulator> AcquireSimulator()
+    {
+        {
+            std::lock_guard<std::mutex> lock(simulators_mutex_);
+            if (!idle_simulators_.empty()) {
+                auto simulator = std::move(idle_simulators_.back());
+                idle_simulators_.pop_back();
+                return simulator;
+            }
+        }
+        return factory_->CreateSimulator();
+    }
+
+    void ReleaseSimulator(std::unique_ptr<ISimulator> simulator)
+    {
+        std::lock_guard<std::mutex> lock(simulators_mutex_);
+        idle_simulators_.push_back(std::move(simulator));
+    }
+};
+
+
+/// @cond Doxygen_Suppress
+// json
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(FreeFlightCacheStats, hits, misses, evictions, resumed_shots, completed_shots, full_shots, skipped_frames, entries)
+/// @endcond
+
+} // namespace digitalcurling::simulators
@@ -0,0 +1,434 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// @brief シミュレーターの精度を検証するための基準ショット集 (ゴールデンコーパス) を定義
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "digitalcurling/common.hpp"
+#include "digitalcurling/coordinate.hpp"
+#include "digitalcurling/moves/shot.hpp"
+#include "digitalcurling/stone.hpp"
+#include "digitalcurling/stone_coordinate.hpp"
+#include "digitalcurling/vector2.hpp"
+#include "digitalcurling/simulators/i_simulator.hpp"
+#include "digitalcurling/simulators/i_simulator_factory.hpp"
+
+namespace digitalcurling::simulators {
+
+
+/// @brief ゴールデンコーパスの形式のバージョン
+inline constexpr std::uint32_t kGoldenCorpusVersion = 1;
+
+/// @brief 停止したストーンの盤面
+///
+/// インデックスは `ISimulator::AllStones` と同じです (0 ～ 7 がチーム0, 8 ～ 15 がチーム1)。
+struct GoldenBoard {
+    /// @brief 各ストーンの位置 (盤面に存在しないストーンは `std::nullopt`)
+    std::array<std::optional<Vector2>, StoneCoordinate::kStoneMax> positions;
+
+    /// @brief シミュレーターのストーンの位置から盤面を作成する
+    /// @param[in] stones 全ストーンの情報
+    /// @returns 盤面
+    static GoldenBoard FromStones(ISimulator::AllStones const& stones)
+    {
+        GoldenBoard board;
+        for (std::size_t i = 0; i < stones.size(); ++i) {
+            if (stones[i]) board.positions[i] = stones[i]->position;
+        }
+        return board;
+    }
+
+    /// @brief 静止したストーンとしてシミュレーターに設定する盤面を作成する
+    /// @returns 全ストーンの情報
+    ISimulator::AllStones ToStones() const
+    {
+        ISimulator::AllStones stones;
+        for (std::size_t i = 0; i < positions.size(); ++i) {
+            if (positions[i]) stones[i] = ISimulator::StoneState(*positions[i], 0.f, Vector2(), 0.f);
+        }
+        return stones;
+    }
+};
+
+/// @brief ストーンどうしの衝突の発生 (同じ組の接触が続く間は1回と数える)
+struct GoldenCollision {
+    std::uint8_t a; ///< ストーンのID (小さい方)
+    std::uint8_t b; ///< ストーンのID (大きい方)
+    std::uint32_t frame; ///< 接触が始まったフレーム
+
+    /// @brief ストーンの組が等しいかを判定する (フレームは比較しない)
+    /// @param[in] other 比較対象
+    /// @returns 等しい場合 `true`
+    bool SamePair(GoldenCollision const& other) const { return a == other.a && b == other.b; }
+};
+
+/// @brief 1ショットのシミュレーション結果
+struct GoldenTrajectory {
+    /// @brief 停止後の盤面
+    GoldenBoard final_board;
+    /// @brief 衝突の発生順序
+    std::vector<GoldenCollision> collisions;
+    /// @brief 停止までのフレーム数
+    std::uint32_t frames = 0;
+};
+
+/// @brief 基準ショット
+struct GoldenShot {
+    /// @brief ショットの名前 (コーパス内で一意)
+    std::string name;
+    /// @brief ショットの分類 (draw, guard, hit, double_takeout, pileup など)
+    std::string category;
+    /// @brief ショット前の盤面
+    GoldenBoard stones;
+    /// @brief ショット (原点から投げる)
+    moves::Shot shot;
+    /// @brief ショットのストーンを配置するインデックス
+    std::uint8_t shot_stone_index = 0;
+    /// @brief 基準となる結果 (未生成の場合は `std::nullopt`)
+    std::optional<GoldenTrajectory> reference;
+};
+
+/// @brief 基準ショット集
+struct GoldenCorpus {
+    /// @brief 形式のバージョン
+    std::uint32_t version = kGoldenCorpusVersion;
+    /// @brief 基準となる結果を生成したシミュレーターの設定 (`ISimulatorFactory::ToJson()`)
+    nlohmann::json reference_factory;
+    /// @brief シートの幅(m) (この範囲から出たストーンは盤面から取り除かれる)
+    float sheet_width = 4.75f;
+    /// @brief 基準ショット
+    std::vector<GoldenShot> shots;
+};
+
+/// @brief 合否の判定基準
+struct GoldenTolerance {
+    /// @brief ストーンの位置の誤差の許容値(m)
+    float max_position_error = 0.01f;
+    /// @brief エンドの得点が変わることを許容するか
+    bool allow_score_change = false;
+    /// @brief 衝突の発生順序が変わることを許容するか
+    bool allow_collision_mismatch = false;
+};
+
+/// @brief 1ショットの比較結果
+struct GoldenShotResult {
+    /// @brief ショットの名前
+    std::string name;
+    /// @brief ショットの分類
+    std::string category;
+    /// @brief 両方の盤面に存在するストーンの位置の誤差の最大値(m)
+    float max_position_error = 0.f;
+    /// @brief 両方の盤面に存在するストーンの位置の誤差の平均値(m)
+    float mean_position_error = 0.f;
+    /// @brief 片方の盤面にのみ存在するストーンの数
+    std::uint32_t presence_mismatches = 0;
+    /// @brief 基準の盤面の得点 (正の値はチーム0, 負の値はチーム1の得点)
+    int reference_score = 0;
+    /// @brief 検証対象の盤面の得点
+    int candidate_score = 0;
+    /// @brief 衝突の発生順序が最初に食い違った位置 (一致した場合は `std::nullopt`)
+    std::optional<std::uint32_t> collision_mismatch_index;
+    /// @brief 基準の衝突の回数
+    std::uint32_t reference_collisions = 0;
+    /// @brief 検証対象の衝突の回数
+    std::uint32_t candidate_collisions = 0;
+    /// @brief 基準のシミュレーターの実行時間(秒) (計測していない場合は 0)
+    double reference_seconds = 0.;
+    /// @brief 検証対象のシミュレーターの実行時間(秒)
+    double candidate_seconds = 0.;
+    /// @brief 判定基準を満たしたか
+    bool passed = true;
+};
+
+/// @brief コーパス全体の比較結果
+struct GoldenReport {
+    /// @brief 各ショットの比較結果
+    std::vector<GoldenShotResult> shots;
+
+    /// @brief すべてのショットが判定基準を満たしたか
+    /// @returns 満たした場合 `true`
+    bool Passed() const
+    {
+        return std::all_of(shots.begin(), shots.end(), [](GoldenShotResult const& r) { return r.passed; });
+    }
+
+    /// @brief 基準のシミュレーターに対する速度の比を得る
+    /// @returns 基準の実行時間の合計 / 検証対象の実行時間の合計 (計測していない場合は 0)
+    double GetSpeedup() const
+    {
+        double reference = 0., candidate = 0.;
+        for (auto const& r : shots) {
+            reference += r.reference_seconds;
+            candidate += r.candidate_seconds;
+        }
+        return reference > 0. && candidate > 0. ? reference / candidate : 0.;
+    }
+};
+
+
+/// @brief 盤面のエンドの得点を計算する
+///
+/// ハウス内でティーに最も近いストーンのチームが、相手の最も近いストーンよりも内側にある自分のストーンの数を得点とします。
+/// @param[in] board 盤面
+/// @returns 得点 (正の値はチーム0, 負の値はチーム1の得点, 得点なしは 0)
+inline int ComputeGoldenScore(GoldenBoard const& board)
+{
+    std::vector<std::pair<float, bool>> in_house;  // (ティーからの距離, チーム1か)
+    for (std::size_t i = 0; i < board.positions.size(); ++i) {
+        if (!board.positions[i]) continue;
+        Stone const stone(*board.positions[i], 0.f);
+        if (stone.IsInHouse()) in_house.emplace_back(stone.GetDistanceFromTee(), i >= StoneCoordinate::kStoneMax / 2);
+    }
+    if (in_house.empty()) return 0;
+
+    std::sort(in_house.begin(), in_house.end());
+    bool const scoring_team = in_house.front().second;
+    int score = 0;
+    for (auto const& [distance, team] : in_house) {
+        if (team != scoring_team) break;
+        ++score;
+    }
+    return scoring_team ? -score : score;
+}
+
+/// @brief 基準ショットを1回シミュレーションする
+///
+/// ショット前の盤面とショットのストーンを設定し、全てのストーンが停止するまでシミュレーションします。
+/// シートの外に出たストーンは毎フレーム取り除きます (プラグインの `Simulate` と同じ扱い)。
+/// @param[in,out] simulator シミュレーター
+/// @param[in] shot 基準ショット
+/// @param[in] sheet_width シートの幅(m)
+/// @returns シミュレーション結果
+inline GoldenTrajectory RunGoldenShot(ISimulator& simulator, GoldenShot const& shot, float sheet_width)
+{
+    if (shot.shot_stone_index >= StoneCoordinate::kStoneMax)
+        throw std::out_of_range("golden shot \"" + shot.name + "\": shot_stone_index is out of range");
+
+    auto stones = shot.stones.ToStones();
+    stones[shot.shot_stone_index] = ISimulator::StoneState(Vector2(), 0.f, shot.shot.ToVector2(), shot.shot.angular_velocity);
+    simulator.SetStones(stones);
+
+    float const x_limit = sheet_width / 2.f - Stone::kRadius;
+    constexpr float y_limit = coordinate::kBackBoardY - Stone::kRadius;
+    auto const is_out_of_sheet = [x_limit, y_limit](std::optional<ISimulator::StoneState> const& stone) {
+        return stone && (std::abs(stone->position.x) > x_limit || stone->position.y > y_limit || stone->position.y < 0.f);
+    };
+
+    GoldenTrajectory result;
+    std::vector<std::pair<std::uint8_t, std::uint8_t>> touching, next_touching;
+    while (!simulator.AreAllStonesStopped()) {
+        simulator.Step();
+        ++result.frames;
+
+        // 前のフレームから続いている接触は数えない
+        next_touching.clear();
+        for (auto const& c : simulator.GetCollisions()) {
+            std::pair<std::uint8_t, std::uint8_t> const pair = std::minmax(c.a.id, c.b.id);
+            if (std::find(next_touching.begin(), next_touching.end(), pair) != next_touching.end()) continue;
+            next_touching.push_back(pair);
+            if (std::find(touching.begin(), touching.end(), pair) == touching.end())
+                result.collisions.push_back(GoldenCollision{ pair.first, pair.second, result.frames });
+        }
+        touching.swap(next_touching);
+
+        if (sheet_width > 0.f) {
+            auto const& current = simulator.GetStones();
+            if (std::any_of(current.begin(), current.end(), is_out_of_sheet)) {
+                ISimulator::AllStones kept;
+                for (std::size_t i = 0; i < current.size(); ++i) {
+                    if (!is_out_of_sheet(current[i])) kept[i] = current[i];
+                }
+                simulator.SetStones(kept);
+            }
+        }
+    }
+
+    result.final_board = GoldenBoard::FromStones(simulator.GetStones());
+    return result;
+}
+
+/// @brief 2つのシミュレーション結果を比較する
+///
+/// 実行時間は設定しません。
+/// @param[in] reference 基準の結果
+/// @param[in] candidate 検証対象の結果
+/// @param[in] tolerance 判定基準
+/// @returns 比較結果
+inline GoldenShotResult CompareGoldenTrajectory(GoldenTrajectory const& reference, GoldenTrajectory const& candidate, GoldenTolerance const& tolerance)
+{
+    GoldenShotResult result;
+
+    std::size_t compared = 0;
+    double error_sum = 0.;
+    for (std::size_t i = 0; i < reference.final_board.positions.size(); ++i) {
+        auto const& ref = reference.final_board.positions[i];
+        auto const& cand = candidate.final_board.positions[i];
+        if (ref.has_value() != cand.has_value()) {
+            ++result.presence_mismatches;
+        } else if (ref) {
+            float const error = (*ref - *cand).Length();
+            result.max_position_error = std::max(result.max_position_error, error);
+            error_sum += error;
+            ++compared;
+        }
+    }
+    if (compared > 0) result.mean_position_error = static_cast<float>(error_sum / static_cast<double>(compared));
+
+    result.reference_score = ComputeGoldenScore(reference.final_board);
+    result.candidate_score = ComputeGoldenScore(candidate.final_board);
+
+    result.reference_collisions = static_cast<std::uint32_t>(reference.collisions.size());
+    result.candidate_collisions = static_cast<std::uint32_t>(candidate.collisions.size());
+    auto const common = std::min(reference.collisions.size(), candidate.collisions.size());
+    for (std::size_t i = 0; i < common; ++i) {
+        if (!reference.collisions[i].SamePair(candidate.collisions[i])) {
+            result.collision_mismatch_index = static_cast<std::uint32_t>(i);
+            break;
+        }
+    }
+    if (!result.collision_mismatch_index && reference.collisions.size() != candidate.collisions.size())
+        result.collision_mismatch_index = static_cast<std::uint32_t>(common);
+
+    result.passed = result.presence_mismatches == 0
+        && result.max_position_error <= tolerance.max_position_error
+        && (tolerance.allow_score_change || result.reference_score == result.candidate_score)
+        && (tolerance.allow_collision_mismatch || !result.collision_mismatch_index);
+    return result;
+}
+
+namespace detail {
+
+// 基準ショットを `repeat` 回シミュレーションし, 結果と最短の実行時間を返す
+inline std::pair<GoldenTrajectory, double> RunGoldenShotTimed(ISimulator& simulator, GoldenShot const& shot, float sheet_width, unsigned int repeat)
+{
+    GoldenTrajectory trajectory;
+    double best = std::numeric_limits<double>::infinity();
+    for (unsigned int i = 0; i < std::max(repeat, 1u); ++i) {
+        auto const start = std::chrono::steady_clock::now();
+        trajectory = RunGoldenShot(simulator, shot, sheet_width);
+        std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return { std::move(trajectory), best };
+}
+
+} // namespace digitalcurling::simulators::detail
+
+/// @brief コーパスの全ショットを検証対象のシミュレーターで実行し、基準の結果と比較する
+///
+/// `baseline` を指定した場合は同じショットを `baseline` でも実行し、実行時間の比 (速度向上率) を計測します。
+/// 基準の結果を持たないショットは `baseline` の結果を基準として比較します (`baseline` が無い場合は例外を送出します)。
+/// @param[in] corpus 基準ショット集
+/// @param[in] candidate 検証対象のシミュレーターのファクトリー
+/// @param[in] baseline 基準のシミュレーターのファクトリー (省略可)
+/// @param[in] tolerance 判定基準
+/// @param[in] repeat 実行時間の計測の繰り返し回数 (最短の時間を採用)
+/// @returns 比較結果
+/// @throws std::invalid_argument 基準の結果を持たないショットがあり、 `baseline` が指定されていない場合
+inline GoldenReport RunGoldenCorpus(
+    GoldenCorpus const& corpus,
+    ISimulatorFactory const& candidate,
+    ISimulatorFactory const* baseline,
+    GoldenTolerance const& tolerance,
+    unsigned int repeat = 1)
+{
+    auto const candidate_simulator = candidate.CreateSimulator();
+    auto const baseline_simulator = baseline ? baseline->CreateSimulator() : nullptr;
+
+    GoldenReport report;
+    for (auto const& shot : corpus.shots) {
+        std::optional<std::pair<GoldenTrajectory, double>> base;
+        if (baseline_simulator) {
+            base = detail::RunGoldenShotTimed(*baseline_simulator, shot, corpus.sheet_width, repeat);
+        } else if (!shot.reference) {
+            throw std::invalid_argument("golden shot \"" + shot.name + "\" has no reference and no baseline simulator is given");
+        }
+        auto const [trajectory, seconds] = detail::RunGoldenShotTimed(*candidate_simulator, shot, corpus.sheet_width, repeat);
+
+        auto result = CompareGoldenTrajectory(shot.reference ? *shot.reference : base->first, trajectory, tolerance);
+        result.name = shot.name;
+        result.category = shot.category;
+        result.reference_seconds = base ? base->second : 0.;
+        result.candidate_seconds = seconds;
+        report.shots.push_back(std::move(result));
+    }
+    return report;
+}
+
+/// @brief コーパスの全ショットの基準の結果を生成し直す
+/// @param[in,out] corpus 基準ショット集
+/// @param[in] reference 基準のシミュレーターのファクトリー
+inline void UpdateGoldenReferences(GoldenCorpus& corpus, ISimulatorFactory const& reference)
+{
+    auto const simulator = reference.CreateSimulator();
+    for (auto& shot : corpus.shots) {
+        shot.reference = RunGoldenShot(*simulator, shot, corpus.sheet_width);
+    }
+    corpus.reference_factory = reference.ToJson();
+}
+
+
+/// @cond Doxygen_Suppress
+// json
+inline void to_json(nlohmann::json& j, GoldenBoard const& board)
+{
+    j = nlohmann::json::array();
+    for (std::size_t i = 0; i < board.positions.size(); ++i) {
+        if (board.positions[i]) j.push_back({ { "index", i }, { "position", *board.positions[i] } });
+    }
+}
+inline void from_json(nlohmann::json const& j, GoldenBoard& board)
+{
+    board = GoldenBoard();
+    for (auto const& stone : j) {
+        auto const index = stone.at("index").get<std::size_t>();
+        if (index >= board.positions.size()) throw std::out_of_range("golden board: stone index is out of range");
+        board.positions[index] = stone.at("position").get<Vector2>();
+    }
+}
+
+inline void to_json(nlohmann::json& j, GoldenCollision const& c)
+{
+    j = nlohmann::json::array({ c.a, c.b, c.frame });
+}
+inline void from_json(nlohmann::json const& j, GoldenCollision& c)
+{
+    c.a = j.at(0).get<std::uint8_t>();
+    c.b = j.at(1).get<std::uint8_t>();
+    c.frame = j.at(2).get<std::uint32_t>();
+}
+
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(GoldenTrajectory, final_board, collisions, frames)
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(GoldenShot, name, category, stones, shot, shot_stone_index, reference)
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(GoldenCorpus, version, reference_factory, sheet_width, shots)
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(GoldenTolerance, max_position_error, allow_score_change, allow_collision_mismatch)
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(GoldenShotResult, name, category, max_position_error, mean_position_error, presence_mismatches,
+    reference_score, candidate_score, collision_mismatch_index, reference_collisions, candidate_collisions,
+    reference_seconds, candidate_seconds, passed)
+
+inline void to_json(nlohmann::json& j, GoldenReport const& report)
+{
+    j = nlohmann::json{
+        { "passed", report.Passed() },
+        { "speedup", report.GetSpeedup() },
+        { "shots", report.shots },
+    };
+}
+/// @endcond
+
+} // namespace digitalcurling::simulators
@@ -17,6 +17,7 @@
 #include "digitalcurling/stone_coordinate.hpp"
 #include "digitalcurling/vector2.hpp"
 #include "digitalcurling/plugins/i_plugin_object.hpp"
+#include "digitalcurling/simulators/simulator_stats.hpp"
 
 namespace digitalcurling::simulators {
 
@@ -169,6 +170,14 @@ public:
     /// @returns シミュレータID
     virtual std::string GetSimulatorId() const { return std::string(GetId()); }
 
+    /// @brief 性能カウンターを得る
+    ///
+    /// 既定の実装では全ての値が0のカウンターを返します。
+    /// 値はシミュレーターの生成時から累積され、 `Load()` で状態を復元してもリセットされません。
+    ///
+    /// @returns 性能カウンター
+    virtual SimulatorStats GetStats() const { return {}; }
+
     /// @brief ファクトリーを得る
     ///
     /// 得られたファクトリーはこの `ISimulator` インスタンスを生成した `ISimulatorFactory` インスタンスよりも
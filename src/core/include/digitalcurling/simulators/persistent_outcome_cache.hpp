@@ -0,0 +1,425 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// @brief PersistentOutcomeCache を定義
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include "digitalcurling/detail/mapped_file.hpp"
+#include "digitalcurling/detail/process.hpp"
+#include "digitalcurling/stone_coordinate.hpp"
+#include "digitalcurling/vector2.hpp"
+#include "digitalcurling/simulators/i_simulator.hpp"
+#include "digitalcurling/simulators/i_simulator_factory.hpp"
+#include "digitalcurling/simulators/shot_outcome_cache.hpp"
+
+namespace digitalcurling::simulators {
+
+
+/// @brief 永続キャッシュファイルの形式のバージョン
+///
+/// ファイルの構造に互換性のない変更を加えた場合はこの値を増やします。
+inline constexpr std::uint32_t kPersistentOutcomeCacheVersion = 2;
+
+
+/// @brief 永続キャッシュファイルの先頭に書き込まれるヘッダー
+struct PersistentOutcomeCacheHeader {
+    /// @brief 識別子 (`"DCOC"`)
+    std::array<char, 4> magic;
+    /// @brief 形式のバージョン (kPersistentOutcomeCacheVersion)
+    std::uint32_t version;
+    /// @brief PersistentOutcomeCacheSlot のバイト数
+    std::uint32_t slot_size;
+    /// @brief キーの語数 (ShotOutcomeKey::kWords)
+    std::uint32_t key_words;
+    /// @brief スロット数 (2 のべき乗)
+    std::uint64_t slot_count;
+    /// @brief シミュレーターと量子化の設定のフィンガープリント (MakeShotOutcomeFingerprint())
+    std::uint64_t fingerprint;
+    /// @brief 格納されている結果の数 (全プロセスの合計)
+    std::atomic<std::uint64_t> entries;
+};
+
+/// @brief 永続キャッシュファイルの1つの結果
+///
+/// `state` が 0 のスロットは空です。
+/// 最上位ビットが 1 の場合はキーのハッシュ値から作られたタグで、結果が格納されています。
+/// それ以外は書き込み中で、上位 32 ビットが書き込んでいるプロセスの ID、下位 32 ビットが書き込みを始めた時刻 (UNIX 時間の秒) です。
+/// 結果は一度書き込まれると変更されないため、タグを読み込んだ後は排他制御なしで参照できます。
+struct PersistentOutcomeCacheSlot {
+    /// @brief 停止したストーン
+    struct Stone {
+        float x;                ///< 位置 x
+        float y;                ///< 位置 y
+        float angle;            ///< 角度 (rad)
+        std::uint32_t present;  ///< ストーンが盤面に存在する場合は 1
+    };
+
+    /// @brief スロットの状態
+    std::atomic<std::uint64_t> state;
+    /// @brief 結果を書き込んだプロセスの設定のフィンガープリント
+    std::uint64_t fingerprint;
+    /// @brief キー (ShotOutcomeKey::words)
+    std::array<std::int32_t, ShotOutcomeKey::kWords> key;
+    /// @brief 衝突したストーン (ShotOutcome::collided_stones)
+    std::uint32_t collided_stones;
+    /// @brief 全てのストーンが停止した後の盤面
+    std::array<Stone, StoneCoordinate::kStoneMax> stones;
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "PersistentOutcomeCache requires lock-free 64-bit atomics");
+static_assert(sizeof(std::atomic<std::uint64_t>) == sizeof(std::uint64_t));
+
+
+/// @brief PersistentOutcomeCache の統計情報
+///
+/// このインスタンスの生成時からの累積値です (`entries` を除く)。
+struct PersistentOutcomeCacheStats {
+    /// @brief 見つかった検索の数
+    std::uint64_t hits = 0;
+    /// @brief 見つからなかった検索の数
+    std::uint64_t misses = 0;
+    /// @brief 追加した結果の数
+    std::uint64_t insertions = 0;
+    /// @brief 空きスロットが見つからず追加できなかった結果の数
+    std::uint64_t dropped = 0;
+    /// @brief 書き込み中に終了したプロセスから引き継いで追加したスロットの数 (`insertions` に含まれる)
+    std::uint64_t reclaimed = 0;
+    /// @brief ファイルに格納されている結果の数 (全プロセスの合計)
+    std::uint64_t entries = 0;
+};
+
+
+/// @brief シミュレーターと量子化の設定のフィンガープリントを計算する
+///
+/// シミュレーターID、ファクトリーの JSON (例えば `seconds_per_frame`) と、キーの作り方に関わる設定から計算します。
+/// いずれかが異なる場合、キャッシュの結果は再利用できません。
+/// @param[in] factory シミュレーターのファクトリー
+/// @param[in] options キャッシュの設定
+/// @returns フィンガープリント
+inline std::uint64_t MakeShotOutcomeFingerprint(ISimulatorFactory const& factory, ShotOutcomeCacheOptions const& options)
+{
+    nlohmann::json const j = {
+        { "simulator", factory.GetSimulatorId() },
+        { "factory", factory.ToJson() },
+        { "exact", options.exact },
+        { "position_resolution", options.position_resolution },
+        { "velocity_resolution", options.velocity_resolution },
+        { "angle_resolution", options.angle_resolution },
+        { "record_collisions", options.record_collisions },
+    };
+    // FNV-1a
+    std::uint64_t h = 14695981039346656037ull;
+    for (char const c : j.dump()) {
+        h ^= static_cast<std::uint8_t>(c);
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+
+/// @brief 複数のプロセスで共有できる、ファイルに保存される (盤面, ショット) の結果のキャッシュ
+///
+/// ファイルはオープンアドレス法のハッシュ表で、メモリにマップして使用します。
+/// 追加はスロットの状態の CAS で行うため、同じファイルを開いた複数のプロセス・スレッドから同時に検索・追加できます。
+/// 結果は取り除かれず、ハッシュ表が埋まった後の追加は無視されます。
+///
+/// ファイルにはシミュレーターと量子化の設定のフィンガープリントが記録されます。
+/// 異なる設定 (例えば `seconds_per_frame` が異なるファクトリー) で開いた場合、ファイルは新しい空のファイルに置き換えられます。
+/// 置き換える前のファイルを開いているプロセスは、閉じるまで古いファイルを使用し続けます。
+///
+/// ShotOutcomeCache の下位のストアとして使用します。
+/// @code
+/// auto store = std::make_shared<PersistentOutcomeCache>("outcomes.dcoc", factory, options);
+/// ShotOutcomeCache cache(factory, options, store);
+/// @endcode
+///
+/// @note 値はホストのバイト順・表現のまま書き込まれます。異なる環境間でファイルを共有しないでください。
+/// @note 書き込み中にプロセスが終了した場合、そのスロットは書き込んでいたプロセスが存在しなくなった後に、別の結果の追加に再利用されます。
+///       書き込んでいるプロセスが存在する間は再利用しないため、書き込み途中のスロットに他のプロセスが書き込むことはありません。
+///       プロセスの存在を確認するため、ファイルを共有するプロセスは同じ PID 名前空間で実行してください。
+class PersistentOutcomeCache : public IShotOutcomeStore {
+public:
+    /// @brief 新しく作成するファイルの既定のスロット数
+    static constexpr std::size_t kDefaultSlotCount = 65536;
+    /// @brief 検索・追加で調べるスロットの最大数
+    static constexpr std::size_t kMaxProbes = 32;
+
+    /// @brief キャッシュファイルを開く
+    ///
+    /// ファイルが存在しない場合や、形式・設定が異なる場合は新しく作成します。
+    /// @param[in] path ファイルのパス
+    /// @param[in] factory シミュレーターのファクトリー (ShotOutcomeCache と同じもの)
+    /// @param[in] options キャッシュの設定 (ShotOutcomeCache と同じもの)
+    /// @param[in] slot_count 新しく作成する場合のスロット数 (2 のべき乗に切り上げる)
+    /// @throws std::invalid_argument `slot_count` が 0 の場合
+    /// @throws std::runtime_error ファイルを作成・マップできない場合
+    PersistentOutcomeCache(
+        std::filesystem::path const& path,
+        ISimulatorFactory const& factory,
+        ShotOutcomeCacheOptions const& options = ShotOutcomeCacheOptions(),
+        std::size_t slot_count = kDefaultSlotCount)
+        : path_(path)
+        , fingerprint_(MakeShotOutcomeFingerprint(factory, options))
+    {
+        if (slot_count == 0) throw std::invalid_argument("PersistentOutcomeCache: slot_count must be positive");
+        std::uint64_t rounded = 1;
+        while (rounded < slot_count) rounded <<= 1;
+
+        // 他のプロセスが同時にファイルを置き換えた場合に備えて, 数回やり直す
+        for (int attempt = 0; attempt < 4; ++attempt) {
+            if (TryOpen()) return;
+            CreateFile(rounded);
+        }
+        throw std::runtime_error("PersistentOutcomeCache: failed to open \"" + path_.string() + "\".");
+    }
+
+    virtual std::optional<ShotOutcome> Find(ShotOutcomeKey const& key) override
+    {
+        auto const tag = MakeTag(key);
+        for (std::size_t probe = 0; probe < kMaxProbes; ++probe) {
+            auto const& slot = GetSlot(key, probe);
+            auto const state = slot.state.load(std::memory_order_acquire);
+            if (state == kEmpty) break;
+            if (state == tag && Matches(slot, key)) {
+                hits_.fetch_add(1, std::memory_order_relaxed);
+                return ToOutcome(slot);
+            }
+        }
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    virtual void Insert(ShotOutcomeKey const& key, ShotOutcome const& outcome) override
+    {
+        auto const tag = MakeTag(key);
+        auto const writing = MakeWritingState();
+        PersistentOutcomeCacheSlot* abandoned = nullptr;
+        std::uint64_t abandoned_state = kEmpty;
+        for (std::size_t probe = 0; probe < kMaxProbes; ++probe) {
+            auto& slot = GetSlot(key, probe);
+            auto state = slot.state.load(std::memory_order_acquire);
+            if (state == kEmpty) {
+                // 書き込みが中断されたスロットがあればそちらを使う
+                if (abandoned) break;
+                if (!slot.state.compare_exchange_strong(state, writing, std::memory_order_acquire, std::memory_order_acquire)) {
+                    // 他のプロセスが先に書き込みを始めた
+                    if (state == tag && Matches(slot, key)) return;
+                    continue;
+                }
+                Publish(slot, key, outcome, tag, writing);
+                return;
+            }
+            if (state == tag && Matches(slot, key)) return;
+            if (!abandoned && IsAbandoned(state)) {
+                abandoned = &slot;
+                abandoned_state = state;
+            }
+        }
+        // 空にせずに書き込み中のまま引き継ぐため, 後ろのスロットの探索は途切れない
+        if (abandoned && abandoned->state.compare_exchange_strong(abandoned_state, writing, std::memory_order_acquire, std::memory_order_acquire)) {
+            reclaimed_.fetch_add(1, std::memory_order_relaxed);
+            Publish(*abandoned, key, outcome, tag, writing);
+            return;
+        }
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// @brief 統計情報を得る
+    /// @returns 統計情報
+    PersistentOutcomeCacheStats GetStats() const
+    {
+        PersistentOutcomeCacheStats stats;
+        stats.hits = hits_.load(std::memory_order_relaxed);
+        stats.misses = misses_.load(std::memory_order_relaxed);
+        stats.insertions = insertions_.load(std::memory_order_relaxed);
+        stats.dropped = dropped_.load(std::memory_order_relaxed);
+        stats.reclaimed = reclaimed_.load(std::memory_order_relaxed);
+        stats.entries = GetHeader().entries.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    /// @brief スロット数を得る
+    /// @returns スロット数
+    std::size_t GetSlotCount() const { return static_cast<std::size_t>(slot_mask_ + 1); }
+
+    /// @brief 設定のフィンガープリントを得る
+    /// @returns フィンガープリント
+    std::uint64_t GetFingerprint() const { return fingerprint_; }
+
+    /// @brief ファイルのパスを得る
+    /// @returns ファイルのパス
+    std::filesystem::path const& GetPath() const { return path_; }
+
+private:
+    static constexpr std::uint64_t kEmpty = 0;
+    static constexpr std::uint64_t kTagBit = std::uint64_t(1) << 63;
+
+    std::filesystem::path path_;
+    std::uint64_t fingerprint_;
+    detail::MappedFile file_;
+    std::uint64_t slot_mask_ = 0;
+    std::atomic<std::uint64_t> hits_{0};
+    std::atomic<std::uint64_t> misses_{0};
+    std::atomic<std::uint64_t> insertions_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+    std::atomic<std::uint64_t> reclaimed_{0};
+
+    PersistentOutcomeCacheHeader& GetHeader() const
+    {
+        return *reinterpret_cast<PersistentOutcomeCacheHeader*>(file_.mutable_data());
+    }
+
+    PersistentOutcomeCacheSlot& GetSlot(ShotOutcomeKey const& key, std::size_t probe) const
+    {
+        auto const index = (key.hash + probe) & slot_mask_;
+        auto* const slots = reinterpret_cast<PersistentOutcomeCacheSlot*>(file_.mutable_data() + sizeof(PersistentOutcomeCacheHeader));
+        return slots[index];
+    }
+
+    static std::uint64_t MakeTag(ShotOutcomeKey const& key)
+    {
+        return key.hash | kTagBit;
+    }
+
+    static std::uint32_t NowSeconds()
+    {
+        auto const now = std::chrono::system_clock::now().time_since_epoch();
+        return static_cast<std::uint32_t>(std::chrono::duration_cast<std::chrono::seconds>(now).count());
+    }
+
+    // このプロセスが書き込み中であることを表す状態 (プロセス ID は 0 にならないため, 空と区別できる)
+    static std::uint64_t MakeWritingState()
+    {
+        auto const pid = detail::CurrentProcessId() & 0x7fffffffu;
+        return (static_cast<std::uint64_t>(pid) << 32) | NowSeconds();
+    }
+
+    // 書き込みを始めたプロセスが終了している場合は true を返す
+    // 書き込みに時間がかかっていても, プロセスが存在する間は引き継がない (書き込み途中の内容が混ざるため)
+    static bool IsAbandoned(std::uint64_t state)
+    {
+        if (state == kEmpty || (state & kTagBit)) return false;
+        return !detail::IsProcessAlive(static_cast<std::uint32_t>(state >> 32));
+    }
+
+    // 書き込み中にしたスロットに結果を書き込み, タグを設定して公開する
+    void Publish(PersistentOutcomeCacheSlot& slot, ShotOutcomeKey const& key, ShotOutcome const& outcome, std::uint64_t tag, std::uint64_t writing)
+    {
+        slot.fingerprint = fingerprint_;
+        slot.key = key.words;
+        FromOutcome(outcome, slot);
+        // 他のプロセスに引き継がれた場合 (このプロセスが終了したと判定された場合) は公開しない
+        if (!slot.state.compare_exchange_strong(writing, tag, std::memory_order_release, std::memory_order_relaxed)) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        GetHeader().entries.fetch_add(1, std::memory_order_relaxed);
+        insertions_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool Matches(PersistentOutcomeCacheSlot const& slot, ShotOutcomeKey const& key) const
+    {
+        return slot.fingerprint == fingerprint_ && slot.key == key.words;
+    }
+
+    static ShotOutcome ToOutcome(PersistentOutcomeCacheSlot const& slot)
+    {
+        ShotOutcome outcome;
+        for (std::size_t i = 0; i < slot.stones.size(); ++i) {
+            auto const& stone = slot.stones[i];
+            if (stone.present) outcome.stones[i] = ISimulator::StoneState(Vector2(stone.x, stone.y), stone.angle, Vector2(), 0.f);
+        }
+        outcome.collided_stones = static_cast<std::uint16_t>(slot.collided_stones);
+        return outcome;
+    }
+
+    static void FromOutcome(ShotOutcome const& outcome, PersistentOutcomeCacheSlot& slot)
+    {
+        for (std::size_t i = 0; i < slot.stones.size(); ++i) {
+            auto const& stone = outcome.stones[i];
+            slot.stones[i] = stone
+                ? PersistentOutcomeCacheSlot::Stone{ stone->position.x, stone->position.y, stone->angle, 1 }
+                : PersistentOutcomeCacheSlot::Stone{ 0.f, 0.f, 0.f, 0 };
+        }
+        slot.collided_stones = outcome.collided_stones;
+    }
+
+    // 既存のファイルを開く. 形式・設定が異なる場合は false を返す
+    bool TryOpen()
+    {
+        std::error_code ec;
+        if (!std::filesystem::exists(path_, ec)) return false;
+
+        detail::MappedFile file(path_, true);
+        if (file.size() < sizeof(PersistentOutcomeCacheHeader)) return false;
+        auto const& header = *reinterpret_cast<PersistentOutcomeCacheHeader const*>(file.data());
+        auto const slot_count = header.slot_count;
+        if (header.magic != std::array<char, 4>{ 'D', 'C', 'O', 'C' }
+            || header.version != kPersistentOutcomeCacheVersion
+            || header.slot_size != sizeof(PersistentOutcomeCacheSlot)
+            || header.key_words != ShotOutcomeKey::kWords
+            || header.fingerprint != fingerprint_
+            || slot_count == 0 || (slot_count & (slot_count - 1)) != 0
+            || file.size() != sizeof(PersistentOutcomeCacheHeader) + slot_count * sizeof(PersistentOutcomeCacheSlot)) {
+            return false;
+        }
+
+        file_ = std::move(file);
+        slot_mask_ = slot_count - 1;
+        return true;
+    }
+
+    // 空のファイルを一時ファイルとして作成し, 既存のファイルと置き換える
+    void CreateFile(std::uint64_t slot_count)
+    {
+        std::mt19937_64 random(static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()) ^ std::random_device()());
+        auto temp_path = path_;
+        temp_path += ".tmp" + std::to_string(random());
+
+        std::error_code ec;
+        {
+            std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+            if (!out) throw std::runtime_error("PersistentOutcomeCache: failed to create \"" + temp_path.string() + "\".");
+        }
+        // スロットは 0 (空) で埋められる
+        std::filesystem::resize_file(temp_path, sizeof(PersistentOutcomeCacheHeader) + slot_count * sizeof(PersistentOutcomeCacheSlot), ec);
+        if (!ec) {
+            detail::MappedFile file(temp_path, true);
+            auto& header = *reinterpret_cast<PersistentOutcomeCacheHeader*>(file.mutable_data());
+            header.magic = { 'D', 'C', 'O', 'C' };
+            header.version = kPersistentOutcomeCacheVersion;
+            header.slot_size = sizeof(PersistentOutcomeCacheSlot);
+            header.key_words = ShotOutcomeKey::kWords;
+            header.slot_count = slot_count;
+            header.fingerprint = fingerprint_;
+        }
+        if (!ec) std::filesystem::rename(temp_path, path_, ec);
+        if (ec) {
+            std::error_code ignored;
+            std::filesystem::remove(temp_path, ignored);
+            throw std::runtime_error("PersistentOutcomeCache: failed to create \"" + path_.string() + "\": " + ec.message());
+        }
+    }
+};
+
+
+/// @cond Doxygen_Suppress
+// json
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(PersistentOutcomeCacheStats, hits, misses, insertions, dropped, reclaimed, entries)
+/// @endcond
+
+} // namespace digitalcurling::simulators
@@ -0,0 +1,503 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// @brief ShotOutcomeCache を定義
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "digitalcurling/coordinate.hpp"
+#include "digitalcurling/moves/shot.hpp"
+#include "digitalcurling/stone.hpp"
+#include "digitalcurling/stone_coordinate.hpp"
+#include "digitalcurling/vector2.hpp"
+#include "digitalcurling/simulators/i_simulator.hpp"
+#include "digitalcurling/simulators/i_simulator_factory.hpp"
+
+namespace digitalcurling::simulators {
+
+
+/// @brief ShotOutcomeCache の設定
+struct ShotOutcomeCacheOptions {
+    /// @brief 量子化せず、入力が完全に一致する場合のみキャッシュを使用する
+    ///
+    /// 量子化したキーでは、分解能以内の差しかない入力に対して最初にシミュレーションした入力の結果を返します。
+    /// 結果がシミュレーターと完全に一致する必要がある場合は `true` にしてください。
+    bool exact = false;
+    /// @brief ストーンの位置の分解能(m)
+    float position_resolution = 0.001f;
+    /// @brief ストーンとショットの速度の分解能(m/s)
+    float velocity_resolution = 0.001f;
+    /// @brief ストーンの角度, ショットの投球角度, 角速度の分解能(rad, rad/s)
+    float angle_resolution = 0.001f;
+    /// @brief 保持する結果の最大数 (全シャードの合計)
+    std::size_t capacity = 65536;
+    /// @brief シャード数
+    ///
+    /// シャードごとに排他制御と LRU の管理を行います。
+    std::size_t shards = 16;
+    /// @brief 衝突したストーンを記録する
+    bool record_collisions = true;
+};
+
+
+/// @brief キャッシュのキー (量子化した盤面とショット)
+struct ShotOutcomeKey {
+    /// @brief キーの語数
+    ///
+    /// 存在するストーンのビットとショットのストーンのインデックス, ショット(3語), シートの幅,
+    /// 各ストーンの位置・角度・速度・角速度(6語) の順に格納します。
+    static constexpr std::size_t kWords = 5 + 6 * StoneCoordinate::kStoneMax;
+
+    /// @brief キーの値
+    std::array<std::int32_t, kWords> words{};
+    /// @brief `words` のハッシュ値
+    std::uint64_t hash = 0;
+
+    /// @brief `words` からハッシュ値を計算し直す
+    void UpdateHash()
+    {
+        // FNV-1a
+        std::uint64_t h = 14695981039346656037ull;
+        for (auto const word : words) {
+            h ^= static_cast<std::uint32_t>(word);
+            h *= 1099511628211ull;
+        }
+        hash = h;
+    }
+
+    bool operator == (ShotOutcomeKey const& other) const { return hash == other.hash && words == other.words; }
+    bool operator != (ShotOutcomeKey const& other) const { return !(*this == other); }
+};
+
+
+/// @brief ショットの結果
+struct ShotOutcome {
+    /// @brief 全てのストーンが停止した後の盤面
+    ISimulator::AllStones stones;
+    /// @brief 衝突したストーン (i ビット目がインデックス i のストーン)
+    ///
+    /// `ShotOutcomeCacheOptions::record_collisions` が `false` の場合は常に 0 です。
+    std::uint16_t collided_stones = 0;
+};
+
+
+/// @brief ShotOutcomeCache の統計情報
+///
+/// キャッシュの生成時 (または `ShotOutcomeCache::Clear()` の呼び出し時) からの累積値です。
+struct ShotOutcomeCacheStats {
+    /// @brief キャッシュにあった検索の数
+    std::uint64_t hits = 0;
+    /// @brief キャッシュになかった検索の数
+    std::uint64_t misses = 0;
+    /// @brief 追加した結果の数
+    std::uint64_t insertions = 0;
+    /// @brief 容量を超えたため取り除いた結果の数
+    std::uint64_t evictions = 0;
+    /// @brief キャッシュになく、下位のストア (IShotOutcomeStore) にあった検索の数
+    std::uint64_t store_hits = 0;
+    /// @brief 現在保持している結果の数
+    std::uint64_t entries = 0;
+
+    /// @brief ヒット率を得る
+    /// @returns ヒット率 (検索がない場合は 0)
+    double GetHitRate() const
+    {
+        auto const lookups = hits + misses;
+        return lookups == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(lookups);
+    }
+};
+
+
+/// @brief ShotOutcomeCache の下位のストア
+///
+/// ShotOutcomeCache はメモリ上にない結果をストアから検索し、シミュレーションした結果をストアにも追加します。
+/// 実装は複数のスレッドから同時に呼び出されても安全である必要があります。
+class IShotOutcomeStore {
+public:
+    IShotOutcomeStore() = default;
+    IShotOutcomeStore(IShotOutcomeStore const&) = delete;
+    IShotOutcomeStore & operator = (IShotOutcomeStore const&) = delete;
+    virtual ~IShotOutcomeStore() = default;
+
+    /// @brief 結果を検索する
+    /// @param[in] key キー
+    /// @returns 結果 (ない場合は `std::nullopt`)
+    virtual std::optional<ShotOutcome> Find(ShotOutcomeKey const& key) = 0;
+
+    /// @brief 結果を追加する
+    /// @param[in] key キー
+    /// @param[in] outcome 結果
+    virtual void Insert(ShotOutcomeKey const& key, ShotOutcome const& outcome) = 0;
+};
+
+
+/// @brief 盤面を全てのストーンが停止するまでシミュレーションする
+///
+/// `sheet_width` が正の場合、シートの外に出たストーンは毎フレーム取り除きます (プラグインの `Simulate` と同じ扱い)。
+/// @param[in,out] simulator シミュレーター
+/// @param[in] initial シミュレーションを開始する盤面
+/// @param[in] sheet_width シートの幅(m)
+/// @param[in] record_collisions 衝突したストーンを記録する
+/// @returns 結果
+inline ShotOutcome SimulateUntilStopped(
+    ISimulator& simulator,
+    ISimulator::AllStones const& initial,
+    float sheet_width,
+    bool record_collisions = true)
+{
+    simulator.SetStones(initial);
+
+    float const x_limit = sheet_width / 2.f - Stone::kRadius;
+    constexpr float y_limit = coordinate::kBackBoardY - Stone::kRadius;
+    auto const is_out_of_sheet = [x_limit, y_limit](std::optional<ISimulator::StoneState> const& stone) {
+        return stone && (std::abs(stone->position.x) > x_limit || stone->position.y > y_limit || stone->position.y < 0.f);
+    };
+
+    ShotOutcome outcome;
+    while (!simulator.AreAllStonesStopped()) {
+        simulator.Step();
+
+        if (record_collisions) {
+            for (auto const& c : simulator.GetCollisions()) {
+                outcome.collided_stones |= static_cast<std::uint16_t>((1u << c.a.id) | (1u << c.b.id));
+            }
+        }
+
+        if (sheet_width > 0.f) {
+            auto const& current = simulator.GetStones();
+            if (std::any_of(current.begin(), current.end(), is_out_of_sheet)) {
+                ISimulator::AllStones kept;
+                for (std::size_t i = 0; i < current.size(); ++i) {
+                    if (!is_out_of_sheet(current[i])) kept[i] = current[i];
+                }
+                simulator.SetStones(kept);
+            }
+        }
+    }
+
+    outcome.stones = simulator.GetStones();
+    return outcome;
+}
+
+
+/// @brief ショットを全てのストーンが停止するまでシミュレーションする
+///
+/// ショットのストーンを原点から投げ、全てのストーンが停止するまでシミュレーションします。
+/// `sheet_width` が正の場合、シートの外に出たストーンは毎フレーム取り除きます (プラグインの `Simulate` と同じ扱い)。
+/// @param[in,out] simulator シミュレーター
+/// @param[in] stones ショット前の盤面
+/// @param[in] shot ショット
+/// @param[in] shot_stone_index ショットのストーンのインデックス
+/// @param[in] sheet_width シートの幅(m)
+/// @param[in] record_collisions 衝突したストーンを記録する
+/// @returns ショットの結果
+/// @throws std::out_of_range `shot_stone_index` が範囲外の場合
+inline ShotOutcome SimulateShotOutcome(
+    ISimulator& simulator,
+    ISimulator::AllStones const& stones,
+    moves::Shot const& shot,
+    std::size_t shot_stone_index,
+    float sheet_width,
+    bool record_collisions = true)
+{
+    if (shot_stone_index >= StoneCoordinate::kStoneMax)
+        throw std::out_of_range("SimulateShotOutcome: shot_stone_index is out of range");
+
+    auto initial = stones;
+    initial[shot_stone_index] = ISimulator::StoneState(Vector2(), 0.f, shot.ToVector2(), shot.angular_velocity);
+    return SimulateUntilStopped(simulator, initial, sheet_width, record_collisions);
+}
+
+
+/// @brief (盤面, ショット) に対するシミュレーション結果のキャッシュ
+///
+/// 任意の `ISimulatorFactory` を包み、同じ盤面から同じショットを投げた結果を再利用します。
+/// 盤面とショットは `ShotOutcomeCacheOptions` の分解能で量子化してキーにします。
+/// 結果はシャードごとに LRU で管理され、容量を超えると最も長く使用されていない結果から取り除かれます。
+///
+/// 下位のストア (例えば PersistentOutcomeCache) を指定すると、メモリ上にない結果をストアから検索し、
+/// シミュレーションした結果をストアにも追加します。
+///
+/// @note 全てのメンバー関数はスレッドセーフです。
+/// キャッシュにない場合のシミュレーションは呼び出し元のスレッドで行い、シミュレーターはスレッド間で使い回します。
+class ShotOutcomeCache {
+public:
+    /// @brief コンストラクタ
+    /// @param[in] factory シミュレーターのファクトリー (複製して保持する)
+    /// @param[in] options 設定
+    /// @param[in] store 下位のストア (使用しない場合は `nullptr`)
+    /// @throws std::invalid_argument 設定が不正な場合
+    explicit ShotOutcomeCache(
+        ISimulatorFactory const& factory,
+        ShotOutcomeCacheOptions const& options = ShotOutcomeCacheOptions(),
+        std::shared_ptr<IShotOutcomeStore> store = nullptr)
+        : factory_(factory.Clone())
+        , options_(options)
+        , store_(std::move(store))
+        , shards_()
+    {
+        if (options_.shards == 0)
+            throw std::invalid_argument("ShotOutcomeCache: shards must be positive");
+        if (options_.capacity == 0)
+            throw std::invalid_argument("ShotOutcomeCache: capacity must be positive");
+        if (!options_.exact && !(options_.position_resolution > 0.f && options_.velocity_resolution > 0.f && options_.angle_resolution > 0.f))
+            throw std::invalid_argument("ShotOutcomeCache: resolutions must be positive");
+
+        std::size_t const shard_capacity = (options_.capacity + options_.shards - 1) / options_.shards;
+        shards_ = std::vector<Shard>(options_.shards);
+        for (auto& shard : shards_) shard.capacity = shard_capacity;
+    }
+
+    ShotOutcomeCache(ShotOutcomeCache const&) = delete;
+    ShotOutcomeCache & operator = (ShotOutcomeCache const&) = delete;
+
+    /// @brief ショットの結果を得る
+    ///
+    /// キャッシュ (または下位のストア) にあればその結果を返し、なければシミュレーションしてキャッシュに追加します。
+    /// @param[in] stones ショット前の盤面
+    /// @param[in] shot ショット
+    /// @param[in] shot_stone_index ショットのストーンのインデックス
+    /// @param[in] sheet_width シートの幅(m) (0 の場合はシートの外に出たストーンを取り除かない)
+    /// @returns ショットの結果
+    /// @throws std::out_of_range `shot_stone_index` が範囲外の場合
+    ShotOutcome Simulate(ISimulator::AllStones const& stones, moves::Shot const& shot, std::size_t shot_stone_index, float sheet_width)
+    {
+        auto const key = MakeKey(stones, shot, shot_stone_index, sheet_width);
+        if (auto cached = Find(key)) return std::move(*cached);
+
+        if (store_) {
+            if (auto stored = store_->Find(key)) {
+                InsertToShard(key, *stored, true);
+                return std::move(*stored);
+            }
+        }
+
+        auto simulator = AcquireSimulator();
+        auto outcome = SimulateShotOutcome(*simulator, stones, shot, shot_stone_index, sheet_width, options_.record_collisions);
+        ReleaseSimulator(std::move(simulator));
+
+        Insert(key, outcome);
+        return outcome;
+    }
+
+    /// @brief キーを作成する
+    /// @param[in] stones ショット前の盤面 (ショットのストーンのインデックスの値は無視する)
+    /// @param[in] shot ショット
+    /// @param[in] shot_stone_index ショットのストーンのインデックス
+    /// @param[in] sheet_width シートの幅(m)
+    /// @returns キー
+    /// @throws std::out_of_range `shot_stone_index` が範囲外の場合
+    ShotOutcomeKey MakeKey(ISimulator::AllStones const& stones, moves::Shot const& shot, std::size_t shot_stone_index, float sheet_width) const
+    {
+        if (shot_stone_index >= StoneCoordinate::kStoneMax)
+            throw std::out_of_range("ShotOutcomeCache: shot_stone_index is out of range");
+
+        ShotOutcomeKey key;
+        auto word = key.words.begin();
+        std::uint32_t present = 0;
+        for (std::size_t i = 0; i < stones.size(); ++i) {
+            if (stones[i] && i != shot_stone_index) present |= 1u << i;
+        }
+        *word++ = static_cast<std::int32_t>(present | static_cast<std::uint32_t>(shot_stone_index) << StoneCoordinate::kStoneMax);
+        *word++ = Quantize(shot.translational_velocity, options_.velocity_resolution);
+        *word++ = Quantize(shot.angular_velocity, options_.angle_resolution);
+        *word++ = Quantize(shot.release_angle, options_.angle_resolution);
+        *word++ = Quantize(sheet_width, options_.position_resolution);
+        for (std::size_t i = 0; i < stones.size(); ++i) {
+            if (!(present & (1u << i))) {
+                word += 6;
+                continue;
+            }
+            auto const& stone = *stones[i];
+            *word++ = Quantize(stone.position.x, options_.position_resolution);
+            *word++ = Quantize(stone.position.y, options_.position_resolution);
+            *word++ = Quantize(stone.angle, options_.angle_resolution);
+            *word++ = Quantize(stone.translational_velocity.x, options_.velocity_resolution);
+            *word++ = Quantize(stone.translational_velocity.y, options_.velocity_resolution);
+            *word++ = Quantize(stone.angular_velocity, options_.angle_resolution);
+        }
+        key.UpdateHash();
+        return key;
+    }
+
+    /// @brief キャッシュから結果を検索する
+    ///
+    /// 見つかった場合、その結果を最近使用したものとして扱います。
+    /// 下位のストアは検索しません。
+    /// @param[in] key キー
+    /// @returns 結果 (キャッシュにない場合は `std::nullopt`)
+    std::optional<ShotOutcome> Find(ShotOutcomeKey const& key)
+    {
+        auto& shard = GetShard(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto const it = shard.index.find(key);
+        if (it == shard.index.end()) {
+            ++shard.stats.misses;
+            return std::nullopt;
+        }
+        ++shard.stats.hits;
+        shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+        return it->second->second;
+    }
+
+    /// @brief キャッシュに結果を追加する
+    ///
+    /// 同じキーの結果がある場合は置き換えます。
+    /// 下位のストアにも追加します。
+    /// @param[in] key キー
+    /// @param[in] outcome 結果
+    void Insert(ShotOutcomeKey const& key, ShotOutcome const& outcome)
+    {
+        InsertToShard(key, outcome);
+        if (store_) store_->Insert(key, outcome);
+    }
+
+    /// @brief 全ての結果と統計情報を破棄する
+    ///
+    /// 下位のストアの結果は破棄しません。
+    void Clear()
+    {
+        for (auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.index.clear();
+            shard.entries.clear();
+            shard.stats = ShotOutcomeCacheStats();
+        }
+    }
+
+    /// @brief 統計情報を得る
+    /// @returns 全シャードの合計
+    ShotOutcomeCacheStats GetStats() const
+    {
+        ShotOutcomeCacheStats total;
+        for (auto const& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            total.hits += shard.stats.hits;
+            total.misses += shard.stats.misses;
+            total.insertions += shard.stats.insertions;
+            total.evictions += shard.stats.evictions;
+            total.store_hits += shard.stats.store_hits;
+            total.entries += shard.entries.size();
+        }
+        return total;
+    }
+
+    /// @brief シミュレーターのファクトリーを得る
+    /// @returns ファクトリー
+    ISimulatorFactory const& GetFactory() const { return *factory_; }
+
+    /// @brief 設定を得る
+    /// @returns 設定
+    ShotOutcomeCacheOptions const& GetOptions() const { return options_; }
+
+    /// @brief 下位のストアを得る
+    /// @returns 下位のストア (使用しない場合は `nullptr`)
+    std::shared_ptr<IShotOutcomeStore> const& GetStore() const { return store_; }
+
+private:
+    struct KeyHash {
+        std::size_t operator () (ShotOutcomeKey const& key) const noexcept { return static_cast<std::size_t>(key.hash); }
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::size_t capacity = 0;
+        std::list<std::pair<ShotOutcomeKey, ShotOutcome>> entries;  // 先頭ほど最近使用した
+        std::unordered_map<ShotOutcomeKey, std::list<std::pair<ShotOutcomeKey, ShotOutcome>>::iterator, KeyHash> index;
+        ShotOutcomeCacheStats stats;
+    };
+
+    std::unique_ptr<ISimulatorFactory> factory_;
+    ShotOutcomeCacheOptions options_;
+    std::shared_ptr<IShotOutcomeStore> store_;
+    std::vector<Shard> shards_;
+
+    std::mutex simulators_mutex_;
+    std::vector<std::unique_ptr<ISimulator>> idle_simulators_;
+
+    void InsertToShard(ShotOutcomeKey const& key, ShotOutcome const& outcome, bool from_store = false)
+    {
+        auto& shard = GetShard(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (from_store) ++shard.stats.store_hits;
+        auto const it = shard.index.find(key);
+        if (it != shard.index.end()) {
+            it->second->second = outcome;
+            shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+            return;
+        }
+
+        shard.entries.emplace_front(key, outcome);
+        shard.index.emplace(key, shard.entries.begin());
+        ++shard.stats.insertions;
+        if (shard.entries.size() > shard.capacity) {
+            shard.index.erase(shard.entries.back().first);
+            shard.entries.pop_back();
+            ++shard.stats.evictions;
+        }
+    }
+
+    std::int32_t Quantize(float value, float resolution) const
+    {
+        if (options_.exact) {
+            if (value == 0.f) value = 0.f;  // -0 と +0 を同じキーにする
+            std::int32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+        double const q = std::round(static_cast<double>(value) / static_cast<double>(resolution));
+        return static_cast<std::int32_t>(std::clamp(q,
+            static_cast<double>(std::numeric_limits<std::int32_t>::min()),
+            static_cast<double>(std::numeric_limits<std::int32_t>::max())));
+    }
+
+    Shard& GetShard(ShotOutcomeKey const& key)
+    {
+        // unordered_map はハッシュ値の下位ビットを使用するため, シャードの選択には上位ビットを使用する
+        return shards_[static_cast<std::size_t>(key.hash >> 32) % shards_.size()];
+    }
+
+    std::unique_ptr<ISimulator> AcquireSimulator()
+    {
+        {
+            std::lock_guard<std::mutex> lock(simulators_mutex_);
+            if (!idle_simulators_.empty()) {
+                auto simulator = std::move(idle_simulators_.back());
+                idle_simulators_.pop_back();
+                return simulator;
+            }
+        }
+        return factory_->CreateSimulator();
+    }
+
+    void ReleaseSimulator(std::unique_ptr<ISimulator> simulator)
+    {
+        std::lock_guard<std::mutex> lock(simulators_mutex_);
+        idle_simulators_.push_back(std::move(simulator));
+    }
+};
+
+
+/// @cond Doxygen_Suppress
+// json
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(ShotOutcomeCacheStats, hits, misses, insertions, evictions, store_hits, entries)
+/// @endcond
+
+} // namespace digitalcurling::simulators
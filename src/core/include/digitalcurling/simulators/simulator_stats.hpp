@@ -0,0 +1,71 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// @brief SimulatorStats を定義
+
+#pragma once
+
+#include <cstdint>
+#include <nlohmann/json.hpp>
+
+namespace digitalcurling::simulators {
+
+/// @brief シミュレーターの性能カウンター
+///
+/// シミュレーターの生成時からの累積値です。
+/// 対応していないシミュレーターでは全ての値が0になります。
+struct SimulatorStats {
+    /// @brief `Step()` で進めたフレーム数
+    std::uint64_t frames = 0;
+    /// @brief 開始した接触の数
+    std::uint64_t contacts_begun = 0;
+    /// @brief 衝突の解決を行った接触の数
+    std::uint64_t contacts_solved = 0;
+    /// @brief シート外に出たため取り除いたストーンの数
+    std::uint64_t out_of_sheet_removals = 0;
+    /// @brief `SetStones()` の呼び出し回数
+    std::uint64_t set_stones_calls = 0;
+    /// @brief `Load()` の呼び出し回数
+    std::uint64_t load_calls = 0;
+    /// @brief 摩擦・カールによる速度の更新にかかった時間(秒)
+    double motion_seconds = 0.0;
+    /// @brief 物理エンジンのステップにかかった時間(秒)
+    double world_step_seconds = 0.0;
+    /// @brief 物理エンジンを使わずに進めたショットの数
+    std::uint64_t fast_path_shots = 0;
+    /// @brief 物理エンジンを使わずに進めたフレーム数 ( `frames` に含まれる)
+    std::uint64_t fast_path_frames = 0;
+    /// @brief 経路上に他のストーンがあり接触し得るため、物理エンジンで進めたショットの数
+    std::uint64_t fast_path_rejections = 0;
+
+    /// @brief 他のカウンターの値を加算する
+    /// @param[in] other 加算するカウンター
+    /// @returns `*this`
+    SimulatorStats& operator += (SimulatorStats const& other)
+    {
+        frames += other.frames;
+        contacts_begun += other.contacts_begun;
+        contacts_solved += other.contacts_solved;
+        out_of_sheet_removals += other.out_of_sheet_removals;
+        set_stones_calls += other.set_stones_calls;
+        load_calls += other.load_calls;
+        motion_seconds += other.motion_seconds;
+        world_step_seconds += other.world_step_seconds;
+        fast_path_shots += other.fast_path_shots;
+        fast_path_frames += other.fast_path_frames;
+        fast_path_rejections += other.fast_path_rejections;
+        return *this;
+    }
+};
+
+
+/// @cond Doxygen_Suppress
+// json
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(SimulatorStats,
+    frames, contacts_begun, contacts_solved, out_of_sheet_removals,
+    set_stones_calls, load_calls, motion_seconds, world_step_seconds,
+    fast_path_shots, fast_path_frames, fast_path_rejections)
+/// @endcond
+
+} // namespace digitalcurling::simulators
@@ -0,0 +1,273 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// @brief 処理時間のトレース (Trace Event Format) を定義
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace digitalcurling::trace {
+
+
+/// @brief スレッドごとに記録できるイベント数の既定値
+inline constexpr std::size_t kDefaultEventsPerThread = std::size_t(1) << 16;
+
+/// @brief 1つの区間の記録
+///
+/// `category` と `name` は文字列リテラルなど、プログラムの終了まで有効な文字列を指します。
+struct TraceEvent {
+    char const* category; ///< カテゴリ
+    char const* name; ///< 区間の名前
+    std::int64_t start_ns; ///< 開始時刻(ns)
+    std::int64_t duration_ns; ///< 長さ(ns)
+};
+
+namespace detail {
+
+// スレッドごとのイベントのバッファ
+// 書き込みは所有するスレッドのみが行い, 書き込んだ要素数を release で公開する
+struct ThreadBuffer {
+    std::uint32_t thread_id = 0;
+    std::atomic<std::uint64_t> generation{ 0 };
+    std::atomic<std::size_t> size{ 0 };
+    std::atomic<std::uint64_t> dropped{ 0 };
+    std::size_t capacity = 0;
+    std::unique_ptr<TraceEvent[]> events;
+};
+
+struct TracerState {
+    std::atomic<bool> enabled{ false };
+    std::atomic<std::uint64_t> generation{ 0 };
+    std::atomic<std::size_t> events_per_thread{ kDefaultEventsPerThread };
+    std::mutex mutex;  // Start / Stop とバッファの登録を直列化する
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+};
+
+inline TracerState& GetState()
+{
+    static TracerState state;
+    return state;
+}
+
+// モジュール (ローダーとプラグイン) をまたいで同じ値になるよう, スレッドIDのハッシュを使う
+inline std::uint32_t GetCurrentThreadId()
+{
+    auto const hash = static_cast<std::uint64_t>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    return static_cast<std::uint32_t>(hash ^ (hash >> 32));
+}
+
+inline ThreadBuffer* GetThreadBuffer()
+{
+    thread_local std::shared_ptr<ThreadBuffer> buffer;
+    if (!buffer) {
+        auto created = std::make_shared<ThreadBuffer>();
+        created->thread_id = GetCurrentThreadId();
+        auto& state = GetState();
+        std::lock_guard lock(state.mutex);
+        state.buffers.push_back(created);
+        buffer = std::move(created);
+    }
+    return buffer.get();
+}
+
+} // namespace digitalcurling::trace::detail
+
+
+/// @brief トレースの記録中かを得る
+/// @returns 記録中の場合 `true`
+inline bool IsEnabled() noexcept
+{
+    return detail::GetState().enabled.load(std::memory_order_relaxed);
+}
+
+/// @brief トレースで使用する現在時刻を得る
+/// @returns 現在時刻(ns)
+inline std::int64_t Now() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// @brief 区間を記録する
+///
+/// 記録中でない場合は何もしません。
+/// 記録するスレッドのバッファが一杯の場合、イベントは破棄され、破棄された数が `Stop()` の結果に含まれます。
+/// @param[in] category カテゴリ (プログラムの終了まで有効な文字列)
+/// @param[in] name 区間の名前 (プログラムの終了まで有効な文字列)
+/// @param[in] start_ns 開始時刻(ns) ( `Now()` の値)
+/// @param[in] duration_ns 長さ(ns)
+inline void Record(char const* category, char const* name, std::int64_t start_ns, std::int64_t duration_ns) noexcept
+{
+    auto& state = detail::GetState();
+    if (!state.enabled.load(std::memory_order_relaxed)) return;
+
+    try {
+        auto* buffer = detail::GetThreadBuffer();
+
+        // 新しい記録が開始されていれば, このスレッドのバッファを初期化する
+        auto const generation = state.generation.load(std::memory_order_acquire);
+        if (buffer->generation.load(std::memory_order_relaxed) != generation) {
+            auto const capacity = state.events_per_thread.load(std::memory_order_relaxed);
+            if (buffer->capacity != capacity) {
+                buffer->events.reset(new TraceEvent[capacity]);
+                buffer->capacity = capacity;
+            }
+            buffer->size.store(0, std::memory_order_relaxed);
+            buffer->dropped.store(0, std::memory_order_relaxed);
+            buffer->generation.store(generation, std::memory_order_release);
+        }
+
+        auto const index = buffer->size.load(std::memory_order_relaxed);
+        if (index >= buffer->capacity) {
+            buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        buffer->events[index] = TraceEvent{ category, name, start_ns, duration_ns };
+        buffer->size.store(index + 1, std::memory_order_release);
+    } catch (...) {
+        // メモリを確保できない場合は記録しない
+    }
+}
+
+/// @brief トレースの記録を開始する
+///
+/// 前回の記録で取得されなかったイベントは破棄されます。既に記録中の場合は何もしません。
+/// @param[in] events_per_thread スレッドごとに記録できるイベント数
+inline void Start(std::size_t events_per_thread = kDefaultEventsPerThread)
+{
+    auto& state = detail::GetState();
+    std::lock_guard lock(state.mutex);
+    if (state.enabled.load(std::memory_order_relaxed)) return;
+
+    // 終了したスレッドのバッファを解放する
+    state.buffers.erase(
+        std::remove_if(state.buffers.begin(), state.buffers.end(), [](auto const& b) { return b.use_count() == 1; }),
+        state.buffers.end());
+
+    state.events_per_thread.store(std::max<std::size_t>(events_per_thread, 1), std::memory_order_relaxed);
+    state.generation.fetch_add(1, std::memory_order_release);
+    state.enabled.store(true, std::memory_order_release);
+}
+
+/// @brief トレースの記録を終了し、記録したイベントを取得する
+///
+/// イベントは Trace Event Format の complete event (`"ph": "X"`) として返します。
+/// バッファが一杯で破棄されたイベントがある場合は、その数をカウンターイベント `dropped_events` として追加します。
+/// 取得したイベントはバッファから取り除かれ、続けて呼び出した場合は空の配列を返します。
+/// @returns イベントの配列 (JSON)
+inline nlohmann::json Stop()
+{
+    auto& state = detail::GetState();
+    std::lock_guard lock(state.mutex);
+    state.enabled.store(false, std::memory_order_relaxed);
+
+    auto const generation = state.generation.load(std::memory_order_relaxed);
+    auto events = nlohmann::json::array();
+    std::uint64_t dropped = 0;
+    for (auto const& buffer : state.buffers) {
+        if (buffer->generation.load(std::memory_order_acquire) != generation) continue;
+        auto const size = buffer->size.load(std::memory_order_acquire);
+        for (std::size_t i = 0; i < size; ++i) {
+            auto const& e = buffer->events[i];
+            events.push_back({
+                { "name", e.name },
+                { "cat", e.category },
+                { "ph", "X" },
+                { "ts", static_cast<double>(e.start_ns) / 1000. },
+                { "dur", static_cast<double>(e.duration_ns) / 1000. },
+                { "pid", 1 },
+                { "tid", buffer->thread_id },
+            });
+        }
+        dropped += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    if (dropped > 0) {
+        events.push_back({
+            { "name", "dropped_events" },
+            { "ph", "C" },
+            { "ts", static_cast<double>(Now()) / 1000. },
+            { "pid", 1 },
+            { "args", { { "count", dropped } } },
+        });
+    }
+
+    // 取得済みのバッファは次の記録の開始時に初期化される
+    state.generation.fetch_add(1, std::memory_order_release);
+    return events;
+}
+
+/// @brief イベントをトレースファイルに書き出す
+///
+/// Chrome の `about:tracing` や Perfetto UI で読み込める JSON ファイルを作成します。
+/// @param[in] path 出力先のファイルパス
+/// @param[in] events `Stop()` で取得したイベントの配列
+/// @throws std::runtime_error ファイルを書き込めない場合
+inline void WriteTraceFile(std::filesystem::path const& path, nlohmann::json const& events)
+{
+    std::ofstream file(path);
+    if (!file) throw std::runtime_error("Failed to open trace file: " + path.string());
+    file << nlohmann::json{ { "traceEvents", events }, { "displayTimeUnit", "ns" } }.dump();
+    if (!file) throw std::runtime_error("Failed to write trace file: " + path.string());
+}
+
+
+/// @brief スコープの開始から終了までを1つの区間として記録する
+///
+/// 生成時に記録中でなければ、破棄時にも何もしません。
+class TraceScope {
+public:
+    /// @brief 区間を開始する
+    /// @param[in] category カテゴリ (プログラムの終了まで有効な文字列)
+    /// @param[in] name 区間の名前 (プログラムの終了まで有効な文字列)
+    TraceScope(char const* category, char const* name) noexcept
+        : category_(category), name_(name), start_ns_(IsEnabled() ? Now() : kInactive) {}
+
+    /// @brief 区間を終了して記録する
+    ~TraceScope()
+    {
+        if (start_ns_ != kInactive) Record(category_, name_, start_ns_, Now() - start_ns_);
+    }
+
+    TraceScope(TraceScope const&) = delete;
+    TraceScope& operator = (TraceScope const&) = delete;
+
+private:
+    static constexpr std::int64_t kInactive = -1;
+
+    char const* category_;
+    char const* name_;
+    std::int64_t start_ns_;
+};
+
+} // namespace digitalcurling::trace
+
+
+/// @cond Doxygen_Suppress
+#define DIGITALCURLING_TRACE_CONCAT_INNER(a, b) a##b
+#define DIGITALCURLING_TRACE_CONCAT(a, b) DIGITALCURLING_TRACE_CONCAT_INNER(a, b)
+/// @endcond
+
+#ifndef DIGITALCURLING_DISABLE_TRACE
+    /// @brief 現在のスコープを区間として記録する
+    ///
+    /// `DIGITALCURLING_DISABLE_TRACE` を定義してビルドすると、何も記録しないコードになります。
+    #define DIGITALCURLING_TRACE_SCOPE(category, name) \
+        ::digitalcurling::trace::TraceScope DIGITALCURLING_TRACE_CONCAT(dc_trace_scope_, __LINE__)(category, name)
+#else
+    #define DIGITALCURLING_TRACE_SCOPE(category, name) do {} while (0)
+#endif
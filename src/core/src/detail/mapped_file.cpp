@@ -0,0 +1,84 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+#include "digitalcurling/detail/mapped_file.hpp"
+
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace digitalcurling::detail {
+
+MappedFile::MappedFile(std::filesystem::path const& path, bool writable)
+{
+#ifdef _WIN32
+    HANDLE const file = ::CreateFileW(path.c_str(), GENERIC_READ | (writable ? GENERIC_WRITE : 0), FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) Fail(path);
+    file_ = file;
+    LARGE_INTEGER size;
+    if (!::GetFileSizeEx(file, &size)) Fail(path);
+    size_ = static_cast<std::size_t>(size.QuadPart);
+    if (size_ == 0) return;
+    mapping_ = ::CreateFileMappingW(file, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping_) Fail(path);
+    data_ = static_cast<std::uint8_t*>(::MapViewOfFile(mapping_, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0));
+    if (!data_) Fail(path);
+#else
+    fd_ = ::open(path.c_str(), writable ? O_RDWR : O_RDONLY);
+    if (fd_ < 0) Fail(path);
+    struct stat st;
+    if (::fstat(fd_, &st) != 0) Fail(path);
+    size_ = static_cast<std::size_t>(st.st_size);
+    if (size_ == 0) return;
+    void* data = ::mmap(nullptr, size_, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd_, 0);
+    if (data == MAP_FAILED) Fail(path);
+    data_ = static_cast<std::uint8_t*>(data);
+#endif
+}
+
+void MappedFile::AdviseSequential() const
+{
+#ifndef _WIN32
+    if (data_) ::madvise(data_, size_, MADV_SEQUENTIAL);
+#endif
+}
+
+void MappedFile::Fail(std::filesystem::path const& path)
+{
+    Close();
+    throw std::runtime_error("MappedFile: failed to map \"" + path.string() + "\".");
+}
+
+void MappedFile::Close() noexcept
+{
+#ifdef _WIN32
+    if (data_) ::UnmapViewOfFile(data_);
+    if (mapping_) ::CloseHandle(mapping_);
+    if (file_) ::CloseHandle(file_);
+    mapping_ = nullptr;
+    file_ = nullptr;
+#else
+    if (data_) ::munmap(data_, size_);
+    if (fd_ >= 0) ::close(fd_);
+    fd_ = -1;
+#endif
+    data_ = nullptr;
+    size_ = 0;
+}
+
+} // namespace digitalcurling::detail
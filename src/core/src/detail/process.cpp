@@ -0,0 +1,45 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+#include "digitalcurling/detail/process.hpp"
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <cerrno>
+    #include <signal.h>
+    #include <unistd.h>
+#endif
+
+namespace digitalcurling::detail {
+
+std::uint32_t CurrentProcessId()
+{
+#ifdef _WIN32
+    return static_cast<std::uint32_t>(::GetCurrentProcessId());
+#else
+    return static_cast<std::uint32_t>(::getpid());
+#endif
+}
+
+bool IsProcessAlive(std::uint32_t pid)
+{
+#ifdef _WIN32
+    HANDLE const process = ::OpenProcess(SYNCHRONIZE, FALSE, static_cast<DWORD>(pid));
+    if (!process) return ::GetLastError() != ERROR_INVALID_PARAMETER;
+    bool const alive = ::WaitForSingleObject(process, 0) == WAIT_TIMEOUT;
+    ::CloseHandle(process);
+    return alive;
+#else
+    if (pid == 0) return false;
+    return ::kill(static_cast<pid_t>(pid), 0) == 0 || errno != ESRCH;
+#endif
+}
+
+} // namespace digitalcurling::detail
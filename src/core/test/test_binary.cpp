@@ -0,0 +1,227 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include "digitalcurling/digitalcurling.hpp"
+
+namespace dc = digitalcurling;
+using nlohmann::json;
+
+namespace {
+
+template <typename T>
+T RoundTrip(T const& v, dc::BinaryFormat format)
+{
+    auto const data = dc::ToBinary(v, format);
+    EXPECT_GE(data.size(), dc::kBinaryHeaderSize);
+    EXPECT_EQ(data[3], static_cast<std::uint8_t>(format));
+    return dc::FromBinary<T>(data);
+}
+
+class Binary : public ::testing::TestWithParam<dc::BinaryFormat> {};
+
+} // unnamed namespace
+
+TEST_P(Binary, Vector2)
+{
+    dc::Vector2 const v(1.5f, -2.25f);
+    auto const r = RoundTrip(v, GetParam());
+    EXPECT_EQ(r.x, v.x);
+    EXPECT_EQ(r.y, v.y);
+}
+
+TEST_P(Binary, Stone)
+{
+    dc::Stone const v(dc::Vector2(0.1f, 38.405f), 2.4f);
+    auto const r = RoundTrip(v, GetParam());
+    EXPECT_EQ(r.position.x, v.position.x);
+    EXPECT_EQ(r.position.y, v.position.y);
+    EXPECT_EQ(r.angle, v.angle);
+}
+
+TEST_P(Binary, Move)
+{
+    // shot
+    dc::moves::Shot const v_shot(2.3f, 1.57f, 0.05f);
+    auto const r_shot = RoundTrip(dc::moves::Move(v_shot), GetParam());
+    ASSERT_TRUE(std::holds_alternative<dc::moves::Shot>(r_shot));
+    EXPECT_EQ(std::get<dc::moves::Shot>(r_shot).translational_velocity, v_shot.translational_velocity);
+    EXPECT_EQ(std::get<dc::moves::Shot>(r_shot).angular_velocity, v_shot.angular_velocity);
+    EXPECT_EQ(std::get<dc::moves::Shot>(r_shot).release_angle, v_shot.release_angle);
+
+    // concede
+    auto const r_concede = RoundTrip(dc::moves::Move(dc::moves::Concede()), GetParam());
+    EXPECT_TRUE(std::holds_alternative<dc::moves::Concede>(r_concede));
+}
+
+TEST_P(Binary, Team)
+{
+    EXPECT_EQ(RoundTrip(dc::Team::k0, GetParam()), dc::Team::k0);
+    EXPECT_EQ(RoundTrip(dc::Team::k1, GetParam()), dc::Team::k1);
+    EXPECT_EQ(RoundTrip(dc::Team::kInvalid, GetParam()), dc::Team::kInvalid);
+}
+
+TEST_P(Binary, GameRule)
+{
+    dc::GameRule v;
+    v.type = dc::GameRuleType::kMixedDoubles;
+    v.is_wheelchair = true;
+    v.free_guard_zone = dc::rules::FreeGuardZoneRule(true);
+
+    auto const r = RoundTrip(v, GetParam());
+    EXPECT_EQ(r.type, v.type);
+    EXPECT_EQ(r.is_wheelchair, v.is_wheelchair);
+    ASSERT_TRUE(r.free_guard_zone.has_value());
+    EXPECT_EQ(r.free_guard_zone->is_enabled, v.free_guard_zone->is_enabled);
+    EXPECT_EQ(r.free_guard_zone->applied_shot_count, v.free_guard_zone->applied_shot_count);
+    EXPECT_FALSE(r.no_tick_shot.has_value());
+}
+
+TEST_P(Binary, GameSetting)
+{
+    dc::GameSetting v;
+    v.max_end = 6;
+    v.sheet_width = 4.75f;
+    v.thinking_time = dc::TeamValue<std::chrono::milliseconds>(
+        std::chrono::milliseconds(1'525), std::chrono::milliseconds(23'456)
+    );
+    v.extra_end_thinking_time = dc::TeamValue<std::chrono::milliseconds>(
+        std::chrono::milliseconds(525), std::chrono::milliseconds(3'456)
+    );
+
+    auto const r = RoundTrip(v, GetParam());
+    EXPECT_EQ(r.max_end, v.max_end);
+    EXPECT_EQ(r.sheet_width, v.sheet_width);
+    EXPECT_EQ(r.thinking_time[dc::Team::k0], v.thinking_time[dc::Team::k0]);
+    EXPECT_EQ(r.thinking_time[dc::Team::k1], v.thinking_time[dc::Team::k1]);
+    EXPECT_EQ(r.extra_end_thinking_time[dc::Team::k0], v.extra_end_thinking_time[dc::Team::k0]);
+    EXPECT_EQ(r.extra_end_thinking_time[dc::Team::k1], v.extra_end_thinking_time[dc::Team::k1]);
+}
+
+TEST_P(Binary, GameResult)
+{
+    dc::GameResult v;
+    v.winner = dc::Team::k1;
+    v.reason = dc::GameResult::Reason::kTimeLimit;
+
+    auto const r = RoundTrip(v, GetParam());
+    EXPECT_EQ(r.winner, v.winner);
+    EXPECT_EQ(r.reason, v.reason);
+}
+
+TEST_P(Binary, GameState)
+{
+    dc::GameSetting setting;
+    setting.max_end = 8;
+    dc::GameState v(setting);
+    v.end = 3;
+    v.shot = 7;
+    v.hammer = dc::Team::k1;
+
+    auto stones0 = std::array<std::optional<dc::Stone>, 8>{};
+    auto stones1 = std::array<std::optional<dc::Stone>, 8>{};
+    stones0[0] = dc::Stone(dc::Vector2(0.123f, 38.456f), 0.789f);
+    stones1[2] = dc::Stone(dc::Vector2(-1.f, 40.f), 3.14f);
+    v.stones = dc::StoneCoordinate(std::array<std::array<std::optional<dc::Stone>, 8>, 2>{ stones0, stones1 });
+
+    auto scores0 = std::vector<std::optional<std::uint8_t>>(setting.max_end + 1, std::nullopt);
+    auto scores1 = std::vector<std::optional<std::uint8_t>>(setting.max_end + 1, std::nullopt);
+    scores0[0] = 2;
+    scores1[0] = 0;
+    v.scores = dc::GameScores(std::array<std::vector<std::optional<std::uint8_t>>, 2>{ scores0, scores1 });
+    v.game_result = dc::GameResult{ dc::Team::k0, dc::GameResult::Reason::kConcede };
+
+    auto const r = RoundTrip(v, GetParam());
+    EXPECT_EQ(r.end, v.end);
+    EXPECT_EQ(r.shot, v.shot);
+    EXPECT_EQ(r.hammer, v.hammer);
+    for (auto team : { dc::Team::k0, dc::Team::k1 }) {
+        for (std::size_t i = 0; i < v.stones[team].size(); ++i) {
+            ASSERT_EQ(r.stones[team][i].has_value(), v.stones[team][i].has_value());
+            if (!v.stones[team][i]) continue;
+            EXPECT_EQ(r.stones[team][i]->position.x, v.stones[team][i]->position.x);
+            EXPECT_EQ(r.stones[team][i]->position.y, v.stones[team][i]->position.y);
+            EXPECT_EQ(r.stones[team][i]->angle, v.stones[team][i]->angle);
+        }
+        EXPECT_EQ(r.scores[team], v.scores[team]);
+        EXPECT_EQ(r.thinking_time_remaining[team], v.thinking_time_remaining[team]);
+    }
+    ASSERT_TRUE(r.game_result.has_value());
+    EXPECT_EQ(r.game_result->winner, v.game_result->winner);
+    EXPECT_EQ(r.game_result->reason, v.game_result->reason);
+}
+
+TEST_P(Binary, StoneState)
+{
+    dc::simulators::ISimulator::StoneState const v(dc::Vector2(0.5f, 1.5f), 0.25f, dc::Vector2(0.1f, 2.3f), -1.57f);
+    auto const r = RoundTrip(v, GetParam());
+    EXPECT_EQ(r.position.x, v.position.x);
+    EXPECT_EQ(r.position.y, v.position.y);
+    EXPECT_EQ(r.angle, v.angle);
+    EXPECT_EQ(r.translational_velocity.x, v.translational_velocity.x);
+    EXPECT_EQ(r.translational_velocity.y, v.translational_velocity.y);
+    EXPECT_EQ(r.angular_velocity, v.angular_velocity);
+}
+
+TEST_P(Binary, Collision)
+{
+    using Collision = dc::simulators::ISimulator::Collision;
+    dc::simulators::ISimulator::StoneState const stone(dc::Vector2(0.5f, 1.5f), 0.25f, dc::Vector2(0.1f, 2.3f), -1.57f);
+    Collision const v(Collision::CollisionStone(3, stone), Collision::CollisionStone(12, stone), 0.75f, -0.125f);
+
+    auto const r = RoundTrip(v, GetParam());
+    EXPECT_EQ(r.a.id, v.a.id);
+    EXPECT_EQ(r.b.id, v.b.id);
+    EXPECT_EQ(r.a.stone.position.y, v.a.stone.position.y);
+    EXPECT_EQ(r.b.stone.angular_velocity, v.b.stone.angular_velocity);
+    EXPECT_EQ(r.normal_impulse, v.normal_impulse);
+    EXPECT_EQ(r.tangent_impulse, v.tangent_impulse);
+}
+
+TEST_P(Binary, SameAsJson)
+{
+    dc::GameState const v(dc::GameSetting{});
+    EXPECT_EQ(dc::JsonFromBinary(dc::ToBinary(v, GetParam())), json(v));
+}
+
+INSTANTIATE_TEST_SUITE_P(Formats, Binary,
+    ::testing::Values(dc::BinaryFormat::kMessagePack, dc::BinaryFormat::kCbor),
+    [](::testing::TestParamInfo<dc::BinaryFormat> const& info) {
+        return info.param == dc::BinaryFormat::kMessagePack ? std::string("MessagePack") : std::string("Cbor");
+    });
+
+TEST(BinaryHeader, Invalid)
+{
+    auto data = dc::ToBinary(dc::Vector2(1.f, 2.f));
+    EXPECT_EQ(data[0], 'D');
+    EXPECT_EQ(data[1], 'C');
+    EXPECT_EQ(data[2], dc::kBinaryFormatVersion);
+
+    // 短すぎる
+    EXPECT_THROW(dc::JsonFromBinary(data.data(), 2), std::invalid_argument);
+
+    // バージョンが異なる
+    auto wrong_version = data;
+    wrong_version[2] = dc::kBinaryFormatVersion + 1;
+    EXPECT_THROW(dc::JsonFromBinary(wrong_version), std::invalid_argument);
+
+    // 形式が無効
+    auto wrong_format = data;
+    wrong_format[3] = 0;
+    EXPECT_THROW(dc::JsonFromBinary(wrong_format), std::invalid_argument);
+
+    // 本体が壊れている
+    auto truncated = data;
+    truncated.resize(truncated.size() - 1);
+    EXPECT_THROW(dc::JsonFromBinary(truncated), json::parse_error);
+}
@@ -0,0 +1,168 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "digitalcurling/digitalcurling.hpp"
+#include "digitalcurling/simulators/free_flight_cache.hpp"
+#include "toy_simulator.hpp"
+
+namespace dc = digitalcurling;
+namespace dcs = digitalcurling::simulators;
+
+namespace {
+
+using digitalcurling::test::ToySimulatorFactory;
+
+// 全てのストーンの有無と位置が一致するか
+bool SamePositions(dcs::ISimulator::AllStones const& a, dcs::ISimulator::AllStones const& b)
+{
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].has_value() != b[i].has_value()) return false;
+        if (a[i] && (a[i]->position.x != b[i]->position.x || a[i]->position.y != b[i]->position.y)) return false;
+    }
+    return true;
+}
+
+dcs::FreeFlightCacheOptions ExactOptions()
+{
+    dcs::FreeFlightCacheOptions options;
+    options.exact = true;
+    return options;
+}
+
+dc::moves::Shot const kStraightShot(1.f, 0.f, 1.5707963f);
+
+} // unnamed namespace
+
+TEST(FreeFlightCache, ResumeBeforeContact)
+{
+    ToySimulatorFactory factory;
+    dcs::FreeFlightCache cache(factory, ExactOptions());
+
+    // 投げたストーンの正面に2個のストーンを縦に並べた盤面
+    dcs::ISimulator::AllStones stones;
+    stones[8] = dcs::ISimulator::StoneState(dc::Vector2(0.f, 0.6f), 0.f, dc::Vector2(), 0.f);
+    stones[9] = dcs::ISimulator::StoneState(dc::Vector2(0.f, 0.95f), 0.f, dc::Vector2(), 0.f);
+
+    auto const resume = cache.FindResumePoint(stones, kStraightShot, 0, 4.75f);
+    EXPECT_FALSE(resume.completed);
+    EXPECT_GT(resume.skipped_frames, 0u);
+    ASSERT_TRUE(resume.stones[0]);
+    EXPECT_LT(resume.stones[0]->position.y + 2.f * dc::Stone::kRadius, 0.6f);
+
+    // 最初からシミュレーションした結果と一致する
+    auto simulator = factory.CreateSimulator();
+    auto const direct = dcs::SimulateShotOutcome(*simulator, stones, kStraightShot, 0, 4.75f);
+    auto const outcome = cache.Simulate(stones, kStraightShot, 0, 4.75f);
+    EXPECT_TRUE(SamePositions(direct.stones, outcome.stones));
+    EXPECT_EQ(direct.collided_stones, outcome.collided_stones);
+
+    auto const stats = cache.GetStats();
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.resumed_shots, 2u);
+    EXPECT_EQ(stats.skipped_frames, 2 * resume.skipped_frames);
+    EXPECT_EQ(stats.entries, 1u);
+}
+
+TEST(FreeFlightCache, CompletedWithoutSimulation)
+{
+    ToySimulatorFactory factory;
+    dcs::FreeFlightCache cache(factory, ExactOptions());
+
+    // 軌跡から離れたストーンは結果に影響しない
+    dcs::ISimulator::AllStones stones;
+    stones[3] = dcs::ISimulator::StoneState(dc::Vector2(1.f, 0.5f), 0.f, dc::Vector2(), 0.f);
+
+    auto const resume = cache.FindResumePoint(stones, kStraightShot, 0, 4.75f);
+    EXPECT_TRUE(resume.completed);
+    EXPECT_EQ(resume.skipped_frames, cache.GetTrajectory(kStraightShot)->frames);
+
+    auto simulator = factory.CreateSimulator();
+    auto const direct = dcs::SimulateShotOutcome(*simulator, stones, kStraightShot, 0, 4.75f);
+    auto const outcome = cache.Simulate(stones, kStraightShot, 0, 4.75f);
+    EXPECT_TRUE(SamePositions(direct.stones, outcome.stones));
+    EXPECT_EQ(cache.GetStats().completed_shots, 2u);
+
+    // シートの外に出るショットは, ストーンを取り除いた盤面が結果になる
+    dc::moves::Shot const wide_shot(3.f, 0.f, 0.f);
+    auto const out = cache.FindResumePoint(stones, wide_shot, 0, 4.75f);
+    EXPECT_TRUE(out.completed);
+    EXPECT_FALSE(out.stones[0]);
+    EXPECT_TRUE(SamePositions(dcs::SimulateShotOutcome(*simulator, stones, wide_shot, 0, 4.75f).stones, out.stones));
+}
+
+TEST(FreeFlightCache, MovingStonesAreSimulatedFromStart)
+{
+    ToySimulatorFactory factory;
+    dcs::FreeFlightCache cache(factory, ExactOptions());
+
+    dcs::ISimulator::AllStones stones;
+    stones[3] = dcs::ISimulator::StoneState(dc::Vector2(1.f, 0.5f), 0.f, dc::Vector2(-1.f, 0.f), 0.f);
+
+    auto const resume = cache.FindResumePoint(stones, kStraightShot, 0, 4.75f);
+    EXPECT_FALSE(resume.completed);
+    EXPECT_EQ(resume.skipped_frames, 0u);
+    EXPECT_EQ(cache.GetStats().full_shots, 1u);
+
+    // 量子化する場合も, 量子化したショットではなく引数のショットから始める
+    dcs::FreeFlightCache quantized(factory);
+    dc::moves::Shot const shot(1.0001f, 0.f, 1.5707963f);
+    auto const quantized_resume = quantized.FindResumePoint(stones, shot, 0, 4.75f);
+    EXPECT_EQ(quantized_resume.skipped_frames, 0u);
+    ASSERT_TRUE(quantized_resume.stones[0]);
+    EXPECT_NE(quantized.GetTrajectory(shot)->shot.translational_velocity, shot.translational_velocity);
+    EXPECT_EQ(quantized_resume.stones[0]->translational_velocity.x, shot.ToVector2().x);
+    EXPECT_EQ(quantized_resume.stones[0]->translational_velocity.y, shot.ToVector2().y);
+    EXPECT_EQ(quantized_resume.stones[0]->angular_velocity, shot.angular_velocity);
+}
+
+TEST(FreeFlightCache, QuantizedTrajectory)
+{
+    ToySimulatorFactory factory;
+    dcs::FreeFlightCacheOptions options;
+    options.checkpoint_interval = 8;
+    options.capacity = 2;
+    dcs::FreeFlightCache cache(factory, options);
+
+    // 分解能以内のショットは同じ軌跡を共有する
+    auto const a = cache.GetTrajectory(dc::moves::Shot(1.0001f, 0.f, 1.5707963f));
+    auto const b = cache.GetTrajectory(dc::moves::Shot(0.9999f, 0.f, 1.5708f));
+    EXPECT_EQ(a, b);
+    EXPECT_NEAR(a->shot.translational_velocity, 1.f, 1e-6f);
+    EXPECT_EQ(a->checkpoint_interval, 8u);
+    EXPECT_TRUE(a->stopped);
+    ASSERT_EQ(a->checkpoints.size(), a->segments.size() + 1);
+    EXPECT_EQ(a->GetCheckpointFrame(a->checkpoints.size() - 1), a->frames);
+
+    // 容量を超えると最も長く使用されていない軌跡から取り除かれる
+    cache.GetTrajectory(dc::moves::Shot(0.5f, 0.f, 1.5707963f));
+    cache.GetTrajectory(dc::moves::Shot(0.8f, 0.f, 1.5707963f));
+    auto const stats = cache.GetStats();
+    EXPECT_EQ(stats.evictions, 1u);
+    EXPECT_EQ(stats.entries, 2u);
+
+    cache.Clear();
+    EXPECT_EQ(cache.GetStats().entries, 0u);
+}
+
+TEST(FreeFlightCache, InvalidArguments)
+{
+    ToySimulatorFactory factory;
+    dcs::FreeFlightCacheOptions options;
+    options.capacity = 0;
+    EXPECT_THROW(dcs::FreeFlightCache(factory, options), std::invalid_argument);
+    options = dcs::FreeFlightCacheOptions();
+    options.checkpoint_interval = 0;
+    EXPECT_THROW(dcs::FreeFlightCache(factory, options), std::invalid_argument);
+    options = dcs::FreeFlightCacheOptions();
+    options.velocity_resolution = 0.f;
+    EXPECT_THROW(dcs::FreeFlightCache(factory, options), std::invalid_argument);
+
+    dcs::FreeFlightCache cache(factory);
+    EXPECT_THROW(cache.Simulate(dcs::ISimulator::AllStones(), kStraightShot, dc::StoneCoordinate::kStoneMax, 4.75f), std::out_of_range);
+}
@@ -0,0 +1,204 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <variant>
+
+#include <gtest/gtest.h>
+#include "digitalcurling/digitalcurling.hpp"
+#include "digitalcurling/records/game_record_reader.hpp"
+#include "digitalcurling/records/game_record_writer.hpp"
+
+namespace dc = digitalcurling;
+namespace rec = digitalcurling::records;
+
+namespace {
+
+class GameRecord : public ::testing::Test {
+protected:
+    std::filesystem::path path_;
+
+    void SetUp() override
+    {
+        auto const* info = ::testing::UnitTest::GetInstance()->current_test_info();
+        path_ = std::filesystem::temp_directory_path() / (std::string("digitalcurling_test_") + info->name() + ".dcgr");
+        Remove();
+    }
+    void TearDown() override { Remove(); }
+
+    void Remove()
+    {
+        std::filesystem::remove(path_);
+        std::filesystem::remove(rec::GetGameRecordIndexPath(path_));
+    }
+
+    // 試合 `game` の `shot` 番目のショットを決定的に作成する
+    static dc::moves::Shot MakeShot(std::size_t game, std::size_t shot)
+    {
+        return dc::moves::Shot(2.f + 0.01f * game, 1.57f, 0.001f * shot);
+    }
+
+    // `shot_count` 個のショットを持つ試合を書き込む
+    static void WriteGame(rec::GameRecordWriter& writer, std::size_t game, std::size_t shot_count)
+    {
+        dc::GameSetting setting;
+        dc::GameRule rule;
+        rule.type = dc::GameRuleType::kStandard;
+        dc::GameState state(setting);
+        writer.BeginGame(setting, rule, state);
+
+        for (std::size_t i = 0; i < shot_count; ++i) {
+            dc::GameState after = state;
+            after.shot = static_cast<std::uint8_t>(state.shot + 1);
+
+            dc::simulators::ISimulator::AllStones stones;
+            stones[i % 16] = dc::simulators::ISimulator::StoneState(dc::Vector2(0.1f * i, 38.f + game), 0.5f, dc::Vector2(), 0.f);
+            auto const violation = i == 1 ? std::make_optional(dc::rules::AdditionalRuleTypes::kFreeGuardZone) : std::nullopt;
+            auto const shot = MakeShot(game, i);
+            writer.AppendShot(state, shot, dc::moves::Shot(shot.translational_velocity + 0.05f, shot.angular_velocity, shot.release_angle), stones, violation, after);
+            state = after;
+        }
+        writer.EndGame(dc::GameResult{ dc::Team::k1, dc::GameResult::Reason::kScore });
+    }
+};
+
+} // unnamed namespace
+
+TEST_F(GameRecord, WriteAndRead)
+{
+    {
+        rec::GameRecordWriter writer(path_);
+        for (std::size_t game = 0; game < 5; ++game) WriteGame(writer, game, 3 + game);
+        EXPECT_EQ(writer.GetGameCount(), 5u);
+    }
+
+    rec::GameRecordReader reader(path_);
+    ASSERT_EQ(reader.GetGameCount(), 5u);
+    for (std::size_t game = 0; game < 5; ++game) {
+        auto const& header = reader.GetGameHeader(game);
+        EXPECT_EQ(header.game_index, game);
+        EXPECT_EQ(header.shot_count, 3 + game);
+        EXPECT_EQ(header.winner, static_cast<std::int8_t>(dc::Team::k1));
+        EXPECT_EQ(header.reason, static_cast<std::uint8_t>(dc::GameResult::Reason::kScore));
+        EXPECT_EQ(header.max_end, dc::GameSetting().max_end);
+        ASSERT_EQ(reader.GetShotCount(game), 3 + game);
+    }
+
+    // 試合とショットを指定して参照する
+    auto const& record = reader.GetShot(3, 2);
+    EXPECT_EQ(record.shot, 2);
+    EXPECT_EQ(record.move_type, rec::RecordMoveType::kShot);
+    EXPECT_EQ(record.verdict, rec::RecordVerdict::kNone);
+    ASSERT_TRUE(std::holds_alternative<dc::moves::Shot>(record.GetMove()));
+    EXPECT_EQ(std::get<dc::moves::Shot>(record.GetMove()).translational_velocity, MakeShot(3, 2).translational_velocity);
+    EXPECT_EQ(std::get<dc::moves::Shot>(record.GetMove()).release_angle, MakeShot(3, 2).release_angle);
+    EXPECT_EQ(record.GetNoisyShot().translational_velocity, MakeShot(3, 2).translational_velocity + 0.05f);
+    auto const after = record.GetAfter();
+    ASSERT_TRUE(after.GetAllStones()[2].has_value());
+    EXPECT_EQ(after.GetAllStones()[2]->position.y, 41.f);
+    EXPECT_FALSE(after.GetAllStones()[0].has_value());
+    EXPECT_EQ(reader.GetShot(3, 1).GetViolation(), dc::rules::AdditionalRuleTypes::kFreeGuardZone);
+
+    EXPECT_THROW(reader.GetShot(3, 6), std::out_of_range);
+    EXPECT_THROW(reader.GetGameHeader(5), std::out_of_range);
+}
+
+TEST_F(GameRecord, AppendToExistingFile)
+{
+    {
+        rec::GameRecordWriter writer(path_);
+        WriteGame(writer, 0, 4);
+    }
+    {
+        rec::GameRecordWriter writer(path_);
+        EXPECT_EQ(writer.GetGameCount(), 1u);
+        WriteGame(writer, 1, 2);
+    }
+
+    rec::GameRecordReader reader(path_);
+    ASSERT_EQ(reader.GetGameCount(), 2u);
+    EXPECT_EQ(reader.GetGameHeader(1).game_index, 1u);
+    EXPECT_EQ(reader.GetShotCount(1), 2u);
+}
+
+TEST_F(GameRecord, ForEachGame)
+{
+    {
+        rec::GameRecordWriter writer(path_);
+        for (std::size_t game = 0; game < 100; ++game) WriteGame(writer, game, game % 16);
+    }
+
+    rec::GameRecordReader reader(path_);
+    std::atomic<std::size_t> shots = 0;
+    std::atomic<std::size_t> games = 0;
+    reader.ForEachGame([&](std::size_t game, rec::GameRecordHeader const& header, rec::ShotRecord const*, std::size_t shot_count) {
+        EXPECT_EQ(header.game_index, game);
+        games += 1;
+        shots += shot_count;
+    }, 4);
+    EXPECT_EQ(games.load(), 100u);
+    EXPECT_EQ(shots.load(), 726u);
+
+    EXPECT_THROW(reader.ForEachGame([](std::size_t game, auto const&, auto const*, std::size_t) {
+        if (game == 42) throw std::runtime_error("error");
+    }, 4), std::runtime_error);
+}
+
+TEST_F(GameRecord, RebuildIndex)
+{
+    {
+        rec::GameRecordWriter writer(path_);
+        for (std::size_t game = 0; game < 3; ++game) WriteGame(writer, game, 5);
+    }
+
+    // インデックスがなくても読み込める
+    std::filesystem::remove(rec::GetGameRecordIndexPath(path_));
+    {
+        rec::GameRecordReader reader(path_);
+        EXPECT_EQ(reader.GetGameCount(), 3u);
+        EXPECT_EQ(reader.GetShot(2, 4).shot, 4);
+    }
+
+    // 末尾の不完全な試合は切り捨てられる
+    auto const size = std::filesystem::file_size(path_);
+    {
+        std::ofstream stream(path_, std::ios::binary | std::ios::app);
+        rec::GameRecordHeader header{};
+        header.magic = { 'D', 'C', 'G', 'H' };
+        header.shot_count = 10;
+        stream.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    }
+    {
+        rec::GameRecordReader reader(path_);
+        EXPECT_EQ(reader.GetGameCount(), 3u);
+    }
+    {
+        rec::GameRecordWriter writer(path_);
+        EXPECT_EQ(writer.GetGameCount(), 3u);
+        EXPECT_EQ(std::filesystem::file_size(path_), size);
+        EXPECT_EQ(std::filesystem::file_size(rec::GetGameRecordIndexPath(path_)), sizeof(rec::GameRecordIndexEntry) * 3);
+    }
+}
+
+TEST_F(GameRecord, InvalidFile)
+{
+    {
+        std::ofstream stream(path_, std::ios::binary);
+        stream << "not a game record file";
+    }
+    EXPECT_THROW(rec::GameRecordReader reader(path_), std::runtime_error);
+    EXPECT_THROW(rec::GameRecordWriter writer(path_), std::runtime_error);
+
+    rec::GameRecordWriter writer(rec::GetGameRecordIndexPath(path_).string() + ".new");
+    EXPECT_THROW(writer.AppendShot(rec::ShotRecord{}), std::logic_error);
+    EXPECT_THROW(writer.EndGame(std::nullopt), std::logic_error);
+    std::filesystem::remove(rec::GetGameRecordIndexPath(path_).string() + ".new");
+    std::filesystem::remove(rec::GetGameRecordIndexPath(rec::GetGameRecordIndexPath(path_).string() + ".new"));
+}
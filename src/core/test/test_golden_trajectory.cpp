@@ -0,0 +1,158 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "digitalcurling/digitalcurling.hpp"
+#include "digitalcurling/simulators/golden_trajectory.hpp"
+#include "toy_simulator.hpp"
+
+namespace dc = digitalcurling;
+namespace dcs = digitalcurling::simulators;
+
+namespace {
+
+using digitalcurling::test::ToySimulatorFactory;
+
+// 投げたストーンの正面に2個のストーンを縦に並べ, 正面から当てるショット
+dcs::GoldenShot MakePileupShot()
+{
+    dcs::GoldenShot shot;
+    shot.name = "pileup";
+    shot.category = "pileup";
+    shot.stones.positions[8] = dc::Vector2(0.f, 0.6f);
+    shot.stones.positions[9] = dc::Vector2(0.f, 0.95f);
+    shot.shot = dc::moves::Shot(1.f, 0.f, 1.5707963f);
+    shot.shot_stone_index = 0;
+    return shot;
+}
+
+} // unnamed namespace
+
+TEST(GoldenTrajectory, Score)
+{
+    dcs::GoldenBoard board;
+    EXPECT_EQ(0, dcs::ComputeGoldenScore(board));
+
+    board.positions[0] = dc::coordinate::kTee;
+    board.positions[1] = dc::Vector2(0.3f, dc::coordinate::kTeeLineY);
+    board.positions[8] = dc::Vector2(0.f, dc::coordinate::kTeeLineY + 1.f);
+    board.positions[2] = dc::Vector2(0.f, dc::coordinate::kTeeLineY + 1.5f);  // 相手のストーンより外側
+    board.positions[3] = dc::Vector2(0.f, 20.f);  // ハウスの外
+    EXPECT_EQ(2, dcs::ComputeGoldenScore(board));
+
+    board.positions[9] = dc::Vector2(0.f, dc::coordinate::kTeeLineY - 0.01f);
+    board.positions[0] = std::nullopt;
+    EXPECT_EQ(-1, dcs::ComputeGoldenScore(board));
+}
+
+TEST(GoldenTrajectory, Compare)
+{
+    dcs::GoldenTrajectory reference;
+    reference.final_board.positions[0] = dc::coordinate::kTee;
+    reference.final_board.positions[8] = dc::Vector2(1.f, dc::coordinate::kTeeLineY);
+    reference.collisions = { { 0, 8, 10 }, { 8, 9, 20 } };
+
+    dcs::GoldenTolerance const tolerance;
+    {
+        auto const result = dcs::CompareGoldenTrajectory(reference, reference, tolerance);
+        EXPECT_TRUE(result.passed);
+        EXPECT_EQ(0.f, result.max_position_error);
+        EXPECT_FALSE(result.collision_mismatch_index.has_value());
+    }
+    {
+        auto candidate = reference;
+        candidate.final_board.positions[8]->x += 0.02f;
+        candidate.collisions[1].frame = 25;  // 発生フレームの違いは不一致としない
+        auto const result = dcs::CompareGoldenTrajectory(reference, candidate, tolerance);
+        EXPECT_FALSE(result.passed);
+        EXPECT_NEAR(0.02f, result.max_position_error, 1e-5f);
+        EXPECT_NEAR(0.01f, result.mean_position_error, 1e-5f);
+        EXPECT_EQ(1, result.reference_score);
+        EXPECT_EQ(1, result.candidate_score);
+        EXPECT_FALSE(result.collision_mismatch_index.has_value());
+    }
+    {
+        auto candidate = reference;
+        candidate.final_board.positions[0] = std::nullopt;
+        std::swap(candidate.collisions[0], candidate.collisions[1]);
+        auto const result = dcs::CompareGoldenTrajectory(reference, candidate, tolerance);
+        EXPECT_FALSE(result.passed);
+        EXPECT_EQ(1u, result.presence_mismatches);
+        EXPECT_EQ(-1, result.candidate_score);
+        ASSERT_TRUE(result.collision_mismatch_index.has_value());
+        EXPECT_EQ(0u, *result.collision_mismatch_index);
+    }
+    {
+        auto candidate = reference;
+        candidate.collisions.pop_back();
+        auto const result = dcs::CompareGoldenTrajectory(reference, candidate, dcs::GoldenTolerance{ 0.01f, false, true });
+        EXPECT_TRUE(result.passed);
+        ASSERT_TRUE(result.collision_mismatch_index.has_value());
+        EXPECT_EQ(1u, *result.collision_mismatch_index);
+    }
+}
+
+TEST(GoldenTrajectory, RunShot)
+{
+    ToySimulatorFactory factory;
+    auto simulator = factory.CreateSimulator();
+    auto const trajectory = dcs::RunGoldenShot(*simulator, MakePileupShot(), 4.75f);
+
+    // 接触が複数フレーム続いても1回の衝突として数える
+    ASSERT_EQ(2u, trajectory.collisions.size());
+    EXPECT_EQ(0, trajectory.collisions[0].a);
+    EXPECT_EQ(8, trajectory.collisions[0].b);
+    EXPECT_EQ(8, trajectory.collisions[1].a);
+    EXPECT_EQ(9, trajectory.collisions[1].b);
+    EXPECT_LT(trajectory.collisions[0].frame, trajectory.collisions[1].frame);
+    EXPECT_GT(trajectory.frames, trajectory.collisions[1].frame);
+    EXPECT_TRUE(trajectory.final_board.positions[0].has_value());
+    EXPECT_GT(trajectory.final_board.positions[9]->y, 0.95f);
+
+    // シートの外に出たストーンは取り除かれる
+    dcs::GoldenShot wide;
+    wide.shot = dc::moves::Shot(1.f, 0.f, 0.f);
+    auto const out = dcs::RunGoldenShot(*simulator, wide, 1.f);
+    EXPECT_FALSE(out.final_board.positions[0].has_value());
+}
+
+TEST(GoldenTrajectory, Corpus)
+{
+    dcs::GoldenCorpus corpus;
+    corpus.shots.push_back(MakePileupShot());
+
+    ToySimulatorFactory baseline;
+    ToySimulatorFactory candidate;
+    candidate.friction = 0.98f;
+
+    // 基準の結果が無い場合は baseline が必要
+    EXPECT_THROW(dcs::RunGoldenCorpus(corpus, candidate, nullptr, dcs::GoldenTolerance()), std::invalid_argument);
+
+    auto const same = dcs::RunGoldenCorpus(corpus, baseline, &baseline, dcs::GoldenTolerance());
+    EXPECT_TRUE(same.Passed());
+    EXPECT_GT(same.GetSpeedup(), 0.);
+
+    dcs::UpdateGoldenReferences(corpus, baseline);
+    ASSERT_TRUE(corpus.shots[0].reference.has_value());
+    EXPECT_EQ(0.99f, corpus.reference_factory.at("friction").get<float>());
+
+    // JSON で保存した基準の結果で比較できる
+    auto const loaded = nlohmann::json(corpus).get<dcs::GoldenCorpus>();
+    ASSERT_EQ(1u, loaded.shots.size());
+    EXPECT_EQ(corpus.shots[0].reference->collisions.size(), loaded.shots[0].reference->collisions.size());
+
+    auto const report = dcs::RunGoldenCorpus(loaded, candidate, nullptr, dcs::GoldenTolerance());
+    EXPECT_FALSE(report.Passed());
+    EXPECT_EQ(0., report.GetSpeedup());
+    EXPECT_GT(report.shots[0].max_position_error, 0.01f);
+
+    auto const json = nlohmann::json(report);
+    EXPECT_FALSE(json.at("passed").get<bool>());
+    EXPECT_EQ("pileup", json.at("shots").at(0).at("name").get<std::string>());
+}
@@ -0,0 +1,263 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+    #include <sys/wait.h>
+    #include <unistd.h>
+#endif
+
+#include <gtest/gtest.h>
+#include "digitalcurling/digitalcurling.hpp"
+#include "digitalcurling/detail/mapped_file.hpp"
+#include "digitalcurling/simulators/persistent_outcome_cache.hpp"
+#include "toy_simulator.hpp"
+
+namespace dc = digitalcurling;
+namespace dcs = digitalcurling::simulators;
+
+namespace {
+
+using digitalcurling::test::ToySimulatorFactory;
+
+class PersistentOutcomeCache : public ::testing::Test {
+protected:
+    std::filesystem::path path_;
+
+    void SetUp() override
+    {
+        auto const* info = ::testing::UnitTest::GetInstance()->current_test_info();
+        path_ = std::filesystem::temp_directory_path() / (std::string("digitalcurling_test_") + info->name() + ".dcoc");
+        std::filesystem::remove(path_);
+    }
+    void TearDown() override { std::filesystem::remove(path_); }
+
+    // 投げたストーンの正面にストーンを1個置いた盤面
+    static dcs::ISimulator::AllStones MakeStones()
+    {
+        dcs::ISimulator::AllStones stones;
+        stones[8] = dcs::ISimulator::StoneState(dc::Vector2(0.f, 0.6f), 0.f, dc::Vector2(), 0.f);
+        return stones;
+    }
+
+    static dc::moves::Shot MakeShot(std::size_t i)
+    {
+        return dc::moves::Shot(0.8f + 0.01f * i, 0.f, 1.5707963f);
+    }
+
+    // キーが最初に調べるスロットの状態を, 書き込み中の状態に書き換える
+    void SetWritingState(dcs::ShotOutcomeKey const& key, std::size_t slot_count, std::uint32_t pid, std::uint32_t started) const
+    {
+        dc::detail::MappedFile file(path_, true);
+        auto* const slots = reinterpret_cast<dcs::PersistentOutcomeCacheSlot*>(file.mutable_data() + sizeof(dcs::PersistentOutcomeCacheHeader));
+        slots[key.hash & (slot_count - 1)].state.store((static_cast<std::uint64_t>(pid) << 32) | started);
+    }
+
+    static std::uint32_t NowSeconds()
+    {
+        return static_cast<std::uint32_t>(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+    }
+};
+
+} // unnamed namespace
+
+TEST_F(PersistentOutcomeCache, SharedBetweenInstances)
+{
+    ToySimulatorFactory factory;
+    dcs::ShotOutcomeCacheOptions const options;
+
+    // 1つ目のインスタンスでシミュレーションした結果を, 別にファイルを開いたインスタンスから参照できる
+    auto const store1 = std::make_shared<dcs::PersistentOutcomeCache>(path_, factory, options, 1000);
+    EXPECT_EQ(1024u, store1->GetSlotCount());
+    dcs::ShotOutcomeCache cache1(factory, options, store1);
+    auto const first = cache1.Simulate(MakeStones(), MakeShot(0), 0, 4.75f);
+    EXPECT_EQ(1u, store1->GetStats().insertions);
+
+    auto const store2 = std::make_shared<dcs::PersistentOutcomeCache>(path_, factory, options);
+    EXPECT_EQ(1024u, store2->GetSlotCount());  // 既存のファイルのスロット数を使用する
+    dcs::ShotOutcomeCache cache2(factory, options, store2);
+    auto const second = cache2.Simulate(MakeStones(), MakeShot(0), 0, 4.75f);
+    EXPECT_EQ(1u, cache2.GetStats().store_hits);
+    EXPECT_EQ(1u, store2->GetStats().hits);
+    EXPECT_EQ(0u, store2->GetStats().insertions);
+    EXPECT_EQ(1u, store2->GetStats().entries);
+
+    for (std::size_t i = 0; i < first.stones.size(); ++i) {
+        ASSERT_EQ(first.stones[i].has_value(), second.stones[i].has_value());
+        if (!first.stones[i]) continue;
+        EXPECT_EQ(first.stones[i]->position.x, second.stones[i]->position.x);
+        EXPECT_EQ(first.stones[i]->position.y, second.stones[i]->position.y);
+    }
+    EXPECT_EQ(first.collided_stones, second.collided_stones);
+    EXPECT_NE(0u, second.collided_stones);
+
+    // 2回目はメモリ上のキャッシュにある
+    cache2.Simulate(MakeStones(), MakeShot(0), 0, 4.75f);
+    EXPECT_EQ(1u, cache2.GetStats().hits);
+    EXPECT_EQ(1u, store2->GetStats().hits);
+}
+
+TEST_F(PersistentOutcomeCache, FingerprintMismatch)
+{
+    ToySimulatorFactory factory;
+    dcs::ShotOutcomeCacheOptions const options;
+    {
+        dcs::ShotOutcomeCache cache(factory, options, std::make_shared<dcs::PersistentOutcomeCache>(path_, factory, options));
+        cache.Simulate(MakeStones(), MakeShot(0), 0, 4.75f);
+    }
+
+    // ファクトリーの設定が異なる場合は新しいファイルに置き換えられる
+    ToySimulatorFactory changed;
+    changed.friction = 0.98f;
+    EXPECT_NE(dcs::MakeShotOutcomeFingerprint(factory, options), dcs::MakeShotOutcomeFingerprint(changed, options));
+    auto const store = std::make_shared<dcs::PersistentOutcomeCache>(path_, changed, options);
+    EXPECT_EQ(0u, store->GetStats().entries);
+    dcs::ShotOutcomeCache cache(changed, options, store);
+    cache.Simulate(MakeStones(), MakeShot(0), 0, 4.75f);
+    EXPECT_EQ(0u, cache.GetStats().store_hits);
+
+    // 量子化の設定もフィンガープリントに含まれる
+    auto exact = options;
+    exact.exact = true;
+    EXPECT_NE(dcs::MakeShotOutcomeFingerprint(factory, options), dcs::MakeShotOutcomeFingerprint(factory, exact));
+
+    // 形式が異なるファイルも置き換えられる
+    {
+        std::ofstream out(path_, std::ios::binary | std::ios::trunc);
+        out << "not a cache file";
+    }
+    dcs::PersistentOutcomeCache replaced(path_, factory, options, 64);
+    EXPECT_EQ(64u, replaced.GetSlotCount());
+    EXPECT_EQ(0u, replaced.GetStats().entries);
+}
+
+TEST_F(PersistentOutcomeCache, Full)
+{
+    ToySimulatorFactory factory;
+    dcs::ShotOutcomeCacheOptions const options;
+    dcs::ShotOutcomeCache keys(factory, options);
+    dcs::PersistentOutcomeCache store(path_, factory, options, 4);
+
+    dcs::ISimulator::AllStones const empty;
+    for (std::size_t i = 0; i < 6; ++i) store.Insert(keys.MakeKey(empty, MakeShot(i), 0, 0.f), dcs::ShotOutcome());
+    // 同じキーは追加しない
+    store.Insert(keys.MakeKey(empty, MakeShot(0), 0, 0.f), dcs::ShotOutcome());
+
+    auto const stats = store.GetStats();
+    EXPECT_EQ(4u, stats.insertions);
+    EXPECT_EQ(2u, stats.dropped);
+    EXPECT_EQ(4u, stats.entries);
+    EXPECT_TRUE(store.Find(keys.MakeKey(empty, MakeShot(0), 0, 0.f)).has_value());
+    EXPECT_THROW(dcs::PersistentOutcomeCache(path_, factory, options, 0), std::invalid_argument);
+}
+
+TEST_F(PersistentOutcomeCache, Concurrent)
+{
+    ToySimulatorFactory factory;
+    dcs::ShotOutcomeCacheOptions const options;
+    dcs::PersistentOutcomeCache(path_, factory, options);  // ファイルを作成しておく
+
+    // スレッドごとにファイルを開き, 同じ結果を同時に追加する
+    constexpr std::size_t kThreads = 4;
+    constexpr std::size_t kShots = 32;
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&] {
+            dcs::ShotOutcomeCache cache(factory, options, std::make_shared<dcs::PersistentOutcomeCache>(path_, factory, options));
+            for (std::size_t i = 0; i < kShots; ++i) cache.Simulate(MakeStones(), MakeShot(i), 0, 4.75f);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    dcs::PersistentOutcomeCache store(path_, factory, options);
+    EXPECT_GE(store.GetStats().entries, kShots);
+    dcs::ShotOutcomeCache cache(factory, options, std::make_shared<dcs::PersistentOutcomeCache>(path_, factory, options));
+    for (std::size_t i = 0; i < kShots; ++i) cache.Simulate(MakeStones(), MakeShot(i), 0, 4.75f);
+    EXPECT_EQ(kShots, cache.GetStats().store_hits);
+}
+
+#ifndef _WIN32
+TEST_F(PersistentOutcomeCache, ReclaimAbandonedSlot)
+{
+    ToySimulatorFactory factory;
+    dcs::ShotOutcomeCacheOptions const options;
+    dcs::ShotOutcomeCache keys(factory, options);
+    dcs::PersistentOutcomeCache store(path_, factory, options, 64);
+    dcs::ISimulator::AllStones const empty;
+    auto const key0 = keys.MakeKey(empty, MakeShot(0), 0, 0.f);
+    auto const key1 = keys.MakeKey(empty, MakeShot(1), 0, 0.f);
+    auto const key2 = keys.MakeKey(empty, MakeShot(2), 0, 0.f);
+
+    // 書き込みの途中で終了したプロセス
+    pid_t const child = fork();
+    ASSERT_NE(-1, child);
+    if (child == 0) {
+        SetWritingState(key0, store.GetSlotCount(), static_cast<std::uint32_t>(getpid()), NowSeconds());
+        _exit(0);
+    }
+    int status = 0;
+    ASSERT_EQ(child, waitpid(child, &status, 0));
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_FALSE(store.Find(key0).has_value());
+
+    // 終了したプロセスのスロットを引き継ぐ
+    store.Insert(key0, dcs::ShotOutcome());
+    EXPECT_TRUE(store.Find(key0).has_value());
+
+    // 存在するプロセスが書き込み中のスロットは, 書き込みを始めてから長い時間が経っていても引き継がない
+    auto const self = static_cast<std::uint32_t>(getpid());
+    SetWritingState(key1, store.GetSlotCount(), self, NowSeconds());
+    SetWritingState(key2, store.GetSlotCount(), self, NowSeconds() - 24 * 60 * 60);
+    store.Insert(key1, dcs::ShotOutcome());
+    store.Insert(key2, dcs::ShotOutcome());
+    EXPECT_TRUE(store.Find(key1).has_value());
+    EXPECT_TRUE(store.Find(key2).has_value());
+
+    auto const stats = store.GetStats();
+    EXPECT_EQ(3u, stats.insertions);
+    EXPECT_EQ(1u, stats.reclaimed);
+    EXPECT_EQ(0u, stats.dropped);
+    EXPECT_EQ(3u, stats.entries);
+}
+
+TEST_F(PersistentOutcomeCache, MultiProcess)
+{
+    ToySimulatorFactory factory;
+    dcs::ShotOutcomeCacheOptions const options;
+    dcs::PersistentOutcomeCache(path_, factory, options);  // ファイルを作成しておく
+
+    // 2つのプロセスが同じファイルに同じ結果を同時に追加する
+    constexpr std::size_t kShots = 32;
+    auto const simulate_all = [&] {
+        dcs::ShotOutcomeCache cache(factory, options, std::make_shared<dcs::PersistentOutcomeCache>(path_, factory, options));
+        for (std::size_t i = 0; i < kShots; ++i) cache.Simulate(MakeStones(), MakeShot(i), 0, 4.75f);
+    };
+    pid_t const child = fork();
+    ASSERT_NE(-1, child);
+    if (child == 0) {
+        simulate_all();
+        _exit(0);
+    }
+    simulate_all();
+    int status = 0;
+    ASSERT_EQ(child, waitpid(child, &status, 0));
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(0, WEXITSTATUS(status));
+
+    auto const store = std::make_shared<dcs::PersistentOutcomeCache>(path_, factory, options);
+    EXPECT_GE(store->GetStats().entries, kShots);
+    EXPECT_LE(store->GetStats().entries, 2 * kShots);
+    dcs::ShotOutcomeCache cache(factory, options, store);
+    for (std::size_t i = 0; i < kShots; ++i) cache.Simulate(MakeStones(), MakeShot(i), 0, 4.75f);
+    EXPECT_EQ(kShots, cache.GetStats().store_hits);
+}
+#endif
@@ -0,0 +1,198 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "digitalcurling/digitalcurling.hpp"
+#include "digitalcurling/simulators/shot_outcome_cache.hpp"
+#include "toy_simulator.hpp"
+
+namespace dc = digitalcurling;
+namespace dcs = digitalcurling::simulators;
+
+namespace {
+
+using digitalcurling::test::ToySimulatorFactory;
+
+// 投げたストーンの正面に2個のストーンを縦に並べた盤面
+dcs::ISimulator::AllStones MakePileupStones()
+{
+    dcs::ISimulator::AllStones stones;
+    stones[8] = dcs::ISimulator::StoneState(dc::Vector2(0.f, 0.6f), 0.f, dc::Vector2(), 0.f);
+    stones[9] = dcs::ISimulator::StoneState(dc::Vector2(0.f, 0.95f), 0.f, dc::Vector2(), 0.f);
+    return stones;
+}
+
+// 全てのストーンの有無と位置が一致するか
+bool SamePositions(dcs::ISimulator::AllStones const& a, dcs::ISimulator::AllStones const& b)
+{
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].has_value() != b[i].has_value()) return false;
+        if (a[i] && (a[i]->position.x != b[i]->position.x || a[i]->position.y != b[i]->position.y)) return false;
+    }
+    return true;
+}
+
+dc::moves::Shot const kStraightShot(1.f, 0.f, 1.5707963f);
+
+} // unnamed namespace
+
+TEST(ShotOutcomeCache, HitAndMiss)
+{
+    ToySimulatorFactory factory;
+    dcs::ShotOutcomeCache cache(factory);
+    auto const stones = MakePileupStones();
+
+    auto const first = cache.Simulate(stones, kStraightShot, 0, 4.75f);
+    auto const second = cache.Simulate(stones, kStraightShot, 0, 4.75f);
+    EXPECT_TRUE(SamePositions(first.stones, second.stones));
+
+    auto simulator = factory.CreateSimulator();
+    auto const direct = dcs::SimulateShotOutcome(*simulator, stones, kStraightShot, 0, 4.75f);
+    EXPECT_TRUE(SamePositions(direct.stones, first.stones));
+
+    // 衝突したストーンが記録される
+    EXPECT_EQ((1u << 0) | (1u << 8) | (1u << 9), first.collided_stones);
+    EXPECT_EQ(first.collided_stones, second.collided_stones);
+
+    auto const stats = cache.GetStats();
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(1u, stats.misses);
+    EXPECT_EQ(1u, stats.insertions);
+    EXPECT_EQ(1u, stats.entries);
+    EXPECT_DOUBLE_EQ(0.5, stats.GetHitRate());
+
+    // シートの幅, ショットのストーンのインデックスが異なる場合は別の結果
+    cache.Simulate(stones, kStraightShot, 1, 4.75f);
+    cache.Simulate(stones, kStraightShot, 0, 0.f);
+    EXPECT_EQ(3u, cache.GetStats().misses);
+
+    cache.Clear();
+    EXPECT_EQ(0u, cache.GetStats().entries);
+    EXPECT_EQ(0u, cache.GetStats().hits);
+
+    EXPECT_THROW(cache.Simulate(stones, kStraightShot, dc::StoneCoordinate::kStoneMax, 4.75f), std::out_of_range);
+}
+
+TEST(ShotOutcomeCache, Quantization)
+{
+    ToySimulatorFactory factory;
+    auto stones = MakePileupStones();
+    auto nearby = stones;
+    nearby[8]->position.x += 0.0002f;
+    dc::moves::Shot const nearby_shot(kStraightShot.translational_velocity + 0.0002f, kStraightShot.angular_velocity, kStraightShot.release_angle);
+
+    dcs::ShotOutcomeCache cache(factory);
+    EXPECT_EQ(cache.MakeKey(stones, kStraightShot, 0, 4.75f), cache.MakeKey(nearby, nearby_shot, 0, 4.75f));
+    // ショットのストーンのインデックスにあるストーンは無視する
+    nearby[0] = dcs::ISimulator::StoneState(dc::Vector2(1.f, 1.f), 0.f, dc::Vector2(), 0.f);
+    EXPECT_EQ(cache.MakeKey(stones, kStraightShot, 0, 4.75f), cache.MakeKey(nearby, nearby_shot, 0, 4.75f));
+
+    auto moved = stones;
+    moved[8]->position.x += 0.002f;
+    EXPECT_NE(cache.MakeKey(stones, kStraightShot, 0, 4.75f), cache.MakeKey(moved, kStraightShot, 0, 4.75f));
+    auto removed = stones;
+    removed[9] = std::nullopt;
+    EXPECT_NE(cache.MakeKey(stones, kStraightShot, 0, 4.75f), cache.MakeKey(removed, kStraightShot, 0, 4.75f));
+
+    cache.Simulate(stones, kStraightShot, 0, 4.75f);
+    cache.Simulate(nearby, nearby_shot, 0, 4.75f);
+    EXPECT_EQ(1u, cache.GetStats().hits);
+
+    // 完全一致モードでは分解能以内の差も区別する
+    dcs::ShotOutcomeCacheOptions options;
+    options.exact = true;
+    dcs::ShotOutcomeCache exact(factory, options);
+    EXPECT_NE(exact.MakeKey(stones, kStraightShot, 0, 4.75f), exact.MakeKey(stones, nearby_shot, 0, 4.75f));
+    exact.Simulate(stones, kStraightShot, 0, 4.75f);
+    exact.Simulate(stones, nearby_shot, 0, 4.75f);
+    exact.Simulate(stones, kStraightShot, 0, 4.75f);
+    EXPECT_EQ(1u, exact.GetStats().hits);
+    EXPECT_EQ(2u, exact.GetStats().misses);
+}
+
+TEST(ShotOutcomeCache, Eviction)
+{
+    ToySimulatorFactory factory;
+    dcs::ShotOutcomeCacheOptions options;
+    options.capacity = 2;
+    options.shards = 1;
+    dcs::ShotOutcomeCache cache(factory, options);
+
+    dcs::ISimulator::AllStones const empty;
+    auto const a = cache.MakeKey(empty, dc::moves::Shot(1.f, 0.f, 1.5f), 0, 0.f);
+    auto const b = cache.MakeKey(empty, dc::moves::Shot(1.1f, 0.f, 1.5f), 0, 0.f);
+    auto const c = cache.MakeKey(empty, dc::moves::Shot(1.2f, 0.f, 1.5f), 0, 0.f);
+    cache.Insert(a, dcs::ShotOutcome());
+    cache.Insert(b, dcs::ShotOutcome());
+    EXPECT_TRUE(cache.Find(a).has_value());  // a を最近使用したものにする
+    cache.Insert(c, dcs::ShotOutcome());
+
+    EXPECT_TRUE(cache.Find(a).has_value());
+    EXPECT_FALSE(cache.Find(b).has_value());
+    EXPECT_TRUE(cache.Find(c).has_value());
+
+    auto const stats = cache.GetStats();
+    EXPECT_EQ(1u, stats.evictions);
+    EXPECT_EQ(2u, stats.entries);
+    EXPECT_EQ(3u, stats.insertions);
+
+    auto const json = nlohmann::json(stats);
+    EXPECT_EQ(1u, json.at("evictions").get<std::uint64_t>());
+}
+
+TEST(ShotOutcomeCache, Concurrent)
+{
+    ToySimulatorFactory factory;
+    dcs::ShotOutcomeCacheOptions options;
+    options.shards = 4;
+    dcs::ShotOutcomeCache cache(factory, options);
+    auto const stones = MakePileupStones();
+
+    constexpr std::size_t kThreads = 4;
+    constexpr std::size_t kShots = 8;
+    constexpr std::size_t kRounds = 10;
+    std::vector<dcs::ShotOutcome> expected;
+    auto simulator = factory.CreateSimulator();
+    for (std::size_t i = 0; i < kShots; ++i) {
+        expected.push_back(dcs::SimulateShotOutcome(*simulator, stones, dc::moves::Shot(0.8f + 0.05f * i, 0.f, 1.5707963f), 0, 4.75f));
+    }
+
+    std::vector<std::thread> threads;
+    std::vector<int> mismatches(kThreads, 0);
+    for (std::size_t t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            for (std::size_t r = 0; r < kRounds; ++r) {
+                for (std::size_t i = 0; i < kShots; ++i) {
+                    auto const outcome = cache.Simulate(stones, dc::moves::Shot(0.8f + 0.05f * i, 0.f, 1.5707963f), 0, 4.75f);
+                    if (!SamePositions(outcome.stones, expected[i].stones)) ++mismatches[t];
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    for (auto const m : mismatches) EXPECT_EQ(0, m);
+    auto const stats = cache.GetStats();
+    EXPECT_EQ(kThreads * kRounds * kShots, stats.hits + stats.misses);
+    EXPECT_EQ(kShots, stats.entries);
+    EXPECT_GE(stats.misses, kShots);
+}
+
+TEST(ShotOutcomeCache, InvalidOptions)
+{
+    ToySimulatorFactory factory;
+    dcs::ShotOutcomeCacheOptions options;
+    options.shards = 0;
+    EXPECT_THROW(dcs::ShotOutcomeCache(factory, options), std::invalid_argument);
+
+    options = dcs::ShotOutcomeCacheOptions();
+    options.position_resolution = 0.f;
+    EXPECT_THROW(dcs::ShotOutcomeCache(factory, options), std::invalid_argument);
+    options.exact = true;  // 完全一致モードでは分解能を使用しない
+    EXPECT_NO_THROW(dcs::ShotOutcomeCache(factory, options));
+}
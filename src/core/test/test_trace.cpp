@@ -0,0 +1,104 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "digitalcurling/trace.hpp"
+
+namespace dct = digitalcurling::trace;
+
+TEST(Trace, Disabled)
+{
+    dct::Stop();
+    EXPECT_FALSE(dct::IsEnabled());
+    {
+        DIGITALCURLING_TRACE_SCOPE("test", "disabled");
+    }
+    dct::Record("test", "disabled", dct::Now(), 1);
+    EXPECT_TRUE(dct::Stop().empty());
+}
+
+TEST(Trace, MultiThread)
+{
+    constexpr int kThreads = 4;
+    constexpr int kEventsPerThread = 100;
+
+    dct::Start();
+    EXPECT_TRUE(dct::IsEnabled());
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < kEventsPerThread; ++i) {
+                DIGITALCURLING_TRACE_SCOPE("test", "work");
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    {
+        DIGITALCURLING_TRACE_SCOPE("test", "main");
+    }
+
+    auto const events = dct::Stop();
+    EXPECT_FALSE(dct::IsEnabled());
+    ASSERT_EQ(std::size_t(kThreads * kEventsPerThread + 1), events.size());
+
+    std::set<std::uint32_t> tids;
+    for (auto const& event : events) {
+        EXPECT_EQ("X", event.at("ph").get<std::string>());
+        EXPECT_EQ("test", event.at("cat").get<std::string>());
+        EXPECT_GE(event.at("dur").get<double>(), 0.);
+        tids.insert(event.at("tid").get<std::uint32_t>());
+    }
+    EXPECT_GE(tids.size(), 2u);
+
+    // 取得済みのイベントは再度取得されない
+    EXPECT_TRUE(dct::Stop().empty());
+}
+
+TEST(Trace, Dropped)
+{
+    dct::Start(4);
+    for (int i = 0; i < 10; ++i) {
+        DIGITALCURLING_TRACE_SCOPE("test", "overflow");
+    }
+    auto const events = dct::Stop();
+    ASSERT_EQ(5u, events.size());
+    auto const& counter = events.back();
+    EXPECT_EQ("C", counter.at("ph").get<std::string>());
+    EXPECT_EQ(6u, counter.at("args").at("count").get<std::uint64_t>());
+
+    // 新しい記録では以前のイベントとバッファの容量を引き継がない
+    dct::Start();
+    {
+        DIGITALCURLING_TRACE_SCOPE("test", "restart");
+    }
+    auto const restarted = dct::Stop();
+    ASSERT_EQ(1u, restarted.size());
+    EXPECT_EQ("restart", restarted[0].at("name").get<std::string>());
+}
+
+TEST(Trace, WriteFile)
+{
+    dct::Start();
+    {
+        DIGITALCURLING_TRACE_SCOPE("test", "write");
+    }
+    auto const path = std::filesystem::temp_directory_path() / "digitalcurling_test_trace.json";
+    dct::WriteTraceFile(path, dct::Stop());
+
+    std::ifstream file(path);
+    auto const json = nlohmann::json::parse(file);
+    file.close();
+    std::filesystem::remove(path);
+
+    ASSERT_EQ(1u, json.at("traceEvents").size());
+    EXPECT_EQ("write", json.at("traceEvents").at(0).at("name").get<std::string>());
+    EXPECT_EQ("ns", json.at("displayTimeUnit").get<std::string>());
+}
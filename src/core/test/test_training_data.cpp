@@ -0,0 +1,149 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "digitalcurling/digitalcurling.hpp"
+#include "digitalcurling/records/training_data_reader.hpp"
+#include "digitalcurling/records/training_data_writer.hpp"
+
+namespace dc = digitalcurling;
+namespace rec = digitalcurling::records;
+
+namespace {
+
+class TrainingData : public ::testing::Test {
+protected:
+    std::filesystem::path path_;
+
+    void SetUp() override
+    {
+        auto const* info = ::testing::UnitTest::GetInstance()->current_test_info();
+        path_ = std::filesystem::temp_directory_path() / (std::string("digitalcurling_test_") + info->name() + ".dctd");
+        std::filesystem::remove(path_);
+    }
+    void TearDown() override { std::filesystem::remove(path_); }
+
+    // 要素 `i` の盤面を決定的に作成する (インデックス i % 16 のストーンのみ)
+    static dc::simulators::ISimulator::AllStones MakeStones(std::size_t i, float y)
+    {
+        dc::simulators::ISimulator::AllStones stones;
+        stones[i % 16] = dc::simulators::ISimulator::StoneState(dc::Vector2(0.01f * i, y), 0.f, dc::Vector2(), 0.f);
+        return stones;
+    }
+};
+
+} // unnamed namespace
+
+TEST_F(TrainingData, Schema)
+{
+    auto const& schema = rec::GetTrainingDataSchema();
+    EXPECT_EQ(schema[static_cast<std::size_t>(rec::TrainingDataColumnId::kBefore)].GetName(), "before");
+    EXPECT_EQ(schema[static_cast<std::size_t>(rec::TrainingDataColumnId::kBefore)].width, 48u);
+    EXPECT_EQ(schema[static_cast<std::size_t>(rec::TrainingDataColumnId::kShot)].GetName(), "shot");
+    EXPECT_EQ(schema[static_cast<std::size_t>(rec::TrainingDataColumnId::kMirrored)].type, rec::TrainingDataType::kUInt8);
+}
+
+TEST_F(TrainingData, WriteAndRead)
+{
+    dc::GameSetting setting;
+    dc::GameState before(setting);
+    before.end = 3;
+    before.shot = 5;
+    dc::GameState after = before;
+    after.stones = dc::StoneCoordinate(std::array<std::optional<dc::Stone>, dc::StoneCoordinate::kStoneMax>{
+        dc::Stone(dc::Vector2(0.5f, 38.f), 0.f) });
+    dc::moves::Shot const shot(2.3f, 1.57f, 0.1f);
+
+    {
+        rec::TrainingDataWriter writer(path_);
+        rec::TrainingDataChunk chunk(true);
+        chunk.Add(before, shot, after);
+        EXPECT_EQ(chunk.GetRowCount(), 2u);
+        writer.WriteChunk(chunk);
+        EXPECT_EQ(chunk.GetRowCount(), 0u);
+        EXPECT_EQ(writer.GetRowCount(), 2u);
+    }
+
+    rec::TrainingDataReader reader(path_);
+    ASSERT_EQ(reader.GetRowCount(), 2u);
+    ASSERT_EQ(reader.GetChunkCount(), 1u);
+    ASSERT_EQ(reader.GetColumns().size(), rec::kTrainingDataColumnCount);
+
+    auto const after_column = *reader.FindColumn("after");
+    auto const* boards = reader.GetColumnData<float>(0, after_column);
+    EXPECT_EQ(boards[0], 0.5f);
+    EXPECT_EQ(boards[1], 38.f);
+    EXPECT_EQ(boards[2], 1.f);
+    EXPECT_EQ(boards[3 * 5 + 2], 0.f);
+    EXPECT_EQ(boards[48 + 0], -0.5f); // 左右反転
+    EXPECT_EQ(boards[48 + 1], 38.f);
+
+    auto const shots = reader.ReadColumn<float>(*reader.FindColumn("shot"));
+    ASSERT_EQ(shots.size(), 6u);
+    EXPECT_EQ(shots[0], 2.3f);
+    EXPECT_EQ(shots[1], 1.57f);
+    EXPECT_EQ(shots[2], 0.1f);
+    EXPECT_EQ(shots[4], -1.57f);
+    EXPECT_FLOAT_EQ(shots[5], 3.14159265f - 0.1f);
+
+    EXPECT_EQ(reader.ReadColumn<std::uint8_t>(*reader.FindColumn("end")), (std::vector<std::uint8_t>{ 3, 3 }));
+    EXPECT_EQ(reader.ReadColumn<std::uint8_t>(*reader.FindColumn("shot_number")), (std::vector<std::uint8_t>{ 5, 5 }));
+    EXPECT_EQ(reader.ReadColumn<std::uint8_t>(*reader.FindColumn("mirrored")), (std::vector<std::uint8_t>{ 0, 1 }));
+
+    EXPECT_FALSE(reader.FindColumn("unknown").has_value());
+    EXPECT_THROW(reader.GetColumnData<std::uint8_t>(0, after_column), std::invalid_argument);
+    EXPECT_THROW(reader.GetColumnData<float>(1, after_column), std::out_of_range);
+}
+
+TEST_F(TrainingData, WriteBatch)
+{
+    std::size_t const count = 1000;
+    std::vector<dc::simulators::ISimulator::AllStones> before, after;
+    std::vector<dc::moves::Shot> shots;
+    for (std::size_t i = 0; i < count; ++i) {
+        before.push_back(MakeStones(i, 30.f));
+        shots.emplace_back(2.f, 1.57f, 0.001f * i);
+        after.push_back(MakeStones(i, 38.f));
+    }
+
+    {
+        rec::TrainingDataWriter writer(path_);
+        writer.WriteBatch(before, shots, after, false, 4, 64);
+        EXPECT_EQ(writer.GetRowCount(), count);
+        EXPECT_THROW(writer.WriteBatch(before, shots, {}), std::invalid_argument);
+    }
+
+    // チャンクの順序はスレッドに依存するため, ショットの角度から要素を特定する
+    rec::TrainingDataReader reader(path_);
+    ASSERT_EQ(reader.GetRowCount(), count);
+    EXPECT_EQ(reader.GetChunkCount(), 16u);
+    auto const shot_values = reader.ReadColumn<float>(*reader.FindColumn("shot"));
+    auto const after_values = reader.ReadColumn<float>(*reader.FindColumn("after"));
+    std::vector<bool> seen(count);
+    for (std::size_t row = 0; row < count; ++row) {
+        auto const i = static_cast<std::size_t>(std::lround(shot_values[row * 3 + 2] / 0.001f));
+        ASSERT_LT(i, count);
+        seen[i] = true;
+        EXPECT_EQ(after_values[row * 48 + (i % 16) * 3 + 0], 0.01f * i);
+        EXPECT_EQ(after_values[row * 48 + (i % 16) * 3 + 1], 38.f);
+    }
+    EXPECT_EQ(std::count(seen.begin(), seen.end(), true), static_cast<std::ptrdiff_t>(count));
+}
+
+TEST_F(TrainingData, InvalidFile)
+{
+    {
+        std::ofstream stream(path_, std::ios::binary);
+        stream << "not a training data file";
+    }
+    EXPECT_THROW(rec::TrainingDataReader reader(path_), std::runtime_error);
+}
@@ -0,0 +1,82 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "digitalcurling/digitalcurling.hpp"
+
+namespace digitalcurling::test {
+
+// 一定の割合で減速し, 接触したストーンどうしが速度を交換するだけの簡易シミュレーター
+class ToySimulatorFactory : public simulators::ISimulatorFactory {
+public:
+    float friction = 0.99f;
+
+    virtual const char* GetId() const noexcept override { return "toy"; }
+    virtual nlohmann::json ToJson() const override { return { { "type", "toy" }, { "friction", friction } }; }
+    virtual std::unique_ptr<simulators::ISimulator> CreateSimulator() const override;
+    virtual std::unique_ptr<simulators::ISimulatorFactory> Clone() const override { return std::make_unique<ToySimulatorFactory>(*this); }
+};
+
+class ToySimulator : public simulators::ISimulator {
+public:
+    explicit ToySimulator(ToySimulatorFactory const& factory) : factory_(factory) {}
+
+    virtual const char* GetId() const noexcept override { return "toy"; }
+    virtual void SetStones(AllStones const& stones) override { stones_ = stones; }
+    virtual void Step() override
+    {
+        constexpr float kSecondsPerFrame = 0.01f;
+        collisions_.clear();
+        for (auto& stone : stones_) {
+            if (!stone) continue;
+            stone->position += stone->translational_velocity * kSecondsPerFrame;
+            stone->translational_velocity *= factory_.friction;
+            if (stone->translational_velocity.Length() < 0.01f) stone->translational_velocity = digitalcurling::Vector2();
+        }
+        for (std::uint8_t i = 0; i < stones_.size(); ++i) {
+            for (std::uint8_t j = i + 1; j < stones_.size(); ++j) {
+                if (!stones_[i] || !stones_[j]) continue;
+                auto const& a = *stones_[i];
+                auto const& b = *stones_[j];
+                auto const delta = b.position - a.position;
+                if (delta.Length() >= 2.f * digitalcurling::Stone::kRadius) continue;
+                auto const relative = b.translational_velocity - a.translational_velocity;
+                if (delta.x * relative.x + delta.y * relative.y < 0.f)
+                    std::swap(stones_[i]->translational_velocity, stones_[j]->translational_velocity);
+                collisions_.emplace_back(Collision::CollisionStone(i, *stones_[i]), Collision::CollisionStone(j, *stones_[j]), 1.f, 0.f);
+            }
+        }
+    }
+    virtual AllStones const& GetStones() const override { return stones_; }
+    virtual std::vector<Collision> const& GetCollisions() const override { return collisions_; }
+    virtual bool AreAllStonesStopped() const override
+    {
+        for (auto const& stone : stones_) {
+            if (stone && stone->translational_velocity.Length() > 0.f) return false;
+        }
+        return true;
+    }
+    virtual float GetSecondsPerFrame() const override { return 0.01f; }
+    virtual simulators::ISimulatorFactory const& GetFactory() const override { return factory_; }
+    virtual std::unique_ptr<simulators::ISimulatorStorage> CreateStorage() const override { throw std::logic_error("not supported"); }
+    virtual void Save(simulators::ISimulatorStorage&) const override { throw std::logic_error("not supported"); }
+    virtual void Load(simulators::ISimulatorStorage const&) override { throw std::logic_error("not supported"); }
+
+private:
+    ToySimulatorFactory factory_;
+    AllStones stones_;
+    std::vector<Collision> collisions_;
+};
+
+inline std::unique_ptr<simulators::ISimulator> ToySimulatorFactory::CreateSimulator() const
+{
+    return std::make_unique<ToySimulator>(*this);
+}
+
+} // namespace digitalcurling::test
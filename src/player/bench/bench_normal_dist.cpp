@@ -0,0 +1,70 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+// プレイヤー NormalDist のベンチマーク
+
+#include <memory>
+#include <benchmark/benchmark.h>
+#include "digitalcurling/digitalcurling.hpp"
+#include "../src/normal_dist/player_normal_dist.hpp"
+#include "../src/normal_dist/player_normal_dist_factory.hpp"
+
+namespace {
+
+using namespace digitalcurling;
+using namespace digitalcurling::players;
+
+// サンプリング方式ごとに Play のコストを計測する
+void BM_NormalDistPlay(benchmark::State& bm)
+{
+    PlayerNormalDistFactory factory;
+    factory.sampling = static_cast<PlayerNormalDistSampling>(bm.range(0));
+    auto player = factory.CreatePlayer();
+    moves::Shot const shot(2.3f, 1.57f, 1.6f);
+    for (auto _ : bm) {
+        auto result = player->Play(shot);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_NormalDistPlay)
+    ->Arg(static_cast<int>(PlayerNormalDistSampling::kPseudoRandom))
+    ->Arg(static_cast<int>(PlayerNormalDistSampling::kHalton))
+    ->Arg(static_cast<int>(PlayerNormalDistSampling::kAntithetic))
+    ->Arg(static_cast<int>(PlayerNormalDistSampling::kStratified));
+
+void BM_NormalDistCreateStorage(benchmark::State& bm)
+{
+    PlayerNormalDistFactory factory;
+    auto player = factory.CreatePlayer();
+    for (auto _ : bm) {
+        auto storage = player->CreateStorage();
+        benchmark::DoNotOptimize(storage);
+    }
+}
+BENCHMARK(BM_NormalDistCreateStorage);
+
+void BM_NormalDistSave(benchmark::State& bm)
+{
+    PlayerNormalDistFactory factory;
+    auto player = factory.CreatePlayer();
+    auto storage = player->CreateStorage();
+    for (auto _ : bm) {
+        player->Save(*storage);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_NormalDistSave);
+
+void BM_NormalDistLoad(benchmark::State& bm)
+{
+    PlayerNormalDistFactory factory;
+    auto player = factory.CreatePlayer();
+    auto const storage = player->CreateStorage();
+    for (auto _ : bm) {
+        player->Load(*storage);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_NormalDistLoad);
+
+} // unnamed namespace
@@ -0,0 +1,222 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "normal_dist_sampler.hpp"
+
+namespace digitalcurling::players {
+
+namespace {
+
+// (0, 1) の一様乱数
+// 標準ライブラリの分布は実装依存のため, 保存した状態の再現性を保つよう直接エンジンの出力を使う
+double Uniform(std::mt19937 & engine)
+{
+    return (static_cast<double>(engine()) + 0.5) / 4294967296.0;
+}
+
+// [0, n) の一様整数乱数
+std::uint32_t UniformIndex(std::mt19937 & engine, std::uint32_t n)
+{
+    return static_cast<std::uint32_t>(Uniform(engine) * n) % n;
+}
+
+std::vector<std::uint32_t> RandomPermutation(std::mt19937 & engine, std::uint32_t n)
+{
+    std::vector<std::uint32_t> perm(n);
+    std::iota(perm.begin(), perm.end(), 0u);
+    for (std::uint32_t i = n; i > 1; --i) {
+        std::swap(perm[i - 1], perm[UniformIndex(engine, i)]);
+    }
+    return perm;
+}
+
+// 標準正規分布の逆累積分布関数 (Acklam の有理近似, 相対誤差 1.15e-9 以下)
+double InverseNormalCdf(double p)
+{
+    static constexpr double a[] = {
+        -3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+        1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00 };
+    static constexpr double b[] = {
+        -5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+        6.680131188771972e+01, -1.328068155288572e+01 };
+    static constexpr double c[] = {
+        -7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+        -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00 };
+    static constexpr double d[] = {
+        7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+        3.754408661907416e+00 };
+    static constexpr double kLow = 0.02425;
+    static constexpr double kHigh = 1.0 - kLow;
+
+    p = std::clamp(p, 1e-12, 1.0 - 1e-12);
+
+    if (p < kLow) {
+        double const q = std::sqrt(-2.0 * std::log(p));
+        return (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+               ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    }
+    if (p > kHigh) {
+        double const q = std::sqrt(-2.0 * std::log(1.0 - p));
+        return -(((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+                ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    }
+    double const q = p - 0.5;
+    double const r = q * q;
+    return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+           (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+}
+
+// 桁置換によりスクランブルした radical inverse
+// 先頭のゼロ桁にも置換を適用し, 最下位桁以下は一様乱数 `jitter` で埋める
+double ScrambledRadicalInverse(
+    std::uint32_t i, std::uint32_t base, std::vector<std::uint32_t> const& perm, int digits, double jitter)
+{
+    double const inv_base = 1.0 / base;
+    double f = inv_base;
+    double r = 0.0;
+    for (int k = 0; k < digits; ++k) {
+        r += perm[i % base] * f;
+        i /= base;
+        f *= inv_base;
+    }
+    return r + jitter * f * base;
+}
+
+} // unnamed namespace
+
+
+NormalDistSampler::NormalDistSampler(PlayerNormalDistSampling sampling, std::uint32_t block_size)
+    : sampling_(sampling)
+    , block_size_(block_size)
+    , data_()
+{
+    // 擬似乱数ではブロックを生成しないため, ブロックサイズを使用しない
+    if (sampling_ != PlayerNormalDistSampling::kPseudoRandom && block_size_ == 0) {
+        throw std::invalid_argument("block_size must be greater than 0");
+    }
+}
+
+std::array<float, 2> NormalDistSampler::Next(std::mt19937 & engine)
+{
+    if (data_.index >= data_.block.size()) {
+        GenerateBlock(engine);
+    }
+    return data_.block[data_.index++];
+}
+
+NormalDistSamplerData NormalDistSampler::Save() const
+{
+    return data_;
+}
+
+void NormalDistSampler::Load(NormalDistSamplerData const& data)
+{
+    data_ = data;
+}
+
+void NormalDistSampler::GenerateBlock(std::mt19937 & engine)
+{
+    std::uint32_t const n = block_size_;
+    data_.index = 0;
+    data_.block.resize(n);
+
+    switch (sampling_) {
+        case PlayerNormalDistSampling::kHalton: {
+            // 2 次元なので基数 2, 3 の Halton 列で足りる
+            // ブロックごとに開始位置と桁置換を取り直して独立にランダム化する
+            auto const perm2 = RandomPermutation(engine, 2);
+            auto const perm3 = RandomPermutation(engine, 3);
+            std::uint32_t const offset = UniformIndex(engine, 1u << 16);
+            for (std::uint32_t k = 0; k < n; ++k) {
+                double const u0 = ScrambledRadicalInverse(offset + k, 2, perm2, 24, Uniform(engine));
+                double const u1 = ScrambledRadicalInverse(offset + k, 3, perm3, 16, Uniform(engine));
+                data_.block[k] = {
+                    static_cast<float>(InverseNormalCdf(u0)),
+                    static_cast<float>(InverseNormalCdf(u1)) };
+            }
+            break;
+        }
+
+        case PlayerNormalDistSampling::kAntithetic: {
+            for (std::uint32_t k = 0; k < n; k += 2) {
+                std::array<float, 2> const z = {
+                    static_cast<float>(InverseNormalCdf(Uniform(engine))),
+                    static_cast<float>(InverseNormalCdf(Uniform(engine))) };
+                data_.block[k] = z;
+                if (k + 1 < n) data_.block[k + 1] = { -z[0], -z[1] };
+            }
+            break;
+        }
+
+        case PlayerNormalDistSampling::kStratified: {
+            // 各次元を n 個の層に分け, 層の組み合わせを次元ごとに独立に並べ替える
+            auto const perm0 = RandomPermutation(engine, n);
+            auto const perm1 = RandomPermutation(engine, n);
+            for (std::uint32_t k = 0; k < n; ++k) {
+                double const u0 = (perm0[k] + Uniform(engine)) / n;
+                double const u1 = (perm1[k] + Uniform(engine)) / n;
+                data_.block[k] = {
+                    static_cast<float>(InverseNormalCdf(u0)),
+                    static_cast<float>(InverseNormalCdf(u1)) };
+            }
+            break;
+        }
+
+        case PlayerNormalDistSampling::kPseudoRandom:
+        default:
+            // 擬似乱数の場合, PlayerNormalDist は std::normal_distribution から直接生成し, サンプラーを使用しない
+            throw std::logic_error("NormalDistSampler: pseudo_random does not generate blocks");
+    }
+}
+
+std::optional<double> NormalDistSampler::EstimateEffectiveSampleSize(
+    PlayerNormalDistSampling sampling,
+    std::uint32_t block_size,
+    std::vector<double> const& outcomes
+) {
+    if (outcomes.empty()) return std::nullopt;
+    if (sampling == PlayerNormalDistSampling::kPseudoRandom) {
+        return static_cast<double>(outcomes.size());
+    }
+    if (block_size == 0) return std::nullopt;
+
+    std::size_t const num_blocks = outcomes.size() / block_size;
+    if (num_blocks < 2) return std::nullopt;
+    std::size_t const num_samples = num_blocks * block_size;
+
+    double const mean = std::accumulate(outcomes.begin(), outcomes.begin() + num_samples, 0.0) / num_samples;
+
+    double variance = 0.0;
+    for (std::size_t i = 0; i < num_samples; ++i) {
+        variance += (outcomes[i] - mean) * (outcomes[i] - mean);
+    }
+    variance /= static_cast<double>(num_samples - 1);
+    if (variance <= 0.0) return std::nullopt;
+
+    double block_variance = 0.0;
+    for (std::size_t b = 0; b < num_blocks; ++b) {
+        auto const first = outcomes.begin() + b * block_size;
+        double const block_mean = std::accumulate(first, first + block_size, 0.0) / block_size;
+        block_variance += (block_mean - mean) * (block_mean - mean);
+    }
+    block_variance /= static_cast<double>(num_blocks - 1);
+    if (block_variance <= 0.0) return std::numeric_limits<double>::infinity();
+
+    // 推定量の分散は block_variance / num_blocks なので, 独立サンプルで同じ分散を得るのに必要な数は
+    // variance / (block_variance / num_blocks)
+    return variance * static_cast<double>(num_blocks) / block_variance;
+}
+
+} // namespace digitalcurling::players
@@ -0,0 +1,100 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// @brief NormalDistSampler を定義
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace digitalcurling::players {
+
+
+/// @brief プレイヤー NormalDist の乱数サンプリング方式
+enum class PlayerNormalDistSampling : std::uint8_t {
+    /// @brief 擬似乱数 (従来の方式)
+    kPseudoRandom,
+    /// @brief スクランブル Halton 列による準乱数
+    kHalton,
+    /// @brief 対称変量 (antithetic) のペア
+    kAntithetic,
+    /// @brief 層化サンプリング (ラテン超方格)
+    kStratified,
+};
+
+/// @brief サンプラーの状態データ
+struct NormalDistSamplerData {
+    /// @brief 現在のブロック内で次に使用するサンプルのインデックス
+    std::size_t index = 0;
+    /// @brief 現在のブロックの標準正規乱数 (初速, 角度) の組
+    std::vector<std::array<float, 2>> block;
+};
+
+/// @brief 初速と角度に加える標準正規乱数の組を分散低減方式で生成するサンプラー
+///
+/// `block_size` 個のサンプルを 1 ブロックとしてまとめて生成します。
+/// 擬似乱数 (`PlayerNormalDistSampling::kPseudoRandom`) ではブロックを生成しないため、`Next()` は `std::logic_error` を送出します。
+/// ブロックごとに独立にランダム化されるため、ブロック平均は互いに独立な不偏推定量になります。
+class NormalDistSampler {
+public:
+    /// @brief コンストラクタ
+    /// @param sampling サンプリング方式
+    /// @param block_size 1 ブロックあたりのサンプル数 (擬似乱数の場合は使用しない)
+    /// @throws std::invalid_argument 擬似乱数以外で `block_size` が 0 の場合
+    NormalDistSampler(PlayerNormalDistSampling sampling, std::uint32_t block_size);
+
+    /// @brief 次の標準正規乱数の組を得る
+    /// @param engine ブロックのランダム化に使用する乱数エンジン
+    /// @returns 初速, 角度に対応する標準正規乱数
+    std::array<float, 2> Next(std::mt19937 & engine);
+
+    /// @brief サンプラーの状態を保存する
+    /// @returns 状態データ
+    NormalDistSamplerData Save() const;
+    /// @brief サンプラーの状態を復元する
+    /// @param data 状態データ
+    void Load(NormalDistSamplerData const& data);
+
+    /// @brief 評価値の列から有効サンプルサイズを推定する
+    ///
+    /// `outcomes` はブロックの先頭から生成した順に並んでいる必要があります。
+    /// ブロック平均の分散と評価値全体の分散の比から、同じ精度を得るのに必要な独立サンプル数を推定します。
+    /// @param sampling サンプリング方式
+    /// @param block_size 1 ブロックあたりのサンプル数
+    /// @param outcomes 各サンプルに対する評価値
+    /// @returns 有効サンプルサイズ (完全なブロックが 2 個未満の場合など推定できない場合は `std::nullopt`)
+    static std::optional<double> EstimateEffectiveSampleSize(
+        PlayerNormalDistSampling sampling,
+        std::uint32_t block_size,
+        std::vector<double> const& outcomes
+    );
+
+private:
+    PlayerNormalDistSampling sampling_;
+    std::uint32_t block_size_;
+    NormalDistSamplerData data_;
+
+    void GenerateBlock(std::mt19937 & engine);
+};
+
+
+/// @cond Doxygen_Suppress
+// json
+NLOHMANN_JSON_SERIALIZE_ENUM(PlayerNormalDistSampling, {
+    {PlayerNormalDistSampling::kPseudoRandom, "pseudo_random"},
+    {PlayerNormalDistSampling::kHalton, "halton"},
+    {PlayerNormalDistSampling::kAntithetic, "antithetic"},
+    {PlayerNormalDistSampling::kStratified, "stratified"},
+})
+
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(NormalDistSamplerData, index, block)
+/// @endcond
+
+} // namespace digitalcurling::players
@@ -6,6 +6,7 @@
 #include <optional>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "player_normal_dist.hpp"
 
@@ -18,6 +19,8 @@ PlayerNormalDist::PlayerNormalDist(PlayerNormalDistFactory const& factory)
     , cw_speed_dist_(0.f, factory.cw.stddev_speed)
     , ccw_angle_dist_(0.f, factory.ccw.stddev_angle)
     , cw_angle_dist_(0.f, factory.cw.stddev_angle)
+    , ccw_sampler_(factory.sampling, factory.block_size)
+    , cw_sampler_(factory.sampling, factory.block_size)
     , IPlayer()
 {
     if (!factory_.seed.has_value()) {
@@ -33,9 +36,13 @@ PlayerNormalDist::PlayerNormalDist(PlayerNormalDistStorage const& storage)
     , cw_speed_dist_()
     , ccw_angle_dist_()
     , cw_angle_dist_()
+    , ccw_sampler_(storage.factory.sampling, storage.factory.block_size)
+    , cw_sampler_(storage.factory.sampling, storage.factory.block_size)
     , IPlayer()
 {
     LoadEngine(storage.engine_data, storage.ccw_data, storage.cw_data);
+    ccw_sampler_.Load(storage.ccw_sampler_data);
+    cw_sampler_.Load(storage.cw_sampler_data);
 }
 
 moves::Shot PlayerNormalDist::Play(moves::Shot const& shot)
@@ -44,6 +51,17 @@ moves::Shot PlayerNormalDist::Play(moves::Shot const& shot)
 
     bool const is_ccw = shot.angular_velocity > 0.f;
     float const max_speed = is_ccw ? factory_.ccw.max_speed : factory_.cw.max_speed;
+
+    if (factory_.sampling != PlayerNormalDistSampling::kPseudoRandom) {
+        // 層化や対称変量の組が崩れないよう, ブロックは回転方向ごとに分ける
+        auto const& param = is_ccw ? factory_.ccw : factory_.cw;
+        auto & sampler = is_ccw ? ccw_sampler_ : cw_sampler_;
+        auto const z = sampler.Next(engine_.value());
+        float const speed = std::min(shot.translational_velocity, max_speed) + z[0] * param.stddev_speed;
+        float const angle = shot.release_angle + z[1] * param.stddev_angle;
+        return moves::Shot { speed, shot.angular_velocity, angle };
+    }
+
     std::normal_distribution<float> & speed_dist = is_ccw ? ccw_speed_dist_ : cw_speed_dist_;
     std::normal_distribution<float> & angle_dist = is_ccw ? ccw_angle_dist_ : cw_angle_dist_;
 
@@ -83,6 +101,9 @@ void PlayerNormalDist::Save(IPlayerStorage & storage) const
     std::ostringstream s_cw_angle_dist;
     s_cw_angle_dist << cw_angle_dist_;
     s.cw_data.angle_dist = s_cw_angle_dist.str();
+
+    s.ccw_sampler_data = ccw_sampler_.Save();
+    s.cw_sampler_data = cw_sampler_.Save();
 }
 
 void PlayerNormalDist::Load(IPlayerStorage const& storage)
@@ -90,6 +111,15 @@ void PlayerNormalDist::Load(IPlayerStorage const& storage)
     auto const& s = static_cast<PlayerNormalDistStorage const&>(storage);
     factory_ = s.factory;
     LoadEngine(s.engine_data, s.ccw_data, s.cw_data);
+    ccw_sampler_ = NormalDistSampler(factory_.sampling, factory_.block_size);
+    ccw_sampler_.Load(s.ccw_sampler_data);
+    cw_sampler_ = NormalDistSampler(factory_.sampling, factory_.block_size);
+    cw_sampler_.Load(s.cw_sampler_data);
+}
+
+std::optional<double> PlayerNormalDist::EstimateEffectiveSampleSize(std::vector<double> const& outcomes) const
+{
+    return NormalDistSampler::EstimateEffectiveSampleSize(factory_.sampling, factory_.block_size, outcomes);
 }
 
 void PlayerNormalDist::LoadEngine(
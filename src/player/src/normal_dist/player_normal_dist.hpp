@@ -10,8 +10,10 @@
 #include <optional>
 #include <random>
 #include <string>
+#include <vector>
 #include "digitalcurling/players/i_player.hpp"
 
+#include "normal_dist_sampler.hpp"
 #include "player_normal_dist_factory.hpp"
 #include "player_normal_dist_storage.hpp"
 
@@ -41,6 +43,14 @@ public:
     virtual void Save(IPlayerStorage & storage) const override;
     virtual void Load(IPlayerStorage const& storage) override;
 
+    /// @brief このプレイヤーのショットに対する評価値の列から有効サンプルサイズを推定する
+    ///
+    /// サンプリングのブロックは回転方向ごとに分かれているため、`outcomes` には同じ回転方向のショットの評価値のみを、
+    /// その回転方向のブロックの先頭から `Play()` を呼び出した順に並べてください。
+    /// @param outcomes 各ショットの評価値
+    /// @returns 有効サンプルサイズ (推定できない場合は `std::nullopt`)
+    std::optional<double> EstimateEffectiveSampleSize(std::vector<double> const& outcomes) const;
+
 private:
     PlayerNormalDistFactory factory_;
     std::optional<std::mt19937> engine_;
@@ -48,6 +58,8 @@ private:
     std::normal_distribution<float> cw_speed_dist_;
     std::normal_distribution<float> ccw_angle_dist_;
     std::normal_distribution<float> cw_angle_dist_;
+    NormalDistSampler ccw_sampler_;
+    NormalDistSampler cw_sampler_;
 
     void LoadEngine(
         std::string const& engine_data,
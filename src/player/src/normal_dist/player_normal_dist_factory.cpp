@@ -31,6 +31,8 @@ void to_json(nlohmann::json & j, PlayerNormalDistFactory const& v) {
     j["cw"] = v.cw;
     j["ccw"] = v.ccw;
     j["seed"] = v.seed;
+    j["sampling"] = v.sampling;
+    j["block_size"] = v.block_size;
 }
 void from_json(nlohmann::json const& j, PlayerNormalDistFactory & v) {
     j.at("gender").get_to(v.gender);
@@ -52,6 +54,17 @@ void from_json(nlohmann::json const& j, PlayerNormalDistFactory & v) {
     } else {
         v.seed = std::nullopt;
     }
+
+    if (j.contains("sampling")) {
+        j.at("sampling").get_to(v.sampling);
+    } else {
+        v.sampling = PlayerNormalDistSampling::kPseudoRandom;
+    }
+    if (j.contains("block_size")) {
+        j.at("block_size").get_to(v.block_size);
+    } else {
+        v.block_size = 16;
+    }
 }
 
 } // namespace digitalcurling::players
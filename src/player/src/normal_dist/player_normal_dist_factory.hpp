@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <random>
 #include <memory>
 #include <optional>
@@ -14,6 +15,7 @@
 #include "digitalcurling/players/i_player_factory.hpp"
 
 #include "normal_dist.hpp"
+#include "normal_dist_sampler.hpp"
 
 namespace digitalcurling::players {
 
@@ -45,6 +47,17 @@ public:
     /// `std::nullopt` の場合シード値を自動でランダムに設定します。
     std::optional<std::random_device::result_type> seed = std::nullopt;
 
+    /// @brief 乱数のサンプリング方式
+    ///
+    /// `PlayerNormalDistSampling::kPseudoRandom` 以外を指定すると, 同じ精度の期待値推定に必要なショット数を減らせます。
+    PlayerNormalDistSampling sampling = PlayerNormalDistSampling::kPseudoRandom;
+
+    /// @brief 分散低減サンプリングの 1 ブロックあたりのサンプル数
+    ///
+    /// 準乱数列のランダム化や層化はこの単位で行われます。
+    /// `PlayerNormalDistSampling::kPseudoRandom` の場合は使用されません。
+    std::uint32_t block_size = 16;
+
     /// @brief デフォルトコンストラクタ
     PlayerNormalDistFactory() = default;
     /// @brief コピーコンストラクタ
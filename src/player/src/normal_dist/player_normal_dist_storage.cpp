@@ -29,6 +29,8 @@ void to_json(nlohmann::json & j, PlayerNormalDistStorage const& v) {
     j["engine_data"] = v.engine_data;
     j["ccw_data"] = v.ccw_data;
     j["cw_data"] = v.cw_data;
+    j["ccw_sampler_data"] = v.ccw_sampler_data;
+    j["cw_sampler_data"] = v.cw_sampler_data;
 }
 void from_json(nlohmann::json const& j, PlayerNormalDistStorage & v) {
     j.at("factory").get_to(v.factory);
@@ -46,6 +48,14 @@ void from_json(nlohmann::json const& j, PlayerNormalDistStorage & v) {
     } else {
         throw std::runtime_error("Invalid JSON format: missing ccw_data or cw_data");
     }
+
+    if (j.contains("ccw_sampler_data") && j.contains("cw_sampler_data")) {
+        j.at("ccw_sampler_data").get_to(v.ccw_sampler_data);
+        j.at("cw_sampler_data").get_to(v.cw_sampler_data);
+    } else {
+        v.ccw_sampler_data = {};
+        v.cw_sampler_data = {};
+    }
 }
 
 } // namespace digitalcurling::players
@@ -50,6 +50,10 @@ public:
     NormalDistData ccw_data;
     /// @brief 時計回りのショットに対する正規分布データ
     NormalDistData cw_data;
+    /// @brief 反時計回りのショットに対する分散低減サンプリングの状態データ
+    NormalDistSamplerData ccw_sampler_data;
+    /// @brief 時計回りのショットに対する分散低減サンプリングの状態データ
+    NormalDistSamplerData cw_sampler_data;
 };
 
 
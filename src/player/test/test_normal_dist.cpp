@@ -1,5 +1,7 @@
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <vector>
 #include "common.hpp"
 #include "../src/normal_dist/player_normal_dist.hpp"
 #include "../src/normal_dist/player_normal_dist_factory.hpp"
@@ -107,4 +109,109 @@ TEST(PlayerNormalDist, FactoryFromJson2)
     EXPECT_EQ(j_ccw.at("max_speed").get<float>(), v_normal_dist.ccw.max_speed);
     EXPECT_EQ(j_ccw.at("stddev_speed").get<float>(), v_normal_dist.ccw.stddev_speed);
     EXPECT_EQ(j_ccw.at("stddev_angle").get<float>(), v_normal_dist.ccw.stddev_angle);
-}
\ No newline at end of file
+}
+
+TEST(PlayerNormalDist, SamplingSaveLoad)
+{
+    for (auto sampling : { dcp::PlayerNormalDistSampling::kHalton,
+                           dcp::PlayerNormalDistSampling::kAntithetic,
+                           dcp::PlayerNormalDistSampling::kStratified }) {
+        dcp::PlayerNormalDistFactory factory;
+        factory.sampling = sampling;
+        factory.block_size = 4;
+        dct::PlayerTestSaveLoad1(factory.CreatePlayer());
+        dct::PlayerTestSaveLoad3(factory.CreatePlayer());
+        dct::PlayerTestSaveLoad4<dcp::PlayerNormalDistStorage>(factory.CreatePlayer());
+    }
+}
+
+TEST(PlayerNormalDist, SamplingBlockSizeZero)
+{
+    // 擬似乱数ではブロックサイズを使用しないため, 0 のままでもよい
+    dcp::PlayerNormalDistFactory factory;
+    factory.block_size = 0;
+    EXPECT_NO_THROW(factory.CreatePlayer());
+
+    factory.sampling = dcp::PlayerNormalDistSampling::kHalton;
+    EXPECT_THROW(factory.CreatePlayer(), std::invalid_argument);
+}
+
+TEST(PlayerNormalDist, SamplingAntithetic)
+{
+    dcp::PlayerNormalDistFactory factory;
+    factory.sampling = dcp::PlayerNormalDistSampling::kAntithetic;
+    factory.seed = 1;
+    auto player = factory.CreatePlayer();
+
+    auto const shot = dc::moves::Shot(2.f, 1.57f, 0.f);
+    for (int i = 0; i < 8; ++i) {
+        auto const shot0 = player->Play(shot);
+        auto const shot1 = player->Play(shot);
+        EXPECT_FLOAT_EQ(shot0.translational_velocity + shot1.translational_velocity, 2.f * shot.translational_velocity);
+        EXPECT_FLOAT_EQ(shot0.release_angle + shot1.release_angle, 2.f * shot.release_angle);
+    }
+}
+
+TEST(PlayerNormalDist, SamplingPerRotation)
+{
+    dcp::PlayerNormalDistFactory factory;
+    factory.sampling = dcp::PlayerNormalDistSampling::kAntithetic;
+    factory.seed = 3;
+    auto player = factory.CreatePlayer();
+
+    // 回転方向を交互に切り替えても, 回転方向ごとに対称変量の組が保たれる
+    auto const ccw_shot = dc::moves::Shot(2.f, 1.57f, 0.f);
+    auto const cw_shot = dc::moves::Shot(2.f, -1.57f, 0.f);
+    for (int i = 0; i < 8; ++i) {
+        auto const ccw0 = player->Play(ccw_shot);
+        auto const cw0 = player->Play(cw_shot);
+        auto const ccw1 = player->Play(ccw_shot);
+        auto const cw1 = player->Play(cw_shot);
+        EXPECT_FLOAT_EQ(ccw0.release_angle + ccw1.release_angle, 0.f);
+        EXPECT_FLOAT_EQ(cw0.release_angle + cw1.release_angle, 0.f);
+    }
+}
+
+TEST(PlayerNormalDist, SamplingEffectiveSampleSize)
+{
+    auto const shot = dc::moves::Shot(2.f, 1.57f, 0.f);
+    auto ess = [&](dcp::PlayerNormalDistSampling sampling) {
+        dcp::PlayerNormalDistFactory factory;
+        factory.sampling = sampling;
+        factory.block_size = 16;
+        factory.seed = 2;
+        dcp::PlayerNormalDist player(factory);
+
+        // 1. 初速と角度に対して単調な評価値を生成順に記録する
+        std::vector<double> outcomes;
+        for (int i = 0; i < 16 * 32; ++i) {
+            auto const played = player.Play(shot);
+            outcomes.push_back(played.translational_velocity + 4.0 * played.release_angle);
+        }
+
+        // 2. 有効サンプルサイズを推定する
+        auto const result = player.EstimateEffectiveSampleSize(outcomes);
+        EXPECT_TRUE(result.has_value());
+        return result.value_or(0.0);
+    };
+
+    double const n = 16 * 32;
+    EXPECT_DOUBLE_EQ(ess(dcp::PlayerNormalDistSampling::kPseudoRandom), n);
+    EXPECT_GT(ess(dcp::PlayerNormalDistSampling::kHalton), 2.0 * n);
+    EXPECT_GT(ess(dcp::PlayerNormalDistSampling::kAntithetic), 2.0 * n);
+    EXPECT_GT(ess(dcp::PlayerNormalDistSampling::kStratified), 2.0 * n);
+}
+
+TEST(PlayerNormalDist, FactorySamplingJson)
+{
+    dcp::PlayerNormalDistFactory factory;
+    factory.sampling = dcp::PlayerNormalDistSampling::kHalton;
+    factory.block_size = 32;
+
+    json const j = factory;
+    EXPECT_EQ(j.at("sampling").get<std::string>(), "halton");
+
+    auto const copy = j.get<dcp::PlayerNormalDistFactory>();
+    EXPECT_EQ(copy.sampling, dcp::PlayerNormalDistSampling::kHalton);
+    EXPECT_EQ(copy.block_size, 32u);
+}
@@ -0,0 +1,81 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// @brief BinaryStateWriter, BinaryStateReader を定義
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace digitalcurling::plugins {
+
+
+/// @brief Factory / Storage の状態をバイナリ形式で書き込むためのユーティリティ
+///
+/// 値はホストのバイト順・表現のまま書き込まれます。
+/// 異なる環境間での受け渡しには JSON 形式を使用してください。
+class BinaryStateWriter {
+public:
+    /// @brief コンストラクタ
+    /// @param buffer 書き込み先のバッファ (末尾に追記されます)
+    explicit BinaryStateWriter(std::vector<std::uint8_t> & buffer) : buffer_(buffer) {}
+
+    /// @brief 値を書き込む
+    /// @tparam T 書き込む値の型 (trivially copyable である必要があります)
+    /// @param value 書き込む値
+    template <typename T>
+    void Write(T const& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "BinaryStateWriter: T must be trivially copyable.");
+        auto const offset = buffer_.size();
+        buffer_.resize(offset + sizeof(T));
+        std::memcpy(buffer_.data() + offset, &value, sizeof(T));
+    }
+
+private:
+    std::vector<std::uint8_t> & buffer_;
+};
+
+
+/// @brief BinaryStateWriter で書き込まれた状態を読み込むためのユーティリティ
+class BinaryStateReader {
+public:
+    /// @brief コンストラクタ
+    /// @param data 読み込むデータ
+    /// @param size `data` のバイト数
+    BinaryStateReader(std::uint8_t const* data, std::size_t size) : data_(data), size_(size), position_(0) {}
+
+    /// @brief 値を読み込む
+    /// @tparam T 読み込む値の型 (trivially copyable である必要があります)
+    /// @returns 読み込んだ値
+    /// @throws std::invalid_argument データが足りない場合
+    template <typename T>
+    T Read()
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "BinaryStateReader: T must be trivially copyable.");
+        if (size_ - position_ < sizeof(T)) {
+            throw std::invalid_argument("BinaryStateReader: unexpected end of data.");
+        }
+        T value;
+        std::memcpy(&value, data_ + position_, sizeof(T));
+        position_ += sizeof(T);
+        return value;
+    }
+
+    /// @brief 全てのデータを読み込んだか
+    /// @returns 全て読み込んでいれば `true`
+    bool IsEnd() const { return position_ == size_; }
+
+private:
+    std::uint8_t const* data_;
+    std::size_t size_;
+    std::size_t position_;
+};
+
+} // namespace digitalcurling::plugins
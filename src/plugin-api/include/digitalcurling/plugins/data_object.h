@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <stdint.h>
+
 /// @addtogroup plugin_api
 /// @{
 
@@ -31,6 +33,8 @@ typedef enum {
     DIGITALCURLING_ERR_INVALID_PLUGIN_TYPE = 12,
     /// @brief インスタンスが見つからない
     DIGITALCURLING_ERR_INSTANCE_NOT_FOUND = 13,
+    /// @brief プラグインが機能に対応していない
+    DIGITALCURLING_ERR_NOT_SUPPORTED = 14,
     /// @brief 関数が見つからない
     DIGITALCURLING_ERR_FAILED_TO_LOAD_PLUGIN = 19,
 
@@ -137,4 +141,60 @@ typedef struct {
     float release_angle;
 } DigitalCurling_Shot;
 
+/// @brief 衝突に関するストーンの情報を表す構造体 (C互換)
+typedef struct {
+    /// @brief ストーンのID
+    unsigned char id;
+    /// @brief ストーンの位置
+    DigitalCurling_Vector2 position;
+    /// @brief ストーンの角度（rad）
+    float angle;
+    /// @brief ストーンの並進速度
+    DigitalCurling_Vector2 translational_velocity;
+    /// @brief ストーンの角速度
+    float angular_velocity;
+} DigitalCurling_CollisionStone;
+
+/// @brief ストーンどうしの衝突の情報を表す構造体 (C互換)
+typedef struct {
+    /// @brief 衝突したストーン
+    DigitalCurling_CollisionStone a;
+    /// @brief 衝突したストーン
+    DigitalCurling_CollisionStone b;
+    /// @brief 法線方向の撃力
+    float normal_impulse;
+    /// @brief 接線方向の撃力
+    float tangent_impulse;
+} DigitalCurling_Collision;
+
+/// @brief シミュレーターの性能カウンターを表す構造体 (C互換)
+typedef struct {
+    /// @brief 進めたフレーム数
+    uint64_t frames;
+    /// @brief 開始した接触の数
+    uint64_t contacts_begun;
+    /// @brief 衝突の解決を行った接触の数
+    uint64_t contacts_solved;
+    /// @brief シート外に出たため取り除いたストーンの数
+    uint64_t out_of_sheet_removals;
+    /// @brief ストーンの配置の設定回数
+    uint64_t set_stones_calls;
+    /// @brief 状態の復元回数
+    uint64_t load_calls;
+    /// @brief 摩擦・カールによる速度の更新にかかった時間（秒）
+    double motion_seconds;
+    /// @brief 物理エンジンのステップにかかった時間（秒）
+    double world_step_seconds;
+
+    // --- API version 7 ---
+    // 古いプラグインはこれより前のメンバーのみを書き込むため、ローダーはゼロで初期化した構造体を渡す
+
+    /// @brief 物理エンジンを使わずに進めたショットの数
+    uint64_t fast_path_shots;
+    /// @brief 物理エンジンを使わずに進めたフレーム数
+    uint64_t fast_path_frames;
+    /// @brief 経路上に他のストーンがあったため、物理エンジンで進めたショットの数
+    uint64_t fast_path_rejections;
+} DigitalCurling_SimulatorStats;
+
 /// @}
@@ -3,15 +3,22 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <exception>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include <nlohmann/json.hpp>
 #include "digitalcurling/plugins/i_plugin_object.hpp"
 #include "digitalcurling/plugins/data_object.h"
 #include "digitalcurling/plugins/plugin_api.hpp"
 #include "digitalcurling/plugins/plugin_type.hpp"
+#include "digitalcurling/trace.hpp"
 
 
 //* NOTE: DIGITALCURLING_PLUGIN_NAME must be defined as UTF-8 string literal before including this file.
@@ -154,6 +161,105 @@ DigitalCurling_ErrorCode CreatorSetStateImpl(THandle creator, const char* json,
     }
 }
 
+// Factory / Storage がバイナリ形式の状態に対応しているか
+//   static constexpr unsigned int kBinaryStateVersion;
+//   void ToBinary(std::vector<std::uint8_t>& out) const;
+//   void FromBinary(std::uint8_t const* data, std::size_t size);
+template <typename T, typename = void>
+struct HasBinaryState : std::false_type {};
+template <typename T>
+struct HasBinaryState<T, std::void_t<
+    decltype(static_cast<unsigned int>(T::kBinaryStateVersion)),
+    decltype(std::declval<T const&>().ToBinary(std::declval<std::vector<std::uint8_t>&>())),
+    decltype(std::declval<T&>().FromBinary(std::declval<std::uint8_t const*>(), std::declval<std::size_t>()))
+>> : std::true_type {};
+
+template <typename T, typename THandle>
+DigitalCurling_ErrorCode CreatorGetBinaryStateImpl(THandle creator, std::uint8_t* out_buffer, const size_t buffer_size, size_t* out_size, unsigned int* out_format_version, char** out_error)
+{
+    if (!creator)
+        return ReturnError(DIGITALCURLING_ERR_INVALID_ARGUMENT, "CreatorGetBinaryState: creator handle is nullptr.", out_error);
+    if (!out_size || !out_format_version)
+        return ReturnError(DIGITALCURLING_ERR_BUFFER_NULLPTR, "CreatorGetBinaryState: out_size or out_format_version is nullptr.", out_error);
+    if (buffer_size > 0 && !out_buffer)
+        return ReturnError(DIGITALCURLING_ERR_BUFFER_NULLPTR, "CreatorGetBinaryState: out_buffer is nullptr.", out_error);
+
+    try {
+        thread_local std::vector<std::uint8_t> buffer;
+        buffer.clear();
+        dynamic_cast<T*>(creator)->ToBinary(buffer);
+
+        *out_size = buffer.size();
+        *out_format_version = T::kBinaryStateVersion;
+        if (buffer_size >= buffer.size() && !buffer.empty()) {
+            std::memcpy(out_buffer, buffer.data(), buffer.size());
+        }
+        return DIGITALCURLING_OK;
+    } catch (const std::exception& e) {
+        return ReturnException(e, "CreatorGetBinaryState", out_error);
+    }
+}
+template <typename T, typename THandle>
+DigitalCurling_ErrorCode CreatorSetBinaryStateImpl(THandle creator, const std::uint8_t* data, const size_t size, const unsigned int format_version, char** out_error)
+{
+    if (!creator)
+        return ReturnError(DIGITALCURLING_ERR_INVALID_ARGUMENT, "CreatorSetBinaryState: creator handle is nullptr.", out_error);
+    if (size > 0 && !data)
+        return ReturnError(DIGITALCURLING_ERR_INVALID_ARGUMENT, "CreatorSetBinaryState: data is nullptr.", out_error);
+    if (format_version != T::kBinaryStateVersion)
+        return ReturnError(DIGITALCURLING_ERR_INVALID_DATA, "CreatorSetBinaryState: unsupported format version " + std::to_string(format_version) + ".", out_error);
+
+    try {
+        dynamic_cast<T*>(creator)->FromBinary(data, size);
+        return DIGITALCURLING_OK;
+    } catch (const std::invalid_argument& e) {
+        return ReturnError(DIGITALCURLING_ERR_INVALID_DATA, std::string("CreatorSetBinaryState: ") + e.what(), out_error);
+    } catch (const std::exception& e) {
+        return ReturnException(e, "CreatorSetBinaryState", out_error);
+    }
+}
+
+// 対応していない型では nullptr を返す
+template <typename T, typename THandle>
+constexpr auto GetBinaryStateFuncFor()
+{
+    using Func = DigitalCurling_ErrorCode (*)(THandle, std::uint8_t*, const size_t, size_t*, unsigned int*, char**);
+    if constexpr (HasBinaryState<T>::value) {
+        return static_cast<Func>(&CreatorGetBinaryStateImpl<T, THandle>);
+    } else {
+        return static_cast<Func>(nullptr);
+    }
+}
+template <typename T, typename THandle>
+constexpr auto SetBinaryStateFuncFor()
+{
+    using Func = DigitalCurling_ErrorCode (*)(THandle, const std::uint8_t*, const size_t, const unsigned int, char**);
+    if constexpr (HasBinaryState<T>::value) {
+        return static_cast<Func>(&CreatorSetBinaryStateImpl<T, THandle>);
+    } else {
+        return static_cast<Func>(nullptr);
+    }
+}
+
+inline DigitalCurling_ErrorCode TraceStartImpl(const size_t events_per_thread, char** out_error)
+{
+    try {
+        digitalcurling::trace::Start(events_per_thread);
+        return DIGITALCURLING_OK;
+    } catch (const std::exception& e) {
+        return ReturnException(e, "TraceStart", out_error);
+    }
+}
+
+inline DigitalCurling_ErrorCode TraceStopImpl(char** out_events_json, char** out_error)
+{
+    try {
+        return ReturnString(digitalcurling::trace::Stop().dump(), "TraceStop", out_events_json, out_error);
+    } catch (const std::exception& e) {
+        return ReturnException(e, "TraceStop", out_error);
+    }
+}
+
 template <PluginType Type, typename Factory>
 DigitalCurling_ErrorCode GetFactoryImpl(typename digitalcurling::plugins::PluginTypeTraits<Type>::HandleType* handle, FactoryHandle** out_factory_handle, char** out_error)
 {
@@ -252,6 +358,14 @@ namespace dcpd = digitalcurling::plugins::detail;
         /*storage_set_state*/ &dcpd::CreatorSetStateImpl<StorageClass, digitalcurling::plugins::StorageHandle*>, \
         \
         /*player*/ PlayerApiInstance, \
-        /*simulator*/ SimulatorApiInstance \
+        /*simulator*/ SimulatorApiInstance, \
+        \
+        /*factory_get_binary_state*/ dcpd::GetBinaryStateFuncFor<FactoryClass, digitalcurling::plugins::FactoryHandle*>(), \
+        /*storage_get_binary_state*/ dcpd::GetBinaryStateFuncFor<StorageClass, digitalcurling::plugins::StorageHandle*>(), \
+        /*factory_set_binary_state*/ dcpd::SetBinaryStateFuncFor<FactoryClass, digitalcurling::plugins::FactoryHandle*>(), \
+        /*storage_set_binary_state*/ dcpd::SetBinaryStateFuncFor<StorageClass, digitalcurling::plugins::StorageHandle*>(), \
+        \
+        /*trace_start*/ &dcpd::TraceStartImpl, \
+        /*trace_stop*/ &dcpd::TraceStopImpl \
     }; \
     DIGITALCURLING_EXPORT_PLUGIN_FUNCTIONS(g_plugin_info, g_plugin_api)
@@ -6,12 +6,21 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include "digitalcurling/plugins/i_plugin_object.hpp"
 #include "digitalcurling/plugins/data_object.h"
 
 /// @brief プラグインAPIのバージョン
 /// @ingroup plugin_api
-#define DIGITALCURLING_PLUGIN_API_VERSION 1
+#define DIGITALCURLING_PLUGIN_API_VERSION 7
+
+/// @brief ローダーが読み込める最も古いプラグインAPIのバージョン
+///
+/// API関数テーブルへの関数の追加は末尾に行うため、古いバージョンのプラグインも読み込めます。
+/// ローダーはプラグインのバージョンを見て、そのバージョンに存在しない関数を `nullptr` として扱います。
+/// @ingroup plugin_api
+#define DIGITALCURLING_PLUGIN_API_MIN_VERSION 1
 
 namespace digitalcurling::plugins {
 
@@ -74,6 +83,69 @@ typedef DigitalCurling_ErrorCode (*FactorySetStateFunc)(FactoryHandle* creator,
 /// @return 処理結果のエラーコード
 typedef DigitalCurling_ErrorCode (*StorageSetStateFunc)(StorageHandle* creator, const char* json, char** out_error);
 
+/// @brief Factory の現在の状態をバイナリ形式で取得する関数ポインタ型
+///
+/// バイナリ形式のレイアウトはプラグインが定義し、`out_format_version` で区別します。
+/// 状態のバイト数を `out_size` に格納し、`buffer_size` が足りる場合のみ `out_buffer` に書き込みます。
+/// @param[in] creator Factory ハンドル
+/// @param[out] out_buffer 状態を格納するバッファ (`buffer_size` が 0 の場合は `nullptr` でもよい)
+/// @param[in] buffer_size `out_buffer` のバイト数
+/// @param[out] out_size 状態のバイト数を格納するポインタ
+/// @param[out] out_format_version バイナリ形式のバージョンを格納するポインタ
+/// @param[out] out_error エラー発生時のメッセージを格納するポインタ (呼び出し側で解放が必要)
+/// @return 処理結果のエラーコード
+/// @note API バージョン 4 で追加されました。
+typedef DigitalCurling_ErrorCode (*FactoryGetBinaryStateFunc)(FactoryHandle* creator, std::uint8_t* out_buffer, const size_t buffer_size, size_t* out_size, unsigned int* out_format_version, char** out_error);
+
+/// @brief Storage の現在の状態をバイナリ形式で取得する関数ポインタ型
+/// @param[in] creator Storage ハンドル
+/// @param[out] out_buffer 状態を格納するバッファ (`buffer_size` が 0 の場合は `nullptr` でもよい)
+/// @param[in] buffer_size `out_buffer` のバイト数
+/// @param[out] out_size 状態のバイト数を格納するポインタ
+/// @param[out] out_format_version バイナリ形式のバージョンを格納するポインタ
+/// @param[out] out_error エラー発生時のメッセージを格納するポインタ (呼び出し側で解放が必要)
+/// @return 処理結果のエラーコード
+/// @note API バージョン 4 で追加されました。
+typedef DigitalCurling_ErrorCode (*StorageGetBinaryStateFunc)(StorageHandle* creator, std::uint8_t* out_buffer, const size_t buffer_size, size_t* out_size, unsigned int* out_format_version, char** out_error);
+
+/// @brief Factory の状態をバイナリ形式のデータで置き換える関数ポインタ型
+///
+/// JSON による状態の設定と異なり、部分的な更新はできません。
+/// @param[in] creator Factory ハンドル
+/// @param[in] data バイナリ形式の状態
+/// @param[in] size `data` のバイト数
+/// @param[in] format_version バイナリ形式のバージョン
+/// @param[out] out_error エラー発生時のメッセージを格納するポインタ (呼び出し側で解放が必要)
+/// @return 処理結果のエラーコード
+/// @note API バージョン 4 で追加されました。
+typedef DigitalCurling_ErrorCode (*FactorySetBinaryStateFunc)(FactoryHandle* creator, const std::uint8_t* data, const size_t size, const unsigned int format_version, char** out_error);
+
+/// @brief Storage の状態をバイナリ形式のデータで置き換える関数ポインタ型
+/// @param[in] creator Storage ハンドル
+/// @param[in] data バイナリ形式の状態
+/// @param[in] size `data` のバイト数
+/// @param[in] format_version バイナリ形式のバージョン
+/// @param[out] out_error エラー発生時のメッセージを格納するポインタ (呼び出し側で解放が必要)
+/// @return 処理結果のエラーコード
+/// @note API バージョン 4 で追加されました。
+typedef DigitalCurling_ErrorCode (*StorageSetBinaryStateFunc)(StorageHandle* creator, const std::uint8_t* data, const size_t size, const unsigned int format_version, char** out_error);
+
+/// @brief プラグイン内のトレースの記録を開始する関数ポインタ型
+///
+/// 記録は `digitalcurling::trace` によりプラグインごとに行い、ローダーが取得して結合します。
+/// @param[in] events_per_thread スレッドごとに記録できるイベント数
+/// @param[out] out_error エラー発生時のメッセージを格納するポインタ (呼び出し側で解放が必要)
+/// @return 処理結果のエラーコード
+/// @note API バージョン 6 で追加されました。
+typedef DigitalCurling_ErrorCode (*TraceStartFunc)(const size_t events_per_thread, char** out_error);
+
+/// @brief プラグイン内のトレースの記録を終了し、記録したイベントを取得する関数ポインタ型
+/// @param[out] out_events_json Trace Event Format のイベントの配列 (JSON) を格納するポインタ (呼び出し側で解放が必要)
+/// @param[out] out_error エラー発生時のメッセージを格納するポインタ (呼び出し側で解放が必要)
+/// @return 処理結果のエラーコード
+/// @note API バージョン 6 で追加されました。
+typedef DigitalCurling_ErrorCode (*TraceStopFunc)(char** out_events_json, char** out_error);
+
 
 // --- Player Plugin Functions Definition ---
 
@@ -213,6 +285,46 @@ typedef DigitalCurling_ErrorCode (*SimulatorGetSecondsPerFrameFunc)(SimulatorHan
 /// @return 処理結果のエラーコード
 typedef DigitalCurling_ErrorCode (*SimulatorCalculateShotFunc)(SimulatorHandle* sim, const DigitalCurling_Vector2* target_position, const float target_speed, const float angular_velocity, DigitalCurling_Shot* out_shot, char** out_error);
 
+/// @brief 複数の盤面に対してショットをまとめてシミュレーションする関数ポインタ型
+///
+/// 各要素について、ストーンの配置を設定し、ショットのストーンを原点から投げ、停止条件を満たすまでシミュレーションした結果を書き込みます。
+/// 処理後の Simulator の状態は最後の要素をシミュレーションした結果になります。
+/// @param[in] sim Simulator ハンドル
+/// @param[in] stones 初期配置の配列 (要素数 `count`)
+/// @param[in] shots ショットの配列 (要素数 `count`, `nullptr` の場合は `stones` をそのままシミュレーションする)
+/// @param[in] count 要素数
+/// @param[in] shot_stone_index ショットのストーンを配置するインデックス (`shots` が `nullptr` の場合は無視される)
+/// @param[in] mode_flag 終了条件フラグ
+/// @param[in] sheet_width シートの幅
+/// @param[out] out_stones シミュレーション結果を格納する配列 (要素数 `count`, `stones` と同じ領域でもよい)
+/// @param[out] out_error エラー発生時のメッセージを格納するポインタ
+/// @return 処理結果のエラーコード
+/// @note API バージョン 2 で追加されました。
+typedef DigitalCurling_ErrorCode (*SimulatorSimulateBatchFunc)(SimulatorHandle* sim, const DigitalCurling_StoneCoordinate* stones, const DigitalCurling_Shot* shots, const size_t count, const int shot_stone_index, const DigitalCurling_SimulateModeFlag mode_flag, const float sheet_width, DigitalCurling_StoneCoordinate* out_stones, char** out_error);
+
+/// @brief 直前のステップでの衝突情報を構造体の配列として取得する関数ポインタ型
+///
+/// 衝突の総数を `out_count` に格納し、先頭から最大 `capacity` 個を `out_collisions` に書き込みます。
+/// `capacity` に 0 を指定すると、総数のみを取得できます。
+/// @param[in] sim Simulator ハンドル
+/// @param[out] out_collisions 衝突情報を格納する配列 (要素数 `capacity`, `capacity` が 0 の場合は `nullptr` でもよい)
+/// @param[in] capacity `out_collisions` の要素数
+/// @param[out] out_count 衝突の総数を格納するポインタ
+/// @param[out] out_error エラー発生時のメッセージを格納するポインタ
+/// @return 処理結果のエラーコード
+/// @note API バージョン 3 で追加されました。
+typedef DigitalCurling_ErrorCode (*SimulatorGetCollisionRecordsFunc)(SimulatorHandle* sim, DigitalCurling_Collision* out_collisions, const size_t capacity, size_t* out_count, char** out_error);
+
+/// @brief シミュレーターの性能カウンターを取得する関数ポインタ型
+/// @param[in] sim Simulator ハンドル
+/// @param[out] out_stats 性能カウンターを格納するポインタ
+/// @param[out] out_error エラー発生時のメッセージを格納するポインタ
+/// @return 処理結果のエラーコード
+/// @note API バージョン 5 で追加されました。
+/// API バージョン 7 で `DigitalCurling_SimulatorStats` の末尾に `fast_path_*` が追加されました。
+/// それより古いプラグインはこれらのメンバーを書き込まないため、呼び出し側はゼロで初期化した構造体を渡します。
+typedef DigitalCurling_ErrorCode (*SimulatorGetStatsFunc)(SimulatorHandle* sim, DigitalCurling_SimulatorStats* out_stats, char** out_error);
+
 /// @brief シミュレータプラグイン固有のAPI関数テーブル
 struct SimulatorApi {
     /// @brief SimulatorインスタンスからFactoryを取得する関数
@@ -240,6 +352,21 @@ struct SimulatorApi {
 
     /// @brief 目標位置に到達するためのショットを計算する関数
     SimulatorCalculateShotFunc calculate_shot;
+
+    // --- API version 2 ---
+
+    /// @brief 複数の盤面に対してショットをまとめてシミュレーションする関数
+    SimulatorSimulateBatchFunc simulate_batch;
+
+    // --- API version 3 ---
+
+    /// @brief 直前のステップでの衝突情報を構造体の配列として取得する関数
+    SimulatorGetCollisionRecordsFunc get_collision_records;
+
+    // --- API version 5 ---
+
+    /// @brief 性能カウンターを取得する関数
+    SimulatorGetStatsFunc get_stats;
 };
 
 
@@ -282,6 +409,24 @@ struct PluginApi {
     const PlayerApi* player;
     /// @brief シミュレータ固有API (Playerの場合は `nullptr`)
     const SimulatorApi* simulator;
+
+    // --- API version 4 ---
+
+    /// @brief Factory状態のバイナリ形式での取得関数 (対応していない場合は `nullptr`)
+    FactoryGetBinaryStateFunc factory_get_binary_state;
+    /// @brief Storage状態のバイナリ形式での取得関数 (対応していない場合は `nullptr`)
+    StorageGetBinaryStateFunc storage_get_binary_state;
+    /// @brief Factory状態のバイナリ形式での設定関数 (対応していない場合は `nullptr`)
+    FactorySetBinaryStateFunc factory_set_binary_state;
+    /// @brief Storage状態のバイナリ形式での設定関数 (対応していない場合は `nullptr`)
+    StorageSetBinaryStateFunc storage_set_binary_state;
+
+    // --- API version 6 ---
+
+    /// @brief トレースの記録開始関数
+    TraceStartFunc trace_start;
+    /// @brief トレースの記録終了関数
+    TraceStopFunc trace_stop;
 };
 
 
@@ -6,10 +6,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <exception>
 #include <optional>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <nlohmann/json.hpp>
 
 #include "digitalcurling/moves/shot.hpp"
@@ -25,9 +29,94 @@ namespace digitalcurling::plugins::detail {
 
 
 // --- Simulator-specific wrappers ---
+inline digitalcurling::simulators::ISimulator::AllStones ToAllStones(const DigitalCurling_StoneCoordinate& stones)
+{
+    digitalcurling::simulators::ISimulator::AllStones stones_data;
+    for (int i = 0; i < digitalcurling::StoneCoordinate::kStoneMax; i++) {
+        auto const& struct_stone = stones.stones[i];
+        if (struct_stone.position.x == 0.f && struct_stone.position.y == 0.f && struct_stone.angle == 0.f &&
+            struct_stone.translational_velocity.x == 0.f && struct_stone.translational_velocity.y == 0.f && struct_stone.angular_velocity == 0.f)
+        {
+            stones_data[i] = std::nullopt;
+        } else {
+            stones_data[i] = digitalcurling::simulators::ISimulator::StoneState{
+                digitalcurling::Vector2(struct_stone.position.x, struct_stone.position.y),
+                struct_stone.angle,
+                digitalcurling::Vector2(struct_stone.translational_velocity.x, struct_stone.translational_velocity.y),
+                struct_stone.angular_velocity
+            };
+        }
+    }
+    return stones_data;
+}
+inline void FromAllStones(digitalcurling::simulators::ISimulator::AllStones const& stones, DigitalCurling_StoneCoordinate* out_stones)
+{
+    for (int i = 0; i < digitalcurling::StoneCoordinate::kStoneMax; i++) {
+        if (stones[i].has_value()) {
+            out_stones->stones[i].position.x = stones[i]->position.x;
+            out_stones->stones[i].position.y = stones[i]->position.y;
+            out_stones->stones[i].angle = stones[i]->angle;
+            out_stones->stones[i].translational_velocity.x = stones[i]->translational_velocity.x;
+            out_stones->stones[i].translational_velocity.y = stones[i]->translational_velocity.y;
+            out_stones->stones[i].angular_velocity = stones[i]->angular_velocity;
+        } else {
+            out_stones->stones[i].position.x = 0.f;
+            out_stones->stones[i].position.y = 0.f;
+            out_stones->stones[i].angle = 0.f;
+            out_stones->stones[i].translational_velocity.x = 0.f;
+            out_stones->stones[i].translational_velocity.y = 0.f;
+            out_stones->stones[i].angular_velocity = 0.f;
+        }
+    }
+}
+
+inline DigitalCurling_CollisionStone ToCollisionStoneRecord(digitalcurling::simulators::ISimulator::Collision::CollisionStone const& stone)
+{
+    return DigitalCurling_CollisionStone{
+        stone.id,
+        DigitalCurling_Vector2{ stone.stone.position.x, stone.stone.position.y },
+        stone.stone.angle,
+        DigitalCurling_Vector2{ stone.stone.translational_velocity.x, stone.stone.translational_velocity.y },
+        stone.stone.angular_velocity
+    };
+}
+inline DigitalCurling_Collision ToCollisionRecord(digitalcurling::simulators::ISimulator::Collision const& collision)
+{
+    return DigitalCurling_Collision{
+        ToCollisionStoneRecord(collision.a),
+        ToCollisionStoneRecord(collision.b),
+        collision.normal_impulse,
+        collision.tangent_impulse
+    };
+}
+
+// シート外のストーンの除去を記録する関数 (RecordOutOfSheetRemovals) を持つシミュレーターか
+template <typename Simulator, typename = void>
+struct HasRecordOutOfSheetRemovals : std::false_type {};
+template <typename Simulator>
+struct HasRecordOutOfSheetRemovals<Simulator, std::void_t<decltype(std::declval<Simulator&>().RecordOutOfSheetRemovals(std::size_t{}))>> : std::true_type {};
+
+inline DigitalCurling_SimulatorStats ToSimulatorStatsRecord(digitalcurling::simulators::SimulatorStats const& stats)
+{
+    return DigitalCurling_SimulatorStats{
+        stats.frames,
+        stats.contacts_begun,
+        stats.contacts_solved,
+        stats.out_of_sheet_removals,
+        stats.set_stones_calls,
+        stats.load_calls,
+        stats.motion_seconds,
+        stats.world_step_seconds,
+        stats.fast_path_shots,
+        stats.fast_path_frames,
+        stats.fast_path_rejections
+    };
+}
+
 template <typename Simulator>
 void SimulatorSimulateLoopBody(Simulator* sim, const DigitalCurling_SimulateModeFlag mode_flag, const int frames, const float sheet_width)
 {
+    DIGITALCURLING_TRACE_SCOPE("simulator", "SimulateLoop");
     const float x_limit = sheet_width / 2.0f - digitalcurling::Stone::kRadius;
     constexpr float y_limit = digitalcurling::coordinate::kBackBoardY - digitalcurling::Stone::kRadius;
 
@@ -52,13 +141,17 @@ void SimulatorSimulateLoopBody(Simulator* sim, const DigitalCurling_SimulateMode
 
             if (is_stone_out) {
                 digitalcurling::simulators::ISimulator::AllStones new_stones;
+                std::size_t removed = 0;
                 for (int i = 0; i < digitalcurling::StoneCoordinate::kStoneMax; i++) {
                     const auto& stone = stones[i];
                     if (!is_out_of_sheet(stone)) {
                         new_stones[i] = stone;
+                    } else {
+                        ++removed;
                     }
                 }
                 sim->SetStones(new_stones);
+                if constexpr (HasRecordOutOfSheetRemovals<Simulator>::value) sim->RecordOutOfSheetRemovals(removed);
 
                 if (mode_flag & DIGITALCURLING_SIMULATE_MODE_OUT_STONE) return;
             }
@@ -111,23 +204,7 @@ DigitalCurling_ErrorCode SimulatorSetStonesImpl(SimulatorHandle* sim, const Digi
 
     try {
         auto* sim_ptr = dynamic_cast<Simulator*>(sim);
-        digitalcurling::simulators::ISimulator::AllStones stones_data;
-        for (int i = 0; i < digitalcurling::StoneCoordinate::kStoneMax; i++) {
-            auto struct_stone = stones->stones[i];
-            if (struct_stone.position.x == 0.f && struct_stone.position.y == 0.f && struct_stone.angle == 0.f &&
-                struct_stone.translational_velocity.x == 0.f && struct_stone.translational_velocity.y == 0.f && struct_stone.angular_velocity == 0.f)
-            {
-                stones_data[i] = std::nullopt;
-            } else {
-                stones_data[i] = digitalcurling::simulators::ISimulator::StoneState{
-                    digitalcurling::Vector2(struct_stone.position.x, struct_stone.position.y),
-                    struct_stone.angle,
-                    digitalcurling::Vector2(struct_stone.translational_velocity.x, struct_stone.translational_velocity.y),
-                    struct_stone.angular_velocity
-                };
-            }
-        }
-        sim_ptr->SetStones(stones_data);
+        sim_ptr->SetStones(ToAllStones(*stones));
         return DIGITALCURLING_OK;
     } catch (const std::exception& e) {
         return ReturnException(e, "SimulatorSetStones", out_error);
@@ -159,24 +236,7 @@ DigitalCurling_ErrorCode SimulatorGetStonesImpl(SimulatorHandle* sim, DigitalCur
 
     try {
         auto* sim_ptr = dynamic_cast<Simulator*>(sim);
-        auto stones = sim_ptr->GetStones();
-        for (int i = 0; i < digitalcurling::StoneCoordinate::kStoneMax; i++) {
-            if (stones[i].has_value()) {
-                out_stones->stones[i].position.x = stones[i]->position.x;
-                out_stones->stones[i].position.y = stones[i]->position.y;
-                out_stones->stones[i].angle = stones[i]->angle;
-                out_stones->stones[i].translational_velocity.x = stones[i]->translational_velocity.x;
-                out_stones->stones[i].translational_velocity.y = stones[i]->translational_velocity.y;
-                out_stones->stones[i].angular_velocity = stones[i]->angular_velocity;
-            } else {
-                out_stones->stones[i].position.x = 0.f;
-                out_stones->stones[i].position.y = 0.f;
-                out_stones->stones[i].angle = 0.f;
-                out_stones->stones[i].translational_velocity.x = 0.f;
-                out_stones->stones[i].translational_velocity.y = 0.f;
-                out_stones->stones[i].angular_velocity = 0.f;
-            }
-        }
+        FromAllStones(sim_ptr->GetStones(), out_stones);
         return DIGITALCURLING_OK;
     } catch (const std::exception& e) {
         return ReturnException(e, "SimulatorGetStones", out_error);
@@ -198,6 +258,43 @@ DigitalCurling_ErrorCode SimulatorGetCollisionsImpl(SimulatorHandle* sim, char**
     }
 }
 template <typename Simulator>
+DigitalCurling_ErrorCode SimulatorGetCollisionRecordsImpl(SimulatorHandle* sim, DigitalCurling_Collision* out_collisions, const size_t capacity, size_t* out_count, char** out_error)
+{
+    if (!sim)
+        return ReturnError(DIGITALCURLING_ERR_INVALID_ARGUMENT, "SimulatorGetCollisionRecords: simulator handle is nullptr.", out_error);
+    if (!out_count)
+        return ReturnError(DIGITALCURLING_ERR_BUFFER_NULLPTR, "SimulatorGetCollisionRecords: out_count is nullptr.", out_error);
+    if (capacity > 0 && !out_collisions)
+        return ReturnError(DIGITALCURLING_ERR_BUFFER_NULLPTR, "SimulatorGetCollisionRecords: out_collisions is nullptr.", out_error);
+
+    try {
+        auto const& collisions = dynamic_cast<Simulator*>(sim)->GetCollisions();
+        size_t const n = std::min(capacity, collisions.size());
+        for (size_t i = 0; i < n; i++) {
+            out_collisions[i] = ToCollisionRecord(collisions[i]);
+        }
+        *out_count = collisions.size();
+        return DIGITALCURLING_OK;
+    } catch (const std::exception& e) {
+        return ReturnException(e, "SimulatorGetCollisionRecords", out_error);
+    }
+}
+template <typename Simulator>
+DigitalCurling_ErrorCode SimulatorGetStatsImpl(SimulatorHandle* sim, DigitalCurling_SimulatorStats* out_stats, char** out_error)
+{
+    if (!sim)
+        return ReturnError(DIGITALCURLING_ERR_INVALID_ARGUMENT, "SimulatorGetStats: simulator handle is nullptr.", out_error);
+    if (!out_stats)
+        return ReturnError(DIGITALCURLING_ERR_BUFFER_NULLPTR, "SimulatorGetStats: out_stats is nullptr.", out_error);
+
+    try {
+        *out_stats = ToSimulatorStatsRecord(dynamic_cast<Simulator*>(sim)->GetStats());
+        return DIGITALCURLING_OK;
+    } catch (const std::exception& e) {
+        return ReturnException(e, "SimulatorGetStats", out_error);
+    }
+}
+template <typename Simulator>
 DigitalCurling_ErrorCode SimulatorGetSecondsPerFrameImpl(SimulatorHandle* sim, float* out_seconds, char** out_error)
 {
     if (!sim)
@@ -213,6 +310,45 @@ DigitalCurling_ErrorCode SimulatorGetSecondsPerFrameImpl(SimulatorHandle* sim, f
     }
 }
 
+template <typename Simulator>
+DigitalCurling_ErrorCode SimulatorSimulateBatchImpl(SimulatorHandle* sim, const DigitalCurling_StoneCoordinate* stones, const DigitalCurling_Shot* shots, const size_t count,
+                                       const int shot_stone_index, const DigitalCurling_SimulateModeFlag mode_flag, const float sheet_width,
+                                       DigitalCurling_StoneCoordinate* out_stones, char** out_error)
+{
+    if (!sim)
+        return ReturnError(DIGITALCURLING_ERR_INVALID_ARGUMENT, "SimulatorSimulateBatch: simulator handle is nullptr.", out_error);
+    if (count == 0)
+        return DIGITALCURLING_OK;
+    if (!stones)
+        return ReturnError(DIGITALCURLING_ERR_INVALID_ARGUMENT, "SimulatorSimulateBatch: stones is nullptr.", out_error);
+    if (!out_stones)
+        return ReturnError(DIGITALCURLING_ERR_BUFFER_NULLPTR, "SimulatorSimulateBatch: out_stones is nullptr.", out_error);
+    if (shots && (shot_stone_index < 0 || shot_stone_index >= digitalcurling::StoneCoordinate::kStoneMax))
+        return ReturnError(DIGITALCURLING_ERR_INVALID_ARGUMENT, "SimulatorSimulateBatch: shot_stone_index is out of range.", out_error);
+    if (mode_flag & DIGITALCURLING_SIMULATE_MODE_OUT_STONE && sheet_width <= digitalcurling::Stone::kRadius * 2)
+        return ReturnError(DIGITALCURLING_ERR_INVALID_ARGUMENT, "SimulatorSimulateBatch: sheet_width must be positive when OUT_STONE mode is set.", out_error);
+
+    try {
+        auto* sim_ptr = dynamic_cast<Simulator*>(sim);
+        for (size_t i = 0; i < count; i++) {
+            DIGITALCURLING_TRACE_SCOPE("simulator", "SimulateBatchItem");
+            auto stones_data = ToAllStones(stones[i]);
+            if (shots) {
+                digitalcurling::moves::Shot const shot(shots[i].translational_velocity, shots[i].angular_velocity, shots[i].release_angle);
+                stones_data[shot_stone_index] = digitalcurling::simulators::ISimulator::StoneState{
+                    digitalcurling::Vector2(), 0.f, shot.ToVector2(), shot.angular_velocity
+                };
+            }
+            sim_ptr->SetStones(stones_data);
+            SimulatorSimulateLoopBody(sim_ptr, mode_flag, 0, sheet_width);
+            FromAllStones(sim_ptr->GetStones(), &out_stones[i]);
+        }
+        return DIGITALCURLING_OK;
+    } catch (const std::exception& e) {
+        return ReturnException(e, "SimulatorSimulateBatch", out_error);
+    }
+}
+
 template <typename Simulator, moves::Shot (Simulator::*CalcShotFunc)(Vector2 const&, float, float) const>
 DigitalCurling_ErrorCode SimulatorCalculateShotImpl(SimulatorHandle* sim, const DigitalCurling_Vector2* target_position, const float target_speed, const float angular_velocity,
                                        DigitalCurling_Shot* out_shot, char** out_error)
@@ -258,7 +394,12 @@ DigitalCurling_ErrorCode SimulatorCalculateShotImpl(SimulatorHandle* sim, const
         /*get_collisions*/ &digitalcurling::plugins::detail::SimulatorGetCollisionsImpl<SimulatorClass>, \
         /*get_seconds_per_frame*/ &digitalcurling::plugins::detail::SimulatorGetSecondsPerFrameImpl<SimulatorClass>, \
         \
-        /*calculate_shot*/ __VA_ARGS__ \
+        /*calculate_shot*/ __VA_ARGS__, \
+        \
+        /*simulate_batch*/ &digitalcurling::plugins::detail::SimulatorSimulateBatchImpl<SimulatorClass>, \
+        /*get_collision_records*/ &digitalcurling::plugins::detail::SimulatorGetCollisionRecordsImpl<SimulatorClass>, \
+        \
+        /*get_stats*/ &digitalcurling::plugins::detail::SimulatorGetStatsImpl<SimulatorClass>, \
     }; \
     DIGITALCURLING_EXPORT_PLUGIN_INNER(digitalcurling::plugins::PluginType::simulator, FactoryClass, StorageClass, SimulatorClass, nullptr, &g_simulator_api_instance)
 
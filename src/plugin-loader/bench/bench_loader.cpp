@@ -0,0 +1,208 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+// シミュレーター呼び出しのコストを経路ごとに比較するベンチマーク
+//
+// - native: プラグインの実体を直接呼び出す (DIGITALCURLING_BUNDLE_PLUGINS が有効な場合のみ)
+// - plugin: PluginSimulator (C ABI) 経由で呼び出す
+// - c_api: dc_loader_* を UUID で呼び出す
+// - c_api_handle: dc_loader_simulator_handle_* をインスタンスハンドルで呼び出す
+//
+// 動的ロードの場合、プラグインは環境変数 DIGITALCURLING_BENCH_PLUGINS_DIR のディレクトリからロードします。
+
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <benchmark/benchmark.h>
+#include "digitalcurling/coordinate.hpp"
+#include "digitalcurling/plugins/loader.h"
+#include "digitalcurling/plugins/loader_types.h"
+#include "digitalcurling/plugins/plugin_manager.hpp"
+#include "digitalcurling/simulators/plugin_simulator.hpp"
+#include "digitalcurling/simulators/plugin_simulator_factory.hpp"
+
+namespace {
+
+using namespace digitalcurling;
+
+const char* kSimPluginName = "fcv1";
+const char* kSimConfig = "{\"type\":\"fcv1\"}";
+constexpr float kSheetWidth = 4.75f;
+
+// シミュレーターのプラグインをロードする (失敗した場合はエラーメッセージを返す)
+std::optional<std::string> const& LoadSimulatorPlugin()
+{
+    static std::optional<std::string> const error = []() -> std::optional<std::string> {
+        auto& manager = plugins::PluginManager::GetInstance();
+#ifndef DIGITALCURLING_BUNDLE_PLUGINS
+        std::filesystem::path plugin_dir("plugins");
+#ifdef DIGITALCURLING_BENCH_PLUGINS_DIR
+        plugin_dir = DIGITALCURLING_BENCH_PLUGINS_DIR;
+#endif
+        if (auto const* env = std::getenv("DIGITALCURLING_BENCH_PLUGINS_DIR")) plugin_dir = env;
+        auto const sim_path = plugin_dir /
+            ("digitalcurling_simulator_" + std::string(kSimPluginName) + plugins::LibraryExtension);
+        try {
+            manager.LoadPlugin(sim_path, true);
+        } catch (std::exception const& e) {
+            return std::string("failed to load plugin: ") + e.what();
+        }
+#endif
+        if (!manager.IsPluginLoaded(plugins::PluginType::simulator, kSimPluginName)) {
+            return std::string("simulator plugin '") + kSimPluginName + "' is not loaded.";
+        }
+        return std::nullopt;
+    }();
+    return error;
+}
+
+std::unique_ptr<simulators::ISimulator> CreatePluginSimulator(benchmark::State& bm)
+{
+    if (auto const& error = LoadSimulatorPlugin()) {
+        bm.SkipWithError(error->c_str());
+        return nullptr;
+    }
+    auto factory = plugins::PluginManager::GetInstance().CreateSimulatorFactory(std::string(kSimPluginName));
+    return factory->CreateSimulator();
+}
+
+// C API でシミュレーターを作成する
+std::optional<DigitalCurling_Uuid> CreateCApiSimulator(benchmark::State& bm)
+{
+    if (auto const& error = LoadSimulatorPlugin()) {
+        bm.SkipWithError(error->c_str());
+        return std::nullopt;
+    }
+    DigitalCurling_Uuid factory_id;
+    DigitalCurling_Uuid simulator_id;
+    if (dc_loader_create_simulator_factory(kSimPluginName, kSimConfig, &factory_id) != DIGITALCURLING_OK ||
+        dc_loader_create_simulator(&factory_id, &simulator_id) != DIGITALCURLING_OK) {
+        bm.SkipWithError("failed to create simulator via C API.");
+        return std::nullopt;
+    }
+    return simulator_id;
+}
+
+simulators::ISimulator::AllStones MakeStones()
+{
+    simulators::ISimulator::AllStones stones;
+    stones[0] = simulators::ISimulator::StoneState(Vector2(0.f, 10.f), 0.f, Vector2(0.f, 2.f), 1.57f);
+    stones[8] = simulators::ISimulator::StoneState(coordinate::kTee, 0.f, Vector2(), 0.f);
+    return stones;
+}
+
+DigitalCurling_StoneCoordinate MakeCStones()
+{
+    DigitalCurling_StoneCoordinate stones = {};
+    stones.stones[0] = { { 0.f, 10.f }, 0.f, { 0.f, 2.f }, 1.57f };
+    stones.stones[8] = { { coordinate::kTee.x, coordinate::kTee.y }, 0.f, { 0.f, 0.f }, 0.f };
+    return stones;
+}
+
+// ISimulator の呼び出し (SetStones, Step, GetStones) のコスト
+void RunSimulatorCalls(benchmark::State& bm, simulators::ISimulator& simulator)
+{
+    auto const stones = MakeStones();
+    for (auto _ : bm) {
+        simulator.SetStones(stones);
+        simulator.Step();
+        benchmark::DoNotOptimize(simulator.GetStones());
+    }
+    bm.SetItemsProcessed(bm.iterations() * 3);
+}
+
+void BM_LoaderCallsNative(benchmark::State& bm)
+{
+    auto simulator = CreatePluginSimulator(bm);
+    if (!simulator) return;
+    auto* native = static_cast<simulators::PluginSimulator&>(*simulator).GetNative();
+    if (!native) {
+        bm.SkipWithError("native simulator is available only with DIGITALCURLING_BUNDLE_PLUGINS.");
+        return;
+    }
+    RunSimulatorCalls(bm, *native);
+}
+BENCHMARK(BM_LoaderCallsNative);
+
+void BM_LoaderCallsPluginSimulator(benchmark::State& bm)
+{
+    auto simulator = CreatePluginSimulator(bm);
+    if (!simulator) return;
+    RunSimulatorCalls(bm, *simulator);
+}
+BENCHMARK(BM_LoaderCallsPluginSimulator);
+
+void BM_LoaderCallsCApi(benchmark::State& bm)
+{
+    auto const id = CreateCApiSimulator(bm);
+    if (!id) return;
+    auto const stones = MakeCStones();
+    DigitalCurling_StoneCoordinate out;
+    for (auto _ : bm) {
+        dc_loader_simulator_set_stones(&*id, &stones);
+        dc_loader_simulator_step(&*id, 1, kSheetWidth);
+        dc_loader_simulator_get_stones(&*id, &out);
+        benchmark::DoNotOptimize(out);
+    }
+    bm.SetItemsProcessed(bm.iterations() * 3);
+    dc_loader_remove_simulator_instance(&*id);
+}
+BENCHMARK(BM_LoaderCallsCApi);
+
+void BM_LoaderCallsCApiHandle(benchmark::State& bm)
+{
+    auto const id = CreateCApiSimulator(bm);
+    if (!id) return;
+    DigitalCurling_InstanceHandle handle;
+    if (dc_loader_acquire_instance_handle(&*id, &handle) != DIGITALCURLING_OK) {
+        bm.SkipWithError("failed to acquire instance handle.");
+        return;
+    }
+    auto const stones = MakeCStones();
+    DigitalCurling_StoneCoordinate out;
+    for (auto _ : bm) {
+        dc_loader_simulator_handle_set_stones(handle, &stones);
+        dc_loader_simulator_handle_step(handle, 1, kSheetWidth);
+        dc_loader_simulator_handle_get_stones(handle, &out);
+        benchmark::DoNotOptimize(out);
+    }
+    bm.SetItemsProcessed(bm.iterations() * 3);
+    dc_loader_release_instance_handle(handle);
+    dc_loader_remove_simulator_instance(&*id);
+}
+BENCHMARK(BM_LoaderCallsCApiHandle);
+
+// 停止するまでのシミュレーション (プラグイン内でループする)
+void BM_LoaderSimulatePluginSimulator(benchmark::State& bm)
+{
+    auto simulator = CreatePluginSimulator(bm);
+    if (!simulator) return;
+    auto& plugin_simulator = static_cast<simulators::PluginSimulator&>(*simulator);
+    auto const stones = MakeStones();
+    for (auto _ : bm) {
+        plugin_simulator.SetStones(stones);
+        plugin_simulator.Simulate(simulators::SimulateModeFlag::Full, kSheetWidth);
+        benchmark::DoNotOptimize(plugin_simulator.GetStones());
+    }
+}
+BENCHMARK(BM_LoaderSimulatePluginSimulator)->Unit(benchmark::kMicrosecond);
+
+void BM_LoaderSimulateCApi(benchmark::State& bm)
+{
+    auto const id = CreateCApiSimulator(bm);
+    if (!id) return;
+    auto const stones = MakeCStones();
+    DigitalCurling_StoneCoordinate out;
+    for (auto _ : bm) {
+        dc_loader_simulator_set_stones(&*id, &stones);
+        dc_loader_simulator_simulate(&*id, DIGITALCURLING_SIMULATE_MODE_FULL, kSheetWidth);
+        dc_loader_simulator_get_stones(&*id, &out);
+        benchmark::DoNotOptimize(out);
+    }
+    dc_loader_remove_simulator_instance(&*id);
+}
+BENCHMARK(BM_LoaderSimulateCApi)->Unit(benchmark::kMicrosecond);
+
+} // unnamed namespace
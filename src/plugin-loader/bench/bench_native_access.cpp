@@ -0,0 +1,104 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+// シミュレーター呼び出しのコストを比較するベンチマーク
+//
+// - DIGITALCURLING_BUNDLE_PLUGINS が有効な場合: 静的リンクしたプラグインを C ABI 経由 (bundled-abi) と直接 (bundled-direct) で呼び出す
+// - 無効な場合: 動的にロードしたプラグインを C ABI 経由 (dynamic-abi) で呼び出す
+//
+// 使い方: digitalcurling_bench_native_access [反復回数] [プラグインディレクトリ]
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include "digitalcurling/plugins/plugin_manager.hpp"
+#include "digitalcurling/simulators/plugin_simulator.hpp"
+#include "digitalcurling/simulators/plugin_simulator_factory.hpp"
+
+namespace {
+
+using namespace digitalcurling;
+
+const char* kSimPluginName = "fcv1";
+
+// 1 回の反復で SetStones, Step, AreAllStonesStopped を呼び出し, 1 呼び出しあたりの時間 (ns) を返す
+double Measure(simulators::ISimulator & simulator, int iterations)
+{
+    simulators::ISimulator::AllStones stones;
+    stones[0] = simulators::ISimulator::StoneState{ {0.f, 10.f}, 0.f, {0.f, -1.f}, 0.f };
+
+    auto const start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        simulator.SetStones(stones);
+        simulator.Step();
+        simulator.AreAllStonesStopped();
+    }
+    auto const end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / (iterations * 3.0);
+}
+
+void Report(const char* name, double ns_per_call)
+{
+    std::cout << name << ": " << ns_per_call << " ns/call" << std::endl;
+}
+
+} // unnamed namespace
+
+int main(int argc, char* argv[])
+{
+    int const iterations = argc > 1 ? std::atoi(argv[1]) : 100000;
+    if (iterations <= 0) {
+        std::cerr << "invalid iterations: " << argv[1] << std::endl;
+        return 1;
+    }
+
+    auto& manager = plugins::PluginManager::GetInstance();
+
+#ifndef DIGITALCURLING_BUNDLE_PLUGINS
+    std::filesystem::path plugin_dir = argc > 2 ? std::filesystem::path(argv[2]) : std::filesystem::path("plugins");
+#ifdef DIGITALCURLING_BENCH_PLUGINS_DIR
+    if (argc <= 2) plugin_dir = std::filesystem::path(DIGITALCURLING_BENCH_PLUGINS_DIR);
+#endif
+    auto const sim_path = plugin_dir /
+        ("digitalcurling_simulator_" + std::string(kSimPluginName) + plugins::LibraryExtension);
+    try {
+        manager.LoadPlugin(sim_path, true);
+    } catch (std::exception const& e) {
+        std::cerr << "failed to load plugin: " << e.what() << std::endl;
+        return 1;
+    }
+#endif
+
+    if (!manager.IsPluginLoaded(plugins::PluginType::simulator, kSimPluginName)) {
+        std::cerr << "simulator plugin '" << kSimPluginName << "' is not loaded." << std::endl;
+        return 1;
+    }
+
+    // 通常と同じく Factory (JSON で設定可能) からシミュレーターを生成する
+    auto factory = manager.CreateSimulatorFactory(std::string(kSimPluginName));
+    auto simulator = factory->CreateSimulator();
+    auto* plugin_simulator = dynamic_cast<simulators::PluginSimulator*>(simulator.get());
+    if (!plugin_simulator) {
+        std::cerr << "simulator is not a plugin simulator." << std::endl;
+        return 1;
+    }
+
+    std::cout << "iterations: " << iterations << std::endl;
+#ifdef DIGITALCURLING_BUNDLE_PLUGINS
+    Report("bundled-abi", Measure(*simulator, iterations));
+    auto* native = plugin_simulator->GetNative();
+    if (!native) {
+        std::cerr << "native simulator is not available." << std::endl;
+        return 1;
+    }
+    Report("bundled-direct", Measure(*native, iterations));
+#else
+    Report("dynamic-abi", Measure(*simulator, iterations));
+#endif
+
+    return 0;
+}
@@ -39,12 +39,25 @@ public:
     virtual void Save(IPlayerStorage & storage) const override;
     virtual void Load(IPlayerStorage const& storage) override;
 
+    /// @brief プラグインの実体であるプレイヤーを取得する
+    ///
+    /// プラグインがローダーに静的リンク (`DIGITALCURLING_BUNDLE_PLUGINS`) されている場合のみ取得できます。
+    /// 返されたオブジェクトの呼び出しは C ABI を経由しないため、変換のコストがかかりません。
+    /// @note 返されたオブジェクトはこのインスタンスが破棄されるまで有効です。このインスタンスの排他制御は適用されません。
+    /// @return プラグインの実体 (動的にロードされたプラグインの場合は `nullptr`)
+    IPlayer* GetNative() const { return native_; }
+
 private:
+    // 構築時に解決したプラグイン側のハンドル (インスタンスIDによる検索を省くため)
+    plugins::PlayerHandle* handle_;
+    // 静的リンクされたプラグインの実体 (動的にロードされた場合は nullptr)
+    IPlayer* native_;
+
     mutable std::mutex mutex_;
     mutable std::unique_ptr<IPlayerFactory> factory_cache_;
 
     inline void ClearCaches() {
-        std::lock_guard<std::mutex> lock(mutex_);
+        auto lock = LockIfMultiThreaded(mutex_);
         factory_cache_.reset();
     }
 };
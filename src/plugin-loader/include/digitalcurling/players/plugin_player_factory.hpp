@@ -29,24 +29,37 @@ public:
           { }
 
     virtual std::unique_ptr<IPlayer> CreatePlayer() const override {
-        return ExecuteResourceFunc<std::unique_ptr<IPlayer>>([&](auto resource) {
+        return ExecuteResourceFunc<std::unique_ptr<IPlayer>>([&](auto const& resource) {
             auto id = resource->create_target.Execute(GetInstanceId());
             return std::make_unique<PluginPlayer>(GetPluginId(), id, resource);
         });
     }
 
     virtual std::unique_ptr<IPlayerFactory> Clone() const override {
-        auto json = ToJson();
-        return ExecuteResourceFunc<std::unique_ptr<IPlayerFactory>>([&](auto resource) {
-            auto id = resource->create_factory.Execute(json.dump().c_str());
-            return std::make_unique<PluginPlayerFactory>(GetPluginId(), id, resource);
+        return ExecuteResourceFunc<std::unique_ptr<IPlayerFactory>>([&](auto const& resource) -> std::unique_ptr<IPlayerFactory> {
+            if (!resource->SupportsFactoryBinaryState()) {
+                auto state = resource->object_creator_get_state.Execute(GetInstanceId());
+                auto id = resource->create_factory.Execute(state.c_str());
+                return std::make_unique<PluginPlayerFactory>(GetPluginId(), id, resource);
+            }
+
+            // バイナリ形式に対応している場合は JSON を経由せずに状態を複製する
+            auto state = plugins::detail::PluginResource::GetBinaryState(resource->factory_get_binary_state, GetInstanceId());
+            if (!state) throw state.GetError();
+            auto const& binary = state.GetValue();
+
+            auto id = resource->create_factory.Execute(nullptr);
+            auto cloned = std::make_unique<PluginPlayerFactory>(GetPluginId(), id, resource);
+            auto result = resource->factory_set_binary_state.ExecuteRaw(id, binary.data.data(), binary.data.size(), binary.format_version);
+            if (!result) throw result.GetError();
+            return cloned;
         });
     }
 
     /// @brief このファクトリーの状態を JSON 形式で取得する
     /// @return JSON オブジェクト
     virtual nlohmann::json ToJson() const override {
-        return ExecuteResourceFunc<nlohmann::json>([&](auto resource) {
+        return ExecuteResourceFunc<nlohmann::json>([&](auto const& resource) {
             auto res = resource->object_creator_get_state.Execute(GetInstanceId());
             return nlohmann::json::parse(res);
         });
@@ -60,7 +73,7 @@ public:
     /// @param new_gender 新しい性別
     void SetGender(Gender new_gender) {
         auto json = (nlohmann::json {{ "gender", new_gender }}).dump();
-        ExecuteResourceFunc<void>([&](auto resource) {
+        ExecuteResourceFunc<void>([&](auto const& resource) {
             resource->factory_set_state.Execute(GetInstanceId(), json);
         });
     }
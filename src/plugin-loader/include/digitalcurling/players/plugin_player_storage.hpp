@@ -31,7 +31,7 @@ public:
           { }
 
     virtual std::unique_ptr<IPlayer> CreatePlayer() const override {
-        return ExecuteResourceFunc<std::unique_ptr<IPlayer>>([&](auto resource) {
+        return ExecuteResourceFunc<std::unique_ptr<IPlayer>>([&](auto const& resource) {
             auto id = resource->create_target.Execute(GetInstanceId());
             return std::make_unique<PluginPlayer>(GetPluginId(), id, resource);
         });
@@ -40,7 +40,7 @@ public:
     /// @brief このストレージの状態を JSON 形式で取得する
     /// @return JSON オブジェクト
     virtual nlohmann::json ToJson() const override {
-        return ExecuteResourceFunc<nlohmann::json>([&](auto resource) {
+        return ExecuteResourceFunc<nlohmann::json>([&](auto const& resource) {
             auto res = resource->object_creator_get_state.Execute(GetInstanceId());
             return nlohmann::json::parse(res);
         });
@@ -54,7 +54,7 @@ public:
     /// @param new_gender 新しい性別
     void SetGender(Gender new_gender) {
         auto json = (nlohmann::json {{ "gender", new_gender }}).dump();
-        ExecuteResourceFunc<void>([&](auto resource) {
+        ExecuteResourceFunc<void>([&](auto const& resource) {
             resource->factory_set_state.Execute(GetInstanceId(), json);
         });
     }
@@ -149,6 +149,76 @@ struct CTypeConverter<simulators::ISimulator::AllStones, DigitalCurling_StoneCoo
     }
 };
 
+template<>
+struct CTypeConverter<simulators::ISimulator::Collision, DigitalCurling_Collision> {
+    static constexpr bool needs_resolver = false;
+
+    static const DigitalCurling_Collision ToCType(const simulators::ISimulator::Collision& value) {
+        return DigitalCurling_Collision { ToCStone(value.a), ToCStone(value.b), value.normal_impulse, value.tangent_impulse };
+    }
+    static const simulators::ISimulator::Collision FromCType(const DigitalCurling_Collision& c_value) {
+        return simulators::ISimulator::Collision { FromCStone(c_value.a), FromCStone(c_value.b), c_value.normal_impulse, c_value.tangent_impulse };
+    }
+
+private:
+    static DigitalCurling_CollisionStone ToCStone(const simulators::ISimulator::Collision::CollisionStone& value) {
+        return DigitalCurling_CollisionStone {
+            value.id,
+            CTypeConverter<Vector2, DigitalCurling_Vector2>::ToCType(value.stone.position),
+            value.stone.angle,
+            CTypeConverter<Vector2, DigitalCurling_Vector2>::ToCType(value.stone.translational_velocity),
+            value.stone.angular_velocity
+        };
+    }
+    static simulators::ISimulator::Collision::CollisionStone FromCStone(const DigitalCurling_CollisionStone& c_value) {
+        return simulators::ISimulator::Collision::CollisionStone {
+            c_value.id,
+            simulators::ISimulator::StoneState {
+                CTypeConverter<Vector2, DigitalCurling_Vector2>::FromCType(c_value.position),
+                c_value.angle,
+                CTypeConverter<Vector2, DigitalCurling_Vector2>::FromCType(c_value.translational_velocity),
+                c_value.angular_velocity
+            }
+        };
+    }
+};
+
+template<>
+struct CTypeConverter<simulators::SimulatorStats, DigitalCurling_SimulatorStats> {
+    static constexpr bool needs_resolver = false;
+
+    static const DigitalCurling_SimulatorStats ToCType(const simulators::SimulatorStats& value) {
+        return DigitalCurling_SimulatorStats {
+            value.frames,
+            value.contacts_begun,
+            value.contacts_solved,
+            value.out_of_sheet_removals,
+            value.set_stones_calls,
+            value.load_calls,
+            value.motion_seconds,
+            value.world_step_seconds,
+            value.fast_path_shots,
+            value.fast_path_frames,
+            value.fast_path_rejections
+        };
+    }
+    static const simulators::SimulatorStats FromCType(const DigitalCurling_SimulatorStats& c_value) {
+        simulators::SimulatorStats stats;
+        stats.frames = c_value.frames;
+        stats.contacts_begun = c_value.contacts_begun;
+        stats.contacts_solved = c_value.contacts_solved;
+        stats.out_of_sheet_removals = c_value.out_of_sheet_removals;
+        stats.set_stones_calls = c_value.set_stones_calls;
+        stats.load_calls = c_value.load_calls;
+        stats.motion_seconds = c_value.motion_seconds;
+        stats.world_step_seconds = c_value.world_step_seconds;
+        stats.fast_path_shots = c_value.fast_path_shots;
+        stats.fast_path_frames = c_value.fast_path_frames;
+        stats.fast_path_rejections = c_value.fast_path_rejections;
+        return stats;
+    }
+};
+
 // --- CTypeConverter (Read/Write) Specializations ---
 template<>
 struct CTypeConverter<std::string, char*> {
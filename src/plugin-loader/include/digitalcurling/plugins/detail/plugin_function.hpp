@@ -19,6 +19,7 @@
 #include "digitalcurling/plugins/plugin_api.hpp"
 #include "digitalcurling/plugins/plugin_error.hpp"
 #include "digitalcurling/plugins/detail/c_type_converter.hpp"
+#include "digitalcurling/trace.hpp"
 
 #if !defined(_WIN32) && !defined(__cdecl)
     #define __cdecl
@@ -140,11 +141,12 @@ public:
     virtual explicit operator bool() const = 0;
 
 protected:
-    PluginFunctionBase(FreeStringFunc free_string_func, PluginInstanceList& instance_list)
-        : free_string_func_(free_string_func), instance_list_(instance_list) {}
+    PluginFunctionBase(FreeStringFunc free_string_func, PluginInstanceList& instance_list, const char* trace_name)
+        : free_string_func_(free_string_func), instance_list_(instance_list), trace_name_(trace_name) {}
 
     FreeStringFunc free_string_func_;
     PluginInstanceList& instance_list_;
+    const char* trace_name_;  // トレースでの区間の名前 (文字列リテラル)
 
     template<typename T>
     auto GetCArg(T& arg) const {
@@ -233,8 +235,8 @@ class PluginFunction : public PluginFunctionBase {
     using CResultType = typename Traits::ResultType;
 
 public:
-    PluginFunction(FuncPtr func_ptr, FreeStringFunc free, PluginInstanceList& list)
-        : PluginFunctionBase(free, list), func_ptr_(func_ptr) {}
+    PluginFunction(FuncPtr func_ptr, FreeStringFunc free, PluginInstanceList& list, const char* trace_name = "PluginFunction")
+        : PluginFunctionBase(free, list, trace_name), func_ptr_(func_ptr) {}
 
     virtual explicit operator bool() const {
         return func_ptr_ != nullptr && free_string_func_ != nullptr;
@@ -244,6 +246,8 @@ public:
     CppReturnType Execute(CppArgs&&... cpp_args) const {
         auto res = ExecuteImpl<true>(std::forward<CppArgs>(cpp_args)...);
         if (!res) throw res.GetError();
+
+        DIGITALCURLING_TRACE_SCOPE("plugin", "ConvertResult");
         return CTypeConverter<CppReturnType, CResultType>::FromCType(res.GetValue());
     }
     template<typename... CppArgs>
@@ -262,20 +266,28 @@ private:
 
     template<bool IsCpp, typename... CppArgs>
     PluginFunctionResult<CResultType> ExecuteImpl(CppArgs&&... cpp_args) const {
+        DIGITALCURLING_TRACE_SCOPE("plugin", trace_name_);
         if (auto err = CheckValid(reinterpret_cast<void*>(func_ptr_)); err)
             return err.value();
 
         auto cpp_tuple = std::make_tuple(std::forward<CppArgs>(cpp_args)...);
-        auto c_args_tuple = ConvertTuple<IsCpp, CArgTuple>(
-            cpp_tuple, std::make_index_sequence<sizeof...(CppArgs)>{}
-        );
+        auto c_args_tuple = [&] {
+            DIGITALCURLING_TRACE_SCOPE("plugin", "ResolveArgs");
+            return ConvertTuple<IsCpp, CArgTuple>(
+                cpp_tuple, std::make_index_sequence<sizeof...(CppArgs)>{}
+            );
+        }();
 
         CResultType c_result{};
         char* error_buffer = nullptr;
-        DigitalCurling_ErrorCode err = std::apply(
-            [&](auto&... c_args) { return func_ptr_(GetCArg(c_args)..., &c_result, &error_buffer); },
-            c_args_tuple
-        );
+        DigitalCurling_ErrorCode err;
+        {
+            DIGITALCURLING_TRACE_SCOPE("plugin", "PluginCall");
+            err = std::apply(
+                [&](auto&... c_args) { return func_ptr_(GetCArg(c_args)..., &c_result, &error_buffer); },
+                c_args_tuple
+            );
+        }
 
         if (err != DIGITALCURLING_OK)
             return plugin_error { err, GetErrorMessageAndFree(error_buffer) };
@@ -299,8 +311,8 @@ class PluginFunction<
     static_assert(std::is_same_v<typename Traits::ResultType, char*>, "CResultType must be char* for this specialization.");
 
 public:
-    PluginFunction(FuncPtr func_ptr, FreeStringFunc free, PluginInstanceList& list)
-        : PluginFunctionBase(free, list), func_ptr_(func_ptr) {}
+    PluginFunction(FuncPtr func_ptr, FreeStringFunc free, PluginInstanceList& list, const char* trace_name = "PluginFunction")
+        : PluginFunctionBase(free, list, trace_name), func_ptr_(func_ptr) {}
 
     virtual explicit operator bool() const {
         return func_ptr_ != nullptr && free_string_func_ != nullptr;
@@ -314,6 +326,7 @@ public:
         auto ptr = res.GetValue();
         if (!ptr) throw plugin_error{DIGITALCURLING_ERR_UNKNOWN, "Result string is null."};
 
+        DIGITALCURLING_TRACE_SCOPE("plugin", "ConvertResult");
         auto ret = CTypeConverter<CppReturnType, char*>::FromCType(ptr);
         free_string_func_(ptr);
         return ret;
@@ -342,20 +355,28 @@ private:
 
     template<bool IsCpp, typename... CppArgs>
     PluginFunctionResult<char*> ExecuteImpl(CppArgs&&... cpp_args) const {
+        DIGITALCURLING_TRACE_SCOPE("plugin", trace_name_);
         if (auto err = CheckValid(reinterpret_cast<void*>(func_ptr_)); err)
             return err.value();
 
         auto cpp_tuple = std::make_tuple(std::forward<CppArgs>(cpp_args)...);
-        auto c_args_tuple = ConvertTuple<IsCpp, CArgTuple>(
-            cpp_tuple, std::make_index_sequence<sizeof...(CppArgs)>{}
-        );
+        auto c_args_tuple = [&] {
+            DIGITALCURLING_TRACE_SCOPE("plugin", "ResolveArgs");
+            return ConvertTuple<IsCpp, CArgTuple>(
+                cpp_tuple, std::make_index_sequence<sizeof...(CppArgs)>{}
+            );
+        }();
 
         char* c_result{};
         char* error_buffer = nullptr;
-        DigitalCurling_ErrorCode err = std::apply(
-            [&](auto&... c_args) { return func_ptr_(GetCArg(c_args)..., &c_result, &error_buffer); },
-            c_args_tuple
-        );
+        DigitalCurling_ErrorCode err;
+        {
+            DIGITALCURLING_TRACE_SCOPE("plugin", "PluginCall");
+            err = std::apply(
+                [&](auto&... c_args) { return func_ptr_(GetCArg(c_args)..., &c_result, &error_buffer); },
+                c_args_tuple
+            );
+        }
 
         if (err != DIGITALCURLING_OK) {
             if (c_result) this->free_string_func_(c_result);
@@ -373,8 +394,8 @@ class PluginFunction<FuncPtr, void, void> : public PluginFunctionBase {
     using CArgTuple = typename Traits::ArgTuple;
 
 public:
-    PluginFunction(FuncPtr func_ptr, FreeStringFunc free, PluginInstanceList& list)
-        : PluginFunctionBase(free, list), func_ptr_(func_ptr) {}
+    PluginFunction(FuncPtr func_ptr, FreeStringFunc free, PluginInstanceList& list, const char* trace_name = "PluginFunction")
+        : PluginFunctionBase(free, list, trace_name), func_ptr_(func_ptr) {}
 
     virtual explicit operator bool() const {
         return func_ptr_ != nullptr && free_string_func_ != nullptr;
@@ -401,19 +422,27 @@ private:
 
     template<bool IsCpp, typename... CppArgs>
     PluginFunctionResult<void> ExecuteImpl(CppArgs&&... cpp_args) const {
+        DIGITALCURLING_TRACE_SCOPE("plugin", trace_name_);
         if (auto err = CheckValid(reinterpret_cast<void*>(func_ptr_)); err)
             return err.value();
 
         auto cpp_tuple = std::make_tuple(std::forward<CppArgs>(cpp_args)...);
-        auto c_args_tuple = ConvertTuple<IsCpp, CArgTuple>(
-            cpp_tuple, std::make_index_sequence<sizeof...(CppArgs)>{}
-        );
+        auto c_args_tuple = [&] {
+            DIGITALCURLING_TRACE_SCOPE("plugin", "ResolveArgs");
+            return ConvertTuple<IsCpp, CArgTuple>(
+                cpp_tuple, std::make_index_sequence<sizeof...(CppArgs)>{}
+            );
+        }();
 
         char* error_buffer = nullptr;
-        DigitalCurling_ErrorCode err = std::apply(
-            [&](auto&... c_args) { return func_ptr_(GetCArg(c_args)..., &error_buffer); },
-            c_args_tuple
-        );
+        DigitalCurling_ErrorCode err;
+        {
+            DIGITALCURLING_TRACE_SCOPE("plugin", "PluginCall");
+            err = std::apply(
+                [&](auto&... c_args) { return func_ptr_(GetCArg(c_args)..., &error_buffer); },
+                c_args_tuple
+            );
+        }
 
         if (err != DIGITALCURLING_OK)
             return plugin_error { err, GetErrorMessageAndFree(error_buffer) };
@@ -431,8 +460,8 @@ class PluginFunction<FuncPtr, uuidv7::uuidv7, void> : public PluginFunctionBase
     using CResultType = typename Traits::ResultType;
 
 public:
-    PluginFunction(FuncPtr func_ptr, FreeStringFunc free, DestroyObjectFunc destroy, PluginInstanceList& list)
-        : PluginFunctionBase(free, list), func_ptr_(func_ptr), destroy_obj_func_(destroy) {}
+    PluginFunction(FuncPtr func_ptr, FreeStringFunc free, DestroyObjectFunc destroy, PluginInstanceList& list, const char* trace_name = "PluginFunction")
+        : PluginFunctionBase(free, list, trace_name), func_ptr_(func_ptr), destroy_obj_func_(destroy) {}
 
     virtual explicit operator bool() const {
         return func_ptr_ != nullptr && free_string_func_ != nullptr && destroy_obj_func_ != nullptr;
@@ -461,22 +490,30 @@ private:
 
     template<bool IsCpp, typename... CppArgs>
     PluginFunctionResult<uuidv7::uuidv7> ExecuteImpl(CppArgs&&... cpp_args) const {
+        DIGITALCURLING_TRACE_SCOPE("plugin", trace_name_);
         if (auto err = CheckValid(reinterpret_cast<void*>(func_ptr_)); err)
             return err.value();
         if (!destroy_obj_func_)
             return plugin_error{DIGITALCURLING_ERR_UNKNOWN, "Destroy object function pointer is null."};
 
         auto cpp_tuple = std::make_tuple(std::forward<CppArgs>(cpp_args)...);
-        auto c_args_tuple = ConvertTuple<IsCpp, CArgTuple>(
-            cpp_tuple, std::make_index_sequence<sizeof...(CppArgs)>{}
-        );
+        auto c_args_tuple = [&] {
+            DIGITALCURLING_TRACE_SCOPE("plugin", "ResolveArgs");
+            return ConvertTuple<IsCpp, CArgTuple>(
+                cpp_tuple, std::make_index_sequence<sizeof...(CppArgs)>{}
+            );
+        }();
 
         CResultType c_result{};
         char* error_buffer = nullptr;
-        DigitalCurling_ErrorCode err = std::apply(
-            [&](auto&... c_args) { return func_ptr_(GetCArg(c_args)..., &c_result, &error_buffer); },
-            c_args_tuple
-        );
+        DigitalCurling_ErrorCode err;
+        {
+            DIGITALCURLING_TRACE_SCOPE("plugin", "PluginCall");
+            err = std::apply(
+                [&](auto&... c_args) { return func_ptr_(GetCArg(c_args)..., &c_result, &error_buffer); },
+                c_args_tuple
+            );
+        }
 
         if (err != DIGITALCURLING_OK) {
             if (c_result) destroy_obj_func_(c_result);
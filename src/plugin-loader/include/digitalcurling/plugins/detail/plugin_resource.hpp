@@ -3,9 +3,13 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <vector>
 #include <uuidv7/uuidv7.hpp>
 
 #include "digitalcurling/plugins/plugin_api.hpp"
@@ -18,7 +22,15 @@ namespace digitalcurling::plugins::detail {
 class PlayerPluginResource;
 class SimulatorPluginResource;
 
+/// @brief プラグインが定義するバイナリ形式の状態
+struct BinaryState {
+    std::vector<std::uint8_t> data;
+    unsigned int format_version = 0;
+};
+
 class PluginResource {
+    static constexpr size_t kBinaryStateInitialCapacity = 256;
+
 public:
     PluginResource(const PluginResource&) = delete;
     PluginResource& operator=(const PluginResource&) = delete;
@@ -30,8 +42,15 @@ public:
     static std::shared_ptr<PluginResource> Create(PluginInfo info, PluginApi api, std::optional<ModulePtr> handle);
 
     PluginType GetType() const { return static_cast<PluginType>(info_.plugin_type); }
+    unsigned int GetApiVersion() const { return info_.plugin_version; }
     std::string GetName() const { return info_.plugin_name; }
     PluginInstanceList& GetInstanceList() { return instance_list_; }
+    /// @brief ローダーに静的リンクされたプラグインか
+    bool IsStatic() const { return !handle_.has_value(); }
+    /// @brief インスタンスを破棄する
+    /// @param id インスタンスID
+    /// @return インスタンスが存在した場合 `true`
+    virtual bool RemoveInstance(const uuidv7::uuidv7& id) { return instance_list_.Remove(id); }
 
     const PluginFunction<CreateFactoryFunc, uuidv7::uuidv7> create_factory;
     const PluginFunction<CreateStorageFunc, uuidv7::uuidv7> create_storage;
@@ -39,6 +58,40 @@ public:
     const PluginFunction<ObjectCreatorGetStateFunc, std::string> object_creator_get_state;
     const PluginFunction<FactorySetStateFunc, void> factory_set_state;
     const PluginFunction<StorageSetStateFunc, void> storage_set_state;
+    const PluginFunction<FactoryGetBinaryStateFunc, void> factory_get_binary_state;
+    const PluginFunction<StorageGetBinaryStateFunc, void> storage_get_binary_state;
+    const PluginFunction<FactorySetBinaryStateFunc, void> factory_set_binary_state;
+    const PluginFunction<StorageSetBinaryStateFunc, void> storage_set_binary_state;
+    const PluginFunction<TraceStartFunc, void> trace_start;
+    const PluginFunction<TraceStopFunc, std::string> trace_stop;
+
+    bool SupportsFactoryBinaryState() const { return factory_get_binary_state && factory_set_binary_state; }
+    bool SupportsStorageBinaryState() const { return storage_get_binary_state && storage_set_binary_state; }
+    bool SupportsTrace() const { return trace_start && trace_stop; }
+
+    /// @brief バイナリ形式の状態を取得する
+    /// @param get_binary_state `factory_get_binary_state` または `storage_get_binary_state`
+    /// @param id Factory / Storage のインスタンスID
+    /// @return 状態とバイナリ形式のバージョン
+    template <typename FuncPtr>
+    static PluginFunctionResult<BinaryState> GetBinaryState(const PluginFunction<FuncPtr, void>& get_binary_state, const uuidv7::uuidv7& id) {
+        BinaryState state;
+        state.data.resize(kBinaryStateInitialCapacity);
+        for (int attempt = 0; ; ++attempt) {
+            std::uint8_t* buffer = state.data.data();
+            size_t size = 0;
+            size_t* size_ptr = &size;
+            unsigned int* version_ptr = &state.format_version;
+            auto result = get_binary_state.ExecuteRaw(id, buffer, state.data.size(), size_ptr, version_ptr);
+            if (!result) return result.GetError();
+            if (size <= state.data.size()) {
+                state.data.resize(size);
+                return state;
+            }
+            if (attempt > 0) return plugin_error{DIGITALCURLING_ERR_INVALID_DATA, "Binary state size changed while reading."};
+            state.data.resize(size);
+        }
+    }
 
 protected:
     PluginResource(PluginInfo info, PluginApi api, std::optional<ModulePtr> handle);
@@ -78,10 +131,30 @@ public:
     const PluginFunction<SimulatorGetSecondsPerFrameFunc, float> get_seconds_per_frame;
 
     const PluginFunction<SimulatorCalculateShotFunc, moves::Shot> calculate_shot;
+    const PluginFunction<SimulatorSimulateBatchFunc, void> simulate_batch;
+    const PluginFunction<SimulatorGetCollisionRecordsFunc, void> get_collision_records;
+    const PluginFunction<SimulatorGetStatsFunc, simulators::SimulatorStats> get_stats;
 
     explicit SimulatorPluginResource(PluginInfo info, PluginApi api, std::optional<ModulePtr> handle);
 
     bool IsInvertibleSimulator() const { return static_cast<bool>(calculate_shot); }
+    bool SupportsSimulateBatch() const { return static_cast<bool>(simulate_batch); }
+    bool SupportsCollisionRecords() const { return static_cast<bool>(get_collision_records); }
+    bool SupportsStats() const { return static_cast<bool>(get_stats); }
+
+    /// @brief シミュレーターのインスタンスを破棄する
+    ///
+    /// 破棄するインスタンスの性能カウンターは `GetStats()` の集計に引き継がれます。
+    virtual bool RemoveInstance(const uuidv7::uuidv7& id) override;
+
+    /// @brief このプラグインの全シミュレーターの性能カウンターを集計する
+    /// @param out_instance_count 集計時点で存在するシミュレーターの数を格納するポインタ (`nullptr` 可)
+    /// @return 存在するシミュレーターと破棄されたシミュレーターの性能カウンターの合計
+    simulators::SimulatorStats GetStats(std::size_t* out_instance_count = nullptr);
+
+private:
+    std::mutex retired_stats_mutex_;
+    simulators::SimulatorStats retired_stats_;
 };
 
 } // namespace digitalcurling::plugins::detail
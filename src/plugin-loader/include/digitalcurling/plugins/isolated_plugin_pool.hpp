@@ -0,0 +1,114 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// @brief IsolatedPluginPool を定義
+
+#pragma once
+
+#if defined(__linux__) && !defined(DIGITALCURLING_PLUGIN_LOADER_DISABLE_DYNAMIC)
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "digitalcurling_plugin_loader_export.h"
+#include "digitalcurling/moves/shot.hpp"
+#include "digitalcurling/plugins/plugin_type.hpp"
+#include "digitalcurling/simulators/i_simulator.hpp"
+#include "digitalcurling/simulators/simulator_mode_flag.hpp"
+
+namespace digitalcurling::plugins {
+
+namespace detail {
+    struct IsolatedPoolState;
+} // namespace digitalcurling::plugins::detail
+
+/// @brief プラグインを別プロセスで実行するワーカープール
+///
+/// ワーカープロセスごとにプラグインを個別にロードし、ホストとは共有メモリ上のリングバッファで固定長のジョブをやり取りします。
+/// スレッドセーフでないプラグインも複数のコアで並列に実行でき、プラグインがクラッシュしてもホストのプロセスは影響を受けません。
+/// クラッシュしたワーカーは自動的に再起動され、処理中だったジョブは1回だけ再実行されます。
+/// @note
+/// Linux でのみ利用できます。ワーカーは `digitalcurling_plugin_worker` 実行ファイルを `posix_spawn` で起動します。
+/// 実行ファイルは環境変数 `DIGITALCURLING_PLUGIN_WORKER`、ローダーを含むモジュールと同じディレクトリ、その `../bin`、実行中のプログラムと同じディレクトリの順に探索されます。
+/// 一括処理の呼び出しは内部で直列化されます。
+class DIGITALCURLING_LOADER_API IsolatedPluginPool {
+public:
+    /// @brief ワーカープロセスを起動する
+    ///
+    /// すべてのワーカーがプラグインのロードを終えるまで待ちます。
+    /// @param plugin_path ロードするプラグインのファイルパス
+    /// @param config Factory の設定 (省略した場合は既定の設定)
+    /// @param worker_count ワーカープロセスの数 (0 の場合はハードウェアの並列数)
+    /// @throws plugin_error プラグインのロードやワーカーの起動に失敗した場合、ワーカーの実行ファイルが見つからない場合
+    IsolatedPluginPool(const std::filesystem::path& plugin_path, const std::optional<nlohmann::json>& config, std::size_t worker_count);
+    /// @brief ワーカープロセスを終了する
+    ~IsolatedPluginPool();
+
+    IsolatedPluginPool(const IsolatedPluginPool&) = delete;
+    IsolatedPluginPool& operator=(const IsolatedPluginPool&) = delete;
+
+    /// @brief プラグインの種類を取得する
+    /// @return プラグインの種類
+    PluginType GetType() const;
+    /// @brief プラグイン名を取得する
+    /// @return プラグイン名
+    std::string const& GetName() const;
+
+    /// @brief ワーカープロセスの数を取得する
+    /// @return ワーカープロセスの数
+    std::size_t GetWorkerCount() const;
+    /// @brief ワーカープロセスのプロセスIDを取得する
+    /// @return 各ワーカーのプロセスID (停止したワーカーは 0)
+    std::vector<int> GetWorkerProcessIds() const;
+    /// @brief クラッシュによりワーカーを再起動した回数を取得する
+    /// @return 再起動した回数
+    std::size_t GetRestartCount() const;
+
+    /// @brief 複数の盤面に対してショットをまとめてシミュレーションする
+    ///
+    /// 各要素について、ストーンの配置を設定し、ショットのストーンを原点から投げ、停止条件を満たすまでシミュレーションします。
+    /// 要素はワーカーに分配され、並列に処理されます。
+    /// @param stones 初期配置の配列
+    /// @param shots ショットの配列 (空の場合は `stones` をそのままシミュレーションする)
+    /// @param shot_stone_index ショットのストーンを配置するインデックス
+    /// @param mode_flag 停止条件のフラグ
+    /// @param sheet_width シートの幅(m)
+    /// @return 各要素のシミュレーション結果
+    /// @throws plugin_error シミュレーターのプラグインでない場合や、いずれかの要素の処理に失敗した場合
+    std::vector<simulators::ISimulator::AllStones> SimulateBatch(
+        std::vector<simulators::ISimulator::AllStones> const& stones,
+        std::vector<moves::Shot> const& shots,
+        std::size_t shot_stone_index,
+        simulators::SimulateModeFlag mode_flag,
+        float sheet_width
+    );
+
+    /// @brief 複数のショットをまとめてプレイヤーに実行させる
+    ///
+    /// 要素はワーカーに分配され、並列に処理されます。
+    /// 各ワーカーのプレイヤーは独立しているため、乱数を使用するプレイヤーの結果は同じプロセス内で実行した場合と一致しません。
+    /// @param shots ショットの配列
+    /// @return 各ショットに対するプレイヤーの実行結果
+    /// @throws plugin_error プレイヤーのプラグインでない場合や、いずれかの要素の処理に失敗した場合
+    std::vector<moves::Shot> PlayBatch(std::vector<moves::Shot> const& shots);
+
+    /// @brief ワーカープロセスの処理を実行する
+    ///
+    /// `digitalcurling_plugin_worker` 実行ファイルのエントリポイントです。ホストから直接呼び出すことは想定していません。
+    /// @param argc コマンドライン引数の数
+    /// @param argv コマンドライン引数
+    /// @return 終了コード
+    static int RunWorker(int argc, char** argv);
+
+private:
+    std::unique_ptr<detail::IsolatedPoolState> state_;
+};
+
+} // namespace digitalcurling::plugins
+
+#endif // defined(__linux__) && !defined(DIGITALCURLING_PLUGIN_LOADER_DISABLE_DYNAMIC)
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include "digitalcurling_plugin_loader_export.h"
 #include "digitalcurling/plugins/loader_types.h"
 
@@ -35,6 +36,16 @@ DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_get_last_error_mess
 /// @note 格納に必要なサイズが必要な場合、`out_buffer` に `nullptr` を渡すことで、必要なサイズを `out_required_size` に取得できます。
 DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_snapshot_get_data(DigitalCurling_SnapshotHandle snapshot, char* out_buffer, size_t buffer_size, size_t* out_required_size);
 
+/// @brief スナップショットのデータをコピーせずに参照する
+///
+/// 返されるポインタは、`dc_loader_destroy_snapshot` でスナップショットを破棄するまで有効です。
+/// 参照中のスナップショットを他のスレッドから破棄しないでください。
+/// @param[in] snapshot スナップショットハンドル
+/// @param[out] out_data データの先頭へのポインタ (ヌル文字で終端されます)
+/// @param[out] out_size データのサイズ (終端のヌル文字を含まない, `nullptr` でもよい)
+/// @return 処理結果を示すエラーコード
+DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_snapshot_borrow(DigitalCurling_SnapshotHandle snapshot, const char** out_data, size_t* out_size);
+
 /// @brief スナップショットを破棄する
 /// @param[in] snapshot 破棄するスナップショットのハンドル
 /// @return 処理結果を示すエラーコード
@@ -50,6 +61,16 @@ DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_destroy_snapshot(Di
 /// @return 処理結果を示すエラーコード
 DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_load_plugin(const char* plugin_path, DigitalCurling_PluginType* out_plugin_type, char* out_plugin_name, size_t out_name_buffer_size);
 
+/// @brief ディレクトリ内のプラグインを遅延ロードで登録する
+///
+/// マニフェストにキャッシュされた情報を使用し、ライブラリのロードは Factory / Storage を初めて作成するときに行います。
+/// 追加・変更されたファイルはその場でロードされ、マニフェストは自動的に再生成されます。
+/// @param[in] plugin_dir プラグインを探索するディレクトリ
+/// @param[in] manifest_path マニフェストのファイルパス (NULL の場合は `plugin_dir` 内の既定のファイル)
+/// @param[out] out_plugin_count 登録したプラグインの数 (NULL 可)
+/// @return 処理結果を示すエラーコード
+DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_load_plugin_directory(const char* plugin_dir, const char* manifest_path, size_t* out_plugin_count);
+
 /// @brief ロード済みプラグインのスナップショットを取得する
 /// @param[in] plugin_type 取得対象のプラグインタイプ
 /// @param[in] separator 区切り文字
@@ -66,6 +87,30 @@ DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_get_loaded_plugins_
 /// @return 処理結果を示すエラーコード
 DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_is_plugin_loaded(DigitalCurling_PluginType plugin_type, const char* plugin_name, bool* out_loaded);
 
+/// @brief シミュレーターの性能カウンターのスナップショットを取得する
+///
+/// ロード済みのシミュレータープラグインごとに、全インスタンス (破棄されたものを含む) の性能カウンターを集計した JSON を返します。
+/// 形式は `{"simulators": {"<プラグイン名>": {"frames": ..., "instances": ...}}}` です。
+/// @param[out] out_snapshot スナップショットハンドル (使用後は `dc_loader_destroy_snapshot` で破棄が必要)
+/// @param[out] out_snapshot_size スナップショットのサイズ
+/// @return 処理結果を示すエラーコード
+DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_get_stats(DigitalCurling_SnapshotHandle* out_snapshot, size_t* out_snapshot_size);
+
+/// @brief ローダーとロード済みのプラグインで処理時間のトレースの記録を開始する
+///
+/// 記録はスレッドごとのバッファに行われ、記録していない間の負荷はほぼありません。
+/// バッファが一杯になった後のイベントは破棄され、その数がトレースファイルに記録されます。
+/// @param[in] events_per_thread スレッドごとに記録できるイベント数 (0 の場合は既定値)
+/// @return 処理結果を示すエラーコード
+DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_trace_start(size_t events_per_thread);
+
+/// @brief トレースの記録を終了し、記録したイベントをファイルに書き出す
+///
+/// ファイルは Trace Event Format (JSON) で、Chrome の `about:tracing` や Perfetto UI で表示できます。
+/// @param[in] output_path 出力先のファイルパス
+/// @return 処理結果を示すエラーコード
+DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_trace_stop(const char* output_path);
+
 // --- Creator Common Functions ---
 
 /// @brief クリエイター（Factory または Storage）の状態のスナップショットを取得する
@@ -75,6 +120,26 @@ DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_is_plugin_loaded(Di
 /// @return 処理結果を示すエラーコード
 DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_creator_get_state_snapshot(const DigitalCurling_Uuid* creator_id, DigitalCurling_SnapshotHandle* out_snapshot, size_t* out_snapshot_size);
 
+/// @brief クリエイター（Factory または Storage）の状態をバイナリ形式で取得する
+///
+/// バイナリ形式のレイアウトはプラグインが定義します。同じプラグインの `dc_loader_creator_set_binary_state` に渡すことができます。
+/// @param[in] creator_id クリエイターのUUID
+/// @param[out] out_buffer 状態を格納するバッファ
+/// @param[in] buffer_size バッファのサイズ
+/// @param[out] out_required_size 状態の格納に必要なサイズ
+/// @param[out] out_format_version バイナリ形式のバージョン
+/// @return 処理結果を示すエラーコード (プラグインがバイナリ形式に対応していない場合は `DIGITALCURLING_ERR_NOT_SUPPORTED`)
+/// @note `buffer_size` に 0 を渡すことで、必要なサイズを `out_required_size` に取得できます。
+DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_creator_get_binary_state(const DigitalCurling_Uuid* creator_id, uint8_t* out_buffer, size_t buffer_size, size_t* out_required_size, unsigned int* out_format_version);
+
+/// @brief クリエイター（Factory または Storage）の状態をバイナリ形式のデータで置き換える
+/// @param[in] creator_id クリエイターのUUID
+/// @param[in] data `dc_loader_creator_get_binary_state` で取得した状態
+/// @param[in] size `data` のサイズ
+/// @param[in] format_version バイナリ形式のバージョン
+/// @return 処理結果を示すエラーコード (プラグインがバイナリ形式に対応していない場合は `DIGITALCURLING_ERR_NOT_SUPPORTED`)
+DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_creator_set_binary_state(const DigitalCurling_Uuid* creator_id, const uint8_t* data, size_t size, unsigned int format_version);
+
 // --- Player Instance Management ---
 
 /// @brief プレイヤーファクトリーを作成する
@@ -103,6 +168,25 @@ DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_create_player(const
 /// @return 処理結果を示すエラーコード
 DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_remove_player_instance(const DigitalCurling_Uuid* instance_id);
 
+// --- Instance Handle ---
+
+/// @brief プレイヤー・シミュレーターのインスタンスへの直接ハンドルを取得する
+///
+/// ハンドルを受け取る関数は UUID の検索を行わず、ハンドルの有効性の確認のみで呼び出しを行います。
+/// 同じインスタンスに対して複数のハンドルを取得できます。
+/// @param[in] instance_id プレイヤーまたはシミュレーターのUUID
+/// @param[out] out_handle 取得したハンドル
+/// @return 処理結果を示すエラーコード
+/// @note ハンドルを使用する呼び出しと、そのハンドルの解放やインスタンスの削除は、異なるスレッドから同時に行えます。
+/// 実行中の呼び出しはそのまま完了し、解放・削除はその呼び出しが終わるまで待ってからインスタンスへの参照を手放します。
+/// 解放・削除を始めた後にそのハンドルで呼び出すと `DIGITALCURLING_ERR_INSTANCE_NOT_FOUND` を返します。
+DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_acquire_instance_handle(const DigitalCurling_Uuid* instance_id, DigitalCurling_InstanceHandle* out_handle);
+
+/// @brief インスタンスへの直接ハンドルを解放する
+/// @param[in] handle 解放するハンドル
+/// @return 処理結果を示すエラーコード
+DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_release_instance_handle(DigitalCurling_InstanceHandle handle);
+
 // --- Player Actions ---
 
 /// @brief プレイヤーの状態をストレージに保存する
@@ -130,6 +214,13 @@ DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_player_get_gender(c
 /// @return 処理結果を示すエラーコード
 DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_player_play(const DigitalCurling_Uuid* player_id, const DigitalCurling_Shot* shot_info, DigitalCurling_Shot* out_shot);
 
+/// @brief プレイヤーのショットを決定する (ハンドル版)
+/// @param[in] player プレイヤーのハンドル
+/// @param[in] shot_info 理想的なショット情報
+/// @param[out] out_shot 決定されたショット情報
+/// @return 処理結果を示すエラーコード
+DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_player_handle_play(DigitalCurling_InstanceHandle player, const DigitalCurling_Shot* shot_info, DigitalCurling_Shot* out_shot);
+
 // --- Simulator Instance Management ---
 
 /// @brief シミュレーターファクトリーを作成する
@@ -191,6 +282,31 @@ DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_simulator_step(cons
 /// @return 処理結果を示すエラーコード
 DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_simulator_simulate(const DigitalCurling_Uuid* simulator_id, const DigitalCurling_SimulateModeFlag mode_flag, const float sheet_width);
 
+/// @brief 複数の盤面に対してショットをまとめてシミュレーションする
+///
+/// 各要素について、ストーンの配置を設定し、ショットのストーンを原点から投げ、停止条件を満たすまでシミュレーションした結果を `out_stones` に格納します。
+/// 処理後のシミュレーターの状態は最後の要素をシミュレーションした結果になります。
+/// @param[in] simulator_id シミュレーターUUID
+/// @param[in] stones 初期配置の配列 (要素数 `count`)
+/// @param[in] shots ショットの配列 (要素数 `count`, `nullptr` の場合は `stones` をそのままシミュレーションする)
+/// @param[in] count 要素数
+/// @param[in] shot_stone_index ショットのストーンを配置するインデックス
+/// @param[in] mode_flag シミュレーションモード
+/// @param[in] sheet_width シートの幅
+/// @param[out] out_stones シミュレーション結果を格納する配列 (要素数 `count`)
+/// @return 処理結果を示すエラーコード
+/// @note プラグインが一括シミュレーションに対応していない (API バージョン 1) 場合は、ローダー内で1要素ずつシミュレーションします。
+DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_simulator_simulate_batch(
+    const DigitalCurling_Uuid* simulator_id,
+    const DigitalCurling_StoneCoordinate* stones,
+    const DigitalCurling_Shot* shots,
+    const size_t count,
+    const int shot_stone_index,
+    const DigitalCurling_SimulateModeFlag mode_flag,
+    const float sheet_width,
+    DigitalCurling_StoneCoordinate* out_stones
+);
+
 /// @brief シミュレーター上の現在のストーン配置を取得する
 /// @param[in] simulator_id シミュレーターUUID
 /// @param[out] out_stones ストーン座標を格納する配列
@@ -204,6 +320,18 @@ DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_simulator_get_stone
 /// @return 処理結果を示すエラーコード
 DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_simulator_get_collisions_snapshot(const DigitalCurling_Uuid* simulator_id, DigitalCurling_SnapshotHandle* out_snapshot, size_t* out_snapshot_size);
 
+/// @brief シミュレーターの衝突情報を構造体の配列として取得する
+///
+/// 衝突の総数を `out_count` に格納し、先頭から最大 `capacity` 個を `out_collisions` にコピーします。
+/// `capacity` に 0 を指定すると、総数のみを取得できます。
+/// @param[in] simulator_id シミュレーターUUID
+/// @param[out] out_collisions 衝突情報を格納する配列 (要素数 `capacity`, `capacity` が 0 の場合は `nullptr` でもよい)
+/// @param[in] capacity `out_collisions` の要素数
+/// @param[out] out_count 衝突の総数
+/// @return 処理結果を示すエラーコード
+/// @note プラグインが対応していない (API バージョン 2 以前) 場合は、ローダー内でJSONから変換します。
+DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_simulator_get_collisions(const DigitalCurling_Uuid* simulator_id, DigitalCurling_Collision* out_collisions, size_t capacity, size_t* out_count);
+
 /// @brief すべてのストーンが停止しているかを確認する
 /// @param[in] simulator_id シミュレーターUUID
 /// @param[out] out_stopped 停止している場合 `true`
@@ -233,6 +361,137 @@ DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_simulator_calculate
     DigitalCurling_Shot* out_shot
 );
 
+// --- Simulator Actions (Instance Handle) ---
+
+/// @brief シミュレーター上のストーン配置を設定する (ハンドル版)
+/// @param[in] simulator シミュレーターのハンドル
+/// @param[in] stones ストーン座標の配列
+/// @return 処理結果を示すエラーコード
+DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_simulator_handle_set_stones(DigitalCurling_InstanceHandle simulator, const DigitalCurling_StoneCoordinate* stones);
+
+/// @brief シミュレーションを指定フレーム数だけ進める (ハンドル版)
+/// @param[in] simulator シミュレーターのハンドル
+/// @param[in] frames 進めるフレーム数
+/// @param[in] sheet_width シートの幅
+/// @return 処理結果を示すエラーコード
+DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_simulator_handle_step(DigitalCurling_InstanceHandle simulator, const int frames, const float sheet_width);
+
+/// @brief 指定されたモードでシミュレーションを実行する (ハンドル版)
+/// @param[in] simulator シミュレーターのハンドル
+/// @param[in] mode_flag シミュレーションモード
+/// @param[in] sheet_width シートの幅
+/// @return 処理結果を示すエラーコード
+DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_simulator_handle_simulate(DigitalCurling_InstanceHandle simulator, const DigitalCurling_SimulateModeFlag mode_flag, const float sheet_width);
+
+/// @brief シミュレーター上の現在のストーン配置を取得する (ハンドル版)
+/// @param[in] simulator シミュレーターのハンドル
+/// @param[out] out_stones ストーン座標を格納する配列
+/// @return 処理結果を示すエラーコード
+DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_simulator_handle_get_stones(DigitalCurling_InstanceHandle simulator, DigitalCurling_StoneCoordinate* out_stones);
+
+// --- Asynchronous Simulation ---
+
+/// @brief 非同期処理を実行するワーカースレッドの数を設定する
+///
+/// 実行中・待機中のジョブがある場合は、それらの完了を待ってからワーカーを入れ替えます。
+/// 設定しない場合は、最初の非同期処理の呼び出し時にハードウェアの並列数と同じ数のワーカーを起動します。
+/// @param[in] worker_count ワーカースレッドの数 (0 の場合はハードウェアの並列数)
+/// @return 処理結果を示すエラーコード
+DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_set_worker_count(size_t worker_count);
+
+/// @brief 非同期処理を実行するワーカースレッドの数を取得する
+/// @param[out] out_worker_count ワーカースレッドの数
+/// @return 処理結果を示すエラーコード
+DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_get_worker_count(size_t* out_worker_count);
+
+/// @brief 指定されたモードでのシミュレーションをワーカーで非同期に実行する
+///
+/// 処理内容は `dc_loader_simulator_simulate` と同じです。
+/// ジョブが完了するまで、同じシミュレーターに対する他の操作 (他のジョブを含む) は行わないでください。
+/// @param[in] simulator_id シミュレーターUUID
+/// @param[in] mode_flag シミュレーションモード
+/// @param[in] sheet_width シートの幅
+/// @param[out] out_job ジョブのハンドル (`dc_loader_destroy_async_job` で破棄する)
+/// @return 処理結果を示すエラーコード (ジョブの投入に成功した場合は `DIGITALCURLING_OK`)
+DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_simulator_simulate_async(
+    const DigitalCurling_Uuid* simulator_id,
+    const DigitalCurling_SimulateModeFlag mode_flag,
+    const float sheet_width,
+    DigitalCurling_AsyncJobHandle* out_job
+);
+
+/// @brief 複数の盤面に対するショットのシミュレーションをワーカーで非同期に実行する
+///
+/// 処理内容は `dc_loader_simulator_simulate_batch` と同じです。
+/// `stones`, `shots` は呼び出し時にコピーされますが、`out_stones` はジョブが完了するまで有効である必要があります。
+/// ジョブが完了するまで、同じシミュレーターに対する他の操作 (他のジョブを含む) は行わないでください。
+/// @param[in] simulator_id シミュレーターUUID
+/// @param[in] stones 初期配置の配列 (要素数 `count`)
+/// @param[in] shots ショットの配列 (要素数 `count`, `nullptr` の場合は `stones` をそのままシミュレーションする)
+/// @param[in] count 要素数
+/// @param[in] shot_stone_index ショットのストーンを配置するインデックス
+/// @param[in] mode_flag シミュレーションモード
+/// @param[in] sheet_width シートの幅
+/// @param[out] out_stones シミュレーション結果を格納する配列 (要素数 `count`)
+/// @param[out] out_job ジョブのハンドル (`dc_loader_destroy_async_job` で破棄する)
+/// @return 処理結果を示すエラーコード (ジョブの投入に成功した場合は `DIGITALCURLING_OK`)
+DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_simulator_simulate_batch_async(
+    const DigitalCurling_Uuid* simulator_id,
+    const DigitalCurling_StoneCoordinate* stones,
+    const DigitalCurling_Shot* shots,
+    const size_t count,
+    const int shot_stone_index,
+    const DigitalCurling_SimulateModeFlag mode_flag,
+    const float sheet_width,
+    DigitalCurling_StoneCoordinate* out_stones,
+    DigitalCurling_AsyncJobHandle* out_job
+);
+
+/// @brief ジョブが完了しているかを確認する
+/// @param[in] job ジョブのハンドル
+/// @param[out] out_completed 完了している場合 `true`
+/// @return 処理結果を示すエラーコード
+DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_async_poll(DigitalCurling_AsyncJobHandle job, bool* out_completed);
+
+/// @brief ジョブの完了を待つ
+/// @param[in] job ジョブのハンドル
+/// @param[in] timeout_ms 最大の待ち時間 (ミリ秒, 負の値の場合は完了するまで待つ)
+/// @param[out] out_completed 完了した場合 `true` (タイムアウトした場合 `false`)
+/// @return 処理結果を示すエラーコード
+DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_async_wait(DigitalCurling_AsyncJobHandle job, int64_t timeout_ms, bool* out_completed);
+
+/// @brief 複数のジョブのいずれかの完了を待つ
+/// @param[in] jobs ジョブのハンドルの配列 (要素数 `count`)
+/// @param[in] count 要素数
+/// @param[in] timeout_ms 最大の待ち時間 (ミリ秒, 負の値の場合はいずれかが完了するまで待つ)
+/// @param[out] out_index 完了したジョブのインデックス (タイムアウトした場合は `count`)
+/// @return 処理結果を示すエラーコード
+/// @note 既に完了しているジョブが含まれる場合は、その中で最も小さいインデックスを返します。
+DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_async_wait_any(const DigitalCurling_AsyncJobHandle* jobs, size_t count, int64_t timeout_ms, size_t* out_index);
+
+/// @brief 完了したジョブの結果を取得する
+///
+/// ジョブのエラーメッセージはスレッドごとの最後のエラーメッセージではなく、ジョブごとに保持されます。
+/// @param[in] job ジョブのハンドル
+/// @param[out] out_result ジョブの処理結果を示すエラーコード
+/// @param[out] out_message エラーメッセージを格納するバッファ (`buffer_size` が 0 の場合は `nullptr` でもよい)
+/// @param[in] buffer_size バッファのサイズ
+/// @param[out] out_required_size メッセージの格納に必要なサイズ（終端のヌル文字を含む, `nullptr` でもよい）
+/// @return 処理結果を示すエラーコード (ジョブが完了していない場合は `DIGITALCURLING_ERR_INVALID_ARGUMENT`)
+DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_async_get_result(
+    DigitalCurling_AsyncJobHandle job,
+    DigitalCurling_ErrorCode* out_result,
+    char* out_message,
+    size_t buffer_size,
+    size_t* out_required_size
+);
+
+/// @brief ジョブを破棄する
+/// @param[in] job 破棄するジョブのハンドル
+/// @return 処理結果を示すエラーコード
+/// @note ジョブが完了していない場合は、完了を待ってから破棄します。
+DigitalCurling_ErrorCode DIGITALCURLING_LOADER_API dc_loader_destroy_async_job(DigitalCurling_AsyncJobHandle job);
+
 #ifdef __cplusplus
 }
 #endif
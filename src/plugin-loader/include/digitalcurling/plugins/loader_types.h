@@ -13,6 +13,7 @@
 
 /// @cond Doxygen_Suppress
 typedef struct SnapshotData* DigitalCurling_SnapshotHandle;
+typedef struct AsyncJobData* DigitalCurling_AsyncJobHandle;
 /// @endcond
 
 /// @brief UUIDを表す構造体
@@ -21,4 +22,13 @@ typedef struct {
     uint8_t bytes[16];
 } DigitalCurling_Uuid;
 
+/// @brief プレイヤー・シミュレーターのインスタンスを直接参照するハンドル
+///
+/// `dc_loader_acquire_instance_handle` で取得し、`dc_loader_release_instance_handle` で解放します。
+/// インスタンスが削除されたハンドルは無効になり、無効なハンドルを渡した関数は `DIGITALCURLING_ERR_INSTANCE_NOT_FOUND` を返します。
+typedef struct {
+    /// @brief ハンドルの値 (0 は常に無効)
+    uint64_t value;
+} DigitalCurling_InstanceHandle;
+
 /// @}
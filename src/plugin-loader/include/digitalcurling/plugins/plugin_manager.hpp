@@ -6,7 +6,10 @@
 
 #pragma once
 
+#include <cstddef>
+#include <filesystem>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <shared_mutex>
@@ -15,11 +18,14 @@
 #include <nlohmann/json.hpp>
 
 #include "digitalcurling/common.hpp"
+#include "digitalcurling/trace.hpp"
 #include "digitalcurling/plugins/plugin_api.hpp"
+#include "digitalcurling/plugins/isolated_plugin_pool.hpp"
 #include "digitalcurling/players/plugin_player_factory.hpp"
 #include "digitalcurling/players/plugin_player_storage.hpp"
 #include "digitalcurling/simulators/plugin_simulator_factory.hpp"
 #include "digitalcurling/simulators/plugin_simulator_storage.hpp"
+#include "digitalcurling/simulators/simulator_stats.hpp"
 
 #include "digitalcurling_plugin_loader_export.h"
 #include "digitalcurling/plugins/detail/plugin_resource.hpp"
@@ -32,6 +38,8 @@ namespace detail {
 
 /// @brief 共有ライブラリのファイル拡張子
 DIGITALCURLING_LOADER_API extern const std::string LibraryExtension;
+/// @brief プラグインのマニフェストの既定のファイル名
+DIGITALCURLING_LOADER_API extern const std::string PluginManifestFileName;
 
 /// @brief プラグインの識別子
 struct PluginId {
@@ -41,6 +49,16 @@ struct PluginId {
     std::string name;
 };
 
+/// @brief シミュレータープラグインごとの性能カウンター
+struct SimulatorPluginStats {
+    /// @brief プラグイン名
+    std::string name;
+    /// @brief 集計時点で存在するシミュレーターの数
+    std::size_t instance_count;
+    /// @brief 存在するシミュレーターと破棄されたシミュレーターの性能カウンターの合計
+    simulators::SimulatorStats stats;
+};
+
 /// @brief プラグインを管理するクラス
 class DIGITALCURLING_LOADER_API PluginManager {
 public:
@@ -58,6 +76,29 @@ public:
     /// @param plugin_path ロードするプラグインのファイルパス
     /// @param throw_exception ロードに失敗した場合に例外を送出するか
     std::optional<PluginId> LoadPlugin(const std::filesystem::path& plugin_path, bool throw_exception);
+    /// @brief ディレクトリ内のプラグインを遅延ロードで登録する
+    ///
+    /// プラグインの情報 (名前・種類・APIバージョン・ファイルの更新日時とハッシュ) をマニフェストにキャッシュし、
+    /// 変更のないプラグインはライブラリをロードせずに登録します。
+    /// ライブラリのロードは、そのプラグインの Factory / Storage を初めて作成するときに行われます。
+    /// 追加・変更されたファイルはその場でロードされ、マニフェストは自動的に再生成されます。
+    /// @param plugin_dir プラグインを探索するディレクトリ
+    /// @param manifest_path マニフェストのファイルパス (省略した場合は `plugin_dir` 内の PluginManifestFileName)
+    /// @returns 登録したプラグインIDのリスト
+    /// @throws plugin_error ディレクトリが存在しない場合
+    /// @note マニフェストを書き込めない場合でもプラグインは登録されます (次回も変更されたファイルとして扱われます)。
+    std::vector<PluginId> LoadPluginDirectory(const std::filesystem::path& plugin_dir, const std::optional<std::filesystem::path>& manifest_path = std::nullopt);
+#endif
+#if defined(__linux__) && !defined(DIGITALCURLING_PLUGIN_LOADER_DISABLE_DYNAMIC)
+    /// @brief プラグインを別プロセスで実行するワーカープールを作成する
+    ///
+    /// プラグインはこのマネージャーには登録されず、各ワーカープロセスで個別にロードされます。
+    /// @param plugin_path ロードするプラグインのファイルパス
+    /// @param config Factory の設定 (省略した場合は既定の設定)
+    /// @param worker_count ワーカープロセスの数 (0 の場合はハードウェアの並列数)
+    /// @returns 作成したワーカープール
+    /// @throws plugin_error プラグインのロードやワーカーの起動に失敗した場合
+    std::unique_ptr<IsolatedPluginPool> CreateIsolatedPool(const std::filesystem::path& plugin_path, const std::optional<nlohmann::json>& config, std::size_t worker_count);
 #endif
 
     /// @brief プラグインリソースを登録する
@@ -66,23 +107,41 @@ public:
 
     /// @brief ロード済みのプラグイン情報を取得する
     /// @param type プラグインの種類 (省略した場合はすべての種類)
-    /// @return ロード済みのプラグインIDのリスト
+    /// @return ロード済みのプラグインIDのリスト (遅延ロードで登録されたプラグインを含む)
     std::vector<PluginId> GetLoadedPlugins(std::optional<PluginType> type = std::nullopt) const;
 
     /// @brief プラグインがロードされているかを確認する
     /// @param type プラグインの種類
     /// @param name プラグイン名
-    /// @return プラグインがロードされている場合は　`true`
+    /// @return プラグインがロードされている場合 (遅延ロードで登録されている場合を含む) は　`true`
     inline bool IsPluginLoaded(PluginType type, const std::string& name) const {
         std::shared_lock lock(mutex_);
         if (type == PluginType::player) {
-            return player_resources_.count(name) > 0;
+            return player_resources_.count(name) > 0 || lazy_player_plugins_.count(name) > 0;
         } else if (type == PluginType::simulator) {
-            return simulator_resources_.count(name) > 0;
+            return simulator_resources_.count(name) > 0 || lazy_simulator_plugins_.count(name) > 0;
         }
         return false;
     }
 
+    /// @brief シミュレーターの性能カウンターをプラグインごとに集計する
+    ///
+    /// 遅延ロードで登録され、まだライブラリがロードされていないプラグインは含まれません。
+    /// API バージョン 4 以前のプラグインでは、シミュレーターの数のみが集計されます。
+    /// @return シミュレータープラグインごとの性能カウンターのリスト
+    std::vector<SimulatorPluginStats> GetSimulatorStats() const;
+
+    /// @brief ローダーとロード済みのプラグインでトレースの記録を開始する
+    ///
+    /// 記録中に新しくロードされたプラグインでも記録が開始されます。
+    /// API バージョン 5 以前のプラグインでは、ローダー側の区間のみが記録されます。
+    /// @param events_per_thread スレッドごとに記録できるイベント数
+    void StartTrace(std::size_t events_per_thread = trace::kDefaultEventsPerThread);
+
+    /// @brief トレースの記録を終了し、ローダーとプラグインで記録したイベントを取得する
+    /// @return Trace Event Format のイベントの配列 (JSON)
+    nlohmann::json StopTrace();
+
     // --- Player instance management ---
 
     /// @brief プレイヤーファクトリーを作成する
@@ -122,6 +181,14 @@ private:
     std::unordered_map<std::string, std::shared_ptr<detail::PlayerPluginResource>> player_resources_;
     std::unordered_map<std::string, std::shared_ptr<detail::SimulatorPluginResource>> simulator_resources_;
 
+    // 遅延ロードで登録されたプラグイン (プラグイン名 -> ファイルパス)
+    std::unordered_map<std::string, std::filesystem::path> lazy_player_plugins_;
+    std::unordered_map<std::string, std::filesystem::path> lazy_simulator_plugins_;
+    // 遅延ロードの実行を直列化する
+    std::mutex lazy_load_mutex_;
+    // 記録中に登録されたプラグインで使用するイベント数
+    std::size_t trace_events_per_thread_ = trace::kDefaultEventsPerThread;
+
     inline std::shared_ptr<detail::PlayerPluginResource> GetPlayerPluginResource(const std::string& name) const {
         auto it = player_resources_.find(name);
         return it != player_resources_.end() ? it->second : nullptr;
@@ -131,6 +198,11 @@ private:
         return it != simulator_resources_.end() ? it->second : nullptr;
     }
 
+    // 遅延ロードで登録されたプラグインであればロードしてから, プラグインリソースを取得する
+    std::shared_ptr<detail::PlayerPluginResource> AcquirePlayerPluginResource(const std::string& name);
+    std::shared_ptr<detail::SimulatorPluginResource> AcquireSimulatorPluginResource(const std::string& name);
+    void ResolveLazyPlugin(PluginType type, const std::string& name);
+
     friend class detail::LoaderInternalAccessor;
 };
 
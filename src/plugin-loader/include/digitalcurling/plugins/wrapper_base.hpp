@@ -6,7 +6,6 @@
 
 #pragma once
 
-#include <functional>
 #include <memory>
 #include <mutex>
 #include <stdexcept>
@@ -14,6 +13,7 @@
 #include <utility>
 #include <uuidv7/uuidv7.hpp>
 #include "digitalcurling/plugins/plugin_type.hpp"
+#include "digitalcurling/trace.hpp"
 #include "digitalcurling/plugins/detail/plugin_resource.hpp"
 
 namespace digitalcurling::plugins {
@@ -24,9 +24,7 @@ template <typename TBase>
 class WrapperBase : public TBase {
 public:
     virtual ~WrapperBase() {
-        if (auto resource = owner_resource_.lock()) {
-            resource->GetInstanceList().Remove(instance_id_);
-        }
+        owner_resource_->RemoveInstance(instance_id_);
     }
 
     /// @cond Doxygen_Suppress
@@ -42,6 +40,18 @@ public:
     /// @inheritdoc
     virtual const char* GetId() const noexcept override { return id_.c_str(); }
 
+    /// @brief シングルスレッドモードを設定する
+    ///
+    /// シングルスレッドモードでは、プラグインの呼び出しやキャッシュの更新時の排他制御を省略します。
+    /// 1つのスレッドだけがこのオブジェクトを使用する場合に有効にしてください。
+    /// @param enabled 有効にする場合 `true`
+    /// @note 他のスレッドと共有する前に設定する必要があります。
+    void SetSingleThreadedMode(bool enabled) noexcept { single_threaded_ = enabled; }
+
+    /// @brief シングルスレッドモードが有効か
+    /// @returns 有効な場合 `true`
+    bool IsSingleThreadedMode() const noexcept { return single_threaded_; }
+
 protected:
     /// @brief このラッパークラスのプラグインタイプ
     static constexpr PluginType Type = PluginTypeFor<TBase>::value;
@@ -51,9 +61,14 @@ protected:
     /// @brief コンストラクタ
     /// @param id プラグインID
     /// @param instance_id インスタンスID
-    /// @param owner_resource 実際のインスタンスを持つリソースへの参照
+    /// @param owner_resource 実際のインスタンスを持つリソースへの参照 (このオブジェクトが破棄されるまで保持されます)
+    /// @throws std::runtime_error リソースが既に破棄されている場合
     WrapperBase(std::string id, uuidv7::uuidv7 instance_id, std::weak_ptr<OwnerResource> owner_resource)
-        : id_(std::move(id)), instance_id_(std::move(instance_id)), owner_resource_(std::move(owner_resource)) {}
+        : id_(std::move(id)), instance_id_(std::move(instance_id)), owner_resource_(owner_resource.lock()), single_threaded_(false)
+    {
+        if (!owner_resource_)
+            throw std::runtime_error("Owner resource has been destroyed for " + ToString(Type) + ": " + id_);
+    }
 
     /// @brief プラグインIDを得る
     /// @return プラグインID
@@ -61,26 +76,32 @@ protected:
 
     /// @brief プラグインリソースを操作する関数を実行するためのユーティリティ
     /// @tparam T 関数の戻り値の型
+    /// @tparam TFunc 実行する関数の型 (`std::shared_ptr<OwnerResource> const&` を受け取る)
     /// @param func 実行する関数
     /// @return 関数の戻り値
-    template<typename T>
-    T ExecuteResourceFunc(std::function<T(std::shared_ptr<OwnerResource>)> func) const {
-        std::lock_guard<std::mutex> lock(resource_mutex_);
-        return func(GetOwnerResource());
+    template<typename T, typename TFunc>
+    inline T ExecuteResourceFunc(TFunc&& func) const {
+        DIGITALCURLING_TRACE_SCOPE("wrapper", "ExecuteResourceFunc");
+        auto lock = [this] {
+            DIGITALCURLING_TRACE_SCOPE("wrapper", "LockWait");
+            return LockIfMultiThreaded(resource_mutex_);
+        }();
+        return func(owner_resource_);
+    }
+
+    /// @brief シングルスレッドモードでない場合のみ `mutex` をロックする
+    /// @param mutex ロックするミューテックス
+    /// @return ロック (シングルスレッドモードの場合は何も保持しない)
+    inline std::unique_lock<std::mutex> LockIfMultiThreaded(std::mutex& mutex) const {
+        return single_threaded_ ? std::unique_lock<std::mutex>() : std::unique_lock<std::mutex>(mutex);
     }
 
 private:
     std::string id_;
     uuidv7::uuidv7 instance_id_;
-    std::weak_ptr<OwnerResource> owner_resource_;
+    std::shared_ptr<OwnerResource> owner_resource_;
+    bool single_threaded_;
     mutable std::mutex resource_mutex_;
-
-    inline std::shared_ptr<OwnerResource> GetOwnerResource() const {
-        auto resource = owner_resource_.lock();
-        if (!resource)
-            throw std::runtime_error("Owner resource has been destroyed for " + ToString(Type) + ": " + id_);
-        return resource;
-    }
 };
 
 } // namespace digitalcurling::plugins
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -13,6 +14,7 @@
 #include <vector>
 #include <uuidv7/uuidv7.hpp>
 #include "digitalcurling/plugins/detail/plugin_resource.hpp"
+#include "digitalcurling/moves/shot.hpp"
 #include "digitalcurling/plugins/wrapper_base.hpp"
 #include "digitalcurling/simulators/i_simulator.hpp"
 
@@ -40,6 +42,9 @@ public:
     virtual bool AreAllStonesStopped() const override;
     virtual float GetSecondsPerFrame() const override;
     virtual ISimulatorFactory const& GetFactory() const override;
+    /// @copydoc ISimulator::GetStats
+    /// @note API バージョン 4 以前のプラグインでは全ての値が0になります。
+    virtual SimulatorStats GetStats() const override;
 
     virtual std::unique_ptr<ISimulatorStorage> CreateStorage() const override;
     virtual void Save(ISimulatorStorage & storage) const override;
@@ -55,14 +60,49 @@ public:
     /// @param sheet_width シートの幅(m)
     virtual void Simulate(SimulateModeFlag mode_flag, float sheet_width);
 
+    /// @brief 複数の盤面に対してショットをまとめてシミュレーションする
+    ///
+    /// 各要素について、ストーンの配置を設定し、ショットのストーンを原点から投げ、停止条件を満たすまでシミュレーションします。
+    /// プラグインが一括シミュレーションに対応している場合、プラグインの呼び出しは1回で済みます。
+    /// 処理後のシミュレーターの状態は最後の要素をシミュレーションした結果になります。
+    /// @param stones 初期配置の配列
+    /// @param shots ショットの配列 (空の場合は `stones` をそのままシミュレーションする)
+    /// @param shot_stone_index ショットのストーンを配置するインデックス
+    /// @param mode_flag 停止条件のフラグ
+    /// @param sheet_width シートの幅(m)
+    /// @return 各要素のシミュレーション結果
+    virtual std::vector<ISimulator::AllStones> SimulateBatch(
+        std::vector<ISimulator::AllStones> const& stones,
+        std::vector<moves::Shot> const& shots,
+        std::size_t shot_stone_index,
+        SimulateModeFlag mode_flag,
+        float sheet_width
+    );
+
+    /// @brief プラグインの実体であるシミュレーターを取得する
+    ///
+    /// プラグインがローダーに静的リンク (`DIGITALCURLING_BUNDLE_PLUGINS`) されている場合のみ取得できます。
+    /// 返されたオブジェクトの呼び出しは C ABI を経由しないため、変換のコストがかかりません。
+    /// @note
+    /// 返されたオブジェクトはこのインスタンスが破棄されるまで有効です。
+    /// 直接操作した後は、このインスタンスの `GetStones()` などが古い値を返すことがあるため、返されたオブジェクトから取得してください。
+    /// また、このインスタンスの排他制御は適用されません。
+    /// @return プラグインの実体 (動的にロードされたプラグインの場合は `nullptr`)
+    ISimulator* GetNative() const { return native_; }
+
 private:
+    // 構築時に解決したプラグイン側のハンドル (インスタンスIDによる検索を省くため)
+    plugins::SimulatorHandle* handle_;
+    // 静的リンクされたプラグインの実体 (動的にロードされた場合は nullptr)
+    ISimulator* native_;
+
     mutable std::mutex mutex_;
     mutable std::unique_ptr<ISimulatorFactory> factory_cache_;
     mutable std::optional<ISimulator::AllStones> all_stones_cache_;
     mutable std::optional<std::vector<ISimulator::Collision>> collisions_cache_;
 
     inline void ClearCaches() {
-        std::lock_guard<std::mutex> lock(mutex_);
+        auto lock = LockIfMultiThreaded(mutex_);
         factory_cache_.reset();
         all_stones_cache_.reset();
         collisions_cache_.reset();
@@ -29,7 +29,7 @@ public:
           {}
 
     virtual std::unique_ptr<ISimulator> CreateSimulator() const override {
-        return ExecuteResourceFunc<std::unique_ptr<ISimulator>>([&](auto resource) -> std::unique_ptr<ISimulator> {
+        return ExecuteResourceFunc<std::unique_ptr<ISimulator>>([&](auto const& resource) -> std::unique_ptr<ISimulator> {
             auto id = resource->create_target.Execute(GetInstanceId());
             if (resource->IsInvertibleSimulator()) {
                 return std::make_unique<InvertiblePluginSimulator>(GetPluginId(), id, resource);
@@ -40,17 +40,30 @@ public:
     }
 
     virtual std::unique_ptr<ISimulatorFactory> Clone() const override {
-        auto json = ToJson();
-        return ExecuteResourceFunc<std::unique_ptr<ISimulatorFactory>>([&](auto resource) {
-            auto id = resource->create_factory.Execute(json.dump().c_str());
-            return std::make_unique<PluginSimulatorFactory>(GetPluginId(), id, resource);
+        return ExecuteResourceFunc<std::unique_ptr<ISimulatorFactory>>([&](auto const& resource) -> std::unique_ptr<ISimulatorFactory> {
+            if (!resource->SupportsFactoryBinaryState()) {
+                auto state = resource->object_creator_get_state.Execute(GetInstanceId());
+                auto id = resource->create_factory.Execute(state.c_str());
+                return std::make_unique<PluginSimulatorFactory>(GetPluginId(), id, resource);
+            }
+
+            // バイナリ形式に対応している場合は JSON を経由せずに状態を複製する
+            auto state = plugins::detail::PluginResource::GetBinaryState(resource->factory_get_binary_state, GetInstanceId());
+            if (!state) throw state.GetError();
+            auto const& binary = state.GetValue();
+
+            auto id = resource->create_factory.Execute(nullptr);
+            auto cloned = std::make_unique<PluginSimulatorFactory>(GetPluginId(), id, resource);
+            auto result = resource->factory_set_binary_state.ExecuteRaw(id, binary.data.data(), binary.data.size(), binary.format_version);
+            if (!result) throw result.GetError();
+            return cloned;
         });
     }
 
     /// @brief このファクトリーの状態を JSON 形式で取得する
     /// @return JSON オブジェクト
     virtual nlohmann::json ToJson() const override {
-        return ExecuteResourceFunc<nlohmann::json>([&](auto resource) {
+        return ExecuteResourceFunc<nlohmann::json>([&](auto const& resource) {
             auto res = resource->object_creator_get_state.Execute(GetInstanceId());
             return nlohmann::json::parse(res);
         });
@@ -29,7 +29,7 @@ public:
           {}
 
     virtual std::unique_ptr<ISimulator> CreateSimulator() const override {
-        return ExecuteResourceFunc<std::unique_ptr<ISimulator>>([&](auto resource) -> std::unique_ptr<ISimulator> {
+        return ExecuteResourceFunc<std::unique_ptr<ISimulator>>([&](auto const& resource) -> std::unique_ptr<ISimulator> {
             auto id = resource->create_target.Execute(GetInstanceId());
             if (resource->IsInvertibleSimulator()) {
                 return std::make_unique<InvertiblePluginSimulator>(GetPluginId(), id, resource);
@@ -42,7 +42,7 @@ public:
     /// @brief このストレージの状態を JSON 形式で取得する
     /// @return JSON オブジェクト
     virtual nlohmann::json ToJson() const override {
-        return ExecuteResourceFunc<nlohmann::json>([&](auto resource) {
+        return ExecuteResourceFunc<nlohmann::json>([&](auto const& resource) {
             auto res = resource->object_creator_get_state.Execute(GetInstanceId());
             return nlohmann::json::parse(res);
         });
@@ -15,33 +15,52 @@ namespace digitalcurling::players {
 
 PluginPlayer::PluginPlayer(std::string player_id, uuidv7::uuidv7 instance_id, std::weak_ptr<OwnerResource> owner_resource)
     : WrapperBase(std::move(player_id), std::move(instance_id), std::move(owner_resource))
-      {}
+    , handle_(nullptr)
+    , native_(nullptr)
+{
+    ExecuteResourceFunc<void>([&](auto const& resource) {
+        handle_ = resource->GetInstanceList().template Get<plugins::PlayerHandle>(GetInstanceId()).get();
+#ifdef DIGITALCURLING_BUNDLE_PLUGINS
+        // 静的リンクされている場合はハンドルがそのままプラグインの実体を指す
+        if (handle_ && resource->IsStatic())
+            native_ = dynamic_cast<IPlayer*>(handle_);
+#endif
+    });
+    if (!handle_)
+        throw plugins::plugin_error{DIGITALCURLING_ERR_INSTANCE_NOT_FOUND, "Player instance not found: " + GetPluginId()};
+}
 
 moves::Shot PluginPlayer::Play(moves::Shot const& shot) {
+    using ShotConverter = plugins::detail::CTypeConverter<moves::Shot, DigitalCurling_Shot>;
+
     ClearCaches();
-    return ExecuteResourceFunc<moves::Shot>([&](auto resource) {
-        return resource->play.Execute(GetInstanceId(), shot);
+    return ExecuteResourceFunc<moves::Shot>([&](auto const& resource) {
+        auto const c_shot = ShotConverter::ToCType(shot);
+        const DigitalCurling_Shot* shot_ptr = &c_shot;
+        auto result = resource->play.ExecuteRaw(handle_, shot_ptr);
+        if (!result) throw result.GetError();
+        return ShotConverter::FromCType(result.GetValue());
     });
 }
 
 Gender PluginPlayer::GetGender() const {
-    return ExecuteResourceFunc<Gender>([&](auto resource) {
+    return ExecuteResourceFunc<Gender>([&](auto const& resource) {
         return resource->get_gender.Execute(GetInstanceId());
     });
 }
 
 IPlayerFactory const& PluginPlayer::GetFactory() const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    auto lock = LockIfMultiThreaded(mutex_);
     if (factory_cache_) return *factory_cache_;
 
-    ExecuteResourceFunc<void>([&](auto resource) {
+    ExecuteResourceFunc<void>([&](auto const& resource) {
         auto id = resource->get_factory.Execute(GetInstanceId());
         factory_cache_ = std::make_unique<PluginPlayerFactory>(GetPluginId(), id, resource);
     });
     return *factory_cache_;
 }
 std::unique_ptr<IPlayerStorage> PluginPlayer::CreateStorage() const {
-    return ExecuteResourceFunc<std::unique_ptr<IPlayerStorage>>([&](auto resource) {
+    return ExecuteResourceFunc<std::unique_ptr<IPlayerStorage>>([&](auto const& resource) {
         auto id = resource->create_storage.Execute(nullptr);
         resource->save.Execute(GetInstanceId(), id);
         return std::make_unique<PluginPlayerStorage>(GetPluginId(), id, resource);
@@ -53,7 +72,7 @@ void PluginPlayer::Save(IPlayerStorage& storage) const {
     if (!plugin_storage || GetPluginId() != plugin_storage->GetPlayerId())
         throw std::runtime_error("Failed to cast IPlayerStorage to PluginPlayerStorage for player: " + GetPluginId());
 
-    ExecuteResourceFunc<void>([&](auto resource) {
+    ExecuteResourceFunc<void>([&](auto const& resource) {
         resource->save.Execute(GetInstanceId(), plugin_storage->GetInstanceId());
     });
 }
@@ -63,7 +82,7 @@ void PluginPlayer::Load(IPlayerStorage const& storage) {
     if (!plugin_storage || GetPluginId() != plugin_storage->GetPlayerId())
         throw std::runtime_error("Failed to cast IPlayerStorage to PluginPlayerStorage for player: " + GetPluginId());
 
-    ExecuteResourceFunc<void>([&](auto resource) {
+    ExecuteResourceFunc<void>([&](auto const& resource) {
         resource->load.Execute(GetInstanceId(), plugin_storage->GetInstanceId());
     });
 }
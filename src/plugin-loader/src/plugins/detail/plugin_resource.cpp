@@ -1,7 +1,9 @@
 // Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
 // SPDX-License-Identifier: MIT
 
+#include <cstddef>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <stdexcept>
 #include <utility>
@@ -15,19 +17,39 @@
         } \
     } while (0)
 
+// プラグインの API バージョンに存在しない関数は nullptr として扱う
+// 古いプラグインの関数テーブルには該当するフィールドが無いため, バージョンを確認するまで field を評価してはならない
+// (関数の引数として渡すと, 呼び出し前に読み出されてしまう)
+#define DIGITALCURLING_PLUGIN_LOADER_SINCE_API_VERSION(plugin_version, since, field) \
+    ((plugin_version) >= (since) ? (field) : nullptr)
+
 namespace digitalcurling::plugins::detail {
 
+namespace {
+
+using StatsConverter = CTypeConverter<simulators::SimulatorStats, DigitalCurling_SimulatorStats>;
+
+} // namespace
+
 PluginResource::PluginResource(PluginInfo info, PluginApi api, std::optional<ModulePtr> handle)
-    : handle_(std::move(handle)),
+    // メンバーは宣言順 (関数テーブル, info_, api_, handle_, instance_list_) に初期化される
+    // info_ は関数テーブルより後に初期化されるため, バージョンの確認には移動前の引数 info を使用する
+    : create_factory(api.create_factory, api.free_string, api.destroy_factory, instance_list_, "create_factory"),
+      create_storage(api.create_storage, api.free_string, api.destroy_storage, instance_list_, "create_storage"),
+      create_target(api.create_target, api.free_string, api.destroy_target, instance_list_, "create_target"),
+      object_creator_get_state(api.object_creator_get_state, api.free_string, instance_list_, "object_creator_get_state"),
+      factory_set_state(api.factory_set_state, api.free_string, instance_list_, "factory_set_state"),
+      storage_set_state(api.storage_set_state, api.free_string, instance_list_, "storage_set_state"),
+      factory_get_binary_state(DIGITALCURLING_PLUGIN_LOADER_SINCE_API_VERSION(info.plugin_version, 4, api.factory_get_binary_state), api.free_string, instance_list_, "factory_get_binary_state"),
+      storage_get_binary_state(DIGITALCURLING_PLUGIN_LOADER_SINCE_API_VERSION(info.plugin_version, 4, api.storage_get_binary_state), api.free_string, instance_list_, "storage_get_binary_state"),
+      factory_set_binary_state(DIGITALCURLING_PLUGIN_LOADER_SINCE_API_VERSION(info.plugin_version, 4, api.factory_set_binary_state), api.free_string, instance_list_, "factory_set_binary_state"),
+      storage_set_binary_state(DIGITALCURLING_PLUGIN_LOADER_SINCE_API_VERSION(info.plugin_version, 4, api.storage_set_binary_state), api.free_string, instance_list_, "storage_set_binary_state"),
+      trace_start(DIGITALCURLING_PLUGIN_LOADER_SINCE_API_VERSION(info.plugin_version, 6, api.trace_start), api.free_string, instance_list_, "trace_start"),
+      trace_stop(DIGITALCURLING_PLUGIN_LOADER_SINCE_API_VERSION(info.plugin_version, 6, api.trace_stop), api.free_string, instance_list_, "trace_stop"),
       info_(std::move(info)),
       api_(std::move(api)),
-      instance_list_(),
-      create_factory(api.create_factory, api.free_string, api.destroy_factory, instance_list_),
-      create_storage(api.create_storage, api.free_string, api.destroy_storage, instance_list_),
-      create_target(api.create_target, api.free_string, api.destroy_target, instance_list_),
-      object_creator_get_state(api.object_creator_get_state, api.free_string, instance_list_),
-      factory_set_state(api.factory_set_state, api.free_string, instance_list_),
-      storage_set_state(api.storage_set_state, api.free_string, instance_list_)
+      handle_(std::move(handle)),
+      instance_list_()
 {
     DIGITALCURLING_PLUGIN_LOADER_CHECK_VALID_FUNC(api.free_string);
     DIGITALCURLING_PLUGIN_LOADER_CHECK_VALID_FUNC(api.destroy_factory);
@@ -56,11 +78,11 @@ std::shared_ptr<PluginResource> PluginResource::Create(PluginInfo info, PluginAp
 
 PlayerPluginResource::PlayerPluginResource(PluginInfo info, PluginApi api, std::optional<ModulePtr> handle)
     : PluginResource(std::move(info), api, std::move(handle)),
-      get_factory(api.player->get_factory, api.free_string, api.destroy_factory, instance_list_),
-      save(api.player->save, api.free_string, instance_list_),
-      load(api.player->load, api.free_string, instance_list_),
-      get_gender(api.player->get_gender, api.free_string, instance_list_),
-      play(api.player->play, api.free_string, instance_list_)
+      get_factory(api.player->get_factory, api.free_string, api.destroy_factory, instance_list_, "get_factory"),
+      save(api.player->save, api.free_string, instance_list_, "save"),
+      load(api.player->load, api.free_string, instance_list_, "load"),
+      get_gender(api.player->get_gender, api.free_string, instance_list_, "get_gender"),
+      play(api.player->play, api.free_string, instance_list_, "play")
 {
     DIGITALCURLING_PLUGIN_LOADER_CHECK_VALID_FUNC(get_factory);
     DIGITALCURLING_PLUGIN_LOADER_CHECK_VALID_FUNC(save);
@@ -71,17 +93,23 @@ PlayerPluginResource::PlayerPluginResource(PluginInfo info, PluginApi api, std::
 
 SimulatorPluginResource::SimulatorPluginResource(PluginInfo info, PluginApi api, std::optional<ModulePtr> handle)
     : PluginResource(std::move(info), api, std::move(handle)),
-      get_factory(api.simulator->get_factory, api.free_string, api.destroy_factory, instance_list_),
-      save(api.simulator->save, api.free_string, instance_list_),
-      load(api.simulator->load, api.free_string, instance_list_),
-      step(api.simulator->step, api.free_string, instance_list_),
-      simulate(api.simulator->simulate, api.free_string, instance_list_),
-      set_stones(api.simulator->set_stones, api.free_string, instance_list_),
-      are_all_stones_stopped(api.simulator->are_all_stones_stopped, api.free_string, instance_list_),
-      get_stones(api.simulator->get_stones, api.free_string, instance_list_),
-      get_collisions(api.simulator->get_collisions, api.free_string, instance_list_),
-      get_seconds_per_frame(api.simulator->get_seconds_per_frame, api.free_string, instance_list_),
-      calculate_shot(api.simulator->calculate_shot, api.free_string, instance_list_)
+      // 基底クラスの初期化で info は移動済みのため, 以降は info_ を参照する
+      get_factory(api.simulator->get_factory, api.free_string, api.destroy_factory, instance_list_, "get_factory"),
+      save(api.simulator->save, api.free_string, instance_list_, "save"),
+      load(api.simulator->load, api.free_string, instance_list_, "load"),
+      step(api.simulator->step, api.free_string, instance_list_, "step"),
+      simulate(api.simulator->simulate, api.free_string, instance_list_, "simulate"),
+      set_stones(api.simulator->set_stones, api.free_string, instance_list_, "set_stones"),
+      are_all_stones_stopped(api.simulator->are_all_stones_stopped, api.free_string, instance_list_, "are_all_stones_stopped"),
+      get_stones(api.simulator->get_stones, api.free_string, instance_list_, "get_stones"),
+      get_collisions(api.simulator->get_collisions, api.free_string, instance_list_, "get_collisions"),
+      get_seconds_per_frame(api.simulator->get_seconds_per_frame, api.free_string, instance_list_, "get_seconds_per_frame"),
+      calculate_shot(api.simulator->calculate_shot, api.free_string, instance_list_, "calculate_shot"),
+      simulate_batch(DIGITALCURLING_PLUGIN_LOADER_SINCE_API_VERSION(info_.plugin_version, 2, api.simulator->simulate_batch), api.free_string, instance_list_, "simulate_batch"),
+      get_collision_records(DIGITALCURLING_PLUGIN_LOADER_SINCE_API_VERSION(info_.plugin_version, 3, api.simulator->get_collision_records), api.free_string, instance_list_, "get_collision_records"),
+      get_stats(DIGITALCURLING_PLUGIN_LOADER_SINCE_API_VERSION(info_.plugin_version, 5, api.simulator->get_stats), api.free_string, instance_list_, "get_stats"),
+      retired_stats_mutex_(),
+      retired_stats_()
 {
     DIGITALCURLING_PLUGIN_LOADER_CHECK_VALID_FUNC(get_factory);
     DIGITALCURLING_PLUGIN_LOADER_CHECK_VALID_FUNC(save);
@@ -95,4 +123,34 @@ SimulatorPluginResource::SimulatorPluginResource(PluginInfo info, PluginApi api,
     DIGITALCURLING_PLUGIN_LOADER_CHECK_VALID_FUNC(get_seconds_per_frame);
 }
 
+bool SimulatorPluginResource::RemoveInstance(const uuidv7::uuidv7& id) {
+    if (SupportsStats() && instance_list_.Get<SimulatorHandle>(id)) {
+        auto result = get_stats.ExecuteRaw(id);
+        if (result) {
+            std::lock_guard lock(retired_stats_mutex_);
+            retired_stats_ += StatsConverter::FromCType(result.GetValue());
+        }
+    }
+    return instance_list_.Remove(id);
+}
+simulators::SimulatorStats SimulatorPluginResource::GetStats(std::size_t* out_instance_count) {
+    simulators::SimulatorStats stats;
+    std::size_t instance_count = 0;
+    for (auto const& id : instance_list_.GetAllId()) {
+        if (!instance_list_.Get<SimulatorHandle>(id)) continue;
+        ++instance_count;
+        if (!SupportsStats()) continue;
+
+        // 集計中に破棄されたインスタンスは取得に失敗するため, 破棄済みの集計に含まれる
+        auto result = get_stats.ExecuteRaw(id);
+        if (result) stats += StatsConverter::FromCType(result.GetValue());
+    }
+    {
+        std::lock_guard lock(retired_stats_mutex_);
+        stats += retired_stats_;
+    }
+    if (out_instance_count) *out_instance_count = instance_count;
+    return stats;
+}
+
 } // namespace digitalcurling::plugins::detail
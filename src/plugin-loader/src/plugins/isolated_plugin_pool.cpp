@@ -0,0 +1,645 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+#include "digitalcurling/plugins/isolated_plugin_pool.hpp"
+
+#if defined(__linux__) && !defined(DIGITALCURLING_PLUGIN_LOADER_DISABLE_DYNAMIC)
+
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "digitalcurling/stone_coordinate.hpp"
+#include "digitalcurling/plugins/plugin_error.hpp"
+#include "digitalcurling/plugins/detail/c_type_converter.hpp"
+#include "digitalcurling/plugins/detail/native_loader.hpp"
+#include "digitalcurling/plugins/detail/plugin_resource.hpp"
+
+namespace digitalcurling::plugins {
+
+namespace detail {
+
+namespace {
+
+constexpr std::uint32_t kRingCapacity = 64;
+constexpr std::size_t kMessageSize = 256;
+constexpr std::size_t kNameSize = 64;
+constexpr int kWaitTimeoutMs = 10;
+constexpr int kShutdownTimeoutMs = 1000;
+// 1つのジョブを実行してよい回数 (クラッシュ時に1回だけ再実行する)
+constexpr std::uint8_t kMaxAttempts = 2;
+// ワーカープロセスに共有メモリを渡すファイルディスクリプタの番号
+constexpr int kSharedMemoryFd = 3;
+// ワーカーの実行ファイル
+constexpr const char* kWorkerExecutableName = "digitalcurling_plugin_worker";
+constexpr const char* kWorkerPathEnv = "DIGITALCURLING_PLUGIN_WORKER";
+
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "Shared memory requires lock-free 32-bit atomics.");
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Shared memory requires lock-free 64-bit atomics.");
+
+enum class JobKind : std::uint32_t {
+    kSimulate,
+    kPlay,
+};
+
+enum class WorkerState : std::uint32_t {
+    kStarting,
+    kReady,
+    kFailed,
+};
+
+struct JobRequest {
+    std::uint64_t job_index;
+    JobKind kind;
+    std::int32_t shot_stone_index;
+    DigitalCurling_SimulateModeFlag mode_flag;
+    float sheet_width;
+    std::uint32_t has_shot;
+    DigitalCurling_StoneCoordinate stones;
+    DigitalCurling_Shot shot;
+};
+
+struct JobResponse {
+    std::uint64_t job_index;
+    DigitalCurling_ErrorCode result;
+    DigitalCurling_StoneCoordinate stones;
+    DigitalCurling_Shot shot;
+    char error_message[kMessageSize];
+};
+
+// 単一の生産者と単一の消費者の間のリングバッファ (プロセス間で共有する)
+template <typename T>
+struct SpscRing {
+    alignas(64) std::atomic<std::uint32_t> head;
+    alignas(64) std::atomic<std::uint32_t> tail;
+    T slots[kRingCapacity];
+
+    void Reset() {
+        head.store(0, std::memory_order_relaxed);
+        tail.store(0, std::memory_order_relaxed);
+    }
+    bool TryPush(T const& value) {
+        auto const t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == kRingCapacity) return false;
+        slots[t % kRingCapacity] = value;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+    bool TryPop(T& value) {
+        auto const h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return false;
+        value = slots[h % kRingCapacity];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+// ワーカー1つ分の共有領域
+struct Channel {
+    SpscRing<JobRequest> requests;
+    SpscRing<JobResponse> responses;
+    // ワーカーはジョブが投入されるまでこの値で待機する
+    alignas(64) std::atomic<std::uint32_t> request_seq;
+    // ワーカーが実行中のジョブのインデックス + 1 (実行中でなければ 0)
+    std::atomic<std::uint64_t> current_job;
+    std::atomic<WorkerState> state;
+    DigitalCurling_PluginType plugin_type;
+    DigitalCurling_ErrorCode error_code;
+    char plugin_name[kNameSize];
+    char error_message[kMessageSize];
+};
+
+struct SharedHeader {
+    // ホストは結果が返されるまでこの値で待機する
+    alignas(64) std::atomic<std::uint32_t> response_seq;
+    std::atomic<std::uint32_t> shutdown;
+};
+
+// 共有領域は SharedHeader に続けてワーカーの数だけ Channel を並べる
+constexpr std::size_t kChannelsOffset = (sizeof(SharedHeader) + alignof(Channel) - 1) / alignof(Channel) * alignof(Channel);
+
+void FutexWait(std::atomic<std::uint32_t>& word, std::uint32_t expected, int timeout_ms) {
+    timespec timeout{ timeout_ms / 1000, static_cast<long>(timeout_ms % 1000) * 1000000L };
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+}
+void FutexWake(std::atomic<std::uint32_t>& word) {
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+void CopyMessage(char (&dest)[kMessageSize], const char* message) {
+    std::strncpy(dest, message, kMessageSize - 1);
+    dest[kMessageSize - 1] = '\0';
+}
+
+void SetError(JobResponse& response, plugin_error const& error) {
+    response.result = static_cast<DigitalCurling_ErrorCode>(error.code());
+    CopyMessage(response.error_message, error.what());
+}
+
+void ExecuteSimulate(SimulatorPluginResource const& resource, uuidv7::uuidv7 const& target_id, JobRequest const& request, JobResponse& response) {
+    DigitalCurling_StoneCoordinate initial = request.stones;
+    if (request.has_shot) {
+        auto const shot = moves::Shot(request.shot.translational_velocity, request.shot.angular_velocity, request.shot.release_angle);
+        auto const velocity = shot.ToVector2();
+        auto& shot_stone = initial.stones[request.shot_stone_index];
+        shot_stone.position = DigitalCurling_Vector2{ 0.f, 0.f };
+        shot_stone.angle = 0.f;
+        shot_stone.translational_velocity = DigitalCurling_Vector2{ velocity.x, velocity.y };
+        shot_stone.angular_velocity = shot.angular_velocity;
+    }
+
+    const DigitalCurling_StoneCoordinate* initial_ptr = &initial;
+    auto set_result = resource.set_stones.ExecuteRaw(target_id, initial_ptr);
+    if (!set_result) return SetError(response, set_result.GetError());
+    auto simulate_result = resource.simulate.ExecuteRaw(target_id, request.mode_flag, request.sheet_width);
+    if (!simulate_result) return SetError(response, simulate_result.GetError());
+    auto get_result = resource.get_stones.ExecuteRaw(target_id);
+    if (!get_result) return SetError(response, get_result.GetError());
+    response.stones = get_result.GetValue();
+}
+
+void ExecutePlay(PlayerPluginResource const& resource, uuidv7::uuidv7 const& target_id, JobRequest const& request, JobResponse& response) {
+    const DigitalCurling_Shot* shot_ptr = &request.shot;
+    auto result = resource.play.ExecuteRaw(target_id, shot_ptr);
+    if (!result) return SetError(response, result.GetError());
+    response.shot = result.GetValue();
+}
+
+// ワーカーの実行ファイルを探す
+// 環境変数, ローダーを含むモジュールと同じディレクトリ, その ../bin, 実行中のプログラムと同じディレクトリ, ビルドツリーの順に探索する
+std::string FindWorkerExecutable() {
+    if (auto const* path = std::getenv(kWorkerPathEnv); path && *path) return path;
+
+    std::vector<std::filesystem::path> candidates;
+    Dl_info info{};
+    if (dladdr(reinterpret_cast<void*>(&FindWorkerExecutable), &info) && info.dli_fname && *info.dli_fname) {
+        auto const dir = std::filesystem::path(info.dli_fname).parent_path();
+        candidates.push_back(dir / kWorkerExecutableName);
+        candidates.push_back(dir / ".." / "bin" / kWorkerExecutableName);
+    }
+    std::error_code ec;
+    if (auto const exe = std::filesystem::read_symlink("/proc/self/exe", ec); !ec)
+        candidates.push_back(exe.parent_path() / kWorkerExecutableName);
+#ifdef DIGITALCURLING_PLUGIN_WORKER_BUILD_PATH
+    candidates.emplace_back(DIGITALCURLING_PLUGIN_WORKER_BUILD_PATH);
+#endif
+
+    for (auto const& candidate : candidates) {
+        if (access(candidate.c_str(), X_OK) == 0) return candidate.string();
+    }
+    throw plugin_error{ DIGITALCURLING_ERR_FAILED_TO_LOAD_PLUGIN,
+        std::string("Worker executable \"") + kWorkerExecutableName + "\" was not found. Set " + kWorkerPathEnv + " to its path." };
+}
+
+// ワーカープロセスの処理
+int RunWorker(SharedHeader& header, Channel& channel, pid_t host_pid, std::string const& plugin_path, std::optional<std::string> const& config) {
+    // ホストが終了した場合はワーカーも終了する
+    // PR_SET_PDEATHSIG はワーカーを起動したスレッドの終了でも発火するため使わず, 待機のたびに親プロセスを確認する
+    if (getppid() != host_pid) return 0;
+
+    std::shared_ptr<PluginResource> resource;
+    uuidv7::uuidv7 target_id;
+    try {
+        auto native = LoadNativePlugin(plugin_path);
+        auto info = native.get_plugin_info();
+        if (info.plugin_version < DIGITALCURLING_PLUGIN_API_MIN_VERSION || info.plugin_version > DIGITALCURLING_PLUGIN_API_VERSION)
+            throw plugin_error{ DIGITALCURLING_ERR_PLUGIN_VERSION_MISMATCH, "Plugin version is incompatible." };
+
+        resource = PluginResource::Create(info, native.get_plugin_api(), std::move(native.handle));
+        auto factory_id = resource->create_factory.Execute(config ? config->c_str() : nullptr);
+        target_id = resource->create_target.Execute(factory_id);
+
+        channel.plugin_type = info.plugin_type;
+        std::strncpy(channel.plugin_name, info.plugin_name, kNameSize - 1);
+        channel.plugin_name[kNameSize - 1] = '\0';
+        channel.state.store(WorkerState::kReady, std::memory_order_release);
+    } catch (std::exception const& e) {
+        auto const* error = dynamic_cast<plugin_error const*>(&e);
+        channel.error_code = error ? static_cast<DigitalCurling_ErrorCode>(error->code()) : DIGITALCURLING_ERR_FAILED_TO_LOAD_PLUGIN;
+        CopyMessage(channel.error_message, e.what());
+        channel.state.store(WorkerState::kFailed, std::memory_order_release);
+    }
+    header.response_seq.fetch_add(1, std::memory_order_release);
+    FutexWake(header.response_seq);
+    if (channel.state.load(std::memory_order_relaxed) != WorkerState::kReady) return 1;
+
+    auto const simulator = std::dynamic_pointer_cast<SimulatorPluginResource>(resource);
+    auto const player = std::dynamic_pointer_cast<PlayerPluginResource>(resource);
+
+    JobRequest request;
+    JobResponse response;
+    for (;;) {
+        if (!channel.requests.TryPop(request)) {
+            auto const seq = channel.request_seq.load(std::memory_order_acquire);
+            if (header.shutdown.load(std::memory_order_acquire) || getppid() != host_pid) return 0;
+            if (!channel.requests.TryPop(request)) {
+                FutexWait(channel.request_seq, seq, kWaitTimeoutMs * 10);
+                continue;
+            }
+        }
+
+        // クラッシュした場合にホストが再実行の回数を数えるジョブ
+        channel.current_job.store(request.job_index + 1, std::memory_order_release);
+        response.job_index = request.job_index;
+        response.result = DIGITALCURLING_OK;
+        response.error_message[0] = '\0';
+        if (request.kind == JobKind::kSimulate && simulator) {
+            ExecuteSimulate(*simulator, target_id, request, response);
+        } else if (request.kind == JobKind::kPlay && player) {
+            ExecutePlay(*player, target_id, request, response);
+        } else {
+            SetError(response, plugin_error{ DIGITALCURLING_ERR_INVALID_PLUGIN_TYPE, "The job is not supported by the plugin." });
+        }
+
+        // ホストは処理中のジョブをリングの容量以下に抑えるため, 通常は空きがある
+        while (!channel.responses.TryPush(response)) std::this_thread::yield();
+        channel.current_job.store(0, std::memory_order_release);
+        header.response_seq.fetch_add(1, std::memory_order_release);
+        FutexWake(header.response_seq);
+    }
+}
+
+} // namespace
+
+
+struct IsolatedPoolState {
+    std::string plugin_path;
+    std::optional<std::string> config;
+    std::string worker_path;
+    PluginType type = PluginType::simulator;
+    std::string name;
+
+    int shared_memory_fd = -1;
+    void* region = MAP_FAILED;
+    std::size_t region_size = 0;
+    SharedHeader* header = nullptr;
+    Channel* channels = nullptr;
+
+    // 一括処理を直列化する
+    std::mutex run_mutex;
+    // pids と restart_count は一括処理のスレッドだけが書き換え, 書き換えと外部からの読み出しは mutex で保護する
+    std::vector<pid_t> pids;
+    std::size_t restart_count = 0;
+    mutable std::mutex mutex;
+
+    ~IsolatedPoolState() {
+        if (header) {
+            header->shutdown.store(1, std::memory_order_release);
+            for (std::size_t i = 0; i < pids.size(); ++i) {
+                channels[i].request_seq.fetch_add(1, std::memory_order_release);
+                FutexWake(channels[i].request_seq);
+            }
+            auto const deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(kShutdownTimeoutMs);
+            for (auto pid : pids) {
+                if (pid <= 0) continue;
+                while (waitpid(pid, nullptr, WNOHANG) == 0) {
+                    if (std::chrono::steady_clock::now() >= deadline) {
+                        kill(pid, SIGKILL);
+                        waitpid(pid, nullptr, 0);
+                        break;
+                    }
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }
+        }
+        if (region != MAP_FAILED) munmap(region, region_size);
+        if (shared_memory_fd >= 0) close(shared_memory_fd);
+    }
+
+    pid_t Spawn(std::size_t index) {
+        auto& channel = channels[index];
+        channel.requests.Reset();
+        channel.responses.Reset();
+        channel.current_job.store(0, std::memory_order_relaxed);
+        channel.state.store(WorkerState::kStarting, std::memory_order_relaxed);
+        channel.error_code = DIGITALCURLING_OK;
+        channel.error_message[0] = '\0';
+
+        // マルチスレッドのホストを fork するとロックを保持したままの子プロセスでロードを行うことになるため,
+        // 別の実行ファイルを posix_spawn で起動し, 共有メモリはファイルディスクリプタで渡す
+        auto const index_arg = std::to_string(index);
+        auto const host_pid_arg = std::to_string(getpid());
+        std::vector<char*> argv{
+            const_cast<char*>(worker_path.c_str()),
+            const_cast<char*>(index_arg.c_str()),
+            const_cast<char*>(host_pid_arg.c_str()),
+            const_cast<char*>(plugin_path.c_str()),
+        };
+        if (config) argv.push_back(const_cast<char*>(config->c_str()));
+        argv.push_back(nullptr);
+
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_adddup2(&actions, shared_memory_fd, kSharedMemoryFd);
+        pid_t pid = 0;
+        auto const error = posix_spawn(&pid, worker_path.c_str(), &actions, nullptr, argv.data(), environ);
+        posix_spawn_file_actions_destroy(&actions);
+        if (error != 0)
+            throw plugin_error{ DIGITALCURLING_ERR_OTHER_EXCEPTION, "Failed to start worker process \"" + worker_path + "\": " + std::strerror(error) };
+        return pid;
+    }
+    void SetPid(std::size_t index, pid_t pid) {
+        std::lock_guard lock(mutex);
+        pids[index] = pid;
+    }
+
+    // 終了したワーカーを回収し, 終了していれば true を返す
+    bool Reap(std::size_t index) {
+        if (pids[index] <= 0) return false;
+        if (waitpid(pids[index], nullptr, WNOHANG) != pids[index]) return false;
+        SetPid(index, 0);
+        return true;
+    }
+
+    template <typename TFill, typename TStore>
+    void Run(std::size_t count, JobKind kind, TFill&& fill, TStore&& store) {
+        // mutex は保持し続けないため, 一括処理の間もワーカーの情報を取得できる
+        std::lock_guard lock(run_mutex);
+
+        std::deque<std::size_t> pending;
+        for (std::size_t i = 0; i < count; ++i) pending.push_back(i);
+        std::vector<std::uint8_t> attempts(count, 0);
+        std::vector<std::deque<std::size_t>> in_flight(pids.size());
+        std::optional<std::pair<std::size_t, plugin_error>> first_error;
+        std::size_t completed = 0;
+
+        auto fail = [&](std::size_t job_index, plugin_error error) {
+            if (!first_error || job_index < first_error->first) first_error.emplace(job_index, std::move(error));
+            ++completed;
+        };
+        auto collect = [&](std::size_t worker) {
+            bool collected = false;
+            JobResponse response;
+            while (channels[worker].responses.TryPop(response)) {
+                auto const job_index = static_cast<std::size_t>(response.job_index);
+                auto& jobs = in_flight[worker];
+                jobs.erase(std::find(jobs.begin(), jobs.end(), job_index));
+                if (response.result == DIGITALCURLING_OK) {
+                    store(job_index, response);
+                    ++completed;
+                } else {
+                    fail(job_index, plugin_error{ response.result, response.error_message });
+                }
+                collected = true;
+            }
+            return collected;
+        };
+
+        JobRequest request{};
+        request.kind = kind;
+        while (completed < count) {
+            // 1. 空きのあるワーカーにジョブを投入する
+            for (std::size_t w = 0; w < pids.size() && !pending.empty(); ++w) {
+                if (pids[w] <= 0) continue;
+                bool pushed = false;
+                while (!pending.empty() && in_flight[w].size() < kRingCapacity) {
+                    auto const job_index = pending.front();
+                    request.job_index = job_index;
+                    fill(job_index, request);
+                    if (!channels[w].requests.TryPush(request)) break;
+                    in_flight[w].push_back(job_index);
+                    pending.pop_front();
+                    pushed = true;
+                }
+                if (pushed) {
+                    channels[w].request_seq.fetch_add(1, std::memory_order_release);
+                    FutexWake(channels[w].request_seq);
+                }
+            }
+
+            // 2. 結果を回収する
+            auto const seq = header->response_seq.load(std::memory_order_acquire);
+            bool progress = false;
+            for (std::size_t w = 0; w < pids.size(); ++w) progress |= collect(w);
+            if (progress) continue;
+
+            // 3. 終了したワーカーの処理中のジョブを戻し, ワーカーを再起動する
+            // 再実行の回数は終了時に実行していたジョブだけに数え, 順番待ちだったジョブはそのまま戻す
+            bool any_alive = false;
+            for (std::size_t w = 0; w < pids.size(); ++w) {
+                if (Reap(w)) {
+                    collect(w);
+                    bool const was_ready = channels[w].state.load(std::memory_order_acquire) == WorkerState::kReady;
+                    auto const current_job = channels[w].current_job.load(std::memory_order_acquire);
+                    auto& jobs = in_flight[w];
+                    for (auto it = jobs.rbegin(); it != jobs.rend(); ++it) {
+                        auto const job_index = *it;
+                        if (current_job == job_index + 1 && ++attempts[job_index] >= kMaxAttempts)
+                            fail(job_index, plugin_error{ DIGITALCURLING_ERR_OTHER_EXCEPTION,
+                                "Worker process crashed while processing job " + std::to_string(job_index) + "." });
+                        else
+                            pending.push_front(job_index);
+                    }
+                    jobs.clear();
+                    // 初期化中に終了したワーカーは再起動しない
+                    if (was_ready) {
+                        SetPid(w, Spawn(w));
+                        std::lock_guard state_lock(mutex);
+                        ++restart_count;
+                    }
+                }
+                any_alive |= pids[w] > 0;
+            }
+            if (!any_alive) {
+                for (auto job_index : pending)
+                    fail(job_index, plugin_error{ DIGITALCURLING_ERR_OTHER_EXCEPTION, "No worker process is available." });
+                pending.clear();
+                break;
+            }
+
+            FutexWait(header->response_seq, seq, kWaitTimeoutMs);
+        }
+
+        if (first_error) throw first_error->second;
+    }
+};
+
+} // namespace detail
+
+
+IsolatedPluginPool::IsolatedPluginPool(const std::filesystem::path& plugin_path, const std::optional<nlohmann::json>& config, std::size_t worker_count)
+    : state_(std::make_unique<detail::IsolatedPoolState>())
+{
+    if (worker_count == 0) worker_count = std::max(1u, std::thread::hardware_concurrency());
+
+    auto& state = *state_;
+    state.plugin_path = plugin_path.string();
+    if (config) state.config = config->dump();
+    state.worker_path = detail::FindWorkerExecutable();
+
+    state.region_size = detail::kChannelsOffset + sizeof(detail::Channel) * worker_count;
+    // dup2 は複製元と複製先が同じ番号の場合に FD_CLOEXEC を解除しないため, 受け渡し用の番号より後ろに移す
+    auto const memfd = memfd_create("digitalcurling_isolated_pool", MFD_CLOEXEC);
+    if (memfd >= 0) {
+        state.shared_memory_fd = fcntl(memfd, F_DUPFD_CLOEXEC, detail::kSharedMemoryFd + 1);
+        close(memfd);
+    }
+    if (state.shared_memory_fd < 0 || ftruncate(state.shared_memory_fd, static_cast<off_t>(state.region_size)) != 0)
+        throw plugin_error{ DIGITALCURLING_ERR_MEMORY_ALLOCATION, std::string("Failed to create shared memory: ") + std::strerror(errno) };
+    state.region = mmap(nullptr, state.region_size, PROT_READ | PROT_WRITE, MAP_SHARED, state.shared_memory_fd, 0);
+    if (state.region == MAP_FAILED)
+        throw plugin_error{ DIGITALCURLING_ERR_MEMORY_ALLOCATION, std::string("Failed to map shared memory: ") + std::strerror(errno) };
+
+    auto* base = static_cast<std::uint8_t*>(state.region);
+    state.header = new (base) detail::SharedHeader{};
+    state.channels = reinterpret_cast<detail::Channel*>(base + detail::kChannelsOffset);
+    for (std::size_t i = 0; i < worker_count; ++i) new (&state.channels[i]) detail::Channel{};
+
+    state.pids.assign(worker_count, 0);
+    for (std::size_t i = 0; i < worker_count; ++i) state.SetPid(i, state.Spawn(i));
+
+    // すべてのワーカーの初期化を待つ
+    for (std::size_t i = 0; i < worker_count; ++i) {
+        auto& channel = state.channels[i];
+        for (;;) {
+            auto const seq = state.header->response_seq.load(std::memory_order_acquire);
+            auto const worker_state = channel.state.load(std::memory_order_acquire);
+            if (worker_state == detail::WorkerState::kReady) break;
+            if (worker_state == detail::WorkerState::kFailed)
+                throw plugin_error{ channel.error_code, "\"" + state.plugin_path + "\": " + channel.error_message };
+            if (state.Reap(i))
+                throw plugin_error{ DIGITALCURLING_ERR_FAILED_TO_LOAD_PLUGIN, "\"" + state.plugin_path + "\": Worker process exited during initialization." };
+            detail::FutexWait(state.header->response_seq, seq, detail::kWaitTimeoutMs);
+        }
+    }
+
+    state.type = static_cast<PluginType>(state.channels[0].plugin_type);
+    state.name = state.channels[0].plugin_name;
+}
+
+IsolatedPluginPool::~IsolatedPluginPool() = default;
+
+int IsolatedPluginPool::RunWorker(int argc, char** argv) {
+    if (argc != 4 && argc != 5) {
+        std::fprintf(stderr, "usage: %s <worker_index> <host_pid> <plugin_path> [config]\n", argc > 0 ? argv[0] : detail::kWorkerExecutableName);
+        return 2;
+    }
+
+    std::size_t index = 0;
+    pid_t host_pid = 0;
+    try {
+        index = std::stoul(argv[1]);
+        host_pid = static_cast<pid_t>(std::stol(argv[2]));
+    } catch (std::exception const&) {
+        std::fprintf(stderr, "%s: invalid arguments\n", argv[0]);
+        return 2;
+    }
+
+    struct stat st{};
+    if (fstat(detail::kSharedMemoryFd, &st) != 0) {
+        std::fprintf(stderr, "%s: shared memory is not passed\n", argv[0]);
+        return 2;
+    }
+    auto const region_size = static_cast<std::size_t>(st.st_size);
+    if (region_size < detail::kChannelsOffset + sizeof(detail::Channel) * (index + 1)) {
+        std::fprintf(stderr, "%s: worker index is out of range\n", argv[0]);
+        return 2;
+    }
+    void* region = mmap(nullptr, region_size, PROT_READ | PROT_WRITE, MAP_SHARED, detail::kSharedMemoryFd, 0);
+    close(detail::kSharedMemoryFd);
+    if (region == MAP_FAILED) {
+        std::fprintf(stderr, "%s: failed to map shared memory: %s\n", argv[0], std::strerror(errno));
+        return 2;
+    }
+
+    auto* base = static_cast<std::uint8_t*>(region);
+    auto& header = *reinterpret_cast<detail::SharedHeader*>(base);
+    auto& channel = reinterpret_cast<detail::Channel*>(base + detail::kChannelsOffset)[index];
+    std::optional<std::string> config;
+    if (argc == 5) config = argv[4];
+    return detail::RunWorker(header, channel, host_pid, argv[3], config);
+}
+
+PluginType IsolatedPluginPool::GetType() const { return state_->type; }
+std::string const& IsolatedPluginPool::GetName() const { return state_->name; }
+std::size_t IsolatedPluginPool::GetWorkerCount() const { return state_->pids.size(); }
+
+std::vector<int> IsolatedPluginPool::GetWorkerProcessIds() const {
+    std::lock_guard lock(state_->mutex);
+    return std::vector<int>(state_->pids.begin(), state_->pids.end());
+}
+std::size_t IsolatedPluginPool::GetRestartCount() const {
+    std::lock_guard lock(state_->mutex);
+    return state_->restart_count;
+}
+
+std::vector<simulators::ISimulator::AllStones> IsolatedPluginPool::SimulateBatch(
+    std::vector<simulators::ISimulator::AllStones> const& stones,
+    std::vector<moves::Shot> const& shots,
+    std::size_t shot_stone_index,
+    simulators::SimulateModeFlag mode_flag,
+    float sheet_width
+) {
+    if (state_->type != PluginType::simulator)
+        throw plugin_error{ DIGITALCURLING_ERR_INVALID_PLUGIN_TYPE, "IsolatedPluginPool::SimulateBatch: the plugin is not a simulator." };
+    if (!shots.empty() && shots.size() != stones.size())
+        throw std::invalid_argument("IsolatedPluginPool::SimulateBatch: shots must be empty or have the same size as stones.");
+    if (!shots.empty() && shot_stone_index >= StoneCoordinate::kStoneMax)
+        throw std::invalid_argument("IsolatedPluginPool::SimulateBatch: shot_stone_index is out of range.");
+
+    using StonesConverter = detail::CTypeConverter<simulators::ISimulator::AllStones, DigitalCurling_StoneCoordinate>;
+    using ShotConverter = detail::CTypeConverter<moves::Shot, DigitalCurling_Shot>;
+    using ModeConverter = detail::CTypeConverter<simulators::SimulateModeFlag, DigitalCurling_SimulateModeFlag>;
+
+    std::vector<simulators::ISimulator::AllStones> results(stones.size());
+    state_->Run(stones.size(), detail::JobKind::kSimulate,
+        [&](std::size_t i, detail::JobRequest& request) {
+            request.shot_stone_index = static_cast<std::int32_t>(shot_stone_index);
+            request.mode_flag = ModeConverter::ToCType(mode_flag);
+            request.sheet_width = sheet_width;
+            request.stones = StonesConverter::ToCType(stones[i]);
+            request.has_shot = shots.empty() ? 0 : 1;
+            if (!shots.empty()) request.shot = ShotConverter::ToCType(shots[i]);
+        },
+        [&](std::size_t i, detail::JobResponse const& response) {
+            results[i] = StonesConverter::FromCType(response.stones);
+        });
+    return results;
+}
+
+std::vector<moves::Shot> IsolatedPluginPool::PlayBatch(std::vector<moves::Shot> const& shots) {
+    if (state_->type != PluginType::player)
+        throw plugin_error{ DIGITALCURLING_ERR_INVALID_PLUGIN_TYPE, "IsolatedPluginPool::PlayBatch: the plugin is not a player." };
+
+    using ShotConverter = detail::CTypeConverter<moves::Shot, DigitalCurling_Shot>;
+
+    std::vector<moves::Shot> results(shots.size());
+    state_->Run(shots.size(), detail::JobKind::kPlay,
+        [&](std::size_t i, detail::JobRequest& request) {
+            request.shot = ShotConverter::ToCType(shots[i]);
+        },
+        [&](std::size_t i, detail::JobResponse const& response) {
+            results[i] = ShotConverter::FromCType(response.shot);
+        });
+    return results;
+}
+
+} // namespace digitalcurling::plugins
+
+#endif // defined(__linux__) && !defined(DIGITALCURLING_PLUGIN_LOADER_DISABLE_DYNAMIC)
@@ -0,0 +1,10 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+// IsolatedPluginPool のワーカープロセス
+
+#include "digitalcurling/plugins/isolated_plugin_pool.hpp"
+
+int main(int argc, char** argv) {
+    return digitalcurling::plugins::IsolatedPluginPool::RunWorker(argc, argv);
+}
@@ -1,8 +1,16 @@
 // Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
 // SPDX-License-Identifier: MIT
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
+#include <deque>
+#include <filesystem>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -11,11 +19,15 @@
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 #include <nlohmann/json.hpp>
 #include <uuidv7/uuidv7.hpp>
+#include "digitalcurling/stone_coordinate.hpp"
 #include "digitalcurling/moves/shot.hpp"
+#include "digitalcurling/trace.hpp"
 #include "digitalcurling/plugins/plugin_manager.hpp"
 #include "digitalcurling/plugins/plugin_type.hpp"
 #include "digitalcurling/plugins/loader.h"
@@ -88,6 +100,8 @@ namespace digitalcurling::plugins::detail {
 
         explicit SnapshotData(std::string&& data_str) : data(std::move(data_str)) {}
     };
+    // スナップショットの管理
+    // 複数のスレッドからの作成・参照が互いに待たないよう, ハンドルのアドレスで分割したシャードごとにロックする
     class SnapshotManager {
     public:
         static SnapshotManager& GetInstance() {
@@ -96,46 +110,68 @@ namespace digitalcurling::plugins::detail {
         }
 
         DigitalCurling_SnapshotHandle Create(std::string&& data) {
+            DIGITALCURLING_TRACE_SCOPE("snapshot", "SnapshotCreate");
             auto data_ptr = std::make_shared<SnapshotData>(std::move(data));
             auto* raw_ptr = data_ptr.get();
 
-            std::unique_lock lock(mutex_);
-            valid_handles_[raw_ptr] = std::move(data_ptr);
+            auto& shard = GetShard(raw_ptr);
+            std::unique_lock lock(shard.mutex);
+            shard.valid_handles[raw_ptr] = std::move(data_ptr);
             return reinterpret_cast<DigitalCurling_SnapshotHandle>(raw_ptr);
         }
 
-        std::shared_ptr<SnapshotData> GetData(DigitalCurling_SnapshotHandle snapshot) {
+        std::shared_ptr<SnapshotData> GetData(DigitalCurling_SnapshotHandle snapshot) const {
+            DIGITALCURLING_TRACE_SCOPE("snapshot", "SnapshotGetData");
             auto* data_ptr = reinterpret_cast<SnapshotData*>(snapshot);
-            std::shared_lock lock(mutex_);
-            auto it = valid_handles_.find(data_ptr);
-            return it != valid_handles_.end() ? it->second : nullptr;
+            auto const& shard = GetShard(data_ptr);
+            std::shared_lock lock(shard.mutex);
+            auto it = shard.valid_handles.find(data_ptr);
+            return it != shard.valid_handles.end() ? it->second : nullptr;
         }
 
         bool Destroy(DigitalCurling_SnapshotHandle snapshot) {
+            DIGITALCURLING_TRACE_SCOPE("snapshot", "SnapshotDestroy");
             auto* data_ptr = reinterpret_cast<SnapshotData*>(snapshot);
+            auto& shard = GetShard(data_ptr);
             std::shared_ptr<SnapshotData> sptr;
             {
-                std::unique_lock lock(mutex_);
-                auto it = valid_handles_.find(data_ptr);
-                if (it == valid_handles_.end()) return false;
+                std::unique_lock lock(shard.mutex);
+                auto it = shard.valid_handles.find(data_ptr);
+                if (it == shard.valid_handles.end()) return false;
 
                 sptr = std::move(it->second);
-                valid_handles_.erase(it);
+                shard.valid_handles.erase(it);
             }
             return true;
         }
 
     private:
+        static constexpr size_t kShardCount = 16;
+
+        struct Shard {
+            mutable std::shared_mutex mutex;
+            std::unordered_map<SnapshotData*, std::shared_ptr<SnapshotData>> valid_handles;
+        };
+
         SnapshotManager() = default;
         ~SnapshotManager() {
-            std::unique_lock lock(mutex_);
-            for (auto& [handle, ptr] : valid_handles_) ptr.reset();
+            for (auto& shard : shards_) {
+                std::unique_lock lock(shard.mutex);
+                shard.valid_handles.clear();
+            }
         }
         SnapshotManager(const SnapshotManager&) = delete;
         SnapshotManager& operator=(const SnapshotManager&) = delete;
 
-        std::shared_mutex mutex_;
-        std::unordered_map<SnapshotData*, std::shared_ptr<SnapshotData>> valid_handles_;
+        // アドレスの下位ビットはアラインメントにより偏るため, 上位のビットと混ぜて使う
+        static size_t ShardIndex(const SnapshotData* data_ptr) {
+            auto const address = reinterpret_cast<std::uintptr_t>(data_ptr);
+            return static_cast<size_t>((address >> 4) ^ (address >> 12)) % kShardCount;
+        }
+        Shard& GetShard(const SnapshotData* data_ptr) { return shards_[ShardIndex(data_ptr)]; }
+        const Shard& GetShard(const SnapshotData* data_ptr) const { return shards_[ShardIndex(data_ptr)]; }
+
+        std::array<Shard, kShardCount> shards_;
     };
 
     class InstanceManager {
@@ -173,16 +209,383 @@ namespace digitalcurling::plugins::detail {
         std::unordered_map<uuidv7::uuidv7, std::weak_ptr<digitalcurling::plugins::detail::PluginResource>> map_;
     };
 
+    // dc_loader_acquire_instance_handle で発行したハンドルの管理
+    // ハンドルの値は上位 32 bit が世代, 下位 32 bit がスロット番号で, 世代が一致する場合のみ有効
+    // スロットは固定長のチャンク単位で確保し, 確保後は移動しない
+    // 検索はロックを取らず, スロットの状態 (世代, 有効フラグ, ピン数) の CAS でピン留めする
+    // 解放は世代を進めて新たなピン留めを止め, 実行中の呼び出しのピンが外れるのを待ってからインスタンスへの参照を手放す
+    class HandleTable {
+    public:
+        struct Slot {
+            // 上位 32 bit: 世代, bit 31: 有効フラグ, 下位 31 bit: ピン数
+            std::atomic<std::uint64_t> state{std::uint64_t(1) << 32};
+            // 以下は有効フラグが立っている間は変更されない
+            PluginType type = PluginType::player;
+            PluginResource* resource_ptr = nullptr;
+            TargetHandle* target_ptr = nullptr;
+            // 以下は mutex_ で保護される (解放中はピンが外れた後に解放するスレッドのみが触れる)
+            std::optional<uuidv7::uuidv7> id;
+            std::shared_ptr<PluginResource> resource;
+            std::shared_ptr<TargetHandle> target;
+        };
+
+        /// ハンドルが指すインスタンスへのピン留めされた参照
+        /// 破棄されるまで, ハンドルを解放してもインスタンスは破棄されない
+        class Reference {
+        public:
+            Reference() = default;
+            Reference(Reference&& other) noexcept
+                : resource(other.resource), target(other.target), slot_(std::exchange(other.slot_, nullptr)) {}
+            Reference& operator=(Reference&&) = delete;
+            Reference(const Reference&) = delete;
+            Reference& operator=(const Reference&) = delete;
+            ~Reference() {
+                if (slot_) slot_->state.fetch_sub(1, std::memory_order_release);
+            }
+
+            explicit operator bool() const noexcept { return slot_ != nullptr; }
+
+            PluginResource* resource = nullptr;
+            TargetHandle* target = nullptr;
+
+        private:
+            friend class HandleTable;
+            explicit Reference(Slot& slot) noexcept
+                : resource(slot.resource_ptr), target(slot.target_ptr), slot_(&slot) {}
+
+            Slot* slot_ = nullptr;
+        };
+
+        static HandleTable& GetInstance() {
+            static HandleTable instance;
+            return instance;
+        }
+
+        std::uint64_t Acquire(PluginType type, const uuidv7::uuidv7& id, std::shared_ptr<PluginResource> resource, std::shared_ptr<TargetHandle> target) {
+            std::unique_lock lock(mutex_);
+            std::uint32_t index;
+            if (!free_list_.empty()) {
+                index = free_list_.back();
+                free_list_.pop_back();
+            } else {
+                if (size_ >= kChunkSize * kMaxChunks)
+                    throw plugin_error{DIGITALCURLING_ERR_MEMORY_ALLOCATION, "Too many instance handles."};
+                index = size_++;
+                auto& chunk = chunks_[index / kChunkSize];
+                if (!chunk.load(std::memory_order_relaxed)) chunk.store(new Chunk(), std::memory_order_release);
+            }
+
+            auto& slot = GetSlot(index);
+            slot.type = type;
+            slot.id = id;
+            slot.resource_ptr = resource.get();
+            slot.target_ptr = target.get();
+            slot.resource = std::move(resource);
+            slot.target = std::move(target);
+            ids_.emplace(id, index);
+
+            // 空きスロットのピン数は 0 なので, 世代に有効フラグを立てて公開する
+            auto const generation = Generation(slot.state.load(std::memory_order_relaxed));
+            slot.state.store((static_cast<std::uint64_t>(generation) << 32) | kLiveBit, std::memory_order_release);
+            return (static_cast<std::uint64_t>(generation) << 32) | index;
+        }
+
+        Reference Find(std::uint64_t handle, PluginType type) const {
+            auto const index = static_cast<std::uint32_t>(handle);
+            auto const generation = static_cast<std::uint32_t>(handle >> 32);
+            if (generation == 0 || index / kChunkSize >= kMaxChunks) return {};
+
+            auto* const chunk = chunks_[index / kChunkSize].load(std::memory_order_acquire);
+            if (!chunk) return {};
+
+            auto& slot = (*chunk)[index % kChunkSize];
+            auto state = slot.state.load(std::memory_order_relaxed);
+            do {
+                if (Generation(state) != generation || !(state & kLiveBit)) return {};
+            } while (!slot.state.compare_exchange_weak(state, state + 1, std::memory_order_acquire, std::memory_order_relaxed));
+
+            Reference reference(slot);
+            if (slot.type != type) return {};
+            return reference;
+        }
+
+        bool Release(std::uint64_t handle) {
+            std::uint32_t index;
+            {
+                std::unique_lock lock(mutex_);
+                auto const* slot = FindSlot(handle);
+                if (!slot) return false;
+
+                index = static_cast<std::uint32_t>(handle);
+                auto [first, last] = ids_.equal_range(*slot->id);
+                for (auto it = first; it != last; ++it) {
+                    if (it->second == index) { ids_.erase(it); break; }
+                }
+                Invalidate(index);
+            }
+            Reclaim(index);
+            return true;
+        }
+
+        void ReleaseAll(const uuidv7::uuidv7& id) {
+            std::vector<std::uint32_t> indices;
+            {
+                std::unique_lock lock(mutex_);
+                auto [first, last] = ids_.equal_range(id);
+                for (auto it = first; it != last; ++it) {
+                    Invalidate(it->second);
+                    indices.push_back(it->second);
+                }
+                ids_.erase(first, last);
+            }
+            for (auto index : indices) Reclaim(index);
+        }
+
+    private:
+        static constexpr std::uint32_t kChunkSize = 1024;
+        static constexpr std::uint32_t kMaxChunks = 1024;
+        static constexpr std::uint64_t kLiveBit = std::uint64_t(1) << 31;
+        static constexpr std::uint64_t kPinMask = kLiveBit - 1;
+        using Chunk = std::array<Slot, kChunkSize>;
+
+        HandleTable() = default;
+        ~HandleTable() {
+            for (auto& chunk : chunks_) delete chunk.load(std::memory_order_relaxed);
+        }
+        HandleTable(const HandleTable&) = delete;
+        HandleTable& operator=(const HandleTable&) = delete;
+
+        static std::uint32_t Generation(std::uint64_t state) { return static_cast<std::uint32_t>(state >> 32); }
+
+        Slot& GetSlot(std::uint32_t index) {
+            return (*chunks_[index / kChunkSize].load(std::memory_order_relaxed))[index % kChunkSize];
+        }
+
+        // mutex_ を保持した状態で呼び出す
+        Slot const* FindSlot(std::uint64_t handle) const {
+            auto const index = static_cast<std::uint32_t>(handle);
+            auto const generation = static_cast<std::uint32_t>(handle >> 32);
+            if (generation == 0 || index >= size_) return nullptr;
+
+            auto const& slot = (*chunks_[index / kChunkSize].load(std::memory_order_relaxed))[index % kChunkSize];
+            auto const state = slot.state.load(std::memory_order_relaxed);
+            if (Generation(state) != generation || !(state & kLiveBit)) return nullptr;
+            return &slot;
+        }
+
+        // mutex_ を保持した状態で呼び出す
+        // 世代を進めて有効フラグを下ろし, 既存のハンドルによる新たなピン留めを止める (ピン数は保たれる)
+        void Invalidate(std::uint32_t index) {
+            auto& slot = GetSlot(index);
+            auto state = slot.state.load(std::memory_order_relaxed);
+            std::uint64_t next;
+            do {
+                auto generation = Generation(state) + 1;
+                if (generation == 0) generation = 1;
+                next = (static_cast<std::uint64_t>(generation) << 32) | (state & kPinMask);
+            } while (!slot.state.compare_exchange_weak(state, next, std::memory_order_relaxed));
+        }
+
+        // Invalidate したスロットのピンが外れるのを待ち, インスタンスへの参照を手放して空きスロットに戻す
+        // インスタンスの破棄はロックの外で行う
+        void Reclaim(std::uint32_t index) {
+            auto& slot = GetSlot(index);
+            while (slot.state.load(std::memory_order_acquire) & kPinMask) std::this_thread::yield();
+
+            std::shared_ptr<PluginResource> resource;
+            std::shared_ptr<TargetHandle> target;
+            {
+                std::unique_lock lock(mutex_);
+                slot.id.reset();
+                slot.resource_ptr = nullptr;
+                slot.target_ptr = nullptr;
+                resource = std::move(slot.resource);
+                target = std::move(slot.target);
+                free_list_.push_back(index);
+            }
+        }
+
+        std::mutex mutex_;
+        std::array<std::atomic<Chunk*>, kMaxChunks> chunks_{};
+        std::uint32_t size_ = 0;
+        std::vector<std::uint32_t> free_list_;
+        std::unordered_multimap<uuidv7::uuidv7, std::uint32_t> ids_;
+    };
+
+    struct AsyncJobData {
+        std::function<DigitalCurling_ErrorCode()> task;
+        // 以下は AsyncJobManager::mutex_ で保護される
+        bool completed = false;
+        DigitalCurling_ErrorCode result = DIGITALCURLING_OK;
+        std::string error_message;
+    };
+
+    // 非同期ジョブを実行するローダー所有のワーカープールと, 発行したジョブハンドルの管理
+    // ジョブのエラーはワーカースレッドの last_error_message からジョブ自身に移して保持する
+    class AsyncJobManager {
+    public:
+        static AsyncJobManager& GetInstance() {
+            static AsyncJobManager instance;
+            return instance;
+        }
+
+        DigitalCurling_AsyncJobHandle Submit(std::function<DigitalCurling_ErrorCode()> task) {
+            auto job = std::make_shared<AsyncJobData>();
+            job->task = std::move(task);
+            auto* raw_ptr = job.get();
+            {
+                std::unique_lock lock(mutex_);
+                if (workers_.empty() && !stopping_) StartWorkers(DefaultWorkerCount());
+                jobs_[raw_ptr] = job;
+                queue_.push_back(std::move(job));
+            }
+            queue_cv_.notify_one();
+            return reinterpret_cast<DigitalCurling_AsyncJobHandle>(raw_ptr);
+        }
+
+        std::shared_ptr<AsyncJobData> Get(DigitalCurling_AsyncJobHandle handle) const {
+            auto* data_ptr = reinterpret_cast<AsyncJobData*>(handle);
+            std::unique_lock lock(mutex_);
+            auto it = jobs_.find(data_ptr);
+            return it != jobs_.end() ? it->second : nullptr;
+        }
+
+        bool IsCompleted(const AsyncJobData& job) const {
+            std::unique_lock lock(mutex_);
+            return job.completed;
+        }
+
+        // 完了したジョブのインデックスを返す (タイムアウトした場合は std::nullopt)
+        std::optional<size_t> WaitAny(const std::vector<std::shared_ptr<AsyncJobData>>& jobs, int64_t timeout_ms) const {
+            std::optional<size_t> index;
+            auto any_completed = [&]() {
+                for (size_t i = 0; i < jobs.size(); ++i) {
+                    if (jobs[i]->completed) { index = i; return true; }
+                }
+                return false;
+            };
+
+            std::unique_lock lock(mutex_);
+            if (timeout_ms < 0) completion_cv_.wait(lock, any_completed);
+            else completion_cv_.wait_for(lock, std::chrono::milliseconds(timeout_ms), any_completed);
+            return index;
+        }
+
+        template <typename TFunc>
+        auto ReadResult(const AsyncJobData& job, TFunc&& func) const {
+            std::unique_lock lock(mutex_);
+            return func(job);
+        }
+
+        // 完了を待ってからハンドルを無効にする
+        bool Destroy(DigitalCurling_AsyncJobHandle handle) {
+            auto* data_ptr = reinterpret_cast<AsyncJobData*>(handle);
+            std::shared_ptr<AsyncJobData> job;
+            {
+                std::unique_lock lock(mutex_);
+                auto it = jobs_.find(data_ptr);
+                if (it == jobs_.end()) return false;
+
+                job = std::move(it->second);
+                jobs_.erase(it);
+                completion_cv_.wait(lock, [&]() { return job->completed; });
+            }
+            return true;
+        }
+
+        void SetWorkerCount(size_t count) {
+            std::unique_lock resize_lock(resize_mutex_);
+            std::vector<std::thread> workers;
+            {
+                std::unique_lock lock(mutex_);
+                stopping_ = true;
+                workers.swap(workers_);
+            }
+            // 待機中のジョブを処理し終えたワーカーから終了する
+            queue_cv_.notify_all();
+            for (auto& worker : workers) worker.join();
+
+            std::unique_lock lock(mutex_);
+            stopping_ = false;
+            StartWorkers(count == 0 ? DefaultWorkerCount() : count);
+            if (!queue_.empty()) queue_cv_.notify_all();
+        }
+
+        size_t GetWorkerCount() const {
+            std::unique_lock lock(mutex_);
+            return workers_.empty() ? DefaultWorkerCount() : workers_.size();
+        }
+
+    private:
+        AsyncJobManager() = default;
+        ~AsyncJobManager() {
+            std::vector<std::thread> workers;
+            {
+                std::unique_lock lock(mutex_);
+                shutdown_ = true;
+                workers.swap(workers_);
+            }
+            queue_cv_.notify_all();
+            for (auto& worker : workers) worker.join();
+        }
+        AsyncJobManager(const AsyncJobManager&) = delete;
+        AsyncJobManager& operator=(const AsyncJobManager&) = delete;
+
+        static size_t DefaultWorkerCount() {
+            return std::max<size_t>(1, std::thread::hardware_concurrency());
+        }
+
+        // mutex_ を取得した状態で呼び出す
+        void StartWorkers(size_t count) {
+            workers_.reserve(count);
+            for (size_t i = 0; i < count; ++i) workers_.emplace_back([this]() { WorkerLoop(); });
+        }
+
+        void WorkerLoop() {
+            for (;;) {
+                std::shared_ptr<AsyncJobData> job;
+                {
+                    std::unique_lock lock(mutex_);
+                    queue_cv_.wait(lock, [&]() { return shutdown_ || stopping_ || !queue_.empty(); });
+                    if (shutdown_ || queue_.empty()) return;
+                    job = std::move(queue_.front());
+                    queue_.pop_front();
+                }
+
+                last_error_message.clear();
+                auto result = catch_exceptions("AsyncJob", std::move(job->task));
+                {
+                    std::unique_lock lock(mutex_);
+                    job->task = nullptr;
+                    job->result = result;
+                    if (result != DIGITALCURLING_OK) job->error_message = last_error_message;
+                    job->completed = true;
+                }
+                completion_cv_.notify_all();
+            }
+        }
+
+        mutable std::mutex mutex_;
+        std::mutex resize_mutex_;
+        std::condition_variable queue_cv_;
+        mutable std::condition_variable completion_cv_;
+        std::vector<std::thread> workers_;
+        std::deque<std::shared_ptr<AsyncJobData>> queue_;
+        std::unordered_map<AsyncJobData*, std::shared_ptr<AsyncJobData>> jobs_;
+        bool stopping_ = false;
+        bool shutdown_ = false;
+    };
+
     class LoaderInternalAccessor {
     public:
         static std::shared_ptr<PlayerPluginResource> GetPlayerResource(
-            const PluginManager& manager, const std::string& name) {
-            return manager.GetPlayerPluginResource(name);
+            PluginManager& manager, const std::string& name) {
+            return manager.AcquirePlayerPluginResource(name);
         }
 
         static std::shared_ptr<SimulatorPluginResource> GetSimulatorResource(
-            const PluginManager& manager, const std::string& name) {
-            return manager.GetSimulatorPluginResource(name);
+            PluginManager& manager, const std::string& name) {
+            return manager.AcquireSimulatorPluginResource(name);
         }
     };
 }
@@ -193,6 +596,29 @@ using PluginType = digitalcurling::plugins::PluginType;
 using PluginId = digitalcurling::plugins::PluginId;
 using InstanceManager = digitalcurling::plugins::detail::InstanceManager;
 using SnapshotManager = digitalcurling::plugins::detail::SnapshotManager;
+using HandleTable = digitalcurling::plugins::detail::HandleTable;
+using AsyncJobManager = digitalcurling::plugins::detail::AsyncJobManager;
+
+// --- Internal Helpers ---
+namespace {
+
+// Factory / Storage のインスタンスを持つリソースを探す
+std::shared_ptr<digitalcurling::plugins::detail::PluginResource> FindCreatorResource(const uuidv7::uuidv7& id, bool& out_is_factory) {
+    std::shared_ptr<digitalcurling::plugins::detail::PluginResource> resource;
+    if (auto player_res = InstanceManager::GetInstance().Get<PluginType::player>(id)) {
+        resource = player_res;
+    } else if (auto sim_res = InstanceManager::GetInstance().Get<PluginType::simulator>(id)) {
+        resource = sim_res;
+    }
+    if (!resource) return nullptr;
+
+    auto const& instances = resource->GetInstanceList();
+    out_is_factory = instances.Get<digitalcurling::plugins::FactoryHandle>(id) != nullptr;
+    if (!out_is_factory && !instances.Get<digitalcurling::plugins::StorageHandle>(id)) return nullptr;
+    return resource;
+}
+
+} // namespace
 
 // --- Error Handling ---
 DigitalCurling_ErrorCode dc_loader_get_last_error_message(char* out_buffer, size_t buffer_size, size_t* out_required_size) {
@@ -228,6 +654,21 @@ DigitalCurling_ErrorCode dc_loader_snapshot_get_data(DigitalCurling_SnapshotHand
         return DIGITALCURLING_OK;
     });
 }
+DigitalCurling_ErrorCode dc_loader_snapshot_borrow(DigitalCurling_SnapshotHandle snapshot, const char** out_data, size_t* out_size) {
+    DIGITALCURLING_LOADER_CHECK_POINTER(snapshot);
+    DIGITALCURLING_LOADER_CHECK_POINTER(out_data);
+
+    return digitalcurling::plugins::detail::catch_exceptions(__func__, [&]() {
+        auto data_ptr = SnapshotManager::GetInstance().GetData(snapshot);
+        if (!data_ptr)
+            DIGITALCURLING_LOADER_RETURN_ERROR(DIGITALCURLING_ERR_INSTANCE_NOT_FOUND, "Snapshot handle is not valid.");
+
+        // データの所有権は dc_loader_destroy_snapshot までマネージャーが保持する
+        *out_data = data_ptr->data.c_str();
+        if (out_size) *out_size = data_ptr->data.length();
+        return DIGITALCURLING_OK;
+    });
+}
 DigitalCurling_ErrorCode dc_loader_destroy_snapshot(DigitalCurling_SnapshotHandle snapshot) {
     DIGITALCURLING_LOADER_CHECK_POINTER(snapshot);
 
@@ -255,6 +696,17 @@ DigitalCurling_ErrorCode dc_loader_load_plugin(const char* plugin_path, DigitalC
         return DIGITALCURLING_OK;
     });
 }
+DigitalCurling_ErrorCode dc_loader_load_plugin_directory(const char* plugin_dir, const char* manifest_path, size_t* out_plugin_count) {
+    DIGITALCURLING_LOADER_CHECK_POINTER(plugin_dir);
+
+    return digitalcurling::plugins::detail::catch_exceptions(__func__, [&]() {
+        std::optional<std::filesystem::path> manifest;
+        if (manifest_path) manifest = std::filesystem::path(manifest_path);
+        auto ids = PluginManager::GetInstance().LoadPluginDirectory(plugin_dir, manifest);
+        if (out_plugin_count) *out_plugin_count = ids.size();
+        return DIGITALCURLING_OK;
+    });
+}
 DigitalCurling_ErrorCode dc_loader_get_loaded_plugins_snapshot(DigitalCurling_PluginType plugin_type, const char separator, DigitalCurling_SnapshotHandle* out_snapshot, size_t* out_snapshot_size) {
     DIGITALCURLING_LOADER_CHECK_POINTER(out_snapshot);
 
@@ -281,6 +733,40 @@ DigitalCurling_ErrorCode dc_loader_is_plugin_loaded(DigitalCurling_PluginType pl
     });
 }
 
+DigitalCurling_ErrorCode dc_loader_get_stats(DigitalCurling_SnapshotHandle* out_snapshot, size_t* out_snapshot_size) {
+    DIGITALCURLING_LOADER_CHECK_POINTER(out_snapshot);
+
+    return digitalcurling::plugins::detail::catch_exceptions(__func__, [&]() {
+        nlohmann::json simulators = nlohmann::json::object();
+        for (auto const& entry : PluginManager::GetInstance().GetSimulatorStats()) {
+            nlohmann::json stats = entry.stats;
+            stats["instances"] = entry.instance_count;
+            simulators[entry.name] = std::move(stats);
+        }
+
+        auto snapshot_data = nlohmann::json{{"simulators", std::move(simulators)}}.dump();
+        if (out_snapshot_size) *out_snapshot_size = snapshot_data.size() + 1;
+        *out_snapshot = SnapshotManager::GetInstance().Create(std::move(snapshot_data));
+        return DIGITALCURLING_OK;
+    });
+}
+
+DigitalCurling_ErrorCode dc_loader_trace_start(size_t events_per_thread) {
+    return digitalcurling::plugins::detail::catch_exceptions(__func__, [&]() {
+        PluginManager::GetInstance().StartTrace(events_per_thread > 0 ? events_per_thread : digitalcurling::trace::kDefaultEventsPerThread);
+        return DIGITALCURLING_OK;
+    });
+}
+
+DigitalCurling_ErrorCode dc_loader_trace_stop(const char* output_path) {
+    DIGITALCURLING_LOADER_CHECK_POINTER(output_path);
+
+    return digitalcurling::plugins::detail::catch_exceptions(__func__, [&]() {
+        digitalcurling::trace::WriteTraceFile(std::filesystem::path(output_path), PluginManager::GetInstance().StopTrace());
+        return DIGITALCURLING_OK;
+    });
+}
+
 // --- Creator Common Functions ---
 DigitalCurling_ErrorCode dc_loader_creator_get_state_snapshot(const DigitalCurling_Uuid* creator_id, DigitalCurling_SnapshotHandle* out_snapshot, size_t* out_snapshot_size) {
     DIGITALCURLING_LOADER_CHECK_POINTER(creator_id);
@@ -308,6 +794,82 @@ DigitalCurling_ErrorCode dc_loader_creator_get_state_snapshot(const DigitalCurli
     });
 }
 
+DigitalCurling_ErrorCode dc_loader_creator_get_binary_state(const DigitalCurling_Uuid* creator_id, uint8_t* out_buffer, size_t buffer_size, size_t* out_required_size, unsigned int* out_format_version) {
+    DIGITALCURLING_LOADER_CHECK_POINTER(creator_id);
+    DIGITALCURLING_LOADER_CHECK_POINTER(out_required_size);
+    DIGITALCURLING_LOADER_CHECK_POINTER(out_format_version);
+    if (buffer_size > 0) DIGITALCURLING_LOADER_CHECK_POINTER(out_buffer);
+
+    return digitalcurling::plugins::detail::catch_exceptions(__func__, [&]() {
+        auto uuid = uuidv7::uuidv7::from_bytes(creator_id->bytes);
+        bool is_factory = false;
+        auto resource = FindCreatorResource(uuid, is_factory);
+        if (!resource)
+            DIGITALCURLING_LOADER_RETURN_ERROR(DIGITALCURLING_ERR_INSTANCE_NOT_FOUND, "Creator instance not found.");
+
+        if (is_factory ? !resource->SupportsFactoryBinaryState() : !resource->SupportsStorageBinaryState())
+            DIGITALCURLING_LOADER_RETURN_ERROR(DIGITALCURLING_ERR_NOT_SUPPORTED, "Plugin does not support binary state.");
+
+        auto result = is_factory
+            ? resource->factory_get_binary_state.ExecuteRaw(uuid, out_buffer, buffer_size, out_required_size, out_format_version)
+            : resource->storage_get_binary_state.ExecuteRaw(uuid, out_buffer, buffer_size, out_required_size, out_format_version);
+        DIGITALCURLING_LOADER_CHECK_PLUGIN_RESULT(result);
+        if (buffer_size > 0 && buffer_size < *out_required_size)
+            DIGITALCURLING_LOADER_RETURN_ERROR(DIGITALCURLING_ERR_BUFFER_NULLPTR, "out_buffer is too small.");
+        return DIGITALCURLING_OK;
+    });
+}
+DigitalCurling_ErrorCode dc_loader_creator_set_binary_state(const DigitalCurling_Uuid* creator_id, const uint8_t* data, size_t size, unsigned int format_version) {
+    DIGITALCURLING_LOADER_CHECK_POINTER(creator_id);
+    if (size > 0) DIGITALCURLING_LOADER_CHECK_POINTER(data);
+
+    return digitalcurling::plugins::detail::catch_exceptions(__func__, [&]() {
+        auto uuid = uuidv7::uuidv7::from_bytes(creator_id->bytes);
+        bool is_factory = false;
+        auto resource = FindCreatorResource(uuid, is_factory);
+        if (!resource)
+            DIGITALCURLING_LOADER_RETURN_ERROR(DIGITALCURLING_ERR_INSTANCE_NOT_FOUND, "Creator instance not found.");
+
+        if (is_factory ? !resource->SupportsFactoryBinaryState() : !resource->SupportsStorageBinaryState())
+            DIGITALCURLING_LOADER_RETURN_ERROR(DIGITALCURLING_ERR_NOT_SUPPORTED, "Plugin does not support binary state.");
+
+        auto result = is_factory
+            ? resource->factory_set_binary_state.ExecuteRaw(uuid, data, size, format_version)
+            : resource->storage_set_binary_state.ExecuteRaw(uuid, data, size, format_version);
+        DIGITALCURLING_LOADER_CHECK_PLUGIN_RESULT(result);
+        return DIGITALCURLING_OK;
+    });
+}
+
+// --- Instance Handle ---
+DigitalCurling_ErrorCode dc_loader_acquire_instance_handle(const DigitalCurling_Uuid* instance_id, DigitalCurling_InstanceHandle* out_handle) {
+    DIGITALCURLING_LOADER_CHECK_POINTER(instance_id);
+    DIGITALCURLING_LOADER_CHECK_POINTER(out_handle);
+
+    return digitalcurling::plugins::detail::catch_exceptions(__func__, [&]() {
+        auto uuid = uuidv7::uuidv7::from_bytes(instance_id->bytes);
+        if (auto resource = InstanceManager::GetInstance().Get<PluginType::player>(uuid)) {
+            if (auto target = resource->GetInstanceList().Get<digitalcurling::plugins::PlayerHandle>(uuid)) {
+                out_handle->value = HandleTable::GetInstance().Acquire(PluginType::player, uuid, std::move(resource), std::move(target));
+                return DIGITALCURLING_OK;
+            }
+        } else if (auto resource = InstanceManager::GetInstance().Get<PluginType::simulator>(uuid)) {
+            if (auto target = resource->GetInstanceList().Get<digitalcurling::plugins::SimulatorHandle>(uuid)) {
+                out_handle->value = HandleTable::GetInstance().Acquire(PluginType::simulator, uuid, std::move(resource), std::move(target));
+                return DIGITALCURLING_OK;
+            }
+        }
+        DIGITALCURLING_LOADER_RETURN_ERROR(DIGITALCURLING_ERR_INSTANCE_NOT_FOUND, "Player or simulator instance not found.");
+    });
+}
+DigitalCurling_ErrorCode dc_loader_release_instance_handle(DigitalCurling_InstanceHandle handle) {
+    return digitalcurling::plugins::detail::catch_exceptions(__func__, [&]() {
+        if (!HandleTable::GetInstance().Release(handle.value))
+            DIGITALCURLING_LOADER_RETURN_ERROR(DIGITALCURLING_ERR_INSTANCE_NOT_FOUND, "Instance handle is not valid.");
+        return DIGITALCURLING_OK;
+    });
+}
+
 // --- Player/Simulator Function Template ---
 template <typename T>
 DigitalCurling_ErrorCode create_plugin_object_impl(
@@ -419,6 +981,7 @@ DigitalCurling_ErrorCode dc_loader_remove_player_instance(const DigitalCurling_U
             DIGITALCURLING_LOADER_RETURN_ERROR(DIGITALCURLING_ERR_INSTANCE_NOT_FOUND, "Player instance not found.");
 
         InstanceManager::GetInstance().Unregister(uuid);
+        HandleTable::GetInstance().ReleaseAll(uuid);
         return DIGITALCURLING_OK;
     });
 }
@@ -468,6 +1031,21 @@ DigitalCurling_ErrorCode dc_loader_player_play(const DigitalCurling_Uuid* player
     });
 }
 
+DigitalCurling_ErrorCode dc_loader_player_handle_play(DigitalCurling_InstanceHandle player, const DigitalCurling_Shot* shot_info, DigitalCurling_Shot* out_shot) {
+    DIGITALCURLING_LOADER_CHECK_POINTER(shot_info);
+    DIGITALCURLING_LOADER_CHECK_POINTER(out_shot);
+
+    auto const slot = HandleTable::GetInstance().Find(player.value, PluginType::player);
+    if (!slot)
+        DIGITALCURLING_LOADER_RETURN_ERROR(DIGITALCURLING_ERR_INSTANCE_NOT_FOUND, "Player handle is not valid.");
+
+    auto const& resource = static_cast<const digitalcurling::plugins::detail::PlayerPluginResource&>(*slot.resource);
+    auto result = resource.play.ExecuteRaw(static_cast<digitalcurling::plugins::PlayerHandle*>(slot.target), shot_info);
+    DIGITALCURLING_LOADER_CHECK_PLUGIN_RESULT(result);
+    *out_shot = result.GetValue();
+    return DIGITALCURLING_OK;
+}
+
 // --- Simulator Instance Management ---
 DigitalCurling_ErrorCode dc_loader_create_simulator_factory(const char* plugin_name, const char* json_config, DigitalCurling_Uuid* out_factory_id) {
     DIGITALCURLING_LOADER_CHECK_POINTER(plugin_name);
@@ -509,10 +1087,11 @@ DigitalCurling_ErrorCode dc_loader_remove_simulator_instance(const DigitalCurlin
     return digitalcurling::plugins::detail::catch_exceptions(__func__, [&]() {
         auto uuid = uuidv7::uuidv7::from_bytes(instance_id->bytes);
         auto resource = InstanceManager::GetInstance().Get<PluginType::simulator>(uuid);
-        if (!resource || !resource->GetInstanceList().Remove(uuid))
+        if (!resource || !resource->RemoveInstance(uuid))
             DIGITALCURLING_LOADER_RETURN_ERROR(DIGITALCURLING_ERR_INSTANCE_NOT_FOUND, "Simulator instance not found.");
 
         InstanceManager::GetInstance().Unregister(uuid);
+        HandleTable::GetInstance().ReleaseAll(uuid);
         return DIGITALCURLING_OK;
     });
 }
@@ -571,6 +1150,52 @@ DigitalCurling_ErrorCode dc_loader_simulator_simulate(const DigitalCurling_Uuid*
         return DIGITALCURLING_OK;
     });
 }
+DigitalCurling_ErrorCode dc_loader_simulator_simulate_batch(const DigitalCurling_Uuid* simulator_id, const DigitalCurling_StoneCoordinate* stones, const DigitalCurling_Shot* shots,
+                                                 const size_t count, const int shot_stone_index, const DigitalCurling_SimulateModeFlag mode_flag, const float sheet_width,
+                                                 DigitalCurling_StoneCoordinate* out_stones) {
+    DIGITALCURLING_LOADER_CHECK_POINTER(simulator_id);
+    if (count == 0) return DIGITALCURLING_OK;
+    DIGITALCURLING_LOADER_CHECK_POINTER(stones);
+    DIGITALCURLING_LOADER_CHECK_POINTER(out_stones);
+    if (shots && (shot_stone_index < 0 || shot_stone_index >= digitalcurling::StoneCoordinate::kStoneMax))
+        DIGITALCURLING_LOADER_RETURN_ERROR(DIGITALCURLING_ERR_INVALID_ARGUMENT, "shot_stone_index is out of range.");
+
+    return digitalcurling::plugins::detail::catch_exceptions(__func__, [&]() {
+        auto uuid = uuidv7::uuidv7::from_bytes(simulator_id->bytes);
+        auto resource = InstanceManager::GetInstance().Get<PluginType::simulator>(uuid);
+        if (!resource)
+            DIGITALCURLING_LOADER_RETURN_ERROR(DIGITALCURLING_ERR_INSTANCE_NOT_FOUND, "Simulator instance not found.");
+
+        if (resource->SupportsSimulateBatch()) {
+            auto result = resource->simulate_batch.ExecuteRaw(uuid, stones, shots, count, shot_stone_index, mode_flag, sheet_width, out_stones);
+            DIGITALCURLING_LOADER_CHECK_PLUGIN_RESULT(result);
+            return DIGITALCURLING_OK;
+        }
+
+        // API バージョン 1 のプラグインでは, 1要素ずつ set_stones, simulate, get_stones を呼び出す
+        for (size_t i = 0; i < count; ++i) {
+            DigitalCurling_StoneCoordinate initial = stones[i];
+            if (shots) {
+                auto const shot = digitalcurling::moves::Shot(shots[i].translational_velocity, shots[i].angular_velocity, shots[i].release_angle);
+                auto const velocity = shot.ToVector2();
+                auto& shot_stone = initial.stones[shot_stone_index];
+                shot_stone.position = DigitalCurling_Vector2{ 0.f, 0.f };
+                shot_stone.angle = 0.f;
+                shot_stone.translational_velocity = DigitalCurling_Vector2{ velocity.x, velocity.y };
+                shot_stone.angular_velocity = shot.angular_velocity;
+            }
+
+            auto set_result = resource->set_stones.ExecuteRaw(uuid, &initial);
+            DIGITALCURLING_LOADER_CHECK_PLUGIN_RESULT(set_result);
+            auto simulate_result = resource->simulate.ExecuteRaw(uuid, mode_flag, sheet_width);
+            DIGITALCURLING_LOADER_CHECK_PLUGIN_RESULT(simulate_result);
+            auto get_result = resource->get_stones.ExecuteRaw(uuid);
+            DIGITALCURLING_LOADER_CHECK_PLUGIN_RESULT(get_result);
+            out_stones[i] = get_result.GetValue();
+        }
+        return DIGITALCURLING_OK;
+    });
+}
 DigitalCurling_ErrorCode dc_loader_simulator_get_stones(const DigitalCurling_Uuid* simulator_id, DigitalCurling_StoneCoordinate* out_stones) {
     DIGITALCURLING_LOADER_CHECK_POINTER(simulator_id);
     DIGITALCURLING_LOADER_CHECK_POINTER(out_stones);
@@ -606,6 +1231,37 @@ DigitalCurling_ErrorCode dc_loader_simulator_get_collisions_snapshot(const Digit
         return DIGITALCURLING_OK;
     });
 }
+DigitalCurling_ErrorCode dc_loader_simulator_get_collisions(const DigitalCurling_Uuid* simulator_id, DigitalCurling_Collision* out_collisions, size_t capacity, size_t* out_count) {
+    DIGITALCURLING_LOADER_CHECK_POINTER(simulator_id);
+    DIGITALCURLING_LOADER_CHECK_POINTER(out_count);
+    if (capacity > 0) DIGITALCURLING_LOADER_CHECK_POINTER(out_collisions);
+
+    return digitalcurling::plugins::detail::catch_exceptions(__func__, [&]() {
+        auto uuid = uuidv7::uuidv7::from_bytes(simulator_id->bytes);
+        auto resource = InstanceManager::GetInstance().Get<PluginType::simulator>(uuid);
+        if (!resource)
+            DIGITALCURLING_LOADER_RETURN_ERROR(DIGITALCURLING_ERR_INSTANCE_NOT_FOUND, "Simulator instance not found.");
+
+        if (resource->SupportsCollisionRecords()) {
+            auto result = resource->get_collision_records.ExecuteRaw(uuid, out_collisions, capacity, out_count);
+            DIGITALCURLING_LOADER_CHECK_PLUGIN_RESULT(result);
+            return DIGITALCURLING_OK;
+        }
+
+        // API バージョン 2 以前のプラグインでは, JSON 文字列から変換する
+        auto result = resource->get_collisions.ExecuteRaw(uuid);
+        DIGITALCURLING_LOADER_CHECK_PLUGIN_RESULT(result);
+
+        using CollisionConverter = digitalcurling::plugins::detail::CTypeConverter<digitalcurling::simulators::ISimulator::Collision, DigitalCurling_Collision>;
+        auto const collisions = nlohmann::json::parse(result.GetValue()).get<std::vector<digitalcurling::simulators::ISimulator::Collision>>();
+        size_t const n = std::min(capacity, collisions.size());
+        for (size_t i = 0; i < n; ++i) {
+            out_collisions[i] = CollisionConverter::ToCType(collisions[i]);
+        }
+        *out_count = collisions.size();
+        return DIGITALCURLING_OK;
+    });
+}
 DigitalCurling_ErrorCode dc_loader_simulator_are_all_stones_stopped(const DigitalCurling_Uuid* simulator_id, bool* out_are_stopped) {
     DIGITALCURLING_LOADER_CHECK_POINTER(simulator_id);
     DIGITALCURLING_LOADER_CHECK_POINTER(out_are_stopped);
@@ -655,4 +1311,198 @@ DigitalCurling_ErrorCode dc_loader_simulator_calculate_shot(const DigitalCurling
         *out_shot = result.GetValue();
         return DIGITALCURLING_OK;
     });
-}
\ No newline at end of file
+}
+
+// --- Simulator Functions (Instance Handle) ---
+// ハンドル版は例外を投げる処理を含まないため, catch_exceptions を経由せずに呼び出す
+namespace {
+
+digitalcurling::plugins::detail::HandleTable::Reference FindSimulatorSlot(DigitalCurling_InstanceHandle simulator) {
+    return HandleTable::GetInstance().Find(simulator.value, PluginType::simulator);
+}
+const digitalcurling::plugins::detail::SimulatorPluginResource& GetSimulatorResource(const digitalcurling::plugins::detail::HandleTable::Reference& slot) {
+    return static_cast<const digitalcurling::plugins::detail::SimulatorPluginResource&>(*slot.resource);
+}
+digitalcurling::plugins::SimulatorHandle* GetSimulatorHandle(const digitalcurling::plugins::detail::HandleTable::Reference& slot) {
+    return static_cast<digitalcurling::plugins::SimulatorHandle*>(slot.target);
+}
+
+} // namespace
+
+DigitalCurling_ErrorCode dc_loader_simulator_handle_set_stones(DigitalCurling_InstanceHandle simulator, const DigitalCurling_StoneCoordinate* stones) {
+    DIGITALCURLING_LOADER_CHECK_POINTER(stones);
+
+    auto const slot = FindSimulatorSlot(simulator);
+    if (!slot)
+        DIGITALCURLING_LOADER_RETURN_ERROR(DIGITALCURLING_ERR_INSTANCE_NOT_FOUND, "Simulator handle is not valid.");
+
+    auto result = GetSimulatorResource(slot).set_stones.ExecuteRaw(GetSimulatorHandle(slot), stones);
+    DIGITALCURLING_LOADER_CHECK_PLUGIN_RESULT(result);
+    return DIGITALCURLING_OK;
+}
+DigitalCurling_ErrorCode dc_loader_simulator_handle_step(DigitalCurling_InstanceHandle simulator, const int frames, const float sheet_width) {
+    auto const slot = FindSimulatorSlot(simulator);
+    if (!slot)
+        DIGITALCURLING_LOADER_RETURN_ERROR(DIGITALCURLING_ERR_INSTANCE_NOT_FOUND, "Simulator handle is not valid.");
+
+    auto result = GetSimulatorResource(slot).step.ExecuteRaw(GetSimulatorHandle(slot), frames, sheet_width);
+    DIGITALCURLING_LOADER_CHECK_PLUGIN_RESULT(result);
+    return DIGITALCURLING_OK;
+}
+DigitalCurling_ErrorCode dc_loader_simulator_handle_simulate(DigitalCurling_InstanceHandle simulator, const DigitalCurling_SimulateModeFlag mode_flag, const float sheet_width) {
+    auto const slot = FindSimulatorSlot(simulator);
+    if (!slot)
+        DIGITALCURLING_LOADER_RETURN_ERROR(DIGITALCURLING_ERR_INSTANCE_NOT_FOUND, "Simulator handle is not valid.");
+
+    auto result = GetSimulatorResource(slot).simulate.ExecuteRaw(GetSimulatorHandle(slot), mode_flag, sheet_width);
+    DIGITALCURLING_LOADER_CHECK_PLUGIN_RESULT(result);
+    return DIGITALCURLING_OK;
+}
+DigitalCurling_ErrorCode dc_loader_simulator_handle_get_stones(DigitalCurling_InstanceHandle simulator, DigitalCurling_StoneCoordinate* out_stones) {
+    DIGITALCURLING_LOADER_CHECK_POINTER(out_stones);
+
+    auto const slot = FindSimulatorSlot(simulator);
+    if (!slot)
+        DIGITALCURLING_LOADER_RETURN_ERROR(DIGITALCURLING_ERR_INSTANCE_NOT_FOUND, "Simulator handle is not valid.");
+
+    auto result = GetSimulatorResource(slot).get_stones.ExecuteRaw(GetSimulatorHandle(slot));
+    DIGITALCURLING_LOADER_CHECK_PLUGIN_RESULT(result);
+    *out_stones = result.GetValue();
+    return DIGITALCURLING_OK;
+}
+
+// --- Asynchronous Simulation ---
+// ジョブは同期版の関数をワーカースレッドで呼び出し, その結果とエラーメッセージをジョブに保持する
+DigitalCurling_ErrorCode dc_loader_set_worker_count(size_t worker_count) {
+    return digitalcurling::plugins::detail::catch_exceptions(__func__, [&]() {
+        AsyncJobManager::GetInstance().SetWorkerCount(worker_count);
+        return DIGITALCURLING_OK;
+    });
+}
+DigitalCurling_ErrorCode dc_loader_get_worker_count(size_t* out_worker_count) {
+    DIGITALCURLING_LOADER_CHECK_POINTER(out_worker_count);
+
+    *out_worker_count = AsyncJobManager::GetInstance().GetWorkerCount();
+    return DIGITALCURLING_OK;
+}
+DigitalCurling_ErrorCode dc_loader_simulator_simulate_async(const DigitalCurling_Uuid* simulator_id, const DigitalCurling_SimulateModeFlag mode_flag, const float sheet_width,
+                                                 DigitalCurling_AsyncJobHandle* out_job) {
+    DIGITALCURLING_LOADER_CHECK_POINTER(simulator_id);
+    DIGITALCURLING_LOADER_CHECK_POINTER(out_job);
+
+    return digitalcurling::plugins::detail::catch_exceptions(__func__, [&]() {
+        *out_job = AsyncJobManager::GetInstance().Submit([id = *simulator_id, mode_flag, sheet_width]() {
+            return dc_loader_simulator_simulate(&id, mode_flag, sheet_width);
+        });
+        return DIGITALCURLING_OK;
+    });
+}
+DigitalCurling_ErrorCode dc_loader_simulator_simulate_batch_async(const DigitalCurling_Uuid* simulator_id, const DigitalCurling_StoneCoordinate* stones, const DigitalCurling_Shot* shots,
+                                                 const size_t count, const int shot_stone_index, const DigitalCurling_SimulateModeFlag mode_flag, const float sheet_width,
+                                                 DigitalCurling_StoneCoordinate* out_stones, DigitalCurling_AsyncJobHandle* out_job) {
+    DIGITALCURLING_LOADER_CHECK_POINTER(simulator_id);
+    DIGITALCURLING_LOADER_CHECK_POINTER(out_job);
+    if (count > 0) {
+        DIGITALCURLING_LOADER_CHECK_POINTER(stones);
+        DIGITALCURLING_LOADER_CHECK_POINTER(out_stones);
+    }
+    if (count > 0 && shots && (shot_stone_index < 0 || shot_stone_index >= digitalcurling::StoneCoordinate::kStoneMax))
+        DIGITALCURLING_LOADER_RETURN_ERROR(DIGITALCURLING_ERR_INVALID_ARGUMENT, "shot_stone_index is out of range.");
+
+    return digitalcurling::plugins::detail::catch_exceptions(__func__, [&]() {
+        std::vector<DigitalCurling_StoneCoordinate> stones_copy(stones, stones + count);
+        std::vector<DigitalCurling_Shot> shots_copy;
+        if (shots) shots_copy.assign(shots, shots + count);
+
+        *out_job = AsyncJobManager::GetInstance().Submit(
+            [id = *simulator_id, stones_copy = std::move(stones_copy), shots_copy = std::move(shots_copy), has_shots = shots != nullptr,
+             count, shot_stone_index, mode_flag, sheet_width, out_stones]() {
+                return dc_loader_simulator_simulate_batch(&id, stones_copy.data(), has_shots ? shots_copy.data() : nullptr,
+                                                          count, shot_stone_index, mode_flag, sheet_width, out_stones);
+            });
+        return DIGITALCURLING_OK;
+    });
+}
+DigitalCurling_ErrorCode dc_loader_async_poll(DigitalCurling_AsyncJobHandle job, bool* out_completed) {
+    DIGITALCURLING_LOADER_CHECK_POINTER(job);
+    DIGITALCURLING_LOADER_CHECK_POINTER(out_completed);
+
+    return digitalcurling::plugins::detail::catch_exceptions(__func__, [&]() {
+        auto data_ptr = AsyncJobManager::GetInstance().Get(job);
+        if (!data_ptr)
+            DIGITALCURLING_LOADER_RETURN_ERROR(DIGITALCURLING_ERR_INSTANCE_NOT_FOUND, "Job handle is not valid.");
+
+        *out_completed = AsyncJobManager::GetInstance().IsCompleted(*data_ptr);
+        return DIGITALCURLING_OK;
+    });
+}
+DigitalCurling_ErrorCode dc_loader_async_wait(DigitalCurling_AsyncJobHandle job, int64_t timeout_ms, bool* out_completed) {
+    DIGITALCURLING_LOADER_CHECK_POINTER(job);
+    DIGITALCURLING_LOADER_CHECK_POINTER(out_completed);
+
+    return digitalcurling::plugins::detail::catch_exceptions(__func__, [&]() {
+        auto data_ptr = AsyncJobManager::GetInstance().Get(job);
+        if (!data_ptr)
+            DIGITALCURLING_LOADER_RETURN_ERROR(DIGITALCURLING_ERR_INSTANCE_NOT_FOUND, "Job handle is not valid.");
+
+        *out_completed = AsyncJobManager::GetInstance().WaitAny({ std::move(data_ptr) }, timeout_ms).has_value();
+        return DIGITALCURLING_OK;
+    });
+}
+DigitalCurling_ErrorCode dc_loader_async_wait_any(const DigitalCurling_AsyncJobHandle* jobs, size_t count, int64_t timeout_ms, size_t* out_index) {
+    DIGITALCURLING_LOADER_CHECK_POINTER(jobs);
+    DIGITALCURLING_LOADER_CHECK_POINTER(out_index);
+    if (count == 0)
+        DIGITALCURLING_LOADER_RETURN_ERROR(DIGITALCURLING_ERR_INVALID_ARGUMENT, "count is 0.");
+
+    return digitalcurling::plugins::detail::catch_exceptions(__func__, [&]() {
+        std::vector<std::shared_ptr<digitalcurling::plugins::detail::AsyncJobData>> data_ptrs;
+        data_ptrs.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            auto data_ptr = AsyncJobManager::GetInstance().Get(jobs[i]);
+            if (!data_ptr)
+                DIGITALCURLING_LOADER_RETURN_ERROR(DIGITALCURLING_ERR_INSTANCE_NOT_FOUND, "Job handle is not valid (index " + std::to_string(i) + ").");
+            data_ptrs.push_back(std::move(data_ptr));
+        }
+
+        *out_index = AsyncJobManager::GetInstance().WaitAny(data_ptrs, timeout_ms).value_or(count);
+        return DIGITALCURLING_OK;
+    });
+}
+DigitalCurling_ErrorCode dc_loader_async_get_result(DigitalCurling_AsyncJobHandle job, DigitalCurling_ErrorCode* out_result, char* out_message, size_t buffer_size, size_t* out_required_size) {
+    DIGITALCURLING_LOADER_CHECK_POINTER(job);
+    DIGITALCURLING_LOADER_CHECK_POINTER(out_result);
+    if (buffer_size > 0) DIGITALCURLING_LOADER_CHECK_POINTER(out_message);
+
+    return digitalcurling::plugins::detail::catch_exceptions(__func__, [&]() {
+        auto data_ptr = AsyncJobManager::GetInstance().Get(job);
+        if (!data_ptr)
+            DIGITALCURLING_LOADER_RETURN_ERROR(DIGITALCURLING_ERR_INSTANCE_NOT_FOUND, "Job handle is not valid.");
+
+        return AsyncJobManager::GetInstance().ReadResult(*data_ptr, [&](const digitalcurling::plugins::detail::AsyncJobData& data) {
+            if (!data.completed)
+                DIGITALCURLING_LOADER_RETURN_ERROR(DIGITALCURLING_ERR_INVALID_ARGUMENT, "Job is not completed.");
+
+            *out_result = data.result;
+            auto len = data.error_message.length();
+            if (out_required_size) *out_required_size = len + 1;
+            if (buffer_size <= 0) return DIGITALCURLING_OK;
+            if (buffer_size < len + 1)
+                DIGITALCURLING_LOADER_RETURN_ERROR(DIGITALCURLING_ERR_BUFFER_NULLPTR, "out_message is too small.");
+
+            std::memcpy(out_message, data.error_message.c_str(), len);
+            out_message[len] = '\0';
+            return DIGITALCURLING_OK;
+        });
+    });
+}
+DigitalCurling_ErrorCode dc_loader_destroy_async_job(DigitalCurling_AsyncJobHandle job) {
+    DIGITALCURLING_LOADER_CHECK_POINTER(job);
+
+    return digitalcurling::plugins::detail::catch_exceptions(__func__, [&]() {
+        auto success = AsyncJobManager::GetInstance().Destroy(job);
+        if (!success)
+            DIGITALCURLING_LOADER_RETURN_ERROR(DIGITALCURLING_ERR_INSTANCE_NOT_FOUND, "Job handle is not valid.");
+        return DIGITALCURLING_OK;
+    });
+}
@@ -1,14 +1,20 @@
 // Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
 // SPDX-License-Identifier: MIT
 
+#include <cstdint>
+#include <cstdio>
 #include <exception>
 #include <filesystem>
+#include <fstream>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <random>
 #include <shared_mutex>
 #include <stdexcept>
 #include <string>
+#include <system_error>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include <nlohmann/json.hpp>
@@ -23,6 +29,7 @@ namespace digitalcurling::plugins {
     #error "Build system must define DIGITALCURLING_LIBRARY_EXTENSION. Check CMakeLists.txt. for digitalcurling_plugin_loader."
 #endif
 const std::string LibraryExtension = DIGITALCURLING_LIBRARY_EXTENSION;
+const std::string PluginManifestFileName = "digitalcurling_plugins.manifest.json";
 
 #ifdef DIGITALCURLING_BUNDLE_PLUGINS
     void RegisterStaticPlugin(PluginInfo info, PluginApi api) {
@@ -31,6 +38,124 @@ const std::string LibraryExtension = DIGITALCURLING_LIBRARY_EXTENSION;
     }
 #endif // DIGITALCURLING_BUNDLE_PLUGINS
 
+#ifndef DIGITALCURLING_PLUGIN_LOADER_DISABLE_DYNAMIC
+namespace {
+
+constexpr int kManifestVersion = 1;
+
+// マニフェストに記録するファイルごとの情報
+struct ManifestEntry {
+    std::uintmax_t size = 0;
+    std::int64_t mtime = 0;
+    std::string hash;
+    // プラグインでないファイルは std::nullopt
+    std::optional<PluginType> type;
+    std::string name;
+    unsigned int api_version = 0;
+};
+
+// ファイルの内容の FNV-1a (64bit) ハッシュを16進数の文字列で返す
+std::string HashFile(const std::filesystem::path& path) {
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream) return {};
+
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    char buffer[1 << 16];
+    while (stream) {
+        stream.read(buffer, sizeof(buffer));
+        for (std::streamsize i = 0; i < stream.gcount(); ++i) {
+            hash ^= static_cast<unsigned char>(buffer[i]);
+            hash *= 0x100000001b3ULL;
+        }
+    }
+
+    char text[17];
+    std::snprintf(text, sizeof(text), "%016llx", static_cast<unsigned long long>(hash));
+    return text;
+}
+
+std::int64_t GetWriteTime(const std::filesystem::directory_entry& entry) {
+    return static_cast<std::int64_t>(entry.last_write_time().time_since_epoch().count());
+}
+
+// マニフェストを読み込む (存在しない場合や形式・バージョンが異なる場合は空)
+std::unordered_map<std::string, ManifestEntry> ReadManifest(const std::filesystem::path& path) {
+    std::unordered_map<std::string, ManifestEntry> entries;
+    std::ifstream stream(path);
+    if (!stream) return entries;
+
+    try {
+        auto json = nlohmann::json::parse(stream);
+        if (json.at("manifest_version").get<int>() != kManifestVersion ||
+            json.at("loader_api_version").get<unsigned int>() != DIGITALCURLING_PLUGIN_API_VERSION) {
+            return entries;
+        }
+        for (const auto& item : json.at("plugins")) {
+            ManifestEntry entry;
+            entry.size = item.at("size").get<std::uintmax_t>();
+            entry.mtime = item.at("mtime").get<std::int64_t>();
+            entry.hash = item.at("hash").get<std::string>();
+            if (!item.at("type").is_null()) {
+                auto type = item.at("type").get<std::string>();
+                if (type == ToString(PluginType::simulator)) entry.type = PluginType::simulator;
+                else if (type == ToString(PluginType::player)) entry.type = PluginType::player;
+                else continue;
+                entry.name = item.at("name").get<std::string>();
+                entry.api_version = item.at("api_version").get<unsigned int>();
+            }
+            entries.emplace(item.at("file").get<std::string>(), std::move(entry));
+        }
+    } catch (const std::exception&) {
+        entries.clear();
+    }
+    return entries;
+}
+
+// マニフェストを書き込む (一時ファイルに書き込んでから置き換え, 失敗しても例外は送出しない)
+void WriteManifest(const std::filesystem::path& path, const std::unordered_map<std::string, ManifestEntry>& entries) {
+    auto plugins = nlohmann::json::array();
+    for (const auto& [file, entry] : entries) {
+        nlohmann::json item = {
+            {"file", file},
+            {"size", entry.size},
+            {"mtime", entry.mtime},
+            {"hash", entry.hash},
+            {"type", nullptr},
+        };
+        if (entry.type) {
+            item["type"] = ToString(*entry.type);
+            item["name"] = entry.name;
+            item["api_version"] = entry.api_version;
+        }
+        plugins.push_back(std::move(item));
+    }
+    nlohmann::json json = {
+        {"manifest_version", kManifestVersion},
+        {"loader_api_version", DIGITALCURLING_PLUGIN_API_VERSION},
+        {"plugins", std::move(plugins)},
+    };
+
+    auto temp_path = path;
+    temp_path += ".tmp" + std::to_string(std::random_device{}());
+    {
+        std::ofstream stream(temp_path, std::ios::trunc);
+        if (!stream) return;
+        stream << json.dump(2);
+        if (!stream) {
+            stream.close();
+            std::error_code ec;
+            std::filesystem::remove(temp_path, ec);
+            return;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) std::filesystem::remove(temp_path, ec);
+}
+
+} // namespace
+#endif // DIGITALCURLING_PLUGIN_LOADER_DISABLE_DYNAMIC
+
 
 PluginManager::~PluginManager() {
     std::unique_lock<std::shared_mutex> lock(mutex_);
@@ -59,10 +184,11 @@ std::optional<PluginId> PluginManager::LoadPlugin(const std::filesystem::path& p
         auto native = detail::LoadNativePlugin(plugin_path);
 
         auto info = native.get_plugin_info();
-        if (info.plugin_version != DIGITALCURLING_PLUGIN_API_VERSION) {
+        if (info.plugin_version < DIGITALCURLING_PLUGIN_API_MIN_VERSION || info.plugin_version > DIGITALCURLING_PLUGIN_API_VERSION) {
             throw plugin_error{
                 DIGITALCURLING_ERR_PLUGIN_VERSION_MISMATCH,
-                "Plugin version is incompatible (expected version " + std::to_string(DIGITALCURLING_PLUGIN_API_VERSION) + ")."
+                "Plugin version is incompatible (expected version " + std::to_string(DIGITALCURLING_PLUGIN_API_MIN_VERSION) +
+                " to " + std::to_string(DIGITALCURLING_PLUGIN_API_VERSION) + ")."
             };
         }
         auto api = native.get_plugin_api();
@@ -76,21 +202,116 @@ std::optional<PluginId> PluginManager::LoadPlugin(const std::filesystem::path& p
         throw;
     }
 }
+
+std::vector<PluginId> PluginManager::LoadPluginDirectory(const std::filesystem::path& plugin_dir, const std::optional<std::filesystem::path>& manifest_path) {
+    if (!std::filesystem::is_directory(plugin_dir))
+        throw plugin_error { DIGITALCURLING_ERR_FAILED_TO_LOAD_PLUGIN, "\"" + plugin_dir.string() + "\": Directory does not exist." };
+
+    auto const manifest_file = manifest_path.value_or(plugin_dir / PluginManifestFileName);
+    auto cached = ReadManifest(manifest_file);
+
+    std::unordered_map<std::string, ManifestEntry> entries;
+    std::vector<std::pair<PluginId, std::filesystem::path>> lazy_plugins;
+    std::vector<PluginId> ids;
+    bool modified = false;
+
+    for (const auto& dir_entry : std::filesystem::directory_iterator(plugin_dir)) {
+        const auto& path = dir_entry.path();
+        if (!dir_entry.is_regular_file() || path.extension() != LibraryExtension) continue;
+
+        auto file = path.filename().string();
+        auto const size = dir_entry.file_size();
+        auto const mtime = GetWriteTime(dir_entry);
+
+        // サイズと更新日時が一致すれば変更なし, 更新日時のみ異なる場合はハッシュで判定する
+        auto it = cached.find(file);
+        if (it != cached.end() && it->second.size == size) {
+            auto entry = it->second;
+            bool unchanged = entry.mtime == mtime;
+            if (!unchanged && entry.hash == HashFile(path)) {
+                entry.mtime = mtime;
+                unchanged = true;
+                modified = true;
+            }
+            if (unchanged) {
+                if (entry.type && entry.api_version >= DIGITALCURLING_PLUGIN_API_MIN_VERSION && entry.api_version <= DIGITALCURLING_PLUGIN_API_VERSION)
+                    lazy_plugins.emplace_back(PluginId{ *entry.type, entry.name }, path);
+                entries.emplace(std::move(file), std::move(entry));
+                continue;
+            }
+        }
+
+        // 追加・変更されたファイルはロードして情報を取得する
+        modified = true;
+        ManifestEntry entry;
+        entry.size = size;
+        entry.mtime = mtime;
+        entry.hash = HashFile(path);
+        try {
+            auto id = *LoadPlugin(path, true);
+            std::shared_lock lock(mutex_);
+            std::shared_ptr<detail::PluginResource> resource;
+            if (id.type == PluginType::player) resource = GetPlayerPluginResource(id.name);
+            else resource = GetSimulatorPluginResource(id.name);
+            entry.type = id.type;
+            entry.name = id.name;
+            entry.api_version = resource->GetApiVersion();
+            ids.push_back(std::move(id));
+        } catch (const std::exception&) {
+            // プラグインでないファイルも記録し, 変更されるまではロードしない
+        }
+        entries.emplace(std::move(file), std::move(entry));
+    }
+    if (entries.size() != cached.size()) modified = true;
+
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        for (auto& [id, path] : lazy_plugins) {
+            // 既にロード済みのプラグインは遅延ロードに登録しない
+            auto const loaded = id.type == PluginType::player ? player_resources_.count(id.name) > 0 : simulator_resources_.count(id.name) > 0;
+            if (!loaded) {
+                auto& lazy = id.type == PluginType::player ? lazy_player_plugins_ : lazy_simulator_plugins_;
+                lazy.emplace(id.name, std::move(path));
+            }
+            ids.push_back(std::move(id));
+        }
+    }
+
+    if (modified) WriteManifest(manifest_file, entries);
+    return ids;
+}
 #endif // DIGITALCURLING_PLUGIN_LOADER_DISABLE_DYNAMIC
 
+#if defined(__linux__) && !defined(DIGITALCURLING_PLUGIN_LOADER_DISABLE_DYNAMIC)
+std::unique_ptr<IsolatedPluginPool> PluginManager::CreateIsolatedPool(const std::filesystem::path& plugin_path, const std::optional<nlohmann::json>& config, std::size_t worker_count) {
+    if (!std::filesystem::exists(plugin_path) || !std::filesystem::is_regular_file(plugin_path))
+        throw plugin_error { DIGITALCURLING_ERR_FAILED_TO_LOAD_PLUGIN, "\"" + plugin_path.string() + "\": File does not exist or is not a regular file." };
+    if (!plugin_path.has_extension() || plugin_path.extension() != LibraryExtension)
+        throw plugin_error { DIGITALCURLING_ERR_FAILED_TO_LOAD_PLUGIN, "\"" + plugin_path.string() + "\": Invalid file extension. Expected " + LibraryExtension + "." };
+
+    return std::make_unique<IsolatedPluginPool>(plugin_path, config, worker_count);
+}
+#endif
+
 void PluginManager::RegisterPlugin(std::shared_ptr<detail::PluginResource> resource) {
     std::unique_lock<std::shared_mutex> lock(mutex_);
 
+    // 記録中にロードされたプラグインでも記録を開始する (失敗してもロードは続ける)
+    if (trace::IsEnabled() && resource->SupportsTrace())
+        (void)resource->trace_start.ExecuteRaw(trace_events_per_thread_);
+
     auto type = resource->GetType();
     if (type == PluginType::player) {
         auto player_resource = std::dynamic_pointer_cast<detail::PlayerPluginResource>(resource);
         if (player_resource) {
+            lazy_player_plugins_.erase(resource->GetName());
             player_resources_[resource->GetName()] = std::move(player_resource);
             return;
         }
     } else if (type == PluginType::simulator) {
         auto simulator_resource = std::dynamic_pointer_cast<detail::SimulatorPluginResource>(resource);
         if (simulator_resource) {
+            lazy_simulator_plugins_.erase(resource->GetName());
             simulator_resources_[resource->GetName()] = std::move(simulator_resource);
             return;
         }
@@ -109,65 +330,161 @@ std::vector<PluginId> PluginManager::GetLoadedPlugins(std::optional<PluginType>
     std::vector<PluginId> ids;
 
     if (!type.has_value()) {
-        ids.reserve(player_resources_.size() + simulator_resources_.size());
+        ids.reserve(player_resources_.size() + simulator_resources_.size() + lazy_player_plugins_.size() + lazy_simulator_plugins_.size());
         for (const auto& pair : player_resources_) ids.push_back({PluginType::player, pair.first});
+        for (const auto& pair : lazy_player_plugins_) ids.push_back({PluginType::player, pair.first});
         for (const auto& pair : simulator_resources_) ids.push_back({PluginType::simulator, pair.first});
+        for (const auto& pair : lazy_simulator_plugins_) ids.push_back({PluginType::simulator, pair.first});
         return ids;
     } else if (type == PluginType::player) {
         for (const auto& pair : player_resources_) ids.push_back({PluginType::player, pair.first});
+        for (const auto& pair : lazy_player_plugins_) ids.push_back({PluginType::player, pair.first});
     } else if (type == PluginType::simulator) {
         for (const auto& pair : simulator_resources_) ids.push_back({PluginType::simulator, pair.first});
+        for (const auto& pair : lazy_simulator_plugins_) ids.push_back({PluginType::simulator, pair.first});
     } else {
         throw plugin_error{DIGITALCURLING_ERR_INVALID_PLUGIN_TYPE, "Plugin type is invalid."};
     }
     return ids;
 }
 
+std::vector<SimulatorPluginStats> PluginManager::GetSimulatorStats() const {
+    std::vector<std::pair<std::string, std::shared_ptr<detail::SimulatorPluginResource>>> resources;
+    {
+        std::shared_lock lock(mutex_);
+        resources.assign(simulator_resources_.begin(), simulator_resources_.end());
+    }
+
+    // プラグインの呼び出しはロックを解放してから行う
+    std::vector<SimulatorPluginStats> result;
+    result.reserve(resources.size());
+    for (auto const& [name, resource] : resources) {
+        SimulatorPluginStats entry{name, 0, {}};
+        entry.stats = resource->GetStats(&entry.instance_count);
+        result.push_back(std::move(entry));
+    }
+    return result;
+}
+
+void PluginManager::StartTrace(std::size_t events_per_thread) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    trace_events_per_thread_ = events_per_thread;
+
+    // 開始の呼び出し自体を記録しないよう, プラグインを先に開始する
+    for (auto const& pair : player_resources_) {
+        if (pair.second->SupportsTrace()) pair.second->trace_start.Execute(events_per_thread);
+    }
+    for (auto const& pair : simulator_resources_) {
+        if (pair.second->SupportsTrace()) pair.second->trace_start.Execute(events_per_thread);
+    }
+    trace::Start(events_per_thread);
+}
+
+nlohmann::json PluginManager::StopTrace() {
+    std::vector<std::shared_ptr<detail::PluginResource>> resources;
+    nlohmann::json events;
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        events = trace::Stop();
+        for (auto const& pair : player_resources_) resources.push_back(pair.second);
+        for (auto const& pair : simulator_resources_) resources.push_back(pair.second);
+    }
+
+    // プラグインごとの記録を結合する (ローダーに静的リンクされたプラグインの記録は上で取得済み)
+    for (auto const& resource : resources) {
+        if (!resource->SupportsTrace()) continue;
+        for (auto& event : nlohmann::json::parse(resource->trace_stop.Execute()))
+            events.push_back(std::move(event));
+    }
+    return events;
+}
+
+void PluginManager::ResolveLazyPlugin(PluginType type, const std::string& name) {
+#ifndef DIGITALCURLING_PLUGIN_LOADER_DISABLE_DYNAMIC
+    auto& lazy_plugins = type == PluginType::player ? lazy_player_plugins_ : lazy_simulator_plugins_;
+    {
+        std::shared_lock lock(mutex_);
+        if (lazy_plugins.count(name) == 0) return;
+    }
+
+    // 同じプラグインを複数のスレッドが同時にロードしないよう直列化する
+    std::lock_guard load_lock(lazy_load_mutex_);
+    std::filesystem::path path;
+    {
+        std::shared_lock lock(mutex_);
+        auto it = lazy_plugins.find(name);
+        if (it == lazy_plugins.end()) return;
+        path = it->second;
+    }
+
+    auto id = *LoadPlugin(path, true);
+    if (id.type != type || id.name != name) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        lazy_plugins.erase(name);
+        throw plugin_error {
+            DIGITALCURLING_ERR_PLUGIN_NOT_FOUND,
+            "\"" + path.string() + "\": The plugin does not match the manifest (expected " + ToString(type) + " plugin: " + name + ")."
+        };
+    }
+#endif // DIGITALCURLING_PLUGIN_LOADER_DISABLE_DYNAMIC
+}
+
+std::shared_ptr<detail::PlayerPluginResource> PluginManager::AcquirePlayerPluginResource(const std::string& name) {
+    ResolveLazyPlugin(PluginType::player, name);
+    std::shared_lock lock(mutex_);
+    return GetPlayerPluginResource(name);
+}
+std::shared_ptr<detail::SimulatorPluginResource> PluginManager::AcquireSimulatorPluginResource(const std::string& name) {
+    ResolveLazyPlugin(PluginType::simulator, name);
+    std::shared_lock lock(mutex_);
+    return GetSimulatorPluginResource(name);
+}
+
 // --- Player instance management ---
 std::unique_ptr<players::PluginPlayerFactory> PluginManager::CreatePlayerFactory(const std::string& name) {
-    std::shared_lock lock(mutex_);
-    auto res = GetPlayerPluginResource(name);
+    DIGITALCURLING_TRACE_SCOPE("manager", "CreatePlayerFactory");
+    auto res = AcquirePlayerPluginResource(name);
     return std::make_unique<players::PluginPlayerFactory>(name, res->create_factory.Execute(nullptr), res);
 }
 std::unique_ptr<players::PluginPlayerFactory> PluginManager::CreatePlayerFactory(const nlohmann::json& json) {
-    std::shared_lock lock(mutex_);
+    DIGITALCURLING_TRACE_SCOPE("manager", "CreatePlayerFactory");
     auto name = json.at("type").get<std::string>();
-    auto res = GetPlayerPluginResource(name);
+    auto res = AcquirePlayerPluginResource(name);
     return std::make_unique<players::PluginPlayerFactory>(name, res->create_factory.Execute(json.dump().c_str()), res);
 }
 std::unique_ptr<players::PluginPlayerStorage> PluginManager::CreatePlayerStorage(const std::string& name) {
-    std::shared_lock lock(mutex_);
-    auto res = GetPlayerPluginResource(name);
+    DIGITALCURLING_TRACE_SCOPE("manager", "CreatePlayerStorage");
+    auto res = AcquirePlayerPluginResource(name);
     return std::make_unique<players::PluginPlayerStorage>(name, res->create_storage.Execute(nullptr), res);
 }
 std::unique_ptr<players::PluginPlayerStorage> PluginManager::CreatePlayerStorage(const nlohmann::json& json) {
-    std::shared_lock lock(mutex_);
+    DIGITALCURLING_TRACE_SCOPE("manager", "CreatePlayerStorage");
     auto name = json.at("type").get<std::string>();
-    auto res = GetPlayerPluginResource(name);
+    auto res = AcquirePlayerPluginResource(name);
     return std::make_unique<players::PluginPlayerStorage>(name, res->create_storage.Execute(json.dump().c_str()), res);
 }
 
 // --- Simulator instance management ---
 std::unique_ptr<simulators::PluginSimulatorFactory> PluginManager::CreateSimulatorFactory(const std::string& name) {
-    std::shared_lock lock(mutex_);
-    auto res = GetSimulatorPluginResource(name);
+    DIGITALCURLING_TRACE_SCOPE("manager", "CreateSimulatorFactory");
+    auto res = AcquireSimulatorPluginResource(name);
     return std::make_unique<simulators::PluginSimulatorFactory>(name, res->create_factory.Execute(nullptr), res);
 }
 std::unique_ptr<simulators::PluginSimulatorFactory> PluginManager::CreateSimulatorFactory(const nlohmann::json& json) {
-    std::shared_lock lock(mutex_);
+    DIGITALCURLING_TRACE_SCOPE("manager", "CreateSimulatorFactory");
     auto name = json.at("type").get<std::string>();
-    auto res = GetSimulatorPluginResource(name);
+    auto res = AcquireSimulatorPluginResource(name);
     return std::make_unique<simulators::PluginSimulatorFactory>(name, res->create_factory.Execute(json.dump().c_str()), res);
 }
 std::unique_ptr<simulators::PluginSimulatorStorage> PluginManager::CreateSimulatorStorage(const std::string& name) {
-    std::shared_lock lock(mutex_);
-    auto res = GetSimulatorPluginResource(name);
+    DIGITALCURLING_TRACE_SCOPE("manager", "CreateSimulatorStorage");
+    auto res = AcquireSimulatorPluginResource(name);
     return std::make_unique<simulators::PluginSimulatorStorage>(name, res->create_storage.Execute(nullptr), res);
 }
 std::unique_ptr<simulators::PluginSimulatorStorage> PluginManager::CreateSimulatorStorage(const nlohmann::json& json) {
-    std::shared_lock lock(mutex_);
+    DIGITALCURLING_TRACE_SCOPE("manager", "CreateSimulatorStorage");
     auto name = json.at("type").get<std::string>();
-    auto res = GetSimulatorPluginResource(name);
+    auto res = AcquireSimulatorPluginResource(name);
     return std::make_unique<simulators::PluginSimulatorStorage>(name, res->create_storage.Execute(json.dump().c_str()), res);
 }
 
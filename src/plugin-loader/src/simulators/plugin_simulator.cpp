@@ -1,6 +1,7 @@
 // Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
 // SPDX-License-Identifier: MIT
 
+#include <cstddef>
 #include <memory>
 #include <mutex>
 #include <stdexcept>
@@ -10,6 +11,7 @@
 #include <nlohmann/json.hpp>
 #include <uuidv7/uuidv7.hpp>
 #include "digitalcurling/common.hpp"
+#include "digitalcurling/stone_coordinate.hpp"
 #include "digitalcurling/simulators/plugin_simulator.hpp"
 #include "digitalcurling/simulators/plugin_simulator_factory.hpp"
 #include "digitalcurling/simulators/plugin_simulator_storage.hpp"
@@ -18,69 +20,191 @@ namespace digitalcurling::simulators {
 
 PluginSimulator::PluginSimulator(std::string simulator_id, uuidv7::uuidv7 instance_id, std::weak_ptr<OwnerResource> owner_resource)
     : WrapperBase(std::move(simulator_id), std::move(instance_id), std::move(owner_resource))
-      { }
+    , handle_(nullptr)
+    , native_(nullptr)
+{
+    this->template ExecuteResourceFunc<void>([&](auto const& resource) {
+        handle_ = resource->GetInstanceList().template Get<plugins::SimulatorHandle>(this->GetInstanceId()).get();
+#ifdef DIGITALCURLING_BUNDLE_PLUGINS
+        // 静的リンクされている場合はハンドルがそのままプラグインの実体を指す
+        if (handle_ && resource->IsStatic())
+            native_ = dynamic_cast<ISimulator*>(handle_);
+#endif
+    });
+    if (!handle_)
+        throw plugins::plugin_error{DIGITALCURLING_ERR_INSTANCE_NOT_FOUND, "Simulator instance not found: " + this->GetPluginId()};
+}
 
 void PluginSimulator::SetStones(ISimulator::AllStones const& stones) {
+    using StonesConverter = plugins::detail::CTypeConverter<ISimulator::AllStones, DigitalCurling_StoneCoordinate>;
+
     ClearCaches();
-    this->template ExecuteResourceFunc<void>([&](auto resource) {
-        resource->set_stones.Execute(this->GetInstanceId(), stones);
+    this->template ExecuteResourceFunc<void>([&](auto const& resource) {
+        auto const c_stones = StonesConverter::ToCType(stones);
+        const DigitalCurling_StoneCoordinate* stones_ptr = &c_stones;
+        auto result = resource->set_stones.ExecuteRaw(handle_, stones_ptr);
+        if (!result) throw result.GetError();
     });
 }
 void PluginSimulator::Step(int frames, float sheet_width) {
     ClearCaches();
-    this->template ExecuteResourceFunc<void>([&](auto resource) {
-        resource->step.Execute(this->GetInstanceId(), frames, sheet_width);
+    this->template ExecuteResourceFunc<void>([&](auto const& resource) {
+        auto result = resource->step.ExecuteRaw(handle_, frames, sheet_width);
+        if (!result) throw result.GetError();
     });
 }
 void PluginSimulator::Simulate(SimulateModeFlag mode_flag, float sheet_width) {
+    using ModeConverter = plugins::detail::CTypeConverter<SimulateModeFlag, DigitalCurling_SimulateModeFlag>;
+
     ClearCaches();
-    this->template ExecuteResourceFunc<void>([&](auto resource) {
-        resource->simulate.Execute(this->GetInstanceId(), mode_flag, sheet_width);
+    this->template ExecuteResourceFunc<void>([&](auto const& resource) {
+        auto result = resource->simulate.ExecuteRaw(handle_, ModeConverter::ToCType(mode_flag), sheet_width);
+        if (!result) throw result.GetError();
+    });
+}
+
+std::vector<ISimulator::AllStones> PluginSimulator::SimulateBatch(
+    std::vector<ISimulator::AllStones> const& stones,
+    std::vector<moves::Shot> const& shots,
+    std::size_t shot_stone_index,
+    SimulateModeFlag mode_flag,
+    float sheet_width
+) {
+    if (!shots.empty() && shots.size() != stones.size())
+        throw std::invalid_argument("PluginSimulator::SimulateBatch: shots must be empty or have the same size as stones.");
+    if (!shots.empty() && shot_stone_index >= StoneCoordinate::kStoneMax)
+        throw std::invalid_argument("PluginSimulator::SimulateBatch: shot_stone_index is out of range.");
+
+    using StonesConverter = plugins::detail::CTypeConverter<ISimulator::AllStones, DigitalCurling_StoneCoordinate>;
+    using ShotConverter = plugins::detail::CTypeConverter<moves::Shot, DigitalCurling_Shot>;
+    using ModeConverter = plugins::detail::CTypeConverter<SimulateModeFlag, DigitalCurling_SimulateModeFlag>;
+
+    ClearCaches();
+    return this->template ExecuteResourceFunc<std::vector<ISimulator::AllStones>>([&](auto const& resource) {
+        std::vector<ISimulator::AllStones> results;
+        results.reserve(stones.size());
+
+        if (!resource->SupportsSimulateBatch()) {
+            for (std::size_t i = 0; i < stones.size(); ++i) {
+                auto initial = stones[i];
+                if (!shots.empty()) {
+                    initial[shot_stone_index] = ISimulator::StoneState(
+                        Vector2(), 0.f, shots[i].ToVector2(), shots[i].angular_velocity);
+                }
+                resource->set_stones.Execute(this->GetInstanceId(), initial);
+                resource->simulate.Execute(this->GetInstanceId(), mode_flag, sheet_width);
+                results.push_back(resource->get_stones.Execute(this->GetInstanceId()));
+            }
+            return results;
+        }
+
+        std::vector<DigitalCurling_StoneCoordinate> c_stones;
+        c_stones.reserve(stones.size());
+        for (auto const& s : stones) c_stones.push_back(StonesConverter::ToCType(s));
+
+        std::vector<DigitalCurling_Shot> c_shots;
+        c_shots.reserve(shots.size());
+        for (auto const& s : shots) c_shots.push_back(ShotConverter::ToCType(s));
+
+        const DigitalCurling_StoneCoordinate* stones_ptr = c_stones.data();
+        const DigitalCurling_Shot* shots_ptr = c_shots.empty() ? nullptr : c_shots.data();
+        DigitalCurling_StoneCoordinate* out_ptr = c_stones.data();
+        auto result = resource->simulate_batch.ExecuteRaw(
+            this->GetInstanceId(), stones_ptr, shots_ptr, c_stones.size(),
+            static_cast<int>(shot_stone_index), ModeConverter::ToCType(mode_flag), sheet_width, out_ptr);
+        if (!result) throw result.GetError();
+
+        for (auto const& c : c_stones) results.push_back(StonesConverter::FromCType(c));
+        return results;
     });
 }
 
 ISimulator::AllStones const& PluginSimulator::GetStones() const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    auto lock = LockIfMultiThreaded(mutex_);
     if (all_stones_cache_.has_value()) return all_stones_cache_.value();
 
-    this->template ExecuteResourceFunc<void>([&](auto resource) {
-        all_stones_cache_ = resource->get_stones.Execute(this->GetInstanceId());
+    using StonesConverter = plugins::detail::CTypeConverter<ISimulator::AllStones, DigitalCurling_StoneCoordinate>;
+    this->template ExecuteResourceFunc<void>([&](auto const& resource) {
+        auto result = resource->get_stones.ExecuteRaw(handle_);
+        if (!result) throw result.GetError();
+        all_stones_cache_ = StonesConverter::FromCType(result.GetValue());
     });
     return all_stones_cache_.value();
 }
 std::vector<ISimulator::Collision> const& PluginSimulator::GetCollisions() const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    auto lock = LockIfMultiThreaded(mutex_);
     if (collisions_cache_.has_value()) return collisions_cache_.value();
 
-    this->template ExecuteResourceFunc<void>([&](auto resource) {
-        collisions_cache_ = nlohmann::json::parse(resource->get_collisions.Execute(this->GetInstanceId()))
-            .template get<std::vector<ISimulator::Collision>>();
+    this->template ExecuteResourceFunc<void>([&](auto const& resource) {
+        if (!resource->SupportsCollisionRecords()) {
+            collisions_cache_ = nlohmann::json::parse(resource->get_collisions.Execute(this->GetInstanceId()))
+                .template get<std::vector<ISimulator::Collision>>();
+            return;
+        }
+
+        using CollisionConverter = plugins::detail::CTypeConverter<ISimulator::Collision, DigitalCurling_Collision>;
+        constexpr std::size_t kInitialCapacity = 16;
+        constexpr int kMaxAttempts = 4;
+
+        // 容量が足りなければ総数に合わせて取り直す
+        // 総数がバッファに収まるまで繰り返し, 収まらないまま上限に達したら未書き込みの要素を返さずに失敗とする
+        std::vector<DigitalCurling_Collision> c_collisions(kInitialCapacity);
+        std::size_t count = 0;
+        for (int attempt = 0; ; ++attempt) {
+            DigitalCurling_Collision* out_ptr = c_collisions.data();
+            std::size_t* count_ptr = &count;
+            auto result = resource->get_collision_records.ExecuteRaw(this->GetInstanceId(), out_ptr, c_collisions.size(), count_ptr);
+            if (!result) throw result.GetError();
+            if (count <= c_collisions.size()) break;
+            if (attempt + 1 >= kMaxAttempts)
+                throw plugins::plugin_error{DIGITALCURLING_ERR_INVALID_DATA, "Collision count changed while reading: " + this->GetPluginId()};
+            c_collisions.resize(count);
+        }
+        c_collisions.resize(count);
+
+        std::vector<ISimulator::Collision> collisions;
+        collisions.reserve(count);
+        for (auto const& c : c_collisions) collisions.push_back(CollisionConverter::FromCType(c));
+        collisions_cache_ = std::move(collisions);
     });
     return collisions_cache_.value();
 }
 bool PluginSimulator::AreAllStonesStopped() const {
-    return this->template ExecuteResourceFunc<bool>([&](auto resource) {
-        return resource->are_all_stones_stopped.Execute(this->GetInstanceId());
+    return this->template ExecuteResourceFunc<bool>([&](auto const& resource) {
+        auto result = resource->are_all_stones_stopped.ExecuteRaw(handle_);
+        if (!result) throw result.GetError();
+        return result.GetValue();
     });
 }
 float PluginSimulator::GetSecondsPerFrame() const {
-    return this->template ExecuteResourceFunc<float>([&](auto resource) {
+    return this->template ExecuteResourceFunc<float>([&](auto const& resource) {
         return resource->get_seconds_per_frame.Execute(this->GetInstanceId());
     });
 }
 
 ISimulatorFactory const& PluginSimulator::GetFactory() const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    auto lock = LockIfMultiThreaded(mutex_);
     if (factory_cache_) return *factory_cache_;
 
-    this->template ExecuteResourceFunc<void>([&](auto resource) {
+    this->template ExecuteResourceFunc<void>([&](auto const& resource) {
         auto id = resource->get_factory.Execute(this->GetInstanceId());
         factory_cache_ = std::make_unique<PluginSimulatorFactory>(this->GetPluginId(), id, resource);
     });
     return *factory_cache_;
 }
+SimulatorStats PluginSimulator::GetStats() const {
+    using StatsConverter = plugins::detail::CTypeConverter<SimulatorStats, DigitalCurling_SimulatorStats>;
+
+    return this->template ExecuteResourceFunc<SimulatorStats>([&](auto const& resource) {
+        if (!resource->SupportsStats()) return SimulatorStats{};
+
+        auto result = resource->get_stats.ExecuteRaw(handle_);
+        if (!result) throw result.GetError();
+        return StatsConverter::FromCType(result.GetValue());
+    });
+}
 std::unique_ptr<ISimulatorStorage> PluginSimulator::CreateStorage() const {
-    return this->template ExecuteResourceFunc<std::unique_ptr<ISimulatorStorage>>([&](auto resource) {
+    return this->template ExecuteResourceFunc<std::unique_ptr<ISimulatorStorage>>([&](auto const& resource) {
         auto id = resource->create_storage.Execute(nullptr);
         resource->save.Execute(this->GetInstanceId(), id);
         return std::make_unique<PluginSimulatorStorage>(this->GetPluginId(), id, resource);
@@ -91,7 +215,7 @@ void PluginSimulator::Save(ISimulatorStorage& storage) const {
     if (!plugin_storage || this->GetPluginId() != plugin_storage->GetSimulatorId())
         throw std::runtime_error("Failed to cast ISimulatorStorage to PluginSimulatorImplStorage for simulator: " + this->GetPluginId());
 
-    this->template ExecuteResourceFunc<void>([&](auto resource) {
+    this->template ExecuteResourceFunc<void>([&](auto const& resource) {
         resource->save.Execute(this->GetInstanceId(), plugin_storage->GetInstanceId());
     });
 }
@@ -101,13 +225,13 @@ void PluginSimulator::Load(ISimulatorStorage const& storage) {
         throw std::runtime_error("Failed to cast ISimulatorStorage to PluginSimulatorImplStorage for simulator: " + this->GetPluginId());
 
     ClearCaches();
-    this->template ExecuteResourceFunc<void>([&](auto resource) {
+    this->template ExecuteResourceFunc<void>([&](auto const& resource) {
         resource->load.Execute(this->GetInstanceId(), plugin_storage->GetInstanceId());
     });
 }
 
 moves::Shot InvertiblePluginSimulator::CalculateShot(Vector2 const& target_position, float target_speed, float angular_velocity) const {
-    return ExecuteResourceFunc<moves::Shot>([&](auto resource) {
+    return ExecuteResourceFunc<moves::Shot>([&](auto const& resource) {
         return resource->calculate_shot.Execute(GetInstanceId(), target_position, target_speed, angular_velocity);
     });
 }
@@ -1,7 +1,13 @@
+#include <atomic>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
 #include <optional>
+#include <set>
 #include <string>
+#include <thread>
 #include <vector>
 #include <nlohmann/json.hpp>
 #include <uuidv7/uuidv7.hpp>
@@ -198,6 +204,39 @@ TEST_F(PluginLoaderDynamic, Snapshot_CreatorState) {
 }
 
 
+TEST_F(PluginLoaderDynamic, Snapshot_Borrow) {
+    if (!IsPlayerPluginLoaded()) {
+        GTEST_SKIP() << "Player plugin not loaded, skipping test.";
+    }
+
+    DigitalCurling_Uuid factory_id;
+    ASSERT_EQ(dc_loader_create_player_factory(kPlayerPluginName, nullptr, &factory_id), DIGITALCURLING_OK);
+
+    DigitalCurling_SnapshotHandle handle;
+    size_t snapshot_size = 0;
+    ASSERT_EQ(dc_loader_creator_get_state_snapshot(&factory_id, &handle, &snapshot_size), DIGITALCURLING_OK);
+
+    // コピーせずに参照したデータが get_data で取得したデータと一致するか確認
+    const char* data = nullptr;
+    size_t size = 0;
+    ASSERT_EQ(dc_loader_snapshot_borrow(handle, &data, &size), DIGITALCURLING_OK);
+    ASSERT_NE(data, nullptr);
+    ASSERT_EQ(size + 1, snapshot_size);
+    ASSERT_EQ(data[size], '\0');
+
+    std::vector<char> buffer(snapshot_size);
+    size_t required_size = 0;
+    ASSERT_EQ(dc_loader_snapshot_get_data(handle, buffer.data(), buffer.size(), &required_size), DIGITALCURLING_OK);
+    ASSERT_EQ(std::string(data, size), std::string(buffer.data()));
+
+    // 破棄したスナップショットは参照できない
+    ASSERT_EQ(dc_loader_destroy_snapshot(handle), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_snapshot_borrow(handle, &data, &size), DIGITALCURLING_ERR_INSTANCE_NOT_FOUND);
+    ASSERT_EQ(dc_loader_snapshot_borrow(nullptr, &data, &size), DIGITALCURLING_ERR_INVALID_ARGUMENT);
+
+    ASSERT_EQ(dc_loader_remove_player_instance(&factory_id), DIGITALCURLING_OK);
+}
+
 TEST_F(PluginLoaderDynamic, Player_LifecycleAndAction) {
     if (!IsPlayerPluginLoaded()) {
         GTEST_SKIP() << "Player plugin not loaded, skipping test.";
@@ -338,6 +377,112 @@ TEST_F(PluginLoaderDynamic, Simulator_LifecycleAndActions) {
     ASSERT_EQ(dc_loader_remove_simulator_instance(&factory_id), DIGITALCURLING_OK);
 }
 
+TEST_F(PluginLoaderDynamic, Simulator_InstanceHandle) {
+    if (!IsSimPluginLoaded()) {
+        GTEST_SKIP() << "Simulator plugin not loaded, skipping test.";
+    }
+
+    DigitalCurling_Uuid factory_id, simulator_id;
+    ASSERT_EQ(dc_loader_create_simulator_factory(kSimPluginName, nullptr, &factory_id), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_create_simulator(&factory_id, &simulator_id), DIGITALCURLING_OK);
+
+    // 1. ハンドルの取得 (Factory には取得できない)
+    DigitalCurling_InstanceHandle handle, handle2, factory_handle;
+    ASSERT_EQ(dc_loader_acquire_instance_handle(&simulator_id, &handle), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_acquire_instance_handle(&simulator_id, &handle2), DIGITALCURLING_OK);
+    ASSERT_NE(handle.value, handle2.value);
+    ASSERT_EQ(dc_loader_acquire_instance_handle(&factory_id, &factory_handle), DIGITALCURLING_ERR_INSTANCE_NOT_FOUND);
+
+    // 2. ハンドル経由の操作が UUID 経由の操作と同じインスタンスに作用するか確認
+    DigitalCurling_StoneCoordinate stones_to_set = {};
+    stones_to_set.stones[0] = { {0.f, 10.f}, 0.f, {0.f, -1.f}, 0.f };
+    ASSERT_EQ(dc_loader_simulator_handle_set_stones(handle, &stones_to_set), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_simulator_handle_step(handle, 1, 0), DIGITALCURLING_OK);
+
+    DigitalCurling_StoneCoordinate stones_handle, stones_uuid;
+    ASSERT_EQ(dc_loader_simulator_handle_get_stones(handle2, &stones_handle), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_simulator_get_stones(&simulator_id, &stones_uuid), DIGITALCURLING_OK);
+    ASSERT_NE(stones_handle.stones[0].position.y, 10.f);
+    ASSERT_EQ(stones_handle.stones[0].position.y, stones_uuid.stones[0].position.y);
+
+    ASSERT_EQ(dc_loader_simulator_handle_simulate(handle, DIGITALCURLING_SIMULATE_MODE_FULL, 4.75f), DIGITALCURLING_OK);
+
+    // 3. 種類の異なる操作や解放済みのハンドルは無効
+    DigitalCurling_Shot input_shot = { 1.f, 0.1f, 0.5f }, output_shot;
+    ASSERT_EQ(dc_loader_player_handle_play(handle, &input_shot, &output_shot), DIGITALCURLING_ERR_INSTANCE_NOT_FOUND);
+    ASSERT_EQ(dc_loader_release_instance_handle(handle), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_release_instance_handle(handle), DIGITALCURLING_ERR_INSTANCE_NOT_FOUND);
+    ASSERT_EQ(dc_loader_simulator_handle_step(handle, 1, 0), DIGITALCURLING_ERR_INSTANCE_NOT_FOUND);
+    ASSERT_EQ(dc_loader_simulator_handle_step(handle2, 1, 0), DIGITALCURLING_OK);
+
+    // 4. インスタンスを削除すると残りのハンドルも無効になる
+    ASSERT_EQ(dc_loader_remove_simulator_instance(&simulator_id), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_simulator_handle_step(handle2, 1, 0), DIGITALCURLING_ERR_INSTANCE_NOT_FOUND);
+    ASSERT_EQ(dc_loader_remove_simulator_instance(&factory_id), DIGITALCURLING_OK);
+}
+
+TEST_F(PluginLoaderDynamic, InstanceHandle_ConcurrentRelease) {
+    if (!IsSimPluginLoaded() || !IsPlayerPluginLoaded()) {
+        GTEST_SKIP() << "Simulator or player plugin not loaded, skipping test.";
+    }
+
+    // 別スレッドでハンドル経由の操作を繰り返している間にハンドルの解放とインスタンスの削除を行っても,
+    // 操作は成功するか INSTANCE_NOT_FOUND を返すだけで, 解放済みのインスタンスにはアクセスしない
+    constexpr int kIterations = 200;
+    for (int i = 0; i < kIterations; ++i) {
+        DigitalCurling_Uuid sim_factory_id, simulator_id, player_factory_id, player_id;
+        ASSERT_EQ(dc_loader_create_simulator_factory(kSimPluginName, nullptr, &sim_factory_id), DIGITALCURLING_OK);
+        ASSERT_EQ(dc_loader_create_simulator(&sim_factory_id, &simulator_id), DIGITALCURLING_OK);
+        ASSERT_EQ(dc_loader_create_player_factory(kPlayerPluginName, nullptr, &player_factory_id), DIGITALCURLING_OK);
+        ASSERT_EQ(dc_loader_create_player(&player_factory_id, &player_id), DIGITALCURLING_OK);
+
+        DigitalCurling_InstanceHandle simulator_handle, player_handle;
+        ASSERT_EQ(dc_loader_acquire_instance_handle(&simulator_id, &simulator_handle), DIGITALCURLING_OK);
+        ASSERT_EQ(dc_loader_acquire_instance_handle(&player_id, &player_handle), DIGITALCURLING_OK);
+
+        DigitalCurling_StoneCoordinate stones = {};
+        stones.stones[0] = { {0.f, 10.f}, 0.f, {0.f, -1.f}, 0.f };
+        ASSERT_EQ(dc_loader_simulator_handle_set_stones(simulator_handle, &stones), DIGITALCURLING_OK);
+
+        std::atomic<bool> started{false};
+        std::atomic<int> unexpected{0};
+        std::thread worker([&]() {
+            DigitalCurling_Shot input_shot = { 1.f, 0.1f, 0.5f }, output_shot;
+            bool simulator_valid = true, player_valid = true;
+            while (simulator_valid || player_valid) {
+                if (simulator_valid) {
+                    auto const result = dc_loader_simulator_handle_step(simulator_handle, 1, 0);
+                    if (result == DIGITALCURLING_ERR_INSTANCE_NOT_FOUND) simulator_valid = false;
+                    else if (result != DIGITALCURLING_OK) ++unexpected;
+                }
+                if (player_valid) {
+                    auto const result = dc_loader_player_handle_play(player_handle, &input_shot, &output_shot);
+                    if (result == DIGITALCURLING_ERR_INSTANCE_NOT_FOUND) player_valid = false;
+                    else if (result != DIGITALCURLING_OK) ++unexpected;
+                }
+                started.store(true, std::memory_order_release);
+            }
+        });
+        while (!started.load(std::memory_order_acquire)) std::this_thread::yield();
+
+        // i が偶数のときはハンドルを解放してから削除し, 奇数のときはハンドルを残したままインスタンスを削除する
+        if (i % 2 == 0) {
+            EXPECT_EQ(dc_loader_release_instance_handle(simulator_handle), DIGITALCURLING_OK);
+            EXPECT_EQ(dc_loader_release_instance_handle(player_handle), DIGITALCURLING_OK);
+            EXPECT_EQ(dc_loader_remove_simulator_instance(&simulator_id), DIGITALCURLING_OK);
+            EXPECT_EQ(dc_loader_remove_player_instance(&player_id), DIGITALCURLING_OK);
+        } else {
+            EXPECT_EQ(dc_loader_remove_simulator_instance(&simulator_id), DIGITALCURLING_OK);
+            EXPECT_EQ(dc_loader_remove_player_instance(&player_id), DIGITALCURLING_OK);
+        }
+        worker.join();
+        EXPECT_EQ(unexpected.load(), 0);
+
+        ASSERT_EQ(dc_loader_remove_simulator_instance(&sim_factory_id), DIGITALCURLING_OK);
+        ASSERT_EQ(dc_loader_remove_player_instance(&player_factory_id), DIGITALCURLING_OK);
+    }
+}
+
 TEST_F(PluginLoaderDynamic, Simulator_SaveLoad) {
     if (!IsSimPluginLoaded()) {
         GTEST_SKIP() << "Simulator plugin not loaded, skipping test.";
@@ -373,6 +518,56 @@ TEST_F(PluginLoaderDynamic, Simulator_SaveLoad) {
     ASSERT_EQ(dc_loader_remove_simulator_instance(&storage_id), DIGITALCURLING_OK);
 }
 
+TEST_F(PluginLoaderDynamic, Simulator_BinaryState) {
+    if (!IsSimPluginLoaded()) {
+        GTEST_SKIP() << "Simulator plugin not loaded, skipping test.";
+    }
+
+    DigitalCurling_Uuid factory_id, storage_id, storage2_id, sim_id, sim2_id;
+    ASSERT_EQ(dc_loader_create_simulator_factory(kSimPluginName, nullptr, &factory_id), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_create_simulator_storage(kSimPluginName, nullptr, &storage_id), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_create_simulator_storage(kSimPluginName, nullptr, &storage2_id), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_create_simulator(&factory_id, &sim_id), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_create_simulator(&factory_id, &sim2_id), DIGITALCURLING_OK);
+
+    // 1. sim_id にストーンを設定して storage に Save
+    DigitalCurling_StoneCoordinate stones_to_set = {};
+    stones_to_set.stones[0] = { {0.f, 10.f}, 0.f, {0.f, -1.f}, 0.f };
+    ASSERT_EQ(dc_loader_simulator_set_stones(&sim_id, &stones_to_set), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_simulator_save(&sim_id, &storage_id), DIGITALCURLING_OK);
+
+    // 2. storage の状態をバイナリ形式で取得
+    size_t required_size = 0;
+    unsigned int format_version = 0;
+    ASSERT_EQ(dc_loader_creator_get_binary_state(&storage_id, nullptr, 0, &required_size, &format_version), DIGITALCURLING_OK);
+    ASSERT_GT(required_size, 0u);
+
+    std::vector<std::uint8_t> buffer(required_size);
+    ASSERT_EQ(dc_loader_creator_get_binary_state(&storage_id, buffer.data(), buffer.size(), &required_size, &format_version), DIGITALCURLING_OK);
+    ASSERT_EQ(required_size, buffer.size());
+
+    // 3. storage2 に設定して sim2_id に Load
+    ASSERT_EQ(dc_loader_creator_set_binary_state(&storage2_id, buffer.data(), buffer.size(), format_version), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_simulator_load(&sim2_id, &storage2_id), DIGITALCURLING_OK);
+
+    DigitalCurling_StoneCoordinate stones_loaded;
+    ASSERT_EQ(dc_loader_simulator_get_stones(&sim2_id, &stones_loaded), DIGITALCURLING_OK);
+    ASSERT_NEAR(stones_loaded.stones[0].position.y, 10.f, 1e-6);
+    ASSERT_NEAR(stones_loaded.stones[0].translational_velocity.y, -1.f, 1e-6);
+
+    // 4. 不正なデータ
+    ASSERT_EQ(dc_loader_creator_set_binary_state(&storage2_id, buffer.data(), buffer.size(), format_version + 1), DIGITALCURLING_ERR_INVALID_DATA);
+    ASSERT_EQ(dc_loader_creator_set_binary_state(&storage2_id, buffer.data(), buffer.size() - 1, format_version), DIGITALCURLING_ERR_INVALID_DATA);
+    ASSERT_EQ(dc_loader_creator_get_binary_state(&sim_id, nullptr, 0, &required_size, &format_version), DIGITALCURLING_ERR_INSTANCE_NOT_FOUND);
+
+    // 5. クリーンアップ
+    ASSERT_EQ(dc_loader_remove_simulator_instance(&sim_id), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_remove_simulator_instance(&sim2_id), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_remove_simulator_instance(&factory_id), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_remove_simulator_instance(&storage_id), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_remove_simulator_instance(&storage2_id), DIGITALCURLING_OK);
+}
+
 TEST_F(PluginLoaderDynamic, Simulator_SimulateAndCollisions) {
     if (!IsSimPluginLoaded()) {
         GTEST_SKIP() << "Simulator plugin not loaded, skipping test.";
@@ -417,9 +612,251 @@ TEST_F(PluginLoaderDynamic, Simulator_SimulateAndCollisions) {
     ASSERT_TRUE(j.is_array());
     ASSERT_FALSE(j.empty());
 
-    // 6. クリーンアップ
+    // 6. 構造体の配列として取得し, JSON と一致するか検証
+    size_t collision_count = 0;
+    ASSERT_EQ(dc_loader_simulator_get_collisions(&simulator_id, nullptr, 0, &collision_count), DIGITALCURLING_OK);
+    ASSERT_EQ(collision_count, j.size());
+    std::vector<DigitalCurling_Collision> collisions(collision_count);
+    ASSERT_EQ(dc_loader_simulator_get_collisions(&simulator_id, collisions.data(), collisions.size(), &collision_count), DIGITALCURLING_OK);
+    ASSERT_EQ(collision_count, collisions.size());
+    for (size_t i = 0; i < collisions.size(); ++i) {
+        EXPECT_EQ(collisions[i].a.id, j[i]["a"]["id"].get<int>());
+        EXPECT_EQ(collisions[i].b.id, j[i]["b"]["id"].get<int>());
+        EXPECT_FLOAT_EQ(collisions[i].a.position.x, j[i]["a"]["stone"]["position"]["x"].get<float>());
+        EXPECT_FLOAT_EQ(collisions[i].normal_impulse, j[i]["normal_impulse"].get<float>());
+        EXPECT_FLOAT_EQ(collisions[i].tangent_impulse, j[i]["tangent_impulse"].get<float>());
+    }
+    ASSERT_EQ(dc_loader_simulator_get_collisions(&simulator_id, nullptr, 1, &collision_count), DIGITALCURLING_ERR_BUFFER_NULLPTR);
+
+    // 7. クリーンアップ
     ASSERT_EQ(dc_loader_remove_simulator_instance(&simulator_id), DIGITALCURLING_OK);
     ASSERT_EQ(dc_loader_remove_simulator_instance(&factory_id), DIGITALCURLING_OK);
 }
 
+TEST_F(PluginLoaderDynamic, Simulator_SimulateBatch) {
+    if (!IsSimPluginLoaded()) {
+        GTEST_SKIP() << "Simulator plugin not loaded, skipping test.";
+    }
+
+    DigitalCurling_Uuid factory_id, simulator_id;
+    ASSERT_EQ(dc_loader_create_simulator_factory(kSimPluginName, nullptr, &factory_id), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_create_simulator(&factory_id, &simulator_id), DIGITALCURLING_OK);
+
+    // 1. 盤面とショットを準備 (2つ目の盤面にはガードを置く)
+    std::vector<DigitalCurling_StoneCoordinate> stones(2, DigitalCurling_StoneCoordinate{});
+    stones[1].stones[8] = { {0.5f, 35.f}, 0.f, {0.f, 0.f}, 0.f };
+    std::vector<DigitalCurling_Shot> shots(2);
+    DigitalCurling_Vector2 tee = { coordinate::kTee.x, coordinate::kTee.y };
+    ASSERT_EQ(dc_loader_simulator_calculate_shot(&simulator_id, &tee, 0.f, 1.57f, &shots[0]), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_simulator_calculate_shot(&simulator_id, &tee, 0.f, -1.57f, &shots[1]), DIGITALCURLING_OK);
+
+    // 2. まとめてシミュレーション
+    std::vector<DigitalCurling_StoneCoordinate> results(2);
+    ASSERT_EQ(dc_loader_simulator_simulate_batch(&simulator_id, stones.data(), shots.data(), stones.size(), 0,
+        DIGITALCURLING_SIMULATE_MODE_FULL, 4.75f, results.data()), DIGITALCURLING_OK);
+
+    // 3. 1つずつシミュレーションした結果と一致するか確認
+    for (size_t i = 0; i < stones.size(); ++i) {
+        auto coordinate = stones[i];
+        coordinate.stones[0] = {
+            {0.f, 0.f}, 0.f,
+            {shots[i].translational_velocity * std::cos(shots[i].release_angle), shots[i].translational_velocity * std::sin(shots[i].release_angle)},
+            shots[i].angular_velocity
+        };
+        ASSERT_EQ(dc_loader_simulator_set_stones(&simulator_id, &coordinate), DIGITALCURLING_OK);
+        ASSERT_EQ(dc_loader_simulator_simulate(&simulator_id, DIGITALCURLING_SIMULATE_MODE_FULL, 4.75f), DIGITALCURLING_OK);
+        ASSERT_EQ(dc_loader_simulator_get_stones(&simulator_id, &coordinate), DIGITALCURLING_OK);
+        for (int s = 0; s < 16; ++s) {
+            EXPECT_FLOAT_EQ(coordinate.stones[s].position.x, results[i].stones[s].position.x);
+            EXPECT_FLOAT_EQ(coordinate.stones[s].position.y, results[i].stones[s].position.y);
+        }
+    }
+
+    // 4. 不正なインデックス
+    ASSERT_EQ(dc_loader_simulator_simulate_batch(&simulator_id, stones.data(), shots.data(), stones.size(), 16,
+        DIGITALCURLING_SIMULATE_MODE_FULL, 4.75f, results.data()), DIGITALCURLING_ERR_INVALID_ARGUMENT);
+
+    // 5. クリーンアップ
+    ASSERT_EQ(dc_loader_remove_simulator_instance(&simulator_id), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_remove_simulator_instance(&factory_id), DIGITALCURLING_OK);
+}
+
+TEST_F(PluginLoaderDynamic, Simulator_Stats) {
+    if (!IsSimPluginLoaded()) {
+        GTEST_SKIP() << "Simulator plugin not loaded, skipping test.";
+    }
+
+    auto get_stats = []() {
+        DigitalCurling_SnapshotHandle handle;
+        size_t snapshot_size = 0;
+        EXPECT_EQ(dc_loader_get_stats(&handle, &snapshot_size), DIGITALCURLING_OK);
+        std::string json_data = GetSnapshotData(handle);
+        EXPECT_EQ(json_data.size() + 1, snapshot_size);
+        return nlohmann::json::parse(json_data).at("simulators").at(kSimPluginName);
+    };
+
+    // 1. 他のテストの分を含む集計値を基準にする
+    auto const before_json = get_stats();
+    auto const before = before_json.get<simulators::SimulatorStats>();
+    auto const before_instances = before_json.at("instances").get<size_t>();
+
+    DigitalCurling_Uuid factory_id, simulator_id;
+    ASSERT_EQ(dc_loader_create_simulator_factory(kSimPluginName, nullptr, &factory_id), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_create_simulator(&factory_id, &simulator_id), DIGITALCURLING_OK);
+    EXPECT_EQ(get_stats().at("instances").get<size_t>(), before_instances + 1);
+
+    // 2. シートの外に出るストーンをシミュレーション
+    DigitalCurling_StoneCoordinate coordinate{};
+    coordinate.stones[0] = { {0.f, 1.f}, 0.f, {2.f, 1.f}, 0.f };
+    ASSERT_EQ(dc_loader_simulator_set_stones(&simulator_id, &coordinate), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_simulator_simulate(&simulator_id, DIGITALCURLING_SIMULATE_MODE_FULL, 4.75f), DIGITALCURLING_OK);
+
+    auto const running = get_stats().get<simulators::SimulatorStats>();
+    EXPECT_GT(running.frames, before.frames);
+    EXPECT_EQ(running.out_of_sheet_removals, before.out_of_sheet_removals + 1);
+    EXPECT_GE(running.set_stones_calls, before.set_stones_calls + 1);
+    EXPECT_GE(running.world_step_seconds, before.world_step_seconds);
+
+    // 3. 破棄したシミュレーターの値も集計に残る
+    ASSERT_EQ(dc_loader_remove_simulator_instance(&simulator_id), DIGITALCURLING_OK);
+    auto const after_json = get_stats();
+    EXPECT_EQ(after_json.at("instances").get<size_t>(), before_instances);
+    EXPECT_EQ(after_json.get<simulators::SimulatorStats>().frames, running.frames);
+
+    // 4. クリーンアップ
+    ASSERT_EQ(dc_loader_remove_simulator_instance(&factory_id), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_get_stats(nullptr, nullptr), DIGITALCURLING_ERR_BUFFER_NULLPTR);
+}
+
+TEST_F(PluginLoaderDynamic, Simulator_Trace) {
+    if (!IsSimPluginLoaded()) {
+        GTEST_SKIP() << "Simulator plugin not loaded, skipping test.";
+    }
+
+    auto const path = std::filesystem::temp_directory_path() / "digitalcurling_test_loader_trace.json";
+    auto read_events = [&path]() {
+        std::ifstream file(path);
+        auto json = nlohmann::json::parse(file);
+        file.close();
+        std::filesystem::remove(path);
+        return json.at("traceEvents");
+    };
+
+    DigitalCurling_Uuid factory_id, simulator_id;
+    ASSERT_EQ(dc_loader_create_simulator_factory(kSimPluginName, nullptr, &factory_id), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_create_simulator(&factory_id, &simulator_id), DIGITALCURLING_OK);
+    DigitalCurling_StoneCoordinate coordinate{};
+    coordinate.stones[0] = { {0.f, 1.f}, 0.f, {0.f, 1.f}, 0.f };
+
+    // 1. 記録中でない間の呼び出しは記録されない
+    ASSERT_EQ(dc_loader_simulator_set_stones(&simulator_id, &coordinate), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_trace_start(0), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_trace_stop(path.string().c_str()), DIGITALCURLING_OK);
+    EXPECT_TRUE(read_events().empty());
+
+    // 2. プラグイン関数の呼び出しが区間として記録される
+    ASSERT_EQ(dc_loader_trace_start(0), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_simulator_set_stones(&simulator_id, &coordinate), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_simulator_simulate(&simulator_id, DIGITALCURLING_SIMULATE_MODE_FULL, 4.75f), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_trace_stop(path.string().c_str()), DIGITALCURLING_OK);
+
+    std::set<std::string> names;
+    for (auto const& event : read_events()) {
+        if (event.at("ph").get<std::string>() != "X") continue;
+        EXPECT_GE(event.at("dur").get<double>(), 0.);
+        names.insert(event.at("name").get<std::string>());
+    }
+    EXPECT_EQ(names.count("set_stones"), 1u);
+    EXPECT_EQ(names.count("simulate"), 1u);
+    EXPECT_EQ(names.count("ResolveArgs"), 1u);
+    EXPECT_EQ(names.count("PluginCall"), 1u);
+
+    // 3. クリーンアップ
+    ASSERT_EQ(dc_loader_remove_simulator_instance(&simulator_id), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_remove_simulator_instance(&factory_id), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_trace_stop(nullptr), DIGITALCURLING_ERR_INVALID_ARGUMENT);
+}
+
+TEST_F(PluginLoaderDynamic, Simulator_Async) {
+    if (!IsSimPluginLoaded()) {
+        GTEST_SKIP() << "Simulator plugin not loaded, skipping test.";
+    }
+
+    ASSERT_EQ(dc_loader_set_worker_count(2), DIGITALCURLING_OK);
+    size_t worker_count = 0;
+    ASSERT_EQ(dc_loader_get_worker_count(&worker_count), DIGITALCURLING_OK);
+    ASSERT_EQ(worker_count, 2u);
+
+    DigitalCurling_Uuid factory_id, sim1_id, sim2_id;
+    ASSERT_EQ(dc_loader_create_simulator_factory(kSimPluginName, nullptr, &factory_id), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_create_simulator(&factory_id, &sim1_id), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_create_simulator(&factory_id, &sim2_id), DIGITALCURLING_OK);
+
+    // 1. 盤面とショットを準備
+    std::vector<DigitalCurling_StoneCoordinate> stones(2, DigitalCurling_StoneCoordinate{});
+    stones[1].stones[8] = { {0.5f, 35.f}, 0.f, {0.f, 0.f}, 0.f };
+    std::vector<DigitalCurling_Shot> shots(2);
+    DigitalCurling_Vector2 tee = { coordinate::kTee.x, coordinate::kTee.y };
+    ASSERT_EQ(dc_loader_simulator_calculate_shot(&sim1_id, &tee, 0.f, 1.57f, &shots[0]), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_simulator_calculate_shot(&sim1_id, &tee, 0.f, -1.57f, &shots[1]), DIGITALCURLING_OK);
+
+    std::vector<DigitalCurling_StoneCoordinate> expected(2);
+    ASSERT_EQ(dc_loader_simulator_simulate_batch(&sim1_id, stones.data(), shots.data(), stones.size(), 0,
+        DIGITALCURLING_SIMULATE_MODE_FULL, 4.75f, expected.data()), DIGITALCURLING_OK);
+
+    // 2. 異なるシミュレーターで並行して実行し, 同期版と結果が一致するか確認
+    std::vector<DigitalCurling_StoneCoordinate> results1(2), results2(2);
+    DigitalCurling_AsyncJobHandle jobs[2];
+    ASSERT_EQ(dc_loader_simulator_simulate_batch_async(&sim1_id, stones.data(), shots.data(), stones.size(), 0,
+        DIGITALCURLING_SIMULATE_MODE_FULL, 4.75f, results1.data(), &jobs[0]), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_simulator_simulate_batch_async(&sim2_id, stones.data(), shots.data(), stones.size(), 0,
+        DIGITALCURLING_SIMULATE_MODE_FULL, 4.75f, results2.data(), &jobs[1]), DIGITALCURLING_OK);
+
+    size_t index = 2;
+    ASSERT_EQ(dc_loader_async_wait_any(jobs, 2, -1, &index), DIGITALCURLING_OK);
+    ASSERT_LT(index, 2u);
+    bool completed = false;
+    ASSERT_EQ(dc_loader_async_poll(jobs[index], &completed), DIGITALCURLING_OK);
+    ASSERT_TRUE(completed);
+
+    for (auto job : jobs) {
+        ASSERT_EQ(dc_loader_async_wait(job, -1, &completed), DIGITALCURLING_OK);
+        ASSERT_TRUE(completed);
+        DigitalCurling_ErrorCode result = DIGITALCURLING_ERR_UNKNOWN;
+        ASSERT_EQ(dc_loader_async_get_result(job, &result, nullptr, 0, nullptr), DIGITALCURLING_OK);
+        ASSERT_EQ(result, DIGITALCURLING_OK);
+        ASSERT_EQ(dc_loader_destroy_async_job(job), DIGITALCURLING_OK);
+    }
+    for (size_t i = 0; i < stones.size(); ++i) {
+        for (int s = 0; s < 16; ++s) {
+            EXPECT_FLOAT_EQ(expected[i].stones[s].position.x, results1[i].stones[s].position.x);
+            EXPECT_FLOAT_EQ(expected[i].stones[s].position.y, results1[i].stones[s].position.y);
+            EXPECT_FLOAT_EQ(expected[i].stones[s].position.x, results2[i].stones[s].position.x);
+            EXPECT_FLOAT_EQ(expected[i].stones[s].position.y, results2[i].stones[s].position.y);
+        }
+    }
+    ASSERT_EQ(dc_loader_async_poll(jobs[0], &completed), DIGITALCURLING_ERR_INSTANCE_NOT_FOUND);
+
+    // 3. エラーはジョブごとに保持され, 呼び出し元スレッドの最後のエラーメッセージは変わらない
+    ASSERT_EQ(dc_loader_remove_simulator_instance(&sim2_id), DIGITALCURLING_OK);
+    DigitalCurling_AsyncJobHandle failed_job;
+    ASSERT_EQ(dc_loader_simulator_simulate_async(&sim2_id, DIGITALCURLING_SIMULATE_MODE_FULL, 4.75f, &failed_job), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_async_wait(failed_job, -1, &completed), DIGITALCURLING_OK);
+    ASSERT_TRUE(completed);
+
+    DigitalCurling_ErrorCode result = DIGITALCURLING_OK;
+    size_t required_size = 0;
+    ASSERT_EQ(dc_loader_async_get_result(failed_job, &result, nullptr, 0, &required_size), DIGITALCURLING_OK);
+    ASSERT_EQ(result, DIGITALCURLING_ERR_INSTANCE_NOT_FOUND);
+    ASSERT_GT(required_size, 1u);
+    std::string message(required_size, '\0');
+    ASSERT_EQ(dc_loader_async_get_result(failed_job, &result, message.data(), message.size(), &required_size), DIGITALCURLING_OK);
+    ASSERT_NE(message.find("not found"), std::string::npos);
+    ASSERT_EQ(dc_loader_destroy_async_job(failed_job), DIGITALCURLING_OK);
+
+    // 4. クリーンアップ
+    ASSERT_EQ(dc_loader_remove_simulator_instance(&sim1_id), DIGITALCURLING_OK);
+    ASSERT_EQ(dc_loader_remove_simulator_instance(&factory_id), DIGITALCURLING_OK);
+}
+
 } // namespace
@@ -1,10 +1,16 @@
+#include <chrono>
+#include <cstdlib>
 #include <filesystem>
+#include <future>
 #include <memory>
 #include <optional>
 #include <stdexcept>
 #include <string>
 #include <vector>
 #include <nlohmann/json.hpp>
+#ifdef __linux__
+#include <signal.h>
+#endif
 
 #include "digitalcurling/common.hpp"
 #include "digitalcurling/plugins/plugin_manager.hpp"
@@ -75,6 +81,38 @@ TEST_F(PluginManagerDynamic, LoadNonExistentPlugin_ExceptionFalse) {
     ASSERT_FALSE(result.has_value());
 }
 
+TEST_F(PluginManagerDynamic, LoadPluginDirectory) {
+    if (!IsSimPluginLoaded()) {
+        GTEST_SKIP() << "Simulator plugin not loaded, skipping test.";
+    }
+
+    auto plugin_dir = std::filesystem::path(simulator_plugin_path_).parent_path();
+    auto manifest_path = std::filesystem::temp_directory_path() / ("digitalcurling_test_" + PluginManifestFileName);
+    std::filesystem::remove(manifest_path);
+
+    auto contains_sim = [](std::vector<PluginId> const& ids) {
+        for (auto const& id : ids) if (id.type == PluginType::simulator && id.name == kSimPluginName) return true;
+        return false;
+    };
+
+    // 1回目はマニフェストを生成し, 2回目はマニフェストから登録する
+    std::vector<PluginId> ids;
+    ASSERT_NO_THROW(ids = manager_->LoadPluginDirectory(plugin_dir, manifest_path));
+    EXPECT_TRUE(contains_sim(ids));
+    ASSERT_TRUE(std::filesystem::exists(manifest_path));
+
+    ASSERT_NO_THROW(ids = manager_->LoadPluginDirectory(plugin_dir, manifest_path));
+    EXPECT_TRUE(contains_sim(ids));
+    EXPECT_TRUE(manager_->IsPluginLoaded(PluginType::simulator, kSimPluginName));
+    EXPECT_NE(manager_->CreateSimulatorFactory(std::string(kSimPluginName)), nullptr);
+
+    std::filesystem::remove(manifest_path);
+}
+
+TEST_F(PluginManagerDynamic, LoadPluginDirectory_NonExistent) {
+    EXPECT_THROW(manager_->LoadPluginDirectory("non_existent_plugin_directory"), plugin_error);
+}
+
 TEST_F(PluginManagerDynamic, Player_Lifecycle) {
     if (!IsPlayerPluginLoaded()) {
         GTEST_SKIP() << "Player plugin not loaded, skipping test.";
@@ -229,6 +267,51 @@ TEST_F(PluginManagerDynamic, Simulator_StepAndGetStones) {
     ASSERT_NE(stones_after_step[0]->translational_velocity.y, -1.f);
 }
 
+TEST_F(PluginManagerDynamic, Simulator_SingleThreadedMode) {
+    if (!IsSimPluginLoaded()) {
+        GTEST_SKIP() << "Simulator plugin not loaded, skipping test.";
+    }
+
+    auto factory = manager_->CreateSimulatorFactory(std::string(kSimPluginName));
+    auto simulator = factory->CreateSimulator();
+    auto simulator_st = factory->CreateSimulator();
+    auto* plugin_sim_st = dynamic_cast<simulators::PluginSimulator*>(simulator_st.get());
+    ASSERT_NE(plugin_sim_st, nullptr);
+    ASSERT_FALSE(plugin_sim_st->IsSingleThreadedMode());
+    plugin_sim_st->SetSingleThreadedMode(true);
+    ASSERT_TRUE(plugin_sim_st->IsSingleThreadedMode());
+
+    // 同じ操作をした結果がロックの有無によらず一致するか確認
+    simulators::ISimulator::AllStones stones_to_set;
+    stones_to_set[0] = simulators::ISimulator::StoneState{ {0.f, 10.f}, 0.f, {0.f, -1.f}, 0.f };
+    ASSERT_NO_THROW(simulator->SetStones(stones_to_set));
+    ASSERT_NO_THROW(simulator_st->SetStones(stones_to_set));
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_NO_THROW(simulator->Step());
+        ASSERT_NO_THROW(simulator_st->Step());
+    }
+
+    auto const& stones = simulator->GetStones();
+    auto const& stones_st = simulator_st->GetStones();
+    ASSERT_TRUE(stones_st[0].has_value());
+    ASSERT_EQ(stones[0]->position.y, stones_st[0]->position.y);
+    ASSERT_EQ(stones[0]->translational_velocity.y, stones_st[0]->translational_velocity.y);
+    ASSERT_EQ(simulator->AreAllStonesStopped(), simulator_st->AreAllStonesStopped());
+}
+
+TEST_F(PluginManagerDynamic, Simulator_Native) {
+    if (!IsSimPluginLoaded()) {
+        GTEST_SKIP() << "Simulator plugin not loaded, skipping test.";
+    }
+
+    // 動的にロードしたプラグインの実体は取得できない
+    auto factory = manager_->CreateSimulatorFactory(std::string(kSimPluginName));
+    auto simulator = factory->CreateSimulator();
+    auto* plugin_sim = dynamic_cast<simulators::PluginSimulator*>(simulator.get());
+    ASSERT_NE(plugin_sim, nullptr);
+    ASSERT_EQ(plugin_sim->GetNative(), nullptr);
+}
+
 TEST_F(PluginManagerDynamic, Simulator_SimulateAndGetCollisions) {
     if (!IsSimPluginLoaded()) {
         GTEST_SKIP() << "Simulator plugin not loaded, skipping test.";
@@ -268,4 +351,101 @@ TEST_F(PluginManagerDynamic, Simulator_SimulateAndGetCollisions) {
     ASSERT_FALSE(collisions.empty());
 }
 
+#ifdef __linux__
+TEST_F(PluginManagerDynamic, IsolatedPool_SimulateBatch) {
+    if (!IsSimPluginLoaded()) {
+        GTEST_SKIP() << "Simulator plugin not loaded, skipping test.";
+    }
+
+    std::unique_ptr<IsolatedPluginPool> pool;
+    ASSERT_NO_THROW(pool = manager_->CreateIsolatedPool(simulator_plugin_path_, std::nullopt, 2));
+    EXPECT_EQ(pool->GetType(), PluginType::simulator);
+    EXPECT_EQ(pool->GetName(), kSimPluginName);
+    EXPECT_EQ(pool->GetWorkerCount(), 2u);
+    EXPECT_EQ(pool->GetRestartCount(), 0u);
+
+    std::vector<simulators::ISimulator::AllStones> stones(100);
+    std::vector<moves::Shot> shots;
+    for (std::size_t i = 0; i < stones.size(); ++i)
+        shots.emplace_back(2.2f + 0.005f * i, 1.57f, 0.05f);
+
+    // 同じプロセス内で実行した場合と結果が一致する
+    auto factory = manager_->CreateSimulatorFactory(std::string(kSimPluginName));
+    auto simulator = factory->CreateSimulator();
+    auto* plugin_sim = dynamic_cast<simulators::PluginSimulator*>(simulator.get());
+    ASSERT_NE(plugin_sim, nullptr);
+    auto expected = plugin_sim->SimulateBatch(stones, shots, 0, simulators::SimulateModeFlag::Full, 4.75f);
+
+    std::vector<simulators::ISimulator::AllStones> actual;
+    ASSERT_NO_THROW(actual = pool->SimulateBatch(stones, shots, 0, simulators::SimulateModeFlag::Full, 4.75f));
+    ASSERT_EQ(actual.size(), expected.size());
+    for (std::size_t i = 0; i < actual.size(); ++i) {
+        ASSERT_EQ(actual[i][0].has_value(), expected[i][0].has_value());
+        if (!actual[i][0]) continue;
+        EXPECT_EQ(actual[i][0]->position.x, expected[i][0]->position.x);
+        EXPECT_EQ(actual[i][0]->position.y, expected[i][0]->position.y);
+    }
+
+    EXPECT_THROW(pool->SimulateBatch(stones, { shots[0] }, 0, simulators::SimulateModeFlag::Full, 4.75f), std::invalid_argument);
+    EXPECT_THROW(pool->PlayBatch(shots), plugin_error);
+}
+
+TEST_F(PluginManagerDynamic, IsolatedPool_RestartOnCrash) {
+    if (!IsSimPluginLoaded()) {
+        GTEST_SKIP() << "Simulator plugin not loaded, skipping test.";
+    }
+
+    auto pool = manager_->CreateIsolatedPool(simulator_plugin_path_, std::nullopt, 2);
+    auto pids = pool->GetWorkerProcessIds();
+    ASSERT_EQ(pids.size(), 2u);
+    ASSERT_GT(pids[0], 0);
+
+    // ワーカーが終了しても一括処理は成功し, ワーカーは再起動される
+    ASSERT_EQ(kill(pids[0], SIGKILL), 0);
+    std::vector<simulators::ISimulator::AllStones> stones(50);
+    std::vector<moves::Shot> shots(stones.size(), moves::Shot(2.3f, 1.57f, 0.05f));
+    std::vector<simulators::ISimulator::AllStones> results;
+    ASSERT_NO_THROW(results = pool->SimulateBatch(stones, shots, 0, simulators::SimulateModeFlag::Full, 4.75f));
+    EXPECT_EQ(results.size(), stones.size());
+    EXPECT_EQ(pool->GetRestartCount(), 1u);
+    EXPECT_NE(pool->GetWorkerProcessIds()[0], pids[0]);
+}
+
+TEST_F(PluginManagerDynamic, IsolatedPool_StatusDuringBatch) {
+    if (!IsSimPluginLoaded()) {
+        GTEST_SKIP() << "Simulator plugin not loaded, skipping test.";
+    }
+
+    auto pool = manager_->CreateIsolatedPool(simulator_plugin_path_, std::nullopt, 2);
+    auto const pids = pool->GetWorkerProcessIds();
+
+    // 一括処理の実行中もワーカーの情報を取得できる
+    std::vector<simulators::ISimulator::AllStones> stones(2000);
+    std::vector<moves::Shot> shots(stones.size(), moves::Shot(2.3f, 1.57f, 0.05f));
+    auto batch = std::async(std::launch::async, [&]() {
+        return pool->SimulateBatch(stones, shots, 0, simulators::SimulateModeFlag::Full, 4.75f);
+    });
+    do {
+        EXPECT_EQ(pool->GetWorkerProcessIds(), pids);
+        EXPECT_EQ(pool->GetRestartCount(), 0u);
+    } while (batch.wait_for(std::chrono::milliseconds(1)) != std::future_status::ready);
+    EXPECT_EQ(batch.get().size(), stones.size());
+}
+
+TEST_F(PluginManagerDynamic, IsolatedPool_WorkerExecutableNotFound) {
+    if (!IsSimPluginLoaded()) {
+        GTEST_SKIP() << "Simulator plugin not loaded, skipping test.";
+    }
+
+    // 環境変数で指定した実行ファイルが起動できない場合は失敗する
+    ASSERT_EQ(setenv("DIGITALCURLING_PLUGIN_WORKER", "non_existent_worker", 1), 0);
+    EXPECT_THROW(manager_->CreateIsolatedPool(simulator_plugin_path_, std::nullopt, 1), plugin_error);
+    ASSERT_EQ(unsetenv("DIGITALCURLING_PLUGIN_WORKER"), 0);
+}
+
+TEST_F(PluginManagerDynamic, IsolatedPool_NonExistentPlugin) {
+    EXPECT_THROW(manager_->CreateIsolatedPool("non_existent_plugin" + LibraryExtension, std::nullopt, 1), plugin_error);
+}
+#endif // __linux__
+
 } // namespace
@@ -209,6 +209,91 @@ TEST_F(PluginManagerStatic, Simulator_StepAndGetStones) {
     ASSERT_NE(stones_after_step[0]->translational_velocity.y, -1.f);
 }
 
+TEST_F(PluginManagerStatic, Simulator_SingleThreadedMode) {
+    if (!IsSimPluginLoaded()) {
+        GTEST_SKIP() << "Simulator plugin not loaded, skipping test.";
+    }
+
+    auto factory = manager_->CreateSimulatorFactory(std::string(kSimPluginName));
+    auto simulator = factory->CreateSimulator();
+    auto simulator_st = factory->CreateSimulator();
+    auto* plugin_sim_st = dynamic_cast<simulators::PluginSimulator*>(simulator_st.get());
+    ASSERT_NE(plugin_sim_st, nullptr);
+    ASSERT_FALSE(plugin_sim_st->IsSingleThreadedMode());
+    plugin_sim_st->SetSingleThreadedMode(true);
+    ASSERT_TRUE(plugin_sim_st->IsSingleThreadedMode());
+
+    // 同じ操作をした結果がロックの有無によらず一致するか確認
+    simulators::ISimulator::AllStones stones_to_set;
+    stones_to_set[0] = simulators::ISimulator::StoneState{ {0.f, 10.f}, 0.f, {0.f, -1.f}, 0.f };
+    ASSERT_NO_THROW(simulator->SetStones(stones_to_set));
+    ASSERT_NO_THROW(simulator_st->SetStones(stones_to_set));
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_NO_THROW(simulator->Step());
+        ASSERT_NO_THROW(simulator_st->Step());
+    }
+
+    auto const& stones = simulator->GetStones();
+    auto const& stones_st = simulator_st->GetStones();
+    ASSERT_TRUE(stones_st[0].has_value());
+    ASSERT_EQ(stones[0]->position.y, stones_st[0]->position.y);
+    ASSERT_EQ(stones[0]->translational_velocity.y, stones_st[0]->translational_velocity.y);
+    ASSERT_EQ(simulator->AreAllStonesStopped(), simulator_st->AreAllStonesStopped());
+}
+
+TEST_F(PluginManagerStatic, Simulator_Native) {
+    if (!IsSimPluginLoaded()) {
+        GTEST_SKIP() << "Simulator plugin not loaded, skipping test.";
+    }
+
+    auto factory = manager_->CreateSimulatorFactory(std::string(kSimPluginName));
+    auto simulator = factory->CreateSimulator();
+    auto simulator_native = factory->CreateSimulator();
+    auto* plugin_sim = dynamic_cast<simulators::PluginSimulator*>(simulator_native.get());
+    ASSERT_NE(plugin_sim, nullptr);
+
+    simulators::ISimulator* native = plugin_sim->GetNative();
+    ASSERT_NE(native, nullptr);
+    ASSERT_EQ(native->GetSimulatorId(), kSimPluginName);
+
+    // C ABI 経由と直接呼び出しで結果が一致するか確認
+    simulators::ISimulator::AllStones stones_to_set;
+    stones_to_set[0] = simulators::ISimulator::StoneState{ {0.f, 10.f}, 0.f, {0.f, -1.f}, 0.f };
+    ASSERT_NO_THROW(simulator->SetStones(stones_to_set));
+    ASSERT_NO_THROW(native->SetStones(stones_to_set));
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_NO_THROW(simulator->Step());
+        ASSERT_NO_THROW(native->Step());
+    }
+
+    auto const& stones = simulator->GetStones();
+    auto const& stones_native = native->GetStones();
+    ASSERT_TRUE(stones_native[0].has_value());
+    ASSERT_EQ(stones[0]->position.y, stones_native[0]->position.y);
+    ASSERT_EQ(stones[0]->translational_velocity.y, stones_native[0]->translational_velocity.y);
+}
+
+TEST_F(PluginManagerStatic, Player_Native) {
+    if (!IsPlayerPluginLoaded()) {
+        GTEST_SKIP() << "Player plugin not loaded, skipping test.";
+    }
+
+    auto factory = manager_->CreatePlayerFactory(std::string(kPlayerPluginName));
+    auto player = factory->CreatePlayer();
+    auto* plugin_player = dynamic_cast<players::PluginPlayer*>(player.get());
+    ASSERT_NE(plugin_player, nullptr);
+
+    players::IPlayer* native = plugin_player->GetNative();
+    ASSERT_NE(native, nullptr);
+
+    moves::Shot const shot{ 2.5f, 1.57f, 0.1f };
+    auto const expected = player->Play(shot);
+    auto const actual = native->Play(shot);
+    ASSERT_EQ(expected.translational_velocity, actual.translational_velocity);
+    ASSERT_EQ(expected.angular_velocity, actual.angular_velocity);
+    ASSERT_EQ(expected.release_angle, actual.release_angle);
+}
+
 TEST_F(PluginManagerStatic, Simulator_Actions_Extended) {
     if (!IsSimPluginLoaded()) {
         GTEST_SKIP() << "Simulator plugin not loaded, skipping test.";
@@ -0,0 +1,237 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+// シミュレーター FCV1 のベンチマーク
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "digitalcurling/digitalcurling.hpp"
+#include "../src/fcv1/simulator_fcv1.hpp"
+#include "digitalcurling/simulators/fcv1_differentiable.hpp"
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    #include <malloc.h>
+    #define DIGITALCURLING_BENCH_HAS_MALLINFO2
+#endif
+
+namespace {
+
+using namespace digitalcurling;
+using namespace digitalcurling::simulators;
+
+// 動いているストーンを `moving` 個配置する (互いに衝突しない間隔で並べる)
+ISimulator::AllStones MakeMovingStones(std::size_t moving)
+{
+    ISimulator::AllStones stones;
+    for (std::size_t i = 0; i < moving; ++i) {
+        auto const x = -2.1f + 0.3f * static_cast<float>(i);
+        stones[i] = ISimulator::StoneState(Vector2(x, 10.f), 0.f, Vector2(0.f, 2.5f), i % 2 == 0 ? 1.57f : -1.57f);
+    }
+    return stones;
+}
+
+// ショットのストーンを原点から投げた盤面を作成する
+ISimulator::AllStones MakeShotStones(ISimulator::AllStones stones, std::size_t index, moves::Shot const& shot)
+{
+    stones[index] = ISimulator::StoneState(Vector2(), 0.f, shot.ToVector2(), shot.angular_velocity);
+    return stones;
+}
+
+// 全てのストーンが停止するまでシミュレーションする
+void RunUntilStopped(ISimulator& simulator)
+{
+    while (!simulator.AreAllStonesStopped()) simulator.Step();
+}
+
+// 1フレームあたりの時間を計測する (一定のフレーム数ごとに盤面を再設定する)
+void BM_FCV1Step(benchmark::State& bm)
+{
+    SimulatorFCV1Factory factory;
+    SimulatorFCV1 simulator(factory);
+    auto const stones = MakeMovingStones(static_cast<std::size_t>(bm.range(0)));
+    constexpr int kFramesPerReset = 500;
+
+    simulator.SetStones(stones);
+    int frame = 0;
+    for (auto _ : bm) {
+        if (++frame == kFramesPerReset) {
+            bm.PauseTiming();
+            simulator.SetStones(stones);
+            frame = 0;
+            bm.ResumeTiming();
+        }
+        simulator.Step();
+    }
+    bm.SetItemsProcessed(bm.iterations());
+}
+BENCHMARK(BM_FCV1Step)->Arg(1)->Arg(4)->Arg(16);
+
+// ティーへのドローショットを停止するまでシミュレーションする
+void BM_FCV1FullDraw(benchmark::State& bm)
+{
+    SimulatorFCV1Factory factory;
+    SimulatorFCV1 simulator(factory);
+    auto const shot = simulator.CalculateShot(coordinate::kTee, 0.f, 1.57f);
+    auto const stones = MakeShotStones(ISimulator::AllStones(), 0, shot);
+
+    for (auto _ : bm) {
+        simulator.SetStones(stones);
+        RunUntilStopped(simulator);
+        benchmark::DoNotOptimize(simulator.GetStones());
+    }
+}
+BENCHMARK(BM_FCV1FullDraw)->Unit(benchmark::kMicrosecond);
+
+// ティーのストーンをテイクアウトするショットを停止するまでシミュレーションする
+void BM_FCV1FullTakeout(benchmark::State& bm)
+{
+    SimulatorFCV1Factory factory;
+    SimulatorFCV1 simulator(factory);
+    auto const shot = simulator.CalculateShot(coordinate::kTee, 3.f, 1.57f);
+    ISimulator::AllStones target;
+    target[8] = ISimulator::StoneState(coordinate::kTee, 0.f, Vector2(), 0.f);
+    auto const stones = MakeShotStones(target, 0, shot);
+
+    for (auto _ : bm) {
+        simulator.SetStones(stones);
+        RunUntilStopped(simulator);
+        benchmark::DoNotOptimize(simulator.GetStones());
+    }
+}
+BENCHMARK(BM_FCV1FullTakeout)->Unit(benchmark::kMicrosecond);
+
+// 経路から離れたガードがある盤面でドローショットを停止するまでシミュレーションする
+// Arg(1) は衝突のない経路の高速化を有効にする
+void BM_FCV1FullDrawPastGuard(benchmark::State& bm)
+{
+    SimulatorFCV1Factory factory;
+    factory.fast_path = bm.range(0) != 0;
+    SimulatorFCV1 simulator(factory);
+    auto const shot = simulator.CalculateShot(coordinate::kTee, 0.f, 1.57f);
+    ISimulator::AllStones guards;
+    guards[1] = ISimulator::StoneState(Vector2(-1.9f, 30.f), 0.f, Vector2(), 0.f);
+    guards[3] = ISimulator::StoneState(Vector2(1.9f, 34.f), 0.f, Vector2(), 0.f);
+    auto const stones = MakeShotStones(guards, 0, shot);
+
+    for (auto _ : bm) {
+        simulator.SetStones(stones);
+        RunUntilStopped(simulator);
+        benchmark::DoNotOptimize(simulator.GetStones());
+    }
+    bm.counters["fast_path_shots"] = static_cast<double>(simulator.GetStats().fast_path_shots);
+}
+BENCHMARK(BM_FCV1FullDrawPastGuard)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+// ティーのストーンをテイクアウトするショットの結果と, ショットのパラメーターに対するヤコビ行列を求める
+// 有限差分で求める場合は, BM_FCV1FullTakeout の (入力の数 + 1) 倍のシミュレーションが必要になる
+void BM_FCV1ShotJacobian(benchmark::State& bm)
+{
+    SimulatorFCV1Factory factory;
+    SimulatorFCV1 simulator(factory);
+    auto const shot = simulator.CalculateShot(coordinate::kTee, 3.f, 1.57f);
+    ISimulator::AllStones target;
+    target[8] = ISimulator::StoneState(coordinate::kTee, 0.f, Vector2(), 0.f);
+
+    for (auto _ : bm) {
+        auto result = ComputeFCV1ShotJacobian(target, shot, 0, 4.75f);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_FCV1ShotJacobian)->Unit(benchmark::kMicrosecond);
+
+// 目標地点と速度からショットを逆算する
+void BM_FCV1CalculateShot(benchmark::State& bm)
+{
+    SimulatorFCV1Factory factory;
+    SimulatorFCV1 simulator(factory);
+    for (auto _ : bm) {
+        auto shot = simulator.CalculateShot(coordinate::kTee, 0.f, 1.57f);
+        benchmark::DoNotOptimize(shot);
+    }
+}
+BENCHMARK(BM_FCV1CalculateShot)->Unit(benchmark::kMicrosecond);
+
+void BM_FCV1CreateStorage(benchmark::State& bm)
+{
+    SimulatorFCV1Factory factory;
+    SimulatorFCV1 simulator(factory);
+    simulator.SetStones(MakeMovingStones(16));
+    for (auto _ : bm) {
+        auto storage = simulator.CreateStorage();
+        benchmark::DoNotOptimize(storage);
+    }
+}
+BENCHMARK(BM_FCV1CreateStorage);
+
+void BM_FCV1Save(benchmark::State& bm)
+{
+    SimulatorFCV1Factory factory;
+    SimulatorFCV1 simulator(factory);
+    simulator.SetStones(MakeMovingStones(16));
+    auto storage = simulator.CreateStorage();
+    for (auto _ : bm) {
+        simulator.Save(*storage);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_FCV1Save);
+
+void BM_FCV1Load(benchmark::State& bm)
+{
+    SimulatorFCV1Factory factory;
+    SimulatorFCV1 simulator(factory);
+    simulator.SetStones(MakeMovingStones(16));
+    auto const storage = simulator.CreateStorage();
+    for (auto _ : bm) {
+        simulator.Load(*storage);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_FCV1Load);
+
+#ifdef DIGITALCURLING_BENCH_HAS_MALLINFO2
+// 使用中のヒープのバイト数 (mmap で確保された大きな領域を含む)
+std::size_t HeapInUse()
+{
+    auto const info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+#endif
+
+// 1ステップ進めた後に停止させたシミュレーターが保持するヒープのバイト数 (Arg: 0 通常モード, 1 コンパクトモード)
+// スレッドごとに共有されるエンジンの分は含まない
+void BM_FCV1InstanceFootprint(benchmark::State& bm)
+{
+#ifdef DIGITALCURLING_BENCH_HAS_MALLINFO2
+    constexpr std::size_t kInstances = 1000;
+    SimulatorFCV1Factory factory;
+    factory.compact = bm.range(0) != 0;
+    auto const stones = MakeMovingStones(16);
+    // 共有されるエンジンを計測の前に作成しておく
+    factory.CreateSimulator()->Step();
+
+    double bytes_per_instance = 0.;
+    for (auto _ : bm) {
+        std::vector<std::unique_ptr<ISimulator>> simulators;
+        simulators.reserve(kInstances);
+        auto const before = HeapInUse();
+        for (std::size_t i = 0; i < kInstances; ++i) {
+            auto simulator = factory.CreateSimulator();
+            simulator->SetStones(stones);
+            simulator->Step();
+            simulators.push_back(std::move(simulator));
+        }
+        auto const after = HeapInUse();
+        bytes_per_instance = static_cast<double>(after - before) / static_cast<double>(kInstances);
+    }
+    bm.counters["bytes_per_instance"] = bytes_per_instance;
+#else
+    bm.SkipWithError("heap statistics (mallinfo2) are not available on this platform");
+#endif
+}
+BENCHMARK(BM_FCV1InstanceFootprint)->Arg(0)->Arg(1)->Iterations(1)->Unit(benchmark::kMillisecond);
+
+} // unnamed namespace
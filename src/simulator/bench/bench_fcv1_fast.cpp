@@ -0,0 +1,68 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+// シミュレーター FCV1 Fast のベンチマーク
+
+#include <benchmark/benchmark.h>
+#include "digitalcurling/digitalcurling.hpp"
+#include "../src/fcv1_fast/simulator_fcv1_fast.hpp"
+
+namespace {
+
+using namespace digitalcurling;
+using namespace digitalcurling::simulators;
+
+// 全てのストーンが停止するまでシミュレーションする
+void RunUntilStopped(ISimulator& simulator)
+{
+    while (!simulator.AreAllStonesStopped()) simulator.Step();
+}
+
+// ティーへのドローショットを停止するまでシミュレーションする (BM_FCV1FullDraw と比較する)
+void BM_FCV1FastFullDraw(benchmark::State& bm)
+{
+    SimulatorFCV1FastFactory factory;
+    SimulatorFCV1Fast simulator(factory);
+    auto const shot = simulator.CalculateShot(coordinate::kTee, 0.f, 1.57f);
+    ISimulator::AllStones stones;
+    stones[0] = ISimulator::StoneState(Vector2(), 0.f, shot.ToVector2(), shot.angular_velocity);
+
+    for (auto _ : bm) {
+        simulator.SetStones(stones);
+        RunUntilStopped(simulator);
+        benchmark::DoNotOptimize(simulator.GetStones());
+    }
+}
+BENCHMARK(BM_FCV1FastFullDraw)->Unit(benchmark::kMicrosecond);
+
+// ティーのストーンをテイクアウトするショットを停止するまでシミュレーションする (BM_FCV1FullTakeout と比較する)
+void BM_FCV1FastFullTakeout(benchmark::State& bm)
+{
+    SimulatorFCV1FastFactory factory;
+    SimulatorFCV1Fast simulator(factory);
+    auto const shot = simulator.CalculateShot(coordinate::kTee, 3.f, 1.57f);
+    ISimulator::AllStones stones;
+    stones[0] = ISimulator::StoneState(Vector2(), 0.f, shot.ToVector2(), shot.angular_velocity);
+    stones[8] = ISimulator::StoneState(coordinate::kTee, 0.f, Vector2(), 0.f);
+
+    for (auto _ : bm) {
+        simulator.SetStones(stones);
+        RunUntilStopped(simulator);
+        benchmark::DoNotOptimize(simulator.GetStones());
+    }
+}
+BENCHMARK(BM_FCV1FastFullTakeout)->Unit(benchmark::kMicrosecond);
+
+// 目標地点と速度からショットを逆算する
+void BM_FCV1FastCalculateShot(benchmark::State& bm)
+{
+    SimulatorFCV1FastFactory factory;
+    SimulatorFCV1Fast simulator(factory);
+    for (auto _ : bm) {
+        auto shot = simulator.CalculateShot(coordinate::kTee, 0.f, 1.57f);
+        benchmark::DoNotOptimize(shot);
+    }
+}
+BENCHMARK(BM_FCV1FastCalculateShot)->Unit(benchmark::kMicrosecond);
+
+} // unnamed namespace
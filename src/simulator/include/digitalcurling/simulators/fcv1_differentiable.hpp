@@ -0,0 +1,475 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// @brief FCV1DifferentiableModel を定義
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include "digitalcurling/coordinate.hpp"
+#include "digitalcurling/stone.hpp"
+#include "digitalcurling/stone_coordinate.hpp"
+#include "digitalcurling/vector2.hpp"
+#include "digitalcurling/moves/shot.hpp"
+#include "digitalcurling/simulators/i_simulator.hpp"
+#include "digitalcurling/simulators/fcv1_motion.hpp"
+
+namespace digitalcurling::simulators {
+
+
+/// @brief 前進モード自動微分の双対数
+///
+/// 値と、`N` 個の入力それぞれに対する偏微分係数を保持します。
+/// 比較演算は値のみで行うため、分岐を含む計算では、分岐が変わらない範囲の偏微分係数が得られます。
+/// @tparam N 入力の数
+template <std::size_t N>
+struct Dual {
+    /// @brief 値
+    double value = 0.;
+    /// @brief 各入力に対する偏微分係数
+    std::array<double, N> derivatives{};
+
+    /// @brief 値0の定数を構築する
+    Dual() = default;
+    /// @brief 定数を構築する
+    /// @param[in] value 値
+    Dual(double value) : value(value) {}
+    /// @brief 入力を構築する
+    /// @param[in] value 値
+    /// @param[in] input 入力のインデックス (この入力に対する偏微分係数を 1 にする)
+    Dual(double value, std::size_t input) : value(value) { derivatives[input] = 1.; }
+
+    /// @cond Doxygen_Suppress
+    friend Dual operator + (Dual const& a) { return a; }
+    friend Dual operator - (Dual a)
+    {
+        a.value = -a.value;
+        for (auto & d : a.derivatives) d = -d;
+        return a;
+    }
+    friend Dual operator + (Dual a, Dual const& b)
+    {
+        a.value += b.value;
+        for (std::size_t i = 0; i < N; ++i) a.derivatives[i] += b.derivatives[i];
+        return a;
+    }
+    friend Dual operator - (Dual a, Dual const& b)
+    {
+        a.value -= b.value;
+        for (std::size_t i = 0; i < N; ++i) a.derivatives[i] -= b.derivatives[i];
+        return a;
+    }
+    friend Dual operator * (Dual const& a, Dual const& b)
+    {
+        Dual r(a.value * b.value);
+        for (std::size_t i = 0; i < N; ++i) r.derivatives[i] = a.derivatives[i] * b.value + a.value * b.derivatives[i];
+        return r;
+    }
+    friend Dual operator / (Dual const& a, Dual const& b)
+    {
+        Dual r(a.value / b.value);
+        for (std::size_t i = 0; i < N; ++i) r.derivatives[i] = (a.derivatives[i] - r.value * b.derivatives[i]) / b.value;
+        return r;
+    }
+    Dual & operator += (Dual const& b) { return *this = *this + b; }
+    Dual & operator -= (Dual const& b) { return *this = *this - b; }
+    Dual & operator *= (Dual const& b) { return *this = *this * b; }
+    Dual & operator /= (Dual const& b) { return *this = *this / b; }
+
+    friend bool operator < (Dual const& a, Dual const& b) { return a.value < b.value; }
+    friend bool operator > (Dual const& a, Dual const& b) { return a.value > b.value; }
+    friend bool operator <= (Dual const& a, Dual const& b) { return a.value <= b.value; }
+    friend bool operator >= (Dual const& a, Dual const& b) { return a.value >= b.value; }
+
+    friend Dual sqrt(Dual const& a) { return Chain(a, std::sqrt(a.value), 0.5 / std::sqrt(a.value)); }
+    friend Dual sin(Dual const& a) { return Chain(a, std::sin(a.value), std::cos(a.value)); }
+    friend Dual cos(Dual const& a) { return Chain(a, std::cos(a.value), -std::sin(a.value)); }
+    friend Dual abs(Dual const& a) { return a.value < 0. ? -a : a; }
+    friend Dual pow(Dual const& a, double exponent)
+    {
+        return Chain(a, std::pow(a.value, exponent), exponent * std::pow(a.value, exponent - 1.));
+    }
+    /// @endcond
+
+private:
+    // f(a) の値 value と f'(a) の値 slope から f(a) を構築する
+    static Dual Chain(Dual const& a, double value, double slope)
+    {
+        Dual r(value);
+        for (std::size_t i = 0; i < N; ++i) r.derivatives[i] = slope * a.derivatives[i];
+        return r;
+    }
+};
+
+using fcv1::ValueOf;
+
+/// @brief 双対数の値を得る
+/// @param[in] x 双対数
+/// @returns `x.value`
+template <std::size_t N>
+double ValueOf(Dual<N> const& x) { return x.value; }
+
+
+/// @brief スカラー型を変更できる FCV1 の運動モデル
+///
+/// `T` に `Dual` を指定すると、シミュレーションと同時に初期状態に対する偏微分係数を計算できます。
+/// ショットの最適化で勾配を得る場合は `ComputeFCV1ShotJacobian()` を使用してください。
+///
+/// 自由走行は `SimulatorFCV1::Step()` と同じ `UpdateFCV1Velocity()` で速度と角速度を更新し、Box2D と同じく更新後の速度で位置を進めます。
+/// ストーン同士の衝突は Box2D の代わりに FCV1 Fast と同じ撃力のモデル (完全弾性・摩擦あり) で処理し、
+/// フレーム内の接触時刻を求めて撃力を加え、そのフレームの速度の更新も接触の前後に時間の割合で分けるため、
+/// 接触時刻がフレームの境界をまたいでも結果は連続に変化し、接触時刻を通じた偏微分係数も得られます。
+/// このため衝突を含むショットの結果は `SimulatorFCV1` と一致しません。
+/// @tparam T スカラー型 (`double`, `float`, `Dual<N>` など)
+template <typename T>
+class FCV1DifferentiableModel {
+public:
+    /// @brief ストーンの質量[kg]
+    static constexpr double kStoneMass = 19.96;
+    /// @brief ストーン同士の摩擦係数
+    static constexpr double kStoneFriction = 0.2;
+    /// @brief 1フレームで処理する衝突の最大数
+    static constexpr int kMaxContactsPerFrame = 16;
+
+    /// @brief ストーンの状態
+    struct Stone {
+        /// @brief 位置 x
+        T position_x{};
+        /// @brief 位置 y
+        T position_y{};
+        /// @brief 速度 x
+        T velocity_x{};
+        /// @brief 速度 y
+        T velocity_y{};
+        /// @brief 角速度
+        T angular_velocity{};
+    };
+    /// @brief 全ストーンの状態
+    using AllStones = std::array<std::optional<Stone>, StoneCoordinate::kStoneMax>;
+
+    /// @brief コンストラクタ
+    /// @param[in] seconds_per_frame 1フレームの時間(秒)
+    explicit FCV1DifferentiableModel(double seconds_per_frame = 0.001) : seconds_per_frame_(seconds_per_frame) {}
+
+    /// @brief 全ストーンの状態を得る
+    /// @returns 全ストーンの状態
+    AllStones const& GetStones() const { return stones_; }
+    /// @brief 全ストーンの状態を得る
+    /// @returns 全ストーンの状態
+    AllStones & GetStones() { return stones_; }
+    /// @brief 全ストーンの状態を設定する
+    /// @param[in] stones 全ストーンの状態
+    void SetStones(AllStones const& stones) { stones_ = stones; }
+
+    /// @brief 1フレーム進める
+    void Step()
+    {
+        for (std::size_t i = 0; i < stones_.size(); ++i) {
+            auto & stone = stones_[i];
+            if (!stone) continue;
+            bases_[i] = Base{ stone->velocity_x, stone->velocity_y, stone->angular_velocity, T(0.) };
+            UpdateVelocity(stone->velocity_x, stone->velocity_y, stone->angular_velocity);
+        }
+
+        // 位置を進める (フレーム内で最初に接触するストーンの組があれば, 接触時刻まで進めて撃力を加える)
+        T elapsed = T(0.);
+        for (int contacts = 0; contacts <= kMaxContactsPerFrame; ++contacts) {
+            T const remaining = seconds_per_frame_ - elapsed;
+            std::size_t a = 0;
+            std::size_t b = 0;
+            std::optional<T> contact_time;
+            if (contacts < kMaxContactsPerFrame) {
+                for (std::size_t i = 0; i < stones_.size(); ++i) {
+                    for (std::size_t j = i + 1; j < stones_.size(); ++j) {
+                        auto const t = ContactTime(i, j, remaining);
+                        if (t && (!contact_time || ValueOf(*t) < ValueOf(*contact_time))) {
+                            contact_time = t;
+                            a = i;
+                            b = j;
+                        }
+                    }
+                }
+            }
+            if (!contact_time) {
+                Advance(remaining);
+                break;
+            }
+            Advance(*contact_time);
+            elapsed = elapsed + *contact_time;
+            ResolveContact(a, b, elapsed / seconds_per_frame_);
+        }
+    }
+
+    /// @brief 全てのストーンが停止しているか
+    ///
+    /// `SimulatorFCV1::AreAllStonesStopped()` と同じ判定です。
+    /// @returns 全てのストーンが停止していれば `true`
+    bool AreAllStonesStopped() const
+    {
+        constexpr double kEpsilon = std::numeric_limits<float>::epsilon();
+        for (auto const& stone : stones_) {
+            if (!stone) continue;
+            double const vx = ValueOf(stone->velocity_x);
+            double const vy = ValueOf(stone->velocity_y);
+            if (vx * vx + vy * vy > kEpsilon || ValueOf(stone->angular_velocity) > kEpsilon) return false;
+        }
+        return true;
+    }
+
+    /// @brief 1フレームの時間を得る
+    /// @returns 1フレームの時間(秒)
+    double GetSecondsPerFrame() const { return seconds_per_frame_; }
+
+private:
+    // 速度の更新の基準 (フレーム内の割合 fraction の時点で衝突した後の速度)
+    struct Base {
+        T velocity_x;
+        T velocity_y;
+        T angular_velocity;
+        T fraction;
+    };
+
+    double seconds_per_frame_;
+    AllStones stones_;
+    std::array<Base, StoneCoordinate::kStoneMax> bases_;
+
+    static T Length(T const& x, T const& y)
+    {
+        using std::sqrt;
+        T const squared = x * x + y * y;
+        // sqrt の微分は 0 で発散するため, 停止しているストーンは定数 0 とする
+        return ValueOf(squared) > 0. ? sqrt(squared) : T(0.);
+    }
+
+    // 1フレーム分の速度と角速度の更新 (SimulatorFCV1::Step() と同じ関数)
+    void UpdateVelocity(T & velocity_x, T & velocity_y, T & angular_velocity) const
+    {
+        UpdateFCV1Velocity(velocity_x, velocity_y, angular_velocity, T(seconds_per_frame_));
+    }
+
+    // 基準の速度に, フレームの割合 fraction までの更新を加えた速度を求める
+    void InterpolateVelocity(Base const& base, T const& fraction, Stone & stone) const
+    {
+        T velocity_x = base.velocity_x;
+        T velocity_y = base.velocity_y;
+        T angular_velocity = base.angular_velocity;
+        UpdateVelocity(velocity_x, velocity_y, angular_velocity);
+        T const ratio = fraction - base.fraction;
+        stone.velocity_x = base.velocity_x + ratio * (velocity_x - base.velocity_x);
+        stone.velocity_y = base.velocity_y + ratio * (velocity_y - base.velocity_y);
+        stone.angular_velocity = base.angular_velocity + ratio * (angular_velocity - base.angular_velocity);
+    }
+
+    void Advance(T const& t)
+    {
+        for (auto & stone : stones_) {
+            if (!stone) continue;
+            stone->position_x += stone->velocity_x * t;
+            stone->position_y += stone->velocity_y * t;
+        }
+    }
+
+    // ストーン i と j が [0, limit] の間に接触する時刻 (近づいていない場合は無し)
+    std::optional<T> ContactTime(std::size_t i, std::size_t j, T const& limit) const
+    {
+        using std::sqrt;
+        auto const& p = stones_[i];
+        auto const& q = stones_[j];
+        if (!p || !q) return std::nullopt;
+
+        T const px = q->position_x - p->position_x;
+        T const py = q->position_y - p->position_y;
+        T const vx = q->velocity_x - p->velocity_x;
+        T const vy = q->velocity_y - p->velocity_y;
+        T const half_b = px * vx + py * vy;
+        if (ValueOf(half_b) >= 0.) return std::nullopt;
+
+        constexpr double kContactDistance = 2. * digitalcurling::Stone::kRadius;
+        T const c = px * px + py * py - kContactDistance * kContactDistance;
+        if (ValueOf(c) <= 0.) return T(0.);  // 既に接している
+
+        T const a = vx * vx + vy * vy;
+        T const discriminant = half_b * half_b - a * c;
+        if (ValueOf(discriminant) <= 0.) return std::nullopt;
+        T const t = (-half_b - sqrt(discriminant)) / a;
+        if (ValueOf(t) > ValueOf(limit)) return std::nullopt;
+        return t;
+    }
+
+    // SimulatorFCV1Fast::ResolveContact() と同じ撃力を加える
+    //
+    // フレームの最初に1フレーム分の速度の更新を済ませているため, 接触の前後で更新をフレーム内の割合 fraction で分け,
+    // 接触前の速度には fraction までの更新, 接触後の速度には残りの更新を加える。
+    // これにより接触時刻がフレームの境界をまたいでも結果が連続になる。
+    void ResolveContact(std::size_t a, std::size_t b, T const& fraction)
+    {
+        auto & stone_a = *stones_[a];
+        auto & stone_b = *stones_[b];
+        auto const position_velocity_a = stone_a;
+        auto const position_velocity_b = stone_b;
+        InterpolateVelocity(bases_[a], fraction, stone_a);
+        InterpolateVelocity(bases_[b], fraction, stone_b);
+
+        T const distance = Length(stone_b.position_x - stone_a.position_x, stone_b.position_y - stone_a.position_y);
+        if (ValueOf(distance) <= 0.) {
+            stone_a = position_velocity_a;
+            stone_b = position_velocity_b;
+            return;
+        }
+        T const nx = (stone_b.position_x - stone_a.position_x) / distance;
+        T const ny = (stone_b.position_y - stone_a.position_y) / distance;
+
+        T const rvx = stone_b.velocity_x - stone_a.velocity_x;
+        T const rvy = stone_b.velocity_y - stone_a.velocity_y;
+        T const normal_velocity = rvx * nx + rvy * ny;
+        if (ValueOf(normal_velocity) >= 0.) {
+            stone_a = position_velocity_a;
+            stone_b = position_velocity_b;
+            return;
+        }
+
+        constexpr double kRadius = digitalcurling::Stone::kRadius;
+        T const normal_impulse = -kStoneMass * normal_velocity;
+        T const tx = -ny;
+        T const ty = nx;
+        T const tangent_velocity = rvx * tx + rvy * ty - kRadius * (stone_a.angular_velocity + stone_b.angular_velocity);
+        T const max_tangent_impulse = kStoneFriction * normal_impulse;
+        T tangent_impulse = -kStoneMass * tangent_velocity / 6.;
+        if (ValueOf(tangent_impulse) > ValueOf(max_tangent_impulse)) {
+            tangent_impulse = max_tangent_impulse;
+        } else if (ValueOf(tangent_impulse) < -ValueOf(max_tangent_impulse)) {
+            tangent_impulse = -max_tangent_impulse;
+        }
+
+        constexpr double kInertia = 0.5 * kStoneMass * kRadius * kRadius;
+        T const dvx = (normal_impulse * nx + tangent_impulse * tx) / kStoneMass;
+        T const dvy = (normal_impulse * ny + tangent_impulse * ty) / kStoneMass;
+        T const dw = tangent_impulse * kRadius / kInertia;
+        stone_a.velocity_x -= dvx;
+        stone_a.velocity_y -= dvy;
+        stone_a.angular_velocity -= dw;
+        stone_b.velocity_x += dvx;
+        stone_b.velocity_y += dvy;
+        stone_b.angular_velocity -= dw;
+
+        for (auto const i : { a, b }) {
+            auto & stone = *stones_[i];
+            bases_[i] = Base{ stone.velocity_x, stone.velocity_y, stone.angular_velocity, fraction };
+            InterpolateVelocity(bases_[i], T(1.), stone);
+        }
+    }
+};
+
+
+/// @brief `ComputeFCV1ShotJacobian()` の結果
+struct FCV1ShotJacobian {
+    /// @brief 微分する入力のインデックス
+    enum Input : std::size_t {
+        kSpeed = 0,         ///< ショットの速度
+        kReleaseAngle = 1,  ///< ショットの投球角度
+        kAngularVelocity = 2,  ///< ショットの角速度
+        kInputCount = 3,
+    };
+
+    /// @brief 全てのストーンが停止した後の盤面
+    ///
+    /// 角度は計算しないため、ショット前の値 (ショットのストーンは 0) のままです。
+    ISimulator::AllStones stones;
+    /// @brief 停止した位置のヤコビ行列
+    ///
+    /// `position_jacobian[i][k]` はストーン `i` の停止した位置の、入力 `k` (`Input`) に対する偏微分係数です。
+    /// シートの外に出たストーンや存在しないストーンは 0 です。
+    std::array<std::array<Vector2, kInputCount>, StoneCoordinate::kStoneMax> position_jacobian{};
+    /// @brief シミュレーションしたフレーム数
+    std::size_t frames = 0;
+};
+
+
+/// @brief ショットの結果と、ショットのパラメーターに対するヤコビ行列を1回のシミュレーションで求める
+///
+/// `FCV1DifferentiableModel` を `Dual<3>` で実行します。
+/// 有限差分で勾配を求める場合と異なり、ショットのパラメーターごとにシミュレーションし直す必要はありません。
+/// シートの外に出たストーンは `SimulateShotOutcome()` と同じく各フレームの後に取り除きます。
+/// @param[in] stones ショット前の盤面 (ショットのストーンのインデックスの値は無視する)
+/// @param[in] shot ショット
+/// @param[in] shot_stone_index ショットのストーンのインデックス
+/// @param[in] sheet_width シートの幅(m) (0 の場合はシートの外に出たストーンを取り除かない)
+/// @param[in] seconds_per_frame 1フレームの時間(秒)
+/// @param[in] max_frames シミュレーションする最大のフレーム数
+/// @returns 結果
+/// @throws std::out_of_range `shot_stone_index` が範囲外の場合
+inline FCV1ShotJacobian ComputeFCV1ShotJacobian(
+    ISimulator::AllStones const& stones,
+    moves::Shot const& shot,
+    std::size_t shot_stone_index,
+    float sheet_width,
+    double seconds_per_frame = 0.001,
+    std::size_t max_frames = 1000000)
+{
+    using Scalar = Dual<FCV1ShotJacobian::kInputCount>;
+    using Model = FCV1DifferentiableModel<Scalar>;
+
+    if (shot_stone_index >= StoneCoordinate::kStoneMax)
+        throw std::out_of_range("ComputeFCV1ShotJacobian: shot_stone_index is out of range");
+
+    Model::AllStones initial;
+    for (std::size_t i = 0; i < stones.size(); ++i) {
+        if (!stones[i] || i == shot_stone_index) continue;
+        auto & stone = initial[i].emplace();
+        stone.position_x = stones[i]->position.x;
+        stone.position_y = stones[i]->position.y;
+        stone.velocity_x = stones[i]->translational_velocity.x;
+        stone.velocity_y = stones[i]->translational_velocity.y;
+        stone.angular_velocity = stones[i]->angular_velocity;
+    }
+    Scalar const speed(shot.translational_velocity, FCV1ShotJacobian::kSpeed);
+    Scalar const release_angle(shot.release_angle, FCV1ShotJacobian::kReleaseAngle);
+    auto & shot_stone = initial[shot_stone_index].emplace();
+    shot_stone.velocity_x = speed * cos(release_angle);
+    shot_stone.velocity_y = speed * sin(release_angle);
+    shot_stone.angular_velocity = Scalar(shot.angular_velocity, FCV1ShotJacobian::kAngularVelocity);
+
+    Model model(seconds_per_frame);
+    model.SetStones(initial);
+
+    float const x_limit = sheet_width / 2.f - digitalcurling::Stone::kRadius;
+    constexpr float y_limit = coordinate::kBackBoardY - digitalcurling::Stone::kRadius;
+
+    FCV1ShotJacobian result;
+    while (!model.AreAllStonesStopped() && result.frames < max_frames) {
+        model.Step();
+        ++result.frames;
+        if (sheet_width <= 0.f) continue;
+        for (auto & stone : model.GetStones()) {
+            if (!stone) continue;
+            double const x = stone->position_x.value;
+            double const y = stone->position_y.value;
+            if (std::abs(x) > x_limit || y > y_limit || y < 0.) stone.reset();
+        }
+    }
+
+    for (std::size_t i = 0; i < stones.size(); ++i) {
+        auto const& stone = model.GetStones()[i];
+        if (!stone) continue;
+        float const angle = stones[i] && i != shot_stone_index ? stones[i]->angle : 0.f;
+        result.stones[i] = ISimulator::StoneState(
+            Vector2(static_cast<float>(stone->position_x.value), static_cast<float>(stone->position_y.value)),
+            angle,
+            Vector2(static_cast<float>(stone->velocity_x.value), static_cast<float>(stone->velocity_y.value)),
+            static_cast<float>(stone->angular_velocity.value));
+        for (std::size_t k = 0; k < FCV1ShotJacobian::kInputCount; ++k) {
+            result.position_jacobian[i][k] = Vector2(
+                static_cast<float>(stone->position_x.derivatives[k]),
+                static_cast<float>(stone->position_y.derivatives[k]));
+        }
+    }
+    return result;
+}
+
+} // namespace digitalcurling::simulators
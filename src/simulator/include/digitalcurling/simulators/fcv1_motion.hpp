@@ -0,0 +1,134 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// @brief FCV1 の運動モデル (1フレーム分の速度と角速度の更新) を定義
+
+#pragma once
+
+#include <cmath>
+#include <limits>
+
+namespace digitalcurling::simulators {
+
+
+/// @brief FCV1 の運動モデルの係数
+///
+/// FCV1 は単精度で定義されているため、係数も単精度の値を基準とします。
+namespace fcv1 {
+
+/// @brief 重力加速度[m/s^2]
+inline constexpr float kGravity = 9.80665f;
+/// @brief 減速の式 dv/dt = -(kFrictionA / (v + kFrictionB) + kFrictionC) * kGravity の係数
+inline constexpr float kFrictionA = 0.00200985f;
+/// @brief 減速の式の係数 (`kFrictionA` を参照)
+inline constexpr float kFrictionB = 0.06385782f;
+/// @brief 減速の式の係数 (`kFrictionA` を参照)
+inline constexpr float kFrictionC = 0.00626286f;
+/// @brief 曲がりの式 (ヨーレート ±kYawCoefficient * v^kYawExponent) の係数
+inline constexpr float kYawCoefficient = 0.00820f;
+/// @brief 曲がりの式の指数 (`kYawCoefficient` を参照)
+inline constexpr float kYawExponent = -0.8f;
+/// @brief 回転の減衰の式 (±kSpinDecay / max(v, kSpinDecayMinSpeed)) の係数
+inline constexpr float kSpinDecay = 0.025f;
+/// @brief 回転の減衰の式の速さの下限 (`kSpinDecay` を参照)
+inline constexpr float kSpinDecayMinSpeed = 0.001f;
+
+/// @brief スカラーの値を得る
+/// @param[in] x スカラー
+/// @returns `x`
+inline float ValueOf(float x) { return x; }
+
+/// @brief スカラーの値を得る
+/// @param[in] x スカラー
+/// @returns `x`
+inline double ValueOf(double x) { return x; }
+
+} // namespace fcv1
+
+
+/// @brief `UpdateFCV1Velocity()` で更新した値
+struct FCV1VelocityUpdate {
+    /// @brief 速度を更新したか (停止しているストーンは更新しない)
+    bool velocity = false;
+    /// @brief 角速度を更新したか (回転していないストーンは更新しない)
+    bool angular_velocity = false;
+};
+
+
+/// @brief FCV1 の運動モデルで1フレーム分の速度と角速度を更新する
+///
+/// `SimulatorFCV1::Step()` が Box2D のワールドを進める前に各ストーンに適用する更新です。
+/// `T` が `float` の場合は `SimulatorFCV1::Step()` とビット単位で同じ結果になるよう、Box2D の `b2Vec2::Normalize()` と同じ手順で速度を正規化します。
+/// `T` に双対数を指定すると、更新の偏微分係数も得られます (停止しているストーンの速さは定数 0 として扱います)。
+/// @tparam T スカラー型 (`float`, `double`, `Dual<N>` など)
+/// @param[in,out] velocity_x 速度 x
+/// @param[in,out] velocity_y 速度 y
+/// @param[in,out] angular_velocity 角速度
+/// @param[in] seconds_per_frame 1フレームの時間(秒)
+/// @returns 更新した値
+template <typename T>
+FCV1VelocityUpdate UpdateFCV1Velocity(T & velocity_x, T & velocity_y, T & angular_velocity, T const& seconds_per_frame)
+{
+    using std::abs;
+    using std::cos;
+    using std::pow;
+    using std::sin;
+    using std::sqrt;
+    using fcv1::ValueOf;
+    constexpr float kEpsilon = std::numeric_limits<float>::epsilon();
+
+    FCV1VelocityUpdate updated;
+
+    // b2Vec2::Normalize() と同じく, 長さが kEpsilon 未満の場合は速さを 0 とする
+    // (sqrt の微分は 0 で発散するため, 長さが 0 の場合は sqrt を評価しない)
+    T const squared_speed = velocity_x * velocity_x + velocity_y * velocity_y;
+    T speed = T(0.f);
+    if (ValueOf(squared_speed) > 0.f) {
+        T const length = sqrt(squared_speed);
+        if (!(ValueOf(length) < kEpsilon)) speed = length;
+    }
+    T const w = angular_velocity;
+
+    // 速度を計算
+    // ストーンが停止してる場合は無視
+    if (ValueOf(speed) > kEpsilon) {
+        T const inv_speed = T(1.f) / speed;
+        T const e_longitudinal_x = velocity_x * inv_speed;
+        T const e_longitudinal_y = velocity_y * inv_speed;
+        T const longitudinal_acceleration = -(T(fcv1::kFrictionA) / (speed + T(fcv1::kFrictionB)) + T(fcv1::kFrictionC)) * T(fcv1::kGravity);
+        T const new_speed = speed + longitudinal_acceleration * seconds_per_frame;
+        if (ValueOf(new_speed) <= 0.f) {
+            velocity_x = T(0.f);
+            velocity_y = T(0.f);
+        } else {
+            T yaw_rate = T(0.f);
+            if (abs(ValueOf(w)) > kEpsilon) {
+                yaw_rate = T(ValueOf(w) > 0.f ? 1.0f : -1.0f) * T(fcv1::kYawCoefficient) * pow(speed, fcv1::kYawExponent);
+            }
+            T const yaw = yaw_rate * seconds_per_frame;
+            T const longitudinal_velocity = new_speed * cos(yaw);
+            T const transverse_velocity = new_speed * sin(yaw);
+            // longitudinal_velocity * e_longitudinal + transverse_velocity * Skew(e_longitudinal)
+            velocity_x = longitudinal_velocity * e_longitudinal_x - transverse_velocity * e_longitudinal_y;
+            velocity_y = longitudinal_velocity * e_longitudinal_y + transverse_velocity * e_longitudinal_x;
+        }
+        updated.velocity = true;
+    }
+
+    // 角速度を計算
+    if (abs(ValueOf(w)) > kEpsilon) {
+        T const decay_speed = ValueOf(speed) < fcv1::kSpinDecayMinSpeed ? T(fcv1::kSpinDecayMinSpeed) : speed;
+        T const angular_accel = T(-fcv1::kSpinDecay) / decay_speed * seconds_per_frame;
+        if (abs(ValueOf(w)) <= abs(ValueOf(angular_accel))) {
+            angular_velocity = T(0.f);
+        } else {
+            angular_velocity = w + angular_accel * w / abs(w);
+        }
+        updated.angular_velocity = true;
+    }
+
+    return updated;
+}
+
+} // namespace digitalcurling::simulators
@@ -2,7 +2,11 @@
 // SPDX-License-Identifier: MIT
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <memory>
@@ -10,142 +14,433 @@
 #include <stdexcept>
 #include <utility>
 #include <vector>
+#include "digitalcurling/trace.hpp"
+#include "digitalcurling/simulators/fcv1_motion.hpp"
 #include "simulator_fcv1.hpp"
 
 namespace digitalcurling::simulators {
 
+namespace {
+
+using StatsClock = std::chrono::steady_clock;
+
+std::uint64_t ElapsedNanoseconds(StatsClock::time_point begin, StatsClock::time_point end)
+{
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+}
+
+// trace::Now() と同じ時計の値のため, 性能カウンター用の時刻をそのままトレースにも使う
+std::int64_t ToTraceNanoseconds(StatsClock::time_point time)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+// 停止していないストーンか
+bool IsStoneMoving(b2Vec2 const& velocity, float angular_velocity)
+{
+    return velocity.LengthSquared() > std::numeric_limits<float>::epsilon()
+        || angular_velocity > std::numeric_limits<float>::epsilon();
+}
+
+// 経路と他のストーンの中心の距離に 2×Stone::kRadius に加えて持たせる余裕[m]
+// 経路はフレーム間を線分で結んで判定するため, 浮動小数点数の誤差を吸収できればよい
+constexpr float kFastPathMargin = 0.01f;
+
+// 点 p から線分 ab までの距離の2乗
+float SquaredDistanceToSegment(Vector2 const p, Vector2 const a, Vector2 const b)
+{
+    Vector2 const ab = b - a;
+    Vector2 const ap = p - a;
+    float const length_sq = ab.SquaredLength();
+    float t = length_sq > 0.f ? (ap.x * ab.x + ap.y * ab.y) / length_sq : 0.f;
+    t = std::clamp(t, 0.f, 1.f);
+    return (ap - t * ab).SquaredLength();
+}
+
+// 他のストーンに接触しない1個のストーンを, Box2D を使わずに1フレーム進める
+//
+// Box2D は接触しているボディ同士のみを島にまとめて解くため, 他のストーンに接触しないストーンは単独の島として解かれる。
+// SimulatorFCV1::Step() の速度の更新の後に, b2Island::Solve() が1個のボディに行う処理 (速度と位置の積分とスリープの判定) を
+// 同じ式と順序で行い, Box2D で進めた場合とビット単位で一致させる (SimulatorFCV1.FastPath テストで Box2D と比較している)。
+// sleep_time は b2Body::m_sleepTime に相当する
+void StepLoneStone(ISimulator::StoneState & stone, float & sleep_time, float h)
+{
+    float velocity_x = stone.translational_velocity.x;
+    float velocity_y = stone.translational_velocity.y;
+    float angular_velocity = stone.angular_velocity;
+    auto const updated = UpdateFCV1Velocity(velocity_x, velocity_y, angular_velocity, h);
+
+    // b2Body::SetLinearVelocity(), SetAngularVelocity() は 0 でない値を設定するとスリープまでの時間を 0 に戻す
+    b2Vec2 v = ToB2Vec2(stone.translational_velocity);
+    float w = stone.angular_velocity;
+    if (updated.velocity) {
+        v = b2Vec2(velocity_x, velocity_y);
+        if (b2Dot(v, v) > 0.0f) sleep_time = 0.0f;
+    }
+    if (updated.angular_velocity) {
+        w = angular_velocity;
+        if (w * w > 0.0f) sleep_time = 0.0f;
+    }
+
+    // 速度の積分 (重力, 力, 減衰は全て 0 のため +0 を加えるのみ. -0 は +0 になる)
+    v += b2Vec2_zero;
+    w += 0.0f;
+
+    // 位置の積分
+    b2Vec2 const translation = h * v;
+    if (b2Dot(translation, translation) > b2_maxTranslationSquared) {
+        float const ratio = b2_maxTranslation / translation.Length();
+        v *= ratio;
+    }
+    float const rotation = h * w;
+    if (rotation * rotation > b2_maxRotationSquared) {
+        float const ratio = b2_maxRotation / b2Abs(rotation);
+        w *= ratio;
+    }
+    b2Vec2 c = ToB2Vec2(stone.position);
+    c += h * v;
+
+    stone.position = ToDigitalCurlingVector2(c);
+    stone.angle += h * w;
+    stone.translational_velocity = ToDigitalCurlingVector2(v);
+    stone.angular_velocity = w;
+
+    // スリープの判定 (接触が無いため位置の拘束は常に解けている)
+    float const linear_tolerance_sq = b2_linearSleepTolerance * b2_linearSleepTolerance;
+    float const angular_tolerance_sq = b2_angularSleepTolerance * b2_angularSleepTolerance;
+    if (w * w > angular_tolerance_sq || b2Dot(v, v) > linear_tolerance_sq) {
+        sleep_time = 0.0f;
+    } else {
+        sleep_time += h;
+    }
+    if (sleep_time >= b2_timeToSleep) {
+        // b2Body::SetAwake(false)
+        stone.translational_velocity = Vector2();
+        stone.angular_velocity = 0.f;
+        sleep_time = 0.0f;
+    }
+}
+
+} // namespace
+
+
+class SimulatorFCV1::Engine {
+public:
+    class ContactListener : public b2ContactListener {
+    public:
+        virtual void BeginContact(b2Contact* contact) override;
+        virtual void PostSolve(b2Contact* contact, const b2ContactImpulse* impulse) override;
+
+        // 衝突を記録するシミュレーター (Step() の度に設定される)
+        SimulatorFCV1 * instance = nullptr;
+    };
+
+    Engine()
+        : world(b2Vec2_zero)
+        , bodies()
+        , contact_listener()
+    {
+        b2BodyDef stone_body_def;
+        stone_body_def.type = b2_dynamicBody;
+        stone_body_def.awake = false;
+        stone_body_def.bullet = true;
+        stone_body_def.enabled = false;
+
+        b2CircleShape stone_shape;
+        stone_shape.m_radius = Stone::kRadius;
+
+        b2FixtureDef stone_fixture_def;
+        stone_fixture_def.shape = &stone_shape;
+        stone_fixture_def.friction = 0.2f;  // 適当というかデフォルト値
+        stone_fixture_def.restitution = 1.0; // 完全弾性衝突(完全弾性衝突の根拠は無いし多分違う)
+        stone_fixture_def.restitutionThreshold = 0.f;  // 反発閾値。この値より大きい速度(m/s)で衝突すると反発が適用される。
+        stone_fixture_def.density = kStoneMass / (b2_pi * Stone::kRadius * Stone::kRadius);  // kg/m^2
+
+        for (int i = 0; i < StoneCoordinate::kStoneMax; ++i) {
+            stone_body_def.userData.pointer = static_cast<uintptr_t>(i);
+            bodies[i] = world.CreateBody(&stone_body_def);
+            bodies[i]->CreateFixture(&stone_fixture_def);
+        }
+
+        world.SetContactListener(&contact_listener);
+    }
+    Engine(Engine const&) = delete;
+    Engine & operator = (Engine const&) = delete;
+
+    // ストーンの情報をボディに適用する
+    void Apply(ISimulator::AllStones const& stones)
+    {
+        for (int i = 0; i < StoneCoordinate::kStoneMax; ++i) {
+            if (stones[i]) {
+                auto & stone = *stones[i];
+                bodies[i]->SetEnabled(true);
+                bodies[i]->SetAwake(true);
+                bodies[i]->SetTransform(ToB2Vec2(stone.position), stone.angle);
+                bodies[i]->SetLinearVelocity(ToB2Vec2(stone.translational_velocity));
+                bodies[i]->SetAngularVelocity(stone.angular_velocity);
+            } else {
+                bodies[i]->SetEnabled(false);
+            }
+        }
+    }
+
+    // 全てのボディを無効にしてから適用する (以前の盤面の接触やスリープまでの時間を持ち越さない)
+    // 全てのボディを同じ順序で有効にし直すため, ワールドがそれまでに何を解いていたかによらず同じ状態から始まる
+    void Reset(ISimulator::AllStones const& stones)
+    {
+        for (auto body : bodies) {
+            body->SetAwake(false);
+            body->SetEnabled(false);
+        }
+        Apply(stones);
+    }
+
+    // 1個のボディの状態をストーンの情報として読み出す
+    ISimulator::StoneState ReadStone(std::size_t i) const
+    {
+        ISimulator::StoneState stone;
+        stone.position = ToDigitalCurlingVector2(bodies[i]->GetWorldCenter());
+        stone.angle = bodies[i]->GetAngle();
+        stone.translational_velocity = ToDigitalCurlingVector2(bodies[i]->GetLinearVelocity());
+        stone.angular_velocity = bodies[i]->GetAngularVelocity();
+        return stone;
+    }
+
+    // ボディの状態をストーンの情報として読み出す
+    void Read(ISimulator::AllStones & stones) const
+    {
+        for (int i = 0; i < StoneCoordinate::kStoneMax; ++i) {
+            if (bodies[i]->IsEnabled()) {
+                stones[i] = ReadStone(i);
+            } else {
+                stones[i] = std::nullopt;
+            }
+        }
+    }
+
+    bool AreAllStonesStopped() const
+    {
+        for (auto body : bodies) {
+            if (body->IsEnabled() && IsStoneMoving(body->GetLinearVelocity(), body->GetAngularVelocity())) return false;
+        }
+        return true;
+    }
+
+    b2World world;
+    std::array<b2Body*, StoneCoordinate::kStoneMax> bodies;
+    ContactListener contact_listener;
+};
+
+
 SimulatorFCV1::SimulatorFCV1(SimulatorFCV1Factory const& factory)
     : SimulatorFCV1(SimulatorFCV1Storage(factory))
 {}
 
 SimulatorFCV1::SimulatorFCV1(SimulatorFCV1Storage const& storage)
     : storage_(storage)
-    , world_(b2Vec2_zero)
-    , stone_bodies_()
+    , engine_()                   // UpdateWithStorage で作成される
     , stones_dirty_()             // UpdateWithStorage で上書きされる
     , all_stones_stopped_()       // UpdateWithStorage でdirtyフラグがtrueになるため，後に上書きされる
     , all_stones_stopped_dirty_() // UpdateWithStorage で上書きされる
-    , contact_listener_(this)
 {
-    b2BodyDef stone_body_def;
-    stone_body_def.type = b2_dynamicBody;
-    stone_body_def.awake = false;
-    stone_body_def.bullet = true;
-    stone_body_def.enabled = false;
-
-    b2CircleShape stone_shape;
-    stone_shape.m_radius = Stone::kRadius;
-
-    b2FixtureDef stone_fixture_def;
-    stone_fixture_def.shape = &stone_shape;
-    stone_fixture_def.friction = 0.2f;  // 適当というかデフォルト値
-    stone_fixture_def.restitution = 1.0; // 完全弾性衝突(完全弾性衝突の根拠は無いし多分違う)
-    stone_fixture_def.restitutionThreshold = 0.f;  // 反発閾値。この値より大きい速度(m/s)で衝突すると反発が適用される。
-    stone_fixture_def.density = kStoneMass / (b2_pi * Stone::kRadius * Stone::kRadius);  // kg/m^2
-
-    for (int i = 0; i < StoneCoordinate::kStoneMax; ++i) {
-        stone_body_def.userData.pointer = static_cast<uintptr_t>(i);
-        stone_bodies_[i] = world_.CreateBody(&stone_body_def);
-        stone_bodies_[i]->CreateFixture(&stone_fixture_def);
-    }
-
-    world_.SetContactListener(&contact_listener_);
-
     UpdateWithStorage();
 }
 
+SimulatorFCV1::~SimulatorFCV1() = default;
+
 void SimulatorFCV1::SetStones(ISimulator::AllStones const& stones)
 {
-    // update bodies
-    for (int i = 0; i < StoneCoordinate::kStoneMax; ++i) {
-        if (stones[i]) {
-            auto & stone = *stones[i];
-            stone_bodies_[i]->SetEnabled(true);
-            stone_bodies_[i]->SetAwake(true);
-            stone_bodies_[i]->SetTransform(ToB2Vec2(stone.position), stone.angle);
-            stone_bodies_[i]->SetLinearVelocity(ToB2Vec2(stone.translational_velocity));
-            stone_bodies_[i]->SetAngularVelocity(stone.angular_velocity);
-        } else {
-            stone_bodies_[i]->SetEnabled(false);
-        }
-    }
+    Counters::Add(counters_.set_stones_calls, 1);
+    ApplyStones(stones);
+}
 
-    stones_dirty_ = true;
+void SimulatorFCV1::ApplyStones(ISimulator::AllStones const& stones)
+{
+    if (engine_) {
+        engine_->Apply(stones);
+        stones_dirty_ = true;
+    } else {
+        // コンパクトモードではエンジンに読み込まず, 次の Step() で読み込む
+        storage_.stones = stones;
+        stones_dirty_ = false;
+    }
     all_stones_stopped_dirty_ = true;
+
+    // 新しい盤面が対象かは次の Step() で判定し直す
+    fast_path_.check_pending = storage_.factory.fast_path;
+    fast_path_.active = false;
+}
+
+SimulatorFCV1::Engine& SimulatorFCV1::AcquireEngine()
+{
+    Engine* engine = engine_.get();
+    if (!engine) {
+        thread_local Engine t_engine;
+        engine = &t_engine;
+        // 持ち主が変わっていなくても毎回読み込み直し, 結果を storage_.stones のみから決まるようにする
+        // (読み込み直さずに続けると, 同じスレッドで他のインスタンスを進めたかによって接触の情報の有無が変わる)
+        engine->Reset(storage_.stones);
+    }
+    engine->contact_listener.instance = this;
+    return *engine;
 }
 
 void SimulatorFCV1::Step()
 {
-    // simulate
-    for (auto stone_body : stone_bodies_) {
-        b2Vec2 normalized_stone_velocity = stone_body->GetLinearVelocity();
-        float stone_speed = normalized_stone_velocity.Normalize();
-        float const angular_velocity = stone_body->GetAngularVelocity();
-
-        // 速度を計算
-        // ストーンが停止してる場合は無視
-        constexpr float kGravity = 9.80665f;
-        if (stone_speed > std::numeric_limits<float>::epsilon()) {
-            float const longitudinal_acceleration = -(0.00200985f / (stone_speed + 0.06385782f) + 0.00626286f) * kGravity;
-            float const new_stone_speed = stone_speed + longitudinal_acceleration * storage_.factory.seconds_per_frame;
-            if (new_stone_speed <= 0.f) {
-                stone_body->SetLinearVelocity(b2Vec2_zero);
-            } else {
-                auto yaw_rate = [&]() -> float {
-                    if (std::abs(angular_velocity) <= std::numeric_limits<float>::epsilon()) return 0.f;
-                    return (angular_velocity > 0.f ? 1.0f : -1.0f) * 0.00820f * std::pow(stone_speed, -0.8f);
-                };
-
-                float const yaw = yaw_rate() * storage_.factory.seconds_per_frame;
-                float const longitudinal_velocity = new_stone_speed * std::cos(yaw);
-                float const transverse_velocity = new_stone_speed * std::sin(yaw);
-                b2Vec2 const& e_longitudinal = normalized_stone_velocity;
-                b2Vec2 const e_transverse = e_longitudinal.Skew();
-                b2Vec2 const new_stone_velocity = longitudinal_velocity * e_longitudinal + transverse_velocity * e_transverse;
-                stone_body->SetLinearVelocity(new_stone_velocity);
-            }
+    if (fast_path_.check_pending) {
+        BeginFastPath();
+    }
+    if (fast_path_.active) {
+        auto const& stone = *storage_.stones[fast_path_.stone_index];
+        if (IsStoneMoving(ToB2Vec2(stone.translational_velocity), stone.angular_velocity)) {
+            StepFastPath();
+            return;
         }
+        // 停止した後も Step() が呼ばれた場合は Box2D で進める
+        EndFastPath();
+    }
 
-        // 角速度を計算
-        if (std::abs(angular_velocity) > std::numeric_limits<float>::epsilon()) {
-            float const angular_accel = -0.025f / std::max(stone_speed, 0.001f) * storage_.factory.seconds_per_frame;
-            float new_angular_velocity = 0.f;
-            if (std::abs(angular_velocity) <= std::abs(angular_accel)) {
-                new_angular_velocity = 0.f;
-            } else {
-                new_angular_velocity = angular_velocity + angular_accel * angular_velocity / std::abs(angular_velocity);
-            }
-            stone_body->SetAngularVelocity(new_angular_velocity);
+    auto const motion_begin = StatsClock::now();
+    auto & engine = AcquireEngine();
+
+    // simulate
+    for (auto stone_body : engine.bodies) {
+        b2Vec2 const velocity = stone_body->GetLinearVelocity();
+        float velocity_x = velocity.x;
+        float velocity_y = velocity.y;
+        float angular_velocity = stone_body->GetAngularVelocity();
+        auto const updated = UpdateFCV1Velocity(velocity_x, velocity_y, angular_velocity, storage_.factory.seconds_per_frame);
+
+        // 速度を設定すると Box2D のスリープの判定がリセットされるため, 更新した値のみ設定する
+        if (updated.velocity) {
+            stone_body->SetLinearVelocity(b2Vec2(velocity_x, velocity_y));
+        }
+        if (updated.angular_velocity) {
+            stone_body->SetAngularVelocity(angular_velocity);
         }
     }
 
     storage_.collisions.clear();
 
-    world_.Step(
+    auto const world_step_begin = StatsClock::now();
+
+    engine.world.Step(
         storage_.factory.seconds_per_frame,
         8,  // velocityIterations (公式マニュアルでの推奨値は 8)
         3); // positionIterations (公式マニュアルでの推奨値は 3)
 
-    stones_dirty_ = true;
+    auto const world_step_end = StatsClock::now();
+
+    Counters::Add(counters_.frames, 1);
+    Counters::Add(counters_.motion_nanoseconds, ElapsedNanoseconds(motion_begin, world_step_begin));
+    Counters::Add(counters_.world_step_nanoseconds, ElapsedNanoseconds(world_step_begin, world_step_end));
+
+    if (trace::IsEnabled()) {
+        trace::Record("physics", "Motion", ToTraceNanoseconds(motion_begin), ToTraceNanoseconds(world_step_begin) - ToTraceNanoseconds(motion_begin));
+        trace::Record("physics", "WorldStep", ToTraceNanoseconds(world_step_begin), ToTraceNanoseconds(world_step_end) - ToTraceNanoseconds(world_step_begin));
+    }
+
+    if (engine_) {
+        stones_dirty_ = true;
+    } else {
+        // コンパクトモードでは毎フレーム書き戻す (次の Step() ではここから読み込み直す)
+        engine.Read(storage_.stones);
+    }
     all_stones_stopped_dirty_ = true;
 }
 
+void SimulatorFCV1::BeginFastPath()
+{
+    fast_path_.check_pending = false;
+    auto const& stones = GetStones();
+
+    // 動いているストーンが1個だけで, 他のストーンは完全に静止している盤面のみを対象とする
+    std::optional<std::size_t> moving_index;
+    for (std::size_t i = 0; i < stones.size(); ++i) {
+        if (!stones[i]) continue;
+        if (stones[i]->translational_velocity.x != 0.f || stones[i]->translational_velocity.y != 0.f || stones[i]->angular_velocity != 0.f) {
+            if (moving_index) return;
+            moving_index = i;
+        }
+    }
+    if (!moving_index) return;
+    auto const& moving = *stones[*moving_index];
+    if (!IsStoneMoving(ToB2Vec2(moving.translational_velocity), moving.angular_velocity)) return;
+
+    // 静止したストーン同士が接触していると Box2D は毎フレーム衝突を記録するため, 対象外とする
+    float const clearance = 2.f * Stone::kRadius + kFastPathMargin;
+    for (std::size_t i = 0; i < stones.size(); ++i) {
+        if (!stones[i] || i == *moving_index) continue;
+        for (std::size_t j = i + 1; j < stones.size(); ++j) {
+            if (!stones[j] || j == *moving_index) continue;
+            if ((stones[i]->position - stones[j]->position).SquaredLength() <= clearance * clearance) return;
+        }
+    }
+
+    // 停止するまで進めた経路を 2×Stone::kRadius 広げた範囲に他のストーンがあれば, 接触し得るため Box2D で進める
+    float const seconds_per_frame = storage_.factory.seconds_per_frame;
+    if (!(seconds_per_frame > 0.f)) return;
+    auto const is_clear = [&](Vector2 const prev, Vector2 const next) {
+        for (std::size_t i = 0; i < stones.size(); ++i) {
+            if (!stones[i] || i == *moving_index) continue;
+            if (SquaredDistanceToSegment(stones[i]->position, prev, next) <= clearance * clearance) return false;
+        }
+        return true;
+    };
+    ISimulator::StoneState stone = moving;
+    float sleep_time = 0.f;
+    bool clear = is_clear(stone.position, stone.position);
+    while (clear && IsStoneMoving(ToB2Vec2(stone.translational_velocity), stone.angular_velocity)) {
+        Vector2 const prev = stone.position;
+        StepLoneStone(stone, sleep_time, seconds_per_frame);
+        clear = is_clear(prev, stone.position);
+    }
+    if (!clear) {
+        Counters::Add(counters_.fast_path_rejections, 1);
+        return;
+    }
+
+    Counters::Add(counters_.fast_path_shots, 1);
+    fast_path_.stone_index = *moving_index;
+    fast_path_.active = true;
+    // SetStones() と Load() は全てのボディを起こすため, スリープまでの時間は 0 から始まる
+    fast_path_.sleep_time = 0.f;
+}
+
+void SimulatorFCV1::StepFastPath()
+{
+    // 他のストーンは静止したままのため, 動いているストーンの状態のみを更新する
+    auto & stone = *storage_.stones[fast_path_.stone_index];
+    if (!engine_) {
+        // コンパクトモードの Box2D は毎フレーム全てのボディを起こし直すため, スリープまでの時間を持ち越さない
+        fast_path_.sleep_time = 0.f;
+    }
+    StepLoneStone(stone, fast_path_.sleep_time, storage_.factory.seconds_per_frame);
+    storage_.collisions.clear();
+
+    // Box2D 側は高速化を終えるまで更新しないため, storage_.stones を正とする
+    stones_dirty_ = false;
+    all_stones_stopped_ = !IsStoneMoving(ToB2Vec2(stone.translational_velocity), stone.angular_velocity);
+    all_stones_stopped_dirty_ = false;
+
+    Counters::Add(counters_.frames, 1);
+    Counters::Add(counters_.fast_path_frames, 1);
+}
+
+void SimulatorFCV1::EndFastPath()
+{
+    fast_path_.active = false;
+    // コンパクトモードでは次の Step() で storage_.stones から読み込まれる
+    if (engine_) {
+        engine_->Apply(storage_.stones);
+    }
+}
+
 ISimulator::AllStones const& SimulatorFCV1::GetStones() const
 {
     if (stones_dirty_) {
         // update stones_
-        for (int i = 0; i < StoneCoordinate::kStoneMax; ++i) {
-            if (stone_bodies_[i]->IsEnabled()) {
-                ISimulator::StoneState stone;
-                stone.position = ToDigitalCurlingVector2(stone_bodies_[i]->GetWorldCenter());
-                stone.angle = stone_bodies_[i]->GetAngle();
-                stone.translational_velocity = ToDigitalCurlingVector2(stone_bodies_[i]->GetLinearVelocity());
-                stone.angular_velocity = stone_bodies_[i]->GetAngularVelocity();
-                storage_.stones[i] = stone;
-            } else {
-                storage_.stones[i] = std::nullopt;
-            }
-        }
+        engine_->Read(storage_.stones);
         stones_dirty_ = false;
     }
     return storage_.stones;
@@ -159,14 +454,12 @@ std::vector<ISimulator::Collision> const& SimulatorFCV1::GetCollisions() const
 bool SimulatorFCV1::AreAllStonesStopped() const
 {
     if (all_stones_stopped_dirty_) {
-        all_stones_stopped_ = true;
-        for (auto stone_body : stone_bodies_) {
-            if (!stone_body->IsEnabled()) continue;
-            if (stone_body->GetLinearVelocity().LengthSquared() > std::numeric_limits<float>::epsilon()
-                || stone_body->GetAngularVelocity() > std::numeric_limits<float>::epsilon()) {
-                all_stones_stopped_ = false;
-                break;
-            }
+        if (engine_) {
+            all_stones_stopped_ = engine_->AreAllStonesStopped();
+        } else {
+            all_stones_stopped_ = std::none_of(storage_.stones.begin(), storage_.stones.end(), [](auto const& stone) {
+                return stone && IsStoneMoving(ToB2Vec2(stone->translational_velocity), stone->angular_velocity);
+            });
         }
         all_stones_stopped_dirty_ = false;
     }
@@ -197,10 +490,35 @@ void SimulatorFCV1::Save(ISimulatorStorage & storage) const
 
 void SimulatorFCV1::Load(ISimulatorStorage const& storage)
 {
+    Counters::Add(counters_.load_calls, 1);
     storage_ = static_cast<SimulatorFCV1Storage const&>(storage);
     UpdateWithStorage();
 }
 
+SimulatorStats SimulatorFCV1::GetStats() const
+{
+    constexpr double kNanosecondsToSeconds = 1e-9;
+
+    SimulatorStats stats;
+    stats.frames = counters_.frames.load(std::memory_order_relaxed);
+    stats.contacts_begun = counters_.contacts_begun.load(std::memory_order_relaxed);
+    stats.contacts_solved = counters_.contacts_solved.load(std::memory_order_relaxed);
+    stats.out_of_sheet_removals = counters_.out_of_sheet_removals.load(std::memory_order_relaxed);
+    stats.set_stones_calls = counters_.set_stones_calls.load(std::memory_order_relaxed);
+    stats.load_calls = counters_.load_calls.load(std::memory_order_relaxed);
+    stats.motion_seconds = static_cast<double>(counters_.motion_nanoseconds.load(std::memory_order_relaxed)) * kNanosecondsToSeconds;
+    stats.world_step_seconds = static_cast<double>(counters_.world_step_nanoseconds.load(std::memory_order_relaxed)) * kNanosecondsToSeconds;
+    stats.fast_path_shots = counters_.fast_path_shots.load(std::memory_order_relaxed);
+    stats.fast_path_frames = counters_.fast_path_frames.load(std::memory_order_relaxed);
+    stats.fast_path_rejections = counters_.fast_path_rejections.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void SimulatorFCV1::RecordOutOfSheetRemovals(std::size_t count)
+{
+    Counters::Add(counters_.out_of_sheet_removals, static_cast<std::uint64_t>(count));
+}
+
 moves::Shot SimulatorFCV1::CalculateShot(Vector2 const& target_position, float const target_speed, float const shot_angular_velocity) const {
     if (target_speed < 0.f)
         throw std::invalid_argument("SimulatorFCV1::CalculateShot: target_speed must be non-negative.");
@@ -274,8 +592,15 @@ moves::Shot SimulatorFCV1::CalculateShot(Vector2 const& target_position, float c
     return moves::Shot { v0_speed, angular_velocity, v0_angle };
 }
 
-void SimulatorFCV1::ContactListener::PostSolve(b2Contact* contact, const b2ContactImpulse* impulse)
+void SimulatorFCV1::Engine::ContactListener::BeginContact(b2Contact* /* contact */)
+{
+    Counters::Add(instance->counters_.contacts_begun, 1);
+}
+
+void SimulatorFCV1::Engine::ContactListener::PostSolve(b2Contact* contact, const b2ContactImpulse* impulse)
 {
+    Counters::Add(instance->counters_.contacts_solved, 1);
+
     auto a_body = contact->GetFixtureA()->GetBody();
     auto b_body = contact->GetFixtureB()->GetBody();
 
@@ -293,14 +618,21 @@ void SimulatorFCV1::ContactListener::PostSolve(b2Contact* contact, const b2Conta
     collision.normal_impulse = impulse->normalImpulses[0];
     collision.tangent_impulse = impulse->tangentImpulses[0];
 
-    instance_->storage_.collisions.emplace_back(std::move(collision));
+    instance->storage_.collisions.emplace_back(std::move(collision));
 }
 
 void SimulatorFCV1::UpdateWithStorage()
 {
-    SetStones(storage_.stones);
+    // ストレージのファクトリーの設定に合わせてモードを切り替える
+    if (storage_.factory.compact) {
+        engine_.reset();
+    } else if (!engine_) {
+        engine_ = std::make_unique<Engine>();
+    }
+
+    ApplyStones(storage_.stones);
     stones_dirty_ = false;  // storage_.stones と Box2D側のデータはすでに同期している．
-    // all_stones_dirty_ = true は SetStones() 内ですでに設定されている
+    // all_stones_dirty_ = true は ApplyStones() 内ですでに設定されている
 }
 
 } // namespace simulators
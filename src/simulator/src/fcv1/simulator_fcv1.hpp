@@ -6,7 +6,9 @@
 
 #pragma once
 
-#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include "digitalcurling/moves/shot.hpp"
@@ -20,6 +22,13 @@ namespace digitalcurling::simulators {
 
 
 /// @brief Friction-CurlVelocity式シミュレータ Version1
+///
+/// ファクトリーの `compact` を有効にすると、インスタンスはストーンの状態のみを保持し、
+/// Box2D のワールドは `Step()` の間だけスレッドごとに共有されたものを使用します (コンパクトモード)。
+/// `Step()` の度にストーンの状態からワールドを読み込み直すため、結果は同じスレッドで他のインスタンスを進めたかによりません。
+///
+/// ファクトリーの `fast_path` を有効にすると、他のストーンに接触しないショットは
+/// Box2D が1個のボディに行う積分と同じ計算で、Box2D を使用せずに進めます。
 class SimulatorFCV1 : public ISimulator {
 public:
     /// @brief ストーンの質量[kg]
@@ -31,7 +40,7 @@ public:
     /// @brief コンストラクタ
     /// @param storage このシミュレーターのストレージ
     explicit SimulatorFCV1(SimulatorFCV1Storage const& storage);
-    virtual ~SimulatorFCV1() = default;
+    virtual ~SimulatorFCV1();
 
     virtual const char* GetId() const noexcept override { return DIGITALCURLING_PLUGIN_NAME; }
 
@@ -49,6 +58,16 @@ public:
     virtual void Save(ISimulatorStorage & storage) const override;
     virtual void Load(ISimulatorStorage const& storage) override;
 
+    virtual SimulatorStats GetStats() const override;
+
+    /// @brief シート外に出たストーンを取り除いたことを記録する
+    /// @param count 取り除いたストーンの数
+    void RecordOutOfSheetRemovals(std::size_t count);
+
+    /// @brief コンパクトモードで動作しているか
+    /// @returns コンパクトモードの場合 `true`
+    bool IsCompact() const noexcept { return engine_ == nullptr; }
+
     /// @brief 指定地点を指定速度で通過するショットを逆算(推測)する
     /// @param target_position 目標地点
     /// @param target_speed 目標地点到達時の速度
@@ -59,24 +78,63 @@ public:
     virtual moves::Shot CalculateShot(Vector2 const& target_position, float const target_speed, float const shot_angular_velocity) const;
 
 private:
-    class ContactListener : public b2ContactListener {
-    public:
-        ContactListener(SimulatorFCV1 * instance) : instance_(instance) {}
-        virtual void PostSolve(b2Contact* contact, const b2ContactImpulse* impulse) override;
-    private:
-        SimulatorFCV1 * const instance_;
+    // Box2D のワールドと16個のストーンのボディ (simulator_fcv1.cpp で定義)
+    class Engine;
+
+    // 性能カウンター
+    // 書き込みはこのインスタンスを操作するスレッドのみが行い、読み出しは他のスレッドからも行えるようにする
+    struct Counters {
+        std::atomic<std::uint64_t> frames{0};
+        std::atomic<std::uint64_t> contacts_begun{0};
+        std::atomic<std::uint64_t> contacts_solved{0};
+        std::atomic<std::uint64_t> out_of_sheet_removals{0};
+        std::atomic<std::uint64_t> set_stones_calls{0};
+        std::atomic<std::uint64_t> load_calls{0};
+        std::atomic<std::uint64_t> motion_nanoseconds{0};
+        std::atomic<std::uint64_t> world_step_nanoseconds{0};
+        std::atomic<std::uint64_t> fast_path_shots{0};
+        std::atomic<std::uint64_t> fast_path_frames{0};
+        std::atomic<std::uint64_t> fast_path_rejections{0};
+
+        // 書き込みは1スレッドのみのため, read-modify-write 命令を使わずに加算する
+        static void Add(std::atomic<std::uint64_t>& counter, std::uint64_t value) {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+    };
+
+    // 衝突のない経路の高速化 (factory.fast_path) の状態
+    struct FastPath {
+        // 次の Step() で盤面が対象かを判定する (SetStones() や Load() の後に設定される)
+        bool check_pending = false;
+        // Box2D を使わずに進めているか
+        bool active = false;
+        // 動いているストーンの番号
+        std::size_t stone_index = 0;
+        // 動いているストーンの Box2D のボディがスリープするまでの時間 (b2Body::m_sleepTime に相当する)
+        float sleep_time = 0.f;
     };
 
     mutable SimulatorFCV1Storage storage_;
-    b2World world_;
-    std::array<b2Body*, StoneCoordinate::kStoneMax> stone_bodies_;
+    // 通常モードではこのインスタンス専用のエンジン, コンパクトモードでは nullptr
+    std::unique_ptr<Engine> engine_;
     mutable bool stones_dirty_;
     mutable bool all_stones_stopped_;
     mutable bool all_stones_stopped_dirty_;
-    ContactListener contact_listener_;
+    Counters counters_;
+    FastPath fast_path_;
 
+    // ストーンの情報を Box2D のボディに適用する (コンパクトモードでは storage_.stones に保存する)
+    void ApplyStones(ISimulator::AllStones const& stones);
     // ストレージのデータを内部データに適用する
     void UpdateWithStorage();
+    // Step() で使用するエンジンを得る (コンパクトモードではこのインスタンスの状態を読み込み直したスレッドごとのエンジン)
+    Engine& AcquireEngine();
+    // 盤面が高速化の対象か判定し, 対象であれば Box2D を使わずに進め始める
+    void BeginFastPath();
+    // 動いているストーンを Box2D を使わずに1フレーム進める
+    void StepFastPath();
+    // 高速化を終え, 以降は Box2D で進める
+    void EndFastPath();
 };
 
 } // namespace digitalcurling::simulators
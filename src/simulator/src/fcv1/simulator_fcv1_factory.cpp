@@ -1,9 +1,14 @@
 ﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
 // SPDX-License-Identifier: MIT
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <stdexcept>
+#include <vector>
 #include <nlohmann/json.hpp>
 #include "digitalcurling/common.hpp"
+#include "digitalcurling/plugins/binary_state.hpp"
 #include "simulator_fcv1_factory.hpp"
 #include "simulator_fcv1.hpp"
 
@@ -23,13 +28,35 @@ std::unique_ptr<ISimulatorFactory> SimulatorFCV1Factory::Clone() const {
     return std::make_unique<SimulatorFCV1Factory>(*this);
 }
 
+void SimulatorFCV1Factory::ToBinary(std::vector<std::uint8_t> & out) const {
+    plugins::BinaryStateWriter writer(out);
+    writer.Write(seconds_per_frame);
+    writer.Write(static_cast<std::uint8_t>(compact));
+    writer.Write(static_cast<std::uint8_t>(fast_path));
+}
+void SimulatorFCV1Factory::FromBinary(std::uint8_t const* data, std::size_t size) {
+    plugins::BinaryStateReader reader(data, size);
+    auto const spf = reader.Read<float>();
+    auto const new_compact = reader.Read<std::uint8_t>() != 0;
+    auto const new_fast_path = reader.Read<std::uint8_t>() != 0;
+    if (!reader.IsEnd()) throw std::invalid_argument("SimulatorFCV1Factory: trailing data.");
+    seconds_per_frame = spf;
+    compact = new_compact;
+    fast_path = new_fast_path;
+}
+
 // json
 void to_json(nlohmann::json & j, SimulatorFCV1Factory const& v) {
     j["type"] = DIGITALCURLING_PLUGIN_NAME;
     j["seconds_per_frame"] = v.seconds_per_frame;
+    j["compact"] = v.compact;
+    j["fast_path"] = v.fast_path;
 }
 void from_json(nlohmann::json const& j, SimulatorFCV1Factory & v) {
     j.at("seconds_per_frame").get_to(v.seconds_per_frame);
+    // 省略時は通常モード
+    v.compact = j.value("compact", false);
+    v.fast_path = j.value("fast_path", false);
 }
 
 } // namespace digitalcurling::simulators
@@ -6,8 +6,11 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string_view>
+#include <vector>
 #include <nlohmann/json.hpp>
 #include "digitalcurling/simulators/i_simulator.hpp"
 #include "digitalcurling/simulators/i_simulator_factory.hpp"
@@ -25,6 +28,22 @@ public:
     /// ただし，フレームレートをデフォルトの値から変更した際の動作の保証はしません。
     float seconds_per_frame = 0.001f;
 
+    /// @brief コンパクトモード
+    ///
+    /// `true` の場合、生成されるシミュレーターは Box2D のワールドを持たず、ストーンの状態のみを保持します。
+    /// `Step()` の間はスレッドごとに共有されたワールドを使用するため、多数のシミュレーターを同時に保持する場合のメモリ使用量を大きく削減できます。
+    /// ただし、他のシミュレーターが同じスレッドで `Step()` を呼び出した後はワールドを作り直すため、交互に `Step()` を呼び出す場合は遅くなります。
+    bool compact = false;
+
+    /// @brief 衝突のない経路の高速化
+    ///
+    /// `true` の場合、1個のストーンだけが動き他のストーンが静止している盤面で、
+    /// 空のシートで停止するまで進めた経路から2×`Stone::kRadius` 以内に他のストーンが無ければ、
+    /// Box2D が1個のボディに行う積分と同じ計算で、Box2D を使わずに進めます。結果は Box2D で進めた場合と一致します。
+    ///
+    /// 高速化を行ったショットとフレームの数は `GetStats()` の `fast_path_*` で確認できます。
+    bool fast_path = false;
+
     /// @brief デフォルトコンストラクタ
     SimulatorFCV1Factory() = default;
     /// @brief コピーコンストラクタ
@@ -38,6 +57,16 @@ public:
 
     virtual std::unique_ptr<ISimulator> CreateSimulator() const override;
     virtual std::unique_ptr<ISimulatorFactory> Clone() const override;
+
+    /// @brief バイナリ形式のバージョン
+    static constexpr unsigned int kBinaryStateVersion = 3;
+    /// @brief 状態をバイナリ形式で書き込む
+    /// @param[out] out 書き込み先 (末尾に追記される)
+    void ToBinary(std::vector<std::uint8_t> & out) const;
+    /// @brief バイナリ形式の状態を読み込む
+    /// @param[in] data データ
+    /// @param[in] size `data` のバイト数
+    void FromBinary(std::uint8_t const* data, std::size_t size);
 };
 
 
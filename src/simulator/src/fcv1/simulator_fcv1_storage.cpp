@@ -1,14 +1,52 @@
 ﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
 // SPDX-License-Identifier: MIT
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 #include <nlohmann/json.hpp>
 #include "digitalcurling/common.hpp"
+#include "digitalcurling/plugins/binary_state.hpp"
 #include "simulator_fcv1.hpp"
 #include "simulator_fcv1_storage.hpp"
 
 namespace digitalcurling::simulators {
 
+namespace {
+
+// バイナリ形式 (バージョン 3)
+//   float   factory.seconds_per_frame
+//   uint8   factory.compact
+//   uint8   factory.fast_path
+//   16 x { uint8 存在フラグ, (存在する場合) StoneState }
+//   uint32  衝突数
+//   衝突数 x { uint8 a.id, StoneState a.stone, uint8 b.id, StoneState b.stone, float normal_impulse, float tangent_impulse }
+// StoneState は float 6 個 (position.x, position.y, angle, translational_velocity.x, translational_velocity.y, angular_velocity)
+
+void WriteStoneState(plugins::BinaryStateWriter & writer, ISimulator::StoneState const& stone) {
+    writer.Write(stone.position.x);
+    writer.Write(stone.position.y);
+    writer.Write(stone.angle);
+    writer.Write(stone.translational_velocity.x);
+    writer.Write(stone.translational_velocity.y);
+    writer.Write(stone.angular_velocity);
+}
+ISimulator::StoneState ReadStoneState(plugins::BinaryStateReader & reader) {
+    ISimulator::StoneState stone;
+    stone.position.x = reader.Read<float>();
+    stone.position.y = reader.Read<float>();
+    stone.angle = reader.Read<float>();
+    stone.translational_velocity.x = reader.Read<float>();
+    stone.translational_velocity.y = reader.Read<float>();
+    stone.angular_velocity = reader.Read<float>();
+    return stone;
+}
+
+} // unnamed namespace
+
 SimulatorFCV1Storage::SimulatorFCV1Storage(SimulatorFCV1Factory const& factory)
     : factory(factory)
     , stones()
@@ -25,6 +63,57 @@ std::unique_ptr<ISimulator> SimulatorFCV1Storage::CreateSimulator() const {
     return std::make_unique<SimulatorFCV1>(*this);
 }
 
+void SimulatorFCV1Storage::ToBinary(std::vector<std::uint8_t> & out) const {
+    plugins::BinaryStateWriter writer(out);
+    writer.Write(factory.seconds_per_frame);
+    writer.Write(static_cast<std::uint8_t>(factory.compact));
+    writer.Write(static_cast<std::uint8_t>(factory.fast_path));
+    for (auto const& stone : stones) {
+        writer.Write(static_cast<std::uint8_t>(stone.has_value()));
+        if (stone) WriteStoneState(writer, *stone);
+    }
+    writer.Write(static_cast<std::uint32_t>(collisions.size()));
+    for (auto const& collision : collisions) {
+        writer.Write(collision.a.id);
+        WriteStoneState(writer, collision.a.stone);
+        writer.Write(collision.b.id);
+        WriteStoneState(writer, collision.b.stone);
+        writer.Write(collision.normal_impulse);
+        writer.Write(collision.tangent_impulse);
+    }
+}
+void SimulatorFCV1Storage::FromBinary(std::uint8_t const* data, std::size_t size) {
+    plugins::BinaryStateReader reader(data, size);
+
+    SimulatorFCV1Factory new_factory;
+    new_factory.seconds_per_frame = reader.Read<float>();
+    new_factory.compact = reader.Read<std::uint8_t>() != 0;
+    new_factory.fast_path = reader.Read<std::uint8_t>() != 0;
+
+    ISimulator::AllStones new_stones;
+    for (auto & stone : new_stones) {
+        if (reader.Read<std::uint8_t>()) stone = ReadStoneState(reader);
+    }
+
+    auto const num_collisions = reader.Read<std::uint32_t>();
+    std::vector<ISimulator::Collision> new_collisions;
+    for (std::uint32_t i = 0; i < num_collisions; ++i) {
+        ISimulator::Collision collision;
+        collision.a.id = reader.Read<std::uint8_t>();
+        collision.a.stone = ReadStoneState(reader);
+        collision.b.id = reader.Read<std::uint8_t>();
+        collision.b.stone = ReadStoneState(reader);
+        collision.normal_impulse = reader.Read<float>();
+        collision.tangent_impulse = reader.Read<float>();
+        new_collisions.push_back(collision);
+    }
+    if (!reader.IsEnd()) throw std::invalid_argument("SimulatorFCV1Storage: trailing data.");
+
+    factory = new_factory;
+    stones = new_stones;
+    collisions = std::move(new_collisions);
+}
+
 // json
 void to_json(nlohmann::json & j, SimulatorFCV1Storage const& v) {
     j["type"] = DIGITALCURLING_PLUGIN_NAME;
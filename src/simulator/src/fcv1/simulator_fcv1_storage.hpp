@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <nlohmann/json.hpp>
@@ -33,6 +35,18 @@ public:
 
     virtual std::unique_ptr<ISimulator> CreateSimulator() const override;
 
+    /// @brief バイナリ形式のバージョン
+    static constexpr unsigned int kBinaryStateVersion = 3;
+    /// @brief 状態をバイナリ形式で書き込む
+    /// @param[out] out 書き込み先 (末尾に追記される)
+    void ToBinary(std::vector<std::uint8_t> & out) const;
+    /// @brief バイナリ形式の状態を読み込む
+    ///
+    /// 読み込みに失敗した場合、このストレージの状態は変更されません。
+    /// @param[in] data データ
+    /// @param[in] size `data` のバイト数
+    void FromBinary(std::uint8_t const* data, std::size_t size);
+
     /// @brief このストレージに保存されたシミュレータのファクトリー情報
     SimulatorFCV1Factory factory;
     /// @brief 全ストーンの位置と速度
@@ -0,0 +1,13 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+#include "fcv1_fast.hpp"
+#include "simulator_fcv1_fast.hpp"
+#include "digitalcurling/plugins/simulator_plugin_export.hpp"
+
+DIGITALCURLING_EXPORT_INVERTIBLE_SIMULATOR_PLUGIN(
+    digitalcurling::simulators::SimulatorFCV1FastFactory,
+    digitalcurling::simulators::SimulatorFCV1FastStorage,
+    digitalcurling::simulators::SimulatorFCV1Fast,
+    &digitalcurling::simulators::SimulatorFCV1Fast::CalculateShot
+)
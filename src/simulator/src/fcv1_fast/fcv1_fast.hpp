@@ -0,0 +1,6 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#define DIGITALCURLING_PLUGIN_NAME u8"fcv1_fast"
@@ -0,0 +1,431 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+#include "digitalcurling/simulators/fcv1_motion.hpp"
+#include "fcv1_fast.hpp"
+#include "simulator_fcv1_fast.hpp"
+
+namespace digitalcurling::simulators {
+
+namespace {
+
+using StatsClock = std::chrono::steady_clock;
+
+// FCV1 の減速の式 dv/dt = -(kA / (v + kB) + kC) の係数 (FCV1 の運動モデルの係数から求める)
+constexpr double kA = double(fcv1::kFrictionA) * double(fcv1::kGravity);
+constexpr double kB = fcv1::kFrictionB;
+constexpr double kC = double(fcv1::kFrictionC) * double(fcv1::kGravity);
+// FCV1 の曲がりの式 (ヨーレート ±kYawCoefficient * v^-0.8) の係数
+constexpr double kYawCoefficient = fcv1::kYawCoefficient;
+// FCV1 の回転の減衰の式 (±kSpinDecay / max(v, kSpinDecayMinSpeed)) の係数
+constexpr double kSpinDecay = fcv1::kSpinDecay;
+constexpr double kSpinDecayMinSpeed = fcv1::kSpinDecayMinSpeed;
+
+constexpr double kContactDistance = 2.0 * Stone::kRadius;
+// 1フレームで処理する衝突の数の上限 (押し合いが続く場合に無限ループにならないようにする)
+constexpr int kMaxContactsPerFrame = 128;
+// CalculateShot() で目標地点まで走行させる際の区間の数
+constexpr int kCalculateShotSegments = 64;
+
+// 以下, u = v + kB とおく (dt = u / (kA + kC u) du)
+
+// 時間の原始関数
+double TimeIntegral(double u)
+{
+    return u / kC - kA / (kC * kC) * std::log(kA + kC * u);
+}
+
+// 走行距離の原始関数 (ds = v dt)
+double DistanceIntegral(double u)
+{
+    constexpr double k = kA / kC + kB;
+    return u * u / (2. * kC) - k * u / kC + k * kA / (kC * kC) * std::log(kA + kC * u);
+}
+
+// 回転の減衰量の原始関数 (v >= kSpinDecayMinSpeed の範囲)
+double SpinDecayIntegral(double v)
+{
+    constexpr double alpha = kB / (kA + kC * kB);
+    constexpr double beta = kA / (kA + kC * kB);
+    return kSpinDecay * (alpha * std::log(v) + beta / kC * std::log(kA + kC * (v + kB)));
+}
+
+// 速さが v0 から v1 (< v0) に減速する間の回転の減衰量
+double SpinDecay(double v0, double v1)
+{
+    double decay = 0.;
+    if (v0 > kSpinDecayMinSpeed) {
+        decay += SpinDecayIntegral(v0) - SpinDecayIntegral(std::max(v1, kSpinDecayMinSpeed));
+    }
+    if (v1 < kSpinDecayMinSpeed) {
+        double const time = TimeIntegral(std::min(v0, kSpinDecayMinSpeed) + kB) - TimeIntegral(v1 + kB);
+        decay += kSpinDecay / kSpinDecayMinSpeed * time;
+    }
+    return decay;
+}
+
+// 速さが v0 から v1 (< v0) に減速する間に進行方向が曲がる角度 (の大きさ)
+// v^-0.8 dv = 5 dw (w = v^0.2) と変数変換し, Simpson 則で積分する
+double TurnAngle(double v0, double v1)
+{
+    auto const integrand = [](double w) {
+        double const v = w * w * w * w * w;
+        return (v + kB) / (kA + kC * (v + kB));
+    };
+    double const w0 = std::pow(v0, 0.2);
+    double const w1 = std::pow(v1, 0.2);
+    return kYawCoefficient * 5. * (w0 - w1) / 6. * (integrand(w0) + 4. * integrand((w0 + w1) / 2.) + integrand(w1));
+}
+
+// 他のストーンと接触せずに dt 秒進める
+void Fly(ISimulator::StoneState & stone, double dt)
+{
+    double const vx = stone.translational_velocity.x;
+    double const vy = stone.translational_velocity.y;
+    double const v0 = std::sqrt(vx * vx + vy * vy);
+    double const spin0 = std::abs(stone.angular_velocity);
+
+    double v1 = 0.;
+    double moving_time = 0.;
+    if (v0 > 0.) {
+        double const u0 = v0 + kB;
+        double const t0 = TimeIntegral(u0);
+        double const stop_time = t0 - TimeIntegral(kB);
+        if (dt >= stop_time) {
+            moving_time = stop_time;
+        } else {
+            // TimeIntegral(u) = t0 - dt を Newton 法で解く (TimeIntegral は単調増加)
+            moving_time = dt;
+            double const target = t0 - dt;
+            double u = std::max(kB, u0 - dt * (kA / u0 + kC));
+            for (int i = 0; i < 8; ++i) {
+                double const delta = (TimeIntegral(u) - target) * (kA + kC * u) / u;
+                u = std::max(kB, u - delta);
+                if (std::abs(delta) < 1e-12) break;
+            }
+            v1 = u - kB;
+        }
+
+        double const distance = DistanceIntegral(u0) - DistanceIntegral(v1 + kB);
+        double const heading = std::atan2(vy, vx);
+        // FCV1 と同様に, 回転していないとみなせる場合は曲がらない
+        bool const curls = spin0 > std::numeric_limits<float>::epsilon();
+        double const turn = curls ? std::copysign(TurnAngle(v0, v1), static_cast<double>(stone.angular_velocity)) : 0.;
+        // 区間の両端の進行方向の平均の方向に, 円弧の弦の長さだけ進める
+        double const chord = std::abs(turn) > 1e-9 ? std::sin(turn / 2.) / (turn / 2.) : 1.;
+        double const mid_heading = heading + turn / 2.;
+        stone.position.x += static_cast<float>(distance * chord * std::cos(mid_heading));
+        stone.position.y += static_cast<float>(distance * chord * std::sin(mid_heading));
+        stone.translational_velocity.x = static_cast<float>(v1 * std::cos(heading + turn));
+        stone.translational_velocity.y = static_cast<float>(v1 * std::sin(heading + turn));
+    }
+
+    if (spin0 > 0.) {
+        double const decay = SpinDecay(v0, v1) + kSpinDecay / kSpinDecayMinSpeed * (dt - moving_time);
+        double const spin1 = std::max(spin0 - decay, 0.);
+        double const sign = stone.angular_velocity > 0.f ? 1. : -1.;
+        stone.angle += static_cast<float>(sign * (spin0 + spin1) / 2. * dt);
+        stone.angular_velocity = static_cast<float>(sign * spin1);
+    }
+}
+
+bool IsMoving(std::optional<ISimulator::StoneState> const& stone)
+{
+    return stone && (stone->translational_velocity.x != 0.f || stone->translational_velocity.y != 0.f || stone->angular_velocity != 0.f);
+}
+
+std::uint64_t ElapsedNanoseconds(StatsClock::time_point begin, StatsClock::time_point end)
+{
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+}
+
+} // unnamed namespace
+
+
+SimulatorFCV1Fast::SimulatorFCV1Fast(SimulatorFCV1FastFactory const& factory)
+    : SimulatorFCV1Fast(SimulatorFCV1FastStorage(factory))
+{}
+
+SimulatorFCV1Fast::SimulatorFCV1Fast(SimulatorFCV1FastStorage const& storage)
+    : storage_(storage)
+    , all_stones_stopped_() // UpdateAllStonesStopped で上書きされる
+{
+    UpdateAllStonesStopped();
+}
+
+const char* SimulatorFCV1Fast::GetId() const noexcept
+{
+    return DIGITALCURLING_PLUGIN_NAME;
+}
+
+void SimulatorFCV1Fast::SetStones(ISimulator::AllStones const& stones)
+{
+    Counters::Add(counters_.set_stones_calls, 1);
+    storage_.stones = stones;
+    UpdateAllStonesStopped();
+}
+
+void SimulatorFCV1Fast::Step()
+{
+    auto const motion_begin = StatsClock::now();
+    storage_.collisions.clear();
+
+    auto & stones = storage_.stones;
+    double remaining = storage_.factory.seconds_per_frame;
+    for (int contacts = 0; remaining > 0.; ++contacts) {
+        // フレームの残りの時間を, 衝突が無いものとして進めた位置
+        ISimulator::AllStones next = stones;
+        for (auto & stone : next) {
+            if (IsMoving(stone)) Fly(*stone, remaining);
+        }
+
+        // 各ストーンがフレームの残りの時間で直線上を等速で進むとみなし, 最初に接触する組を求める
+        double first = 2.;  // 残りの時間に対する接触時刻の割合
+        std::uint8_t first_a = 0;
+        std::uint8_t first_b = 0;
+        if (contacts < kMaxContactsPerFrame) {
+            for (std::uint8_t a = 0; a < StoneCoordinate::kStoneMax; ++a) {
+                if (!stones[a]) continue;
+                for (std::uint8_t b = a + 1; b < StoneCoordinate::kStoneMax; ++b) {
+                    if (!stones[b]) continue;
+                    double const px = stones[b]->position.x - stones[a]->position.x;
+                    double const py = stones[b]->position.y - stones[a]->position.y;
+                    double const c = px * px + py * py - kContactDistance * kContactDistance;
+                    double s = 0.;
+                    if (c <= 0.) {
+                        // 既に接触している場合は, 近づいている場合のみ衝突とする
+                        double const rvx = stones[b]->translational_velocity.x - stones[a]->translational_velocity.x;
+                        double const rvy = stones[b]->translational_velocity.y - stones[a]->translational_velocity.y;
+                        if (px * rvx + py * rvy >= 0.) continue;
+                    } else {
+                        double const dx = (next[b]->position.x - next[a]->position.x) - px;
+                        double const dy = (next[b]->position.y - next[a]->position.y) - py;
+                        double const half_b = px * dx + py * dy;
+                        if (half_b >= 0.) continue;  // 離れていく
+                        double const a2 = dx * dx + dy * dy;
+                        double const discriminant = half_b * half_b - a2 * c;
+                        if (discriminant < 0.) continue;
+                        s = (-half_b - std::sqrt(discriminant)) / a2;
+                        if (s > 1.) continue;
+                    }
+                    if (s < first) {
+                        first = s;
+                        first_a = a;
+                        first_b = b;
+                    }
+                }
+            }
+        }
+
+        if (first > 1.) {
+            stones = next;
+            break;
+        }
+
+        // 接触時刻まで全てのストーンを進めてから衝突を処理する
+        double const contact_time = first * remaining;
+        if (contact_time > 0.) {
+            for (auto & stone : stones) {
+                if (IsMoving(stone)) Fly(*stone, contact_time);
+            }
+        }
+        remaining -= contact_time;
+        ResolveContact(first_a, first_b);
+    }
+
+    UpdateAllStonesStopped();
+
+    Counters::Add(counters_.frames, 1);
+    Counters::Add(counters_.motion_nanoseconds, ElapsedNanoseconds(motion_begin, StatsClock::now()));
+}
+
+void SimulatorFCV1Fast::ResolveContact(std::uint8_t a, std::uint8_t b)
+{
+    // 接触を検出した数 (撃力を加えずに離れる場合も含む)
+    Counters::Add(counters_.contacts_begun, 1);
+
+    auto & stone_a = *storage_.stones[a];
+    auto & stone_b = *storage_.stones[b];
+
+    double nx = stone_b.position.x - stone_a.position.x;
+    double ny = stone_b.position.y - stone_a.position.y;
+    double const distance = std::sqrt(nx * nx + ny * ny);
+    if (distance <= 0.) return;
+    nx /= distance;
+    ny /= distance;
+
+    // 直線近似による接触時刻の誤差で重なった分を押し戻す
+    if (distance < kContactDistance) {
+        auto const push = static_cast<float>((kContactDistance - distance) / 2.);
+        stone_a.position.x -= static_cast<float>(nx) * push;
+        stone_a.position.y -= static_cast<float>(ny) * push;
+        stone_b.position.x += static_cast<float>(nx) * push;
+        stone_b.position.y += static_cast<float>(ny) * push;
+    }
+
+    double const rvx = stone_b.translational_velocity.x - stone_a.translational_velocity.x;
+    double const rvy = stone_b.translational_velocity.y - stone_a.translational_velocity.y;
+    double const normal_velocity = rvx * nx + rvy * ny;
+    if (normal_velocity >= 0.) return;
+
+    // 反発係数 1 の法線方向の撃力 (2つのストーンの質量は等しい)
+    double const normal_impulse = -kStoneMass * normal_velocity;
+    // 接触点の接線方向の相対速度を打ち消す撃力 (クーロン摩擦で制限する)
+    // ストーンを一様な円板とみなすと, 接線方向の有効質量は kStoneMass / 6
+    double const tx = -ny;
+    double const ty = nx;
+    double const tangent_velocity = rvx * tx + rvy * ty - Stone::kRadius * (stone_a.angular_velocity + stone_b.angular_velocity);
+    double const max_tangent_impulse = kStoneFriction * normal_impulse;
+    double const tangent_impulse = std::clamp(-kStoneMass * tangent_velocity / 6., -max_tangent_impulse, max_tangent_impulse);
+
+    double const ix = normal_impulse * nx + tangent_impulse * tx;
+    double const iy = normal_impulse * ny + tangent_impulse * ty;
+    double const inertia = 0.5 * kStoneMass * Stone::kRadius * Stone::kRadius;
+    auto const dvx = static_cast<float>(ix / kStoneMass);
+    auto const dvy = static_cast<float>(iy / kStoneMass);
+    auto const dw = static_cast<float>(tangent_impulse * Stone::kRadius / inertia);
+    stone_a.translational_velocity.x -= dvx;
+    stone_a.translational_velocity.y -= dvy;
+    stone_a.angular_velocity -= dw;
+    stone_b.translational_velocity.x += dvx;
+    stone_b.translational_velocity.y += dvy;
+    stone_b.angular_velocity -= dw;
+
+    storage_.collisions.emplace_back(
+        Collision::CollisionStone(a, stone_a),
+        Collision::CollisionStone(b, stone_b),
+        static_cast<float>(normal_impulse),
+        static_cast<float>(tangent_impulse));
+    Counters::Add(counters_.contacts_solved, 1);
+}
+
+void SimulatorFCV1Fast::UpdateAllStonesStopped()
+{
+    all_stones_stopped_ = std::none_of(storage_.stones.begin(), storage_.stones.end(), IsMoving);
+}
+
+ISimulator::AllStones const& SimulatorFCV1Fast::GetStones() const
+{
+    return storage_.stones;
+}
+
+std::vector<ISimulator::Collision> const& SimulatorFCV1Fast::GetCollisions() const
+{
+    return storage_.collisions;
+}
+
+bool SimulatorFCV1Fast::AreAllStonesStopped() const
+{
+    return all_stones_stopped_;
+}
+
+float SimulatorFCV1Fast::GetSecondsPerFrame() const
+{
+    return storage_.factory.seconds_per_frame;
+}
+
+ISimulatorFactory const& SimulatorFCV1Fast::GetFactory() const
+{
+    return storage_.factory;
+}
+
+std::unique_ptr<ISimulatorStorage> SimulatorFCV1Fast::CreateStorage() const
+{
+    return std::make_unique<SimulatorFCV1FastStorage>(storage_);
+}
+
+void SimulatorFCV1Fast::Save(ISimulatorStorage & storage) const
+{
+    static_cast<SimulatorFCV1FastStorage &>(storage) = storage_;
+}
+
+void SimulatorFCV1Fast::Load(ISimulatorStorage const& storage)
+{
+    Counters::Add(counters_.load_calls, 1);
+    storage_ = static_cast<SimulatorFCV1FastStorage const&>(storage);
+    UpdateAllStonesStopped();
+}
+
+SimulatorStats SimulatorFCV1Fast::GetStats() const
+{
+    constexpr double kNanosecondsToSeconds = 1e-9;
+
+    SimulatorStats stats;
+    stats.frames = counters_.frames.load(std::memory_order_relaxed);
+    stats.contacts_begun = counters_.contacts_begun.load(std::memory_order_relaxed);
+    stats.contacts_solved = counters_.contacts_solved.load(std::memory_order_relaxed);
+    stats.out_of_sheet_removals = counters_.out_of_sheet_removals.load(std::memory_order_relaxed);
+    stats.set_stones_calls = counters_.set_stones_calls.load(std::memory_order_relaxed);
+    stats.load_calls = counters_.load_calls.load(std::memory_order_relaxed);
+    stats.motion_seconds = static_cast<double>(counters_.motion_nanoseconds.load(std::memory_order_relaxed)) * kNanosecondsToSeconds;
+    return stats;
+}
+
+void SimulatorFCV1Fast::RecordOutOfSheetRemovals(std::size_t count)
+{
+    Counters::Add(counters_.out_of_sheet_removals, static_cast<std::uint64_t>(count));
+}
+
+moves::Shot SimulatorFCV1Fast::CalculateShot(Vector2 const& target_position, float const target_speed, float const shot_angular_velocity) const {
+    if (target_speed < 0.f)
+        throw std::invalid_argument("SimulatorFCV1Fast::CalculateShot: target_speed must be non-negative.");
+    if (target_speed > 4.f)
+        throw std::invalid_argument("SimulatorFCV1Fast::CalculateShot: target_speed is too large.");
+
+    double const target_r = target_position.Length();
+    if (target_r < 0.1)
+        throw std::invalid_argument("SimulatorFCV1Fast::CalculateShot: target_position is too close to the origin.");
+
+    float const angular_velocity = static_cast<float>(std::acos(-1.0) / 2.0) * (shot_angular_velocity > 0 ? 1.f : -1.f);
+    double const target_u = target_speed + kB;
+
+    // y軸方向に投げたストーンが target_speed まで減速した地点
+    auto const fly = [angular_velocity, target_u](double v0_speed) {
+        ISimulator::StoneState stone(Vector2(), 0.f, Vector2(0.f, static_cast<float>(v0_speed)), angular_velocity);
+        double const time = (TimeIntegral(v0_speed + kB) - TimeIntegral(target_u)) / kCalculateShotSegments;
+        for (int i = 0; i < kCalculateShotSegments; ++i) Fly(stone, time);
+        return stone.position;
+    };
+
+    // 走行距離 path で target_speed まで減速する初速を Newton 法で求める
+    // DistanceIntegral は u > kB で単調増加かつ下に凸なので, 解より大きい初期値から単調に収束する
+    auto const initial_speed = [target_u, target_speed](double path) {
+        double const target = DistanceIntegral(target_u) + path;
+        double const max_deceleration = kA / kB + kC;
+        double u = std::sqrt(static_cast<double>(target_speed) * target_speed + 2. * max_deceleration * path) + kB;
+        for (int i = 0; i < 32; ++i) {
+            double const delta = (DistanceIntegral(u) - target) * (kA + kC * u) / (u * (u - kB));
+            u -= delta;
+            if (std::abs(delta) < 1e-10) break;
+        }
+        return u - kB;
+    };
+
+    // 曲がりによって直線距離が走行距離より短くなる分を補正する
+    double path = target_r;
+    double v0_speed = initial_speed(path);
+    Vector2 delta = fly(v0_speed);
+    for (int i = 0; i < 4; ++i) {
+        double const chord = delta.Length();
+        if (chord <= 0.) break;
+        path *= target_r / chord;
+        v0_speed = initial_speed(path);
+        delta = fly(v0_speed);
+    }
+
+    float const delta_angle = std::atan2(delta.x, delta.y); // 注: delta.x, delta.y の順番で良い
+    float const target_angle = std::atan2(target_position.y, target_position.x);
+    float const v0_angle = target_angle + delta_angle; // 発射方向
+    return moves::Shot { static_cast<float>(v0_speed), angular_velocity, v0_angle };
+}
+
+} // namespace digitalcurling::simulators
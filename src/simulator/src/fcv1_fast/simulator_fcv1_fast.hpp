@@ -0,0 +1,103 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// @brief SimulatorFCV1Fast を定義
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "digitalcurling/moves/shot.hpp"
+#include "digitalcurling/simulators/i_simulator.hpp"
+
+#include "simulator_fcv1_fast_factory.hpp"
+#include "simulator_fcv1_fast_storage.hpp"
+
+namespace digitalcurling::simulators {
+
+
+/// @brief シミュレータ FCV1 の高速な近似 (ロールアウト向け)
+///
+/// FCV1 と同じ減速と曲がりの式を用いますが、次のように精度よりも速度を優先します。
+/// - 自由走行は FCV1 の運動方程式の解析解 (速さと走行距離) と数値積分 (曲がり) で、1フレームを1区間として計算します。
+/// - ストーン同士の衝突は、フレーム内の接触時刻まで全てのストーンを進めた上で、瞬間的な撃力 (完全弾性・摩擦あり) で処理します。
+/// - Box2D を使用しないため、接触が複数フレーム続く場合の挙動 (押し合いなど) は再現しません。
+///
+/// FCV1 に対する誤差は docs/simulators.md を参照してください。
+class SimulatorFCV1Fast : public ISimulator {
+public:
+    /// @brief ストーンの質量[kg]
+    static constexpr float kStoneMass = 19.96f;
+    /// @brief ストーン同士の摩擦係数
+    static constexpr float kStoneFriction = 0.2f;
+
+    /// @brief コンストラクタ
+    /// @param factory このシミュレーターのファクトリー
+    explicit SimulatorFCV1Fast(SimulatorFCV1FastFactory const& factory);
+    /// @brief コンストラクタ
+    /// @param storage このシミュレーターのストレージ
+    explicit SimulatorFCV1Fast(SimulatorFCV1FastStorage const& storage);
+
+    virtual const char* GetId() const noexcept override;
+
+    virtual ISimulator::AllStones const& GetStones() const override;
+    virtual void SetStones(ISimulator::AllStones const& stones) override;
+
+    virtual void Step() override;
+    virtual std::vector<Collision> const& GetCollisions() const override;
+    virtual bool AreAllStonesStopped() const override;
+    virtual float GetSecondsPerFrame() const override;
+
+    virtual ISimulatorFactory const& GetFactory() const override;
+
+    virtual std::unique_ptr<ISimulatorStorage> CreateStorage() const override;
+    virtual void Save(ISimulatorStorage & storage) const override;
+    virtual void Load(ISimulatorStorage const& storage) override;
+
+    virtual SimulatorStats GetStats() const override;
+
+    /// @brief シート外に出たストーンを取り除いたことを記録する
+    /// @param count 取り除いたストーンの数
+    void RecordOutOfSheetRemovals(std::size_t count);
+
+    /// @brief 指定地点を指定速度で通過するショットを逆算する
+    ///
+    /// 自由走行の解析解を用いて求めるため、FCV1 の `CalculateShot()` よりも高速です。
+    /// @param target_position 目標地点
+    /// @param target_speed 目標地点到達時の速度
+    /// @param shot_angular_velocity ショットの回転速度
+    /// @return 推測されたショット
+    virtual moves::Shot CalculateShot(Vector2 const& target_position, float const target_speed, float const shot_angular_velocity) const;
+
+private:
+    // 性能カウンター
+    // 書き込みはこのインスタンスを操作するスレッドのみが行い、読み出しは他のスレッドからも行えるようにする
+    struct Counters {
+        std::atomic<std::uint64_t> frames{0};
+        std::atomic<std::uint64_t> contacts_begun{0};
+        std::atomic<std::uint64_t> contacts_solved{0};
+        std::atomic<std::uint64_t> out_of_sheet_removals{0};
+        std::atomic<std::uint64_t> set_stones_calls{0};
+        std::atomic<std::uint64_t> load_calls{0};
+        std::atomic<std::uint64_t> motion_nanoseconds{0};
+
+        // 書き込みは1スレッドのみのため, read-modify-write 命令を使わずに加算する
+        static void Add(std::atomic<std::uint64_t>& counter, std::uint64_t value) {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+    };
+
+    SimulatorFCV1FastStorage storage_;
+    bool all_stones_stopped_;
+    Counters counters_;
+
+    // ストーンの衝突を処理し, 衝突を記録する
+    void ResolveContact(std::uint8_t a, std::uint8_t b);
+    void UpdateAllStonesStopped();
+};
+
+} // namespace digitalcurling::simulators
@@ -0,0 +1,57 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "digitalcurling/common.hpp"
+#include "digitalcurling/plugins/binary_state.hpp"
+#include "fcv1_fast.hpp"
+#include "simulator_fcv1_fast_factory.hpp"
+#include "simulator_fcv1_fast.hpp"
+
+namespace digitalcurling::simulators {
+
+const char* SimulatorFCV1FastFactory::GetId() const noexcept {
+    return DIGITALCURLING_PLUGIN_NAME;
+}
+
+nlohmann::json SimulatorFCV1FastFactory::ToJson() const {
+    nlohmann::json j;
+    to_json(j, *this);
+    return j;
+}
+
+std::unique_ptr<ISimulator> SimulatorFCV1FastFactory::CreateSimulator() const {
+    return std::make_unique<SimulatorFCV1Fast>(*this);
+}
+
+std::unique_ptr<ISimulatorFactory> SimulatorFCV1FastFactory::Clone() const {
+    return std::make_unique<SimulatorFCV1FastFactory>(*this);
+}
+
+void SimulatorFCV1FastFactory::ToBinary(std::vector<std::uint8_t> & out) const {
+    plugins::BinaryStateWriter writer(out);
+    writer.Write(seconds_per_frame);
+}
+void SimulatorFCV1FastFactory::FromBinary(std::uint8_t const* data, std::size_t size) {
+    plugins::BinaryStateReader reader(data, size);
+    auto const spf = reader.Read<float>();
+    if (!reader.IsEnd()) throw std::invalid_argument("SimulatorFCV1FastFactory: trailing data.");
+    seconds_per_frame = spf;
+}
+
+// json
+void to_json(nlohmann::json & j, SimulatorFCV1FastFactory const& v) {
+    j["type"] = DIGITALCURLING_PLUGIN_NAME;
+    j["seconds_per_frame"] = v.seconds_per_frame;
+}
+void from_json(nlohmann::json const& j, SimulatorFCV1FastFactory & v) {
+    // 省略時は既定値 (fcv1 の設定の "type" のみを書き換えて使用できるようにする)
+    v.seconds_per_frame = j.value("seconds_per_frame", SimulatorFCV1FastFactory().seconds_per_frame);
+}
+
+} // namespace digitalcurling::simulators
@@ -0,0 +1,64 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// @brief SimulatorFCV1FastFactory を定義
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "digitalcurling/simulators/i_simulator.hpp"
+#include "digitalcurling/simulators/i_simulator_factory.hpp"
+
+namespace digitalcurling::simulators {
+
+/// @brief シミュレータ FCV1 Fast のファクトリー
+///
+/// @note ID (`"fcv1_fast"`) は fcv1_fast.hpp で定義されます。
+/// シミュレータ FCV1 のヘッダーと同じ翻訳単位で使用できるよう、このヘッダーでは `DIGITALCURLING_PLUGIN_NAME` を使用しません。
+class SimulatorFCV1FastFactory : public ISimulatorFactory {
+public:
+    /// @brief 1フレームの時間(秒)
+    ///
+    /// 1回の `Step()` で進める時間です。
+    /// フレーム内の自由走行は解析解で計算し、衝突はフレーム内の衝突時刻で処理するため、
+    /// FCV1 ( 0.001 秒) よりも大きな値を使用できます。
+    float seconds_per_frame = 0.05f;
+
+    /// @brief デフォルトコンストラクタ
+    SimulatorFCV1FastFactory() = default;
+    /// @brief コピーコンストラクタ
+    SimulatorFCV1FastFactory(SimulatorFCV1FastFactory const&) = default;
+    /// @brief コピー代入演算子
+    SimulatorFCV1FastFactory & operator = (SimulatorFCV1FastFactory const&) = default;
+    virtual ~SimulatorFCV1FastFactory() override = default;
+
+    virtual const char* GetId() const noexcept override;
+    virtual nlohmann::json ToJson() const override;
+
+    virtual std::unique_ptr<ISimulator> CreateSimulator() const override;
+    virtual std::unique_ptr<ISimulatorFactory> Clone() const override;
+
+    /// @brief バイナリ形式のバージョン
+    static constexpr unsigned int kBinaryStateVersion = 1;
+    /// @brief 状態をバイナリ形式で書き込む
+    /// @param[out] out 書き込み先 (末尾に追記される)
+    void ToBinary(std::vector<std::uint8_t> & out) const;
+    /// @brief バイナリ形式の状態を読み込む
+    /// @param[in] data データ
+    /// @param[in] size `data` のバイト数
+    void FromBinary(std::uint8_t const* data, std::size_t size);
+};
+
+
+/// @cond Doxygen_Suppress
+// json
+void to_json(nlohmann::json &, SimulatorFCV1FastFactory const&);
+void from_json(nlohmann::json const&, SimulatorFCV1FastFactory &);
+/// @endcond
+
+} // namespace digitalcurling::simulators
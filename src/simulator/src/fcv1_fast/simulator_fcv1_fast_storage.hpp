@@ -0,0 +1,65 @@
+﻿// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// @brief SimulatorFCV1FastStorage を定義
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "digitalcurling/simulators/i_simulator_storage.hpp"
+#include "simulator_fcv1_fast_factory.hpp"
+
+namespace digitalcurling::simulators {
+
+/// @brief シミュレータ FCV1 Fast のストレージ
+class SimulatorFCV1FastStorage : public ISimulatorStorage {
+public:
+    /// @brief デフォルトコンストラクタ
+    SimulatorFCV1FastStorage() = default;
+    /// @brief コピーコンストラクタ
+    SimulatorFCV1FastStorage(SimulatorFCV1FastStorage const&) = default;
+    /// @brief コピー代入演算子
+    SimulatorFCV1FastStorage & operator = (SimulatorFCV1FastStorage const&) = default;
+    /// @brief コンストラクタ
+    /// @param factory ストレージを初期化するためのファクトリー
+    SimulatorFCV1FastStorage(SimulatorFCV1FastFactory const& factory);
+    virtual ~SimulatorFCV1FastStorage() override = default;
+
+    virtual const char* GetId() const noexcept override;
+    virtual nlohmann::json ToJson() const override;
+
+    virtual std::unique_ptr<ISimulator> CreateSimulator() const override;
+
+    /// @brief バイナリ形式のバージョン
+    static constexpr unsigned int kBinaryStateVersion = 1;
+    /// @brief 状態をバイナリ形式で書き込む
+    /// @param[out] out 書き込み先 (末尾に追記される)
+    void ToBinary(std::vector<std::uint8_t> & out) const;
+    /// @brief バイナリ形式の状態を読み込む
+    ///
+    /// 読み込みに失敗した場合、このストレージの状態は変更されません。
+    /// @param[in] data データ
+    /// @param[in] size `data` のバイト数
+    void FromBinary(std::uint8_t const* data, std::size_t size);
+
+    /// @brief このストレージに保存されたシミュレータのファクトリー情報
+    SimulatorFCV1FastFactory factory;
+    /// @brief 全ストーンの位置と速度
+    ISimulator::AllStones stones;
+    /// @brief 衝突情報
+    std::vector<ISimulator::Collision> collisions;
+};
+
+
+/// @cond Doxygen_Suppress
+// json
+void to_json(nlohmann::json &, SimulatorFCV1FastStorage const&);
+void from_json(nlohmann::json const&, SimulatorFCV1FastStorage &);
+/// @endcond
+
+} // namespace digitalcurling::simulators
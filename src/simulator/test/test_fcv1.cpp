@@ -1,7 +1,18 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
 #include <nlohmann/json.hpp>
 #include "common.hpp"
+#include "../src/fcv1/simulator_fcv1.hpp"
+#include "digitalcurling/simulators/fcv1_differentiable.hpp"
+#include "digitalcurling/simulators/fcv1_motion.hpp"
 #include "../src/fcv1/simulator_fcv1_factory.hpp"
 #include "../src/fcv1/simulator_fcv1_storage.hpp"
 
@@ -118,6 +129,425 @@ TEST(SimulatorFCV1, SaveLoad4)
 }
 
 
+TEST(SimulatorFCV1, StorageBinaryState)
+{
+    dcs::SimulatorFCV1Factory factory;
+    auto simulator = factory.CreateSimulator();
+
+    {
+        dcs::ISimulator::AllStones init_stones;
+        init_stones[0] = dcs::ISimulator::StoneState(dc::Vector2(0.1f, 2.f), 0.5f, dc::Vector2(-0.1f, -2.f), 1.f);
+        init_stones[15] = dcs::ISimulator::StoneState(dc::Vector2(0.1f, -4.f), 0.5f, dc::Vector2(-0.1f, -2.f), 1.f);
+        simulator->SetStones(init_stones);
+    }
+
+    // 1
+    std::shared_ptr<dcs::ISimulatorStorage> storage = simulator->CreateStorage();
+    std::vector<std::uint8_t> binary;
+    std::dynamic_pointer_cast<dcs::SimulatorFCV1Storage>(storage)->ToBinary(binary);
+    for (int i = 0; i < 10; ++i) { simulator->Step(); }
+    auto const stones1 = simulator->GetStones();
+
+    // 2
+    dcs::SimulatorFCV1Storage storage2;
+    ASSERT_NO_THROW(storage2.FromBinary(binary.data(), binary.size()));
+    auto simulator_copy = storage2.CreateSimulator();
+    for (int i = 0; i < 10; ++i) { simulator_copy->Step(); }
+    auto const stones2 = simulator_copy->GetStones();
+
+    EXPECT_TRUE(dct::EqualsSimulatorStones(stones1, stones2));
+
+    // 3. 不正なデータ
+    EXPECT_THROW(storage2.FromBinary(binary.data(), binary.size() - 1), std::invalid_argument);
+    binary.push_back(0);
+    EXPECT_THROW(storage2.FromBinary(binary.data(), binary.size()), std::invalid_argument);
+}
+
+
+TEST(SimulatorFCV1, Stats)
+{
+    dcs::SimulatorFCV1Factory factory;
+    auto simulator = factory.CreateSimulator();
+
+    auto const initial = simulator->GetStats();
+    EXPECT_EQ(initial.frames, 0u);
+    EXPECT_EQ(initial.set_stones_calls, 0u);
+    EXPECT_EQ(initial.load_calls, 0u);
+
+    // 1. 静止したストーンに衝突させる
+    {
+        dcs::ISimulator::AllStones init_stones;
+        init_stones[0] = dcs::ISimulator::StoneState(dc::Vector2(0.f, 0.f), 0.f, dc::Vector2(0.f, 2.f), 0.f);
+        init_stones[1] = dcs::ISimulator::StoneState(dc::Vector2(0.f, 1.f), 0.f, dc::Vector2(), 0.f);
+        simulator->SetStones(init_stones);
+    }
+    std::uint64_t frames = 0;
+    while (!simulator->AreAllStonesStopped()) {
+        simulator->Step();
+        ++frames;
+    }
+
+    auto const stats1 = simulator->GetStats();
+    EXPECT_EQ(stats1.frames, frames);
+    EXPECT_EQ(stats1.set_stones_calls, 1u);
+    EXPECT_GE(stats1.contacts_begun, 1u);
+    EXPECT_GE(stats1.contacts_solved, 1u);
+    EXPECT_GE(stats1.motion_seconds, 0.0);
+    EXPECT_GT(stats1.world_step_seconds, 0.0);
+
+    // 2. Load は SetStones の呼び出しとして数えず, カウンターもリセットしない
+    auto storage = factory.CreateSimulator()->CreateStorage();
+    simulator->Load(*storage);
+
+    auto const stats2 = simulator->GetStats();
+    EXPECT_EQ(stats2.frames, stats1.frames);
+    EXPECT_EQ(stats2.set_stones_calls, 1u);
+    EXPECT_EQ(stats2.load_calls, 1u);
+}
+
+TEST(SimulatorFCV1, Compact)
+{
+    dcs::SimulatorFCV1Factory factory;
+    dcs::SimulatorFCV1Factory compact_factory;
+    compact_factory.compact = true;
+
+    // 静止したストーンに衝突させる盤面と, 1個のストーンが動くだけの盤面
+    dcs::ISimulator::AllStones collision_stones;
+    collision_stones[0] = dcs::ISimulator::StoneState(dc::Vector2(0.f, 0.f), 0.f, dc::Vector2(0.f, 2.f), 1.f);
+    collision_stones[1] = dcs::ISimulator::StoneState(dc::Vector2(0.f, 1.f), 0.f, dc::Vector2(), 0.f);
+    dcs::ISimulator::AllStones single_stones;
+    single_stones[8] = dcs::ISimulator::StoneState(dc::Vector2(1.f, -2.f), 0.f, dc::Vector2(-0.2f, 2.5f), -1.f);
+
+    auto full = factory.CreateSimulator();
+    auto compact1 = compact_factory.CreateSimulator();
+    auto compact2 = compact_factory.CreateSimulator();
+    EXPECT_FALSE(dynamic_cast<dcs::SimulatorFCV1&>(*full).IsCompact());
+    EXPECT_TRUE(dynamic_cast<dcs::SimulatorFCV1&>(*compact1).IsCompact());
+
+    // 1. 接触の無い盤面では通常モードと一致する
+    full->SetStones(single_stones);
+    compact1->SetStones(single_stones);
+    while (!full->AreAllStonesStopped()) {
+        full->Step();
+        compact1->Step();
+        ASSERT_TRUE(dct::EqualsSimulatorStones(full->GetStones(), compact1->GetStones()));
+    }
+    EXPECT_TRUE(compact1->AreAllStonesStopped());
+
+    // 2. 同じスレッドで他のインスタンスと交互に進めても, 1つだけを進めた場合と完全に一致する
+    std::vector<dcs::ISimulator::AllStones> alone_stones;
+    std::vector<std::size_t> alone_collisions;
+    compact1->SetStones(collision_stones);
+    while (!compact1->AreAllStonesStopped()) {
+        compact1->Step();
+        alone_stones.push_back(compact1->GetStones());
+        alone_collisions.push_back(compact1->GetCollisions().size());
+    }
+    std::size_t collisions = 0;
+    for (auto const n : alone_collisions) collisions += n;
+    EXPECT_GE(collisions, 1u);
+
+    auto compact3 = compact_factory.CreateSimulator();
+    compact2->SetStones(collision_stones);
+    compact3->SetStones(single_stones);
+    for (std::size_t frame = 0; frame < alone_stones.size(); ++frame) {
+        compact3->Step();
+        compact2->Step();
+        ASSERT_EQ(alone_collisions[frame], compact2->GetCollisions().size()) << "frame " << frame;
+        ASSERT_TRUE(dct::EqualsSimulatorStones(alone_stones[frame], compact2->GetStones())) << "frame " << frame;
+    }
+    EXPECT_TRUE(compact2->AreAllStonesStopped());
+
+    // 接触の情報をフレームをまたいで持ち越さないため, 衝突の結果は通常モードと僅かに異なることがある
+    full->SetStones(collision_stones);
+    while (!full->AreAllStonesStopped()) full->Step();
+    for (int i = 0; i < 16; ++i) {
+        ASSERT_EQ(full->GetStones()[i].has_value(), compact2->GetStones()[i].has_value());
+        if (!full->GetStones()[i]) continue;
+        EXPECT_NEAR(full->GetStones()[i]->position.x, compact2->GetStones()[i]->position.x, 1e-3f);
+        EXPECT_NEAR(full->GetStones()[i]->position.y, compact2->GetStones()[i]->position.y, 1e-3f);
+    }
+
+    // 3. ストレージのファクトリーに合わせてモードが切り替わる
+    auto const storage = compact1->CreateStorage();
+    full->Load(*storage);
+    EXPECT_TRUE(dynamic_cast<dcs::SimulatorFCV1&>(*full).IsCompact());
+    EXPECT_TRUE(dct::EqualsSimulatorStones(full->GetStones(), compact1->GetStones()));
+    compact1->Load(*factory.CreateSimulator()->CreateStorage());
+    EXPECT_FALSE(dynamic_cast<dcs::SimulatorFCV1&>(*compact1).IsCompact());
+}
+
+TEST(SimulatorFCV1, FastPath)
+{
+    dcs::SimulatorFCV1Factory factory;
+    dcs::SimulatorFCV1Factory fast_factory;
+    fast_factory.fast_path = true;
+    dcs::SimulatorFCV1Factory fast_compact_factory = fast_factory;
+    fast_compact_factory.compact = true;
+
+    dcs::ISimulator::StoneState const shot(dc::Vector2(), 0.f, dc::Vector2(0.05f, 1.5f), 1.57f);
+
+    // 基準のシミュレーターと1フレームずつ比較しながら停止するまで進める
+    auto run_and_compare = [&](dcs::ISimulator & simulator, dcs::ISimulator::AllStones const& stones) {
+        auto reference = factory.CreateSimulator();
+        reference->SetStones(stones);
+        simulator.SetStones(stones);
+        std::uint64_t frames = 0;
+        std::size_t collisions = 0;
+        while (!reference->AreAllStonesStopped()) {
+            reference->Step();
+            simulator.Step();
+            ++frames;
+            EXPECT_EQ(reference->AreAllStonesStopped(), simulator.AreAllStonesStopped());
+            EXPECT_EQ(reference->GetCollisions().size(), simulator.GetCollisions().size());
+            collisions += simulator.GetCollisions().size();
+            if (!dct::EqualsSimulatorStones(reference->GetStones(), simulator.GetStones())) {
+                ADD_FAILURE() << "frame " << frames;
+                break;
+            }
+        }
+        EXPECT_TRUE(simulator.AreAllStonesStopped());
+        return std::make_pair(frames, collisions);
+    };
+
+    // 1. 空のシートでは最初のショットから Box2D を使わずに同じ結果になる
+    dcs::ISimulator::AllStones empty_sheet;
+    empty_sheet[0] = shot;
+    {
+        auto simulator = fast_factory.CreateSimulator();
+        auto const [frames, collisions] = run_and_compare(*simulator, empty_sheet);
+        EXPECT_EQ(collisions, 0u);
+        EXPECT_EQ(simulator->GetStats().fast_path_shots, 1u);
+        EXPECT_EQ(simulator->GetStats().fast_path_frames, frames);
+    }
+
+    // 2. 経路から離れたストーンしか無ければ, Box2D を使わずに同じ結果になる
+    dcs::ISimulator::AllStones guards = empty_sheet;
+    guards[3] = dcs::ISimulator::StoneState(dc::Vector2(-1.5f, 4.f), 0.3f, dc::Vector2(), 0.f);
+    guards[8] = dcs::ISimulator::StoneState(dc::Vector2(1.8f, 8.f), 0.f, dc::Vector2(), 0.f);
+    for (auto const* f : { &fast_factory, &fast_compact_factory }) {
+        auto simulator = f->CreateSimulator();
+        auto const [frames, collisions] = run_and_compare(*simulator, guards);
+        EXPECT_EQ(collisions, 0u);
+
+        auto const stats = simulator->GetStats();
+        EXPECT_EQ(stats.fast_path_shots, 1u);
+        EXPECT_EQ(stats.fast_path_frames, frames);
+        EXPECT_EQ(stats.frames, frames);
+        EXPECT_EQ(stats.fast_path_rejections, 0u);
+
+        // 停止した後も Box2D で進められる
+        simulator->Step();
+        EXPECT_TRUE(simulator->AreAllStonesStopped());
+        EXPECT_EQ(simulator->GetStats().fast_path_frames, frames);
+    }
+
+    // 3. 実行誤差を加えたような, 毎回異なるショットでも Box2D と一致する
+    {
+        auto simulator = fast_factory.CreateSimulator();
+        std::uint64_t total_frames = 0;
+        for (int i = 0; i < 8; ++i) {
+            dcs::ISimulator::AllStones noisy = guards;
+            float const d = static_cast<float>(i) - 3.5f;
+            noisy[0] = dcs::ISimulator::StoneState(
+                dc::Vector2(),
+                0.f,
+                dc::Vector2(0.05f + 0.0013f * d, 1.5f + 0.0071f * d),
+                (i % 2 == 0 ? 1.f : -1.f) * (1.57f + 0.01f * d));
+            total_frames += run_and_compare(*simulator, noisy).first;
+        }
+        auto const stats = simulator->GetStats();
+        EXPECT_EQ(stats.fast_path_shots, 8u);
+        EXPECT_EQ(stats.fast_path_frames, total_frames);
+    }
+
+    // 4. 途中で SetStones() を呼び出しても, その時点の状態から Box2D と一致する
+    //    (SimulateShotOutcome() がシート外のストーンを取り除く場合など)
+    {
+        auto reference = factory.CreateSimulator();
+        reference->SetStones(guards);
+        for (int i = 0; i < 500; ++i) reference->Step();
+        auto const mid_shot = reference->GetStones();
+        ASSERT_FALSE(reference->AreAllStonesStopped());
+
+        auto simulator = fast_factory.CreateSimulator();
+        auto const [frames, collisions] = run_and_compare(*simulator, mid_shot);
+        EXPECT_EQ(collisions, 0u);
+        EXPECT_EQ(simulator->GetStats().fast_path_shots, 1u);
+        EXPECT_EQ(simulator->GetStats().fast_path_frames, frames);
+    }
+
+    // 5. 経路上にストーンがあれば Box2D で進める
+    dcs::ISimulator::AllStones blocked = guards;
+    blocked[12] = dcs::ISimulator::StoneState(dc::Vector2(0.1f, 3.f), 0.f, dc::Vector2(), 0.f);
+    {
+        auto simulator = fast_factory.CreateSimulator();
+        auto const [frames, collisions] = run_and_compare(*simulator, blocked);
+        EXPECT_GE(collisions, 1u);
+
+        auto const stats = simulator->GetStats();
+        EXPECT_EQ(stats.fast_path_shots, 0u);
+        EXPECT_EQ(stats.fast_path_frames, 0u);
+        EXPECT_EQ(stats.fast_path_rejections, 1u);
+        EXPECT_EQ(stats.frames, frames);
+    }
+
+    // 6. 無効の場合は高速化しない
+    {
+        auto simulator = factory.CreateSimulator();
+        run_and_compare(*simulator, guards);
+        EXPECT_EQ(simulator->GetStats().fast_path_shots, 0u);
+    }
+}
+
+TEST(SimulatorFCV1, MotionMatchesBox2DVectorOperations)
+{
+    // 共通化する前の SimulatorFCV1::Step() と同じく b2Vec2 の演算で更新した速度と, ビット単位で一致する
+    auto const reference = [](b2Vec2 & velocity, float & angular_velocity, float seconds_per_frame) {
+        b2Vec2 normalized = velocity;
+        float const speed = normalized.Normalize();
+        float const w = angular_velocity;
+        if (speed > std::numeric_limits<float>::epsilon()) {
+            float const longitudinal_acceleration = -(0.00200985f / (speed + 0.06385782f) + 0.00626286f) * 9.80665f;
+            float const new_speed = speed + longitudinal_acceleration * seconds_per_frame;
+            if (new_speed <= 0.f) {
+                velocity = b2Vec2_zero;
+            } else {
+                float yaw_rate = 0.f;
+                if (std::abs(w) > std::numeric_limits<float>::epsilon()) {
+                    yaw_rate = (w > 0.f ? 1.0f : -1.0f) * 0.00820f * std::pow(speed, -0.8f);
+                }
+                float const yaw = yaw_rate * seconds_per_frame;
+                float const longitudinal_velocity = new_speed * std::cos(yaw);
+                float const transverse_velocity = new_speed * std::sin(yaw);
+                velocity = longitudinal_velocity * normalized + transverse_velocity * normalized.Skew();
+            }
+        }
+        if (std::abs(w) > std::numeric_limits<float>::epsilon()) {
+            float const angular_accel = -0.025f / std::max(speed, 0.001f) * seconds_per_frame;
+            angular_velocity = std::abs(w) <= std::abs(angular_accel) ? 0.f : w + angular_accel * w / std::abs(w);
+        }
+    };
+
+    float const speeds[] = { 0.f, 1e-8f, 1.2e-7f, 1e-4f, 0.003f, 0.05f, 0.5f, 1.f, 2.2f, 4.f };
+    float const directions[] = { 0.f, 0.3f, 1.5707964f, 2.9f, -2.1f, -0.7f };
+    float const angular_velocities[] = { 0.f, 1e-8f, 0.02f, 1.57f, -1.57f, -3.f };
+    for (float const speed : speeds) {
+        for (float const direction : directions) {
+            for (float const angular_velocity : angular_velocities) {
+                b2Vec2 expected_velocity(speed * std::cos(direction), speed * std::sin(direction));
+                float expected_angular_velocity = angular_velocity;
+                reference(expected_velocity, expected_angular_velocity, 0.001f);
+
+                float velocity_x = speed * std::cos(direction);
+                float velocity_y = speed * std::sin(direction);
+                float actual_angular_velocity = angular_velocity;
+                dcs::UpdateFCV1Velocity(velocity_x, velocity_y, actual_angular_velocity, 0.001f);
+
+                EXPECT_EQ(expected_velocity.x, velocity_x) << speed << ", " << direction << ", " << angular_velocity;
+                EXPECT_EQ(expected_velocity.y, velocity_y) << speed << ", " << direction << ", " << angular_velocity;
+                EXPECT_EQ(expected_angular_velocity, actual_angular_velocity) << speed << ", " << direction << ", " << angular_velocity;
+            }
+        }
+    }
+}
+
+TEST(SimulatorFCV1, Dual)
+{
+    using Dual2 = dcs::Dual<2>;
+    Dual2 const x(2., 0);
+    Dual2 const y(3., 1);
+
+    // f(x, y) = sqrt(x) * sin(y) / x + pow(x, -0.8) * cos(y)
+    auto const f = sqrt(x) * sin(y) / x + pow(x, -0.8) * cos(y);
+    EXPECT_DOUBLE_EQ(f.value, std::sin(3.) / std::sqrt(2.) + std::pow(2., -0.8) * std::cos(3.));
+    EXPECT_NEAR(f.derivatives[0], -0.5 * std::pow(2., -1.5) * std::sin(3.) - 0.8 * std::pow(2., -1.8) * std::cos(3.), 1e-12);
+    EXPECT_NEAR(f.derivatives[1], std::cos(3.) / std::sqrt(2.) - std::pow(2., -0.8) * std::sin(3.), 1e-12);
+
+    // 比較は値のみで行う
+    EXPECT_TRUE(x < y);
+    EXPECT_TRUE(-x < 0.);
+    EXPECT_EQ(abs(-x).derivatives[0], 1.);
+}
+
+TEST(SimulatorFCV1, DifferentiableFreeFlight)
+{
+    // 衝突しないショットの停止位置は SimulatorFCV1 と一致する
+    dcs::SimulatorFCV1Factory factory;
+    auto simulator = factory.CreateSimulator();
+    for (float const angular_velocity : { 1.57f, -1.57f }) {
+        dc::moves::Shot const shot(2.41f, angular_velocity, 1.5707963f + (angular_velocity > 0.f ? -0.02f : 0.02f));
+        dcs::ISimulator::AllStones stones;
+        stones[0] = dcs::ISimulator::StoneState(dc::Vector2(), 0.f, shot.ToVector2(), shot.angular_velocity);
+        simulator->SetStones(stones);
+        while (!simulator->AreAllStonesStopped()) simulator->Step();
+        auto const expected = simulator->GetStones()[0]->position;
+
+        auto const result = dcs::ComputeFCV1ShotJacobian(dcs::ISimulator::AllStones(), shot, 0, 4.75f);
+        ASSERT_TRUE(result.stones[0]);
+        EXPECT_NEAR(result.stones[0]->position.x, expected.x, 5e-3f) << angular_velocity;
+        EXPECT_NEAR(result.stones[0]->position.y, expected.y, 5e-3f) << angular_velocity;
+    }
+}
+
+TEST(SimulatorFCV1, DifferentiableJacobian)
+{
+    using Jacobian = dcs::FCV1ShotJacobian;
+
+    // ヤコビ行列は中心差分と一致する
+    auto const check = [](dcs::ISimulator::AllStones const& stones, dc::moves::Shot const& shot) -> Jacobian {
+        auto const result = dcs::ComputeFCV1ShotJacobian(stones, shot, 0, 4.75f);
+        for (std::size_t k = 0; k < Jacobian::kInputCount; ++k) {
+            // 投球角度は停止位置への影響が大きいため, 刻みを小さくする
+            float const h = k == Jacobian::kReleaseAngle ? 1e-5f : 1e-3f;
+            auto shot_plus = shot;
+            auto shot_minus = shot;
+            auto const perturb = [&](dc::moves::Shot & s, float delta) {
+                switch (k) {
+                    case Jacobian::kSpeed: s.translational_velocity += delta; break;
+                    case Jacobian::kReleaseAngle: s.release_angle += delta; break;
+                    default: s.angular_velocity += delta; break;
+                }
+            };
+            perturb(shot_plus, h);
+            perturb(shot_minus, -h);
+            auto const plus = dcs::ComputeFCV1ShotJacobian(stones, shot_plus, 0, 4.75f);
+            auto const minus = dcs::ComputeFCV1ShotJacobian(stones, shot_minus, 0, 4.75f);
+
+            for (std::size_t i = 0; i < result.stones.size(); ++i) {
+                if (!result.stones[i]) continue;
+                EXPECT_TRUE(plus.stones[i] && minus.stones[i]);
+                if (!plus.stones[i] || !minus.stones[i]) continue;
+                auto const& d = result.position_jacobian[i][k];
+                float const fd_x = (plus.stones[i]->position.x - minus.stones[i]->position.x) / (2.f * h);
+                float const fd_y = (plus.stones[i]->position.y - minus.stones[i]->position.y) / (2.f * h);
+                EXPECT_NEAR(d.x, fd_x, 0.02f + 0.05f * std::abs(fd_x)) << "stone " << i << ", input " << k;
+                EXPECT_NEAR(d.y, fd_y, 0.02f + 0.05f * std::abs(fd_y)) << "stone " << i << ", input " << k;
+            }
+        }
+        return result;
+    };
+
+    // ドロー
+    {
+        auto const result = check(dcs::ISimulator::AllStones(), dc::moves::Shot(2.41f, 1.57f, 1.5507963f));
+        EXPECT_GT(result.position_jacobian[0][Jacobian::kSpeed].y, 0.f);
+        EXPECT_EQ(result.position_jacobian[1][Jacobian::kSpeed].y, 0.f);
+    }
+
+    // ティーのストーンに中心を外して当てるヒット
+    {
+        dcs::ISimulator::AllStones stones;
+        stones[8] = dcs::ISimulator::StoneState(dc::coordinate::kTee, 0.f, dc::Vector2(), 0.f);
+        auto const result = check(stones, dc::moves::Shot(2.6f, 1.57f, 1.5376f));
+        ASSERT_TRUE(result.stones[8]);
+        EXPECT_GT(result.stones[8]->position.y, dc::coordinate::kTee.y);
+        EXPECT_NE(result.position_jacobian[8][Jacobian::kReleaseAngle].x, 0.f);
+    }
+
+    EXPECT_THROW(dcs::ComputeFCV1ShotJacobian(dcs::ISimulator::AllStones(), dc::moves::Shot(), dc::StoneCoordinate::kStoneMax, 4.75f), std::out_of_range);
+}
+
 TEST(SimulatorFCV1, FactoryToJson)
 {
     auto v_fcv1 = std::make_unique<dcs::SimulatorFCV1Factory>();
@@ -126,6 +556,8 @@ TEST(SimulatorFCV1, FactoryToJson)
     nlohmann::json const j_fcv1 = *v_fcv1.get();
     EXPECT_EQ(j_fcv1.at("type").get<std::string>(), "fcv1");
     EXPECT_EQ(j_fcv1.at("seconds_per_frame").get<float>(), v_fcv1->seconds_per_frame);
+    EXPECT_FALSE(j_fcv1.at("compact").get<bool>());
+    EXPECT_FALSE(j_fcv1.at("fast_path").get<bool>());
 }
 
 TEST(SimulatorFCV1, FactoryFromJson)
@@ -138,4 +570,14 @@ TEST(SimulatorFCV1, FactoryFromJson)
     dcs::SimulatorFCV1Factory v_fcv1;
     EXPECT_NO_THROW(v_fcv1 = j_fcv1.get<dcs::SimulatorFCV1Factory>());
     EXPECT_EQ(v_fcv1.seconds_per_frame, 0.25f);
+    EXPECT_FALSE(v_fcv1.compact);
+    EXPECT_FALSE(v_fcv1.fast_path);
+
+    nlohmann::json j_compact = j_fcv1;
+    j_compact["compact"] = true;
+    EXPECT_TRUE(j_compact.get<dcs::SimulatorFCV1Factory>().compact);
+
+    nlohmann::json j_fast_path = j_fcv1;
+    j_fast_path["fast_path"] = true;
+    EXPECT_TRUE(j_fast_path.get<dcs::SimulatorFCV1Factory>().fast_path);
 }
@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "common.hpp"
+#include "../src/fcv1_fast/simulator_fcv1_fast.hpp"
+
+namespace dct = digitalcurling::test;
+
+namespace {
+
+// SimulatorFCV1::Step() と同じ式で1ストーンの自由走行を進める (Box2D による位置の積分を含む)
+void StepFCV1FreeFlight(dcs::ISimulator::StoneState & stone, float dt)
+{
+    float const speed = stone.translational_velocity.Length();
+    float const w = stone.angular_velocity;
+    if (speed > std::numeric_limits<float>::epsilon()) {
+        dc::Vector2 const e_long = stone.translational_velocity / speed;
+        dc::Vector2 const e_trans(-e_long.y, e_long.x);
+        float const new_speed = speed - (0.00200985f / (speed + 0.06385782f) + 0.00626286f) * 9.80665f * dt;
+        if (new_speed <= 0.f) {
+            stone.translational_velocity = dc::Vector2();
+        } else {
+            float const yaw = std::abs(w) <= std::numeric_limits<float>::epsilon() ? 0.f : (w > 0.f ? 1.f : -1.f) * 0.00820f * std::pow(speed, -0.8f) * dt;
+            stone.translational_velocity = new_speed * std::cos(yaw) * e_long + new_speed * std::sin(yaw) * e_trans;
+        }
+    }
+    if (std::abs(w) > std::numeric_limits<float>::epsilon()) {
+        float const accel = 0.025f / std::max(speed, 0.001f) * dt;
+        stone.angular_velocity = std::abs(w) <= accel ? 0.f : w - accel * w / std::abs(w);
+    }
+    stone.position += stone.translational_velocity * dt;
+}
+
+dc::Vector2 RunUntilStopped(dcs::ISimulator & simulator, dcs::ISimulator::StoneState const& stone)
+{
+    dcs::ISimulator::AllStones stones;
+    stones[0] = stone;
+    simulator.SetStones(stones);
+    while (!simulator.AreAllStonesStopped()) simulator.Step();
+    return simulator.GetStones()[0]->position;
+}
+
+} // unnamed namespace
+
+TEST(SimulatorFCV1Fast, InitialState)
+{
+    dcs::SimulatorFCV1FastFactory factory;
+    auto simulator = factory.CreateSimulator();
+    EXPECT_TRUE(simulator->AreAllStonesStopped());
+    EXPECT_EQ(std::string(simulator->GetId()), "fcv1_fast");
+}
+
+TEST(SimulatorFCV1Fast, FreeFlight)
+{
+    dcs::SimulatorFCV1FastFactory factory;
+    auto simulator = factory.CreateSimulator();
+
+    // ドロー (回転なし / 回転あり) の停止位置は FCV1 の式を 1ms 刻みで積分した結果と 1cm 以内で一致する
+    for (float const angular_velocity : { 0.f, 1.57f, -1.57f }) {
+        dcs::ISimulator::StoneState const shot(dc::Vector2(), 0.f, dc::Vector2(0.f, 2.41f), angular_velocity);
+
+        auto reference = shot;
+        while (reference.translational_velocity.Length() > 0.f || reference.angular_velocity > std::numeric_limits<float>::epsilon()) {
+            StepFCV1FreeFlight(reference, 0.001f);
+        }
+
+        auto const position = RunUntilStopped(*simulator, shot);
+        EXPECT_NEAR(position.x, reference.position.x, 0.01f) << angular_velocity;
+        EXPECT_NEAR(position.y, reference.position.y, 0.01f) << angular_velocity;
+        EXPECT_EQ(simulator->GetStones()[0]->angular_velocity, 0.f);
+    }
+    EXPECT_TRUE(simulator->GetCollisions().empty());
+}
+
+TEST(SimulatorFCV1Fast, Collision)
+{
+    dcs::SimulatorFCV1FastFactory factory;
+    auto simulator = factory.CreateSimulator();
+
+    // 静止したストーンに正面から衝突させると, 速度が入れ替わる
+    dcs::ISimulator::AllStones init_stones;
+    init_stones[0] = dcs::ISimulator::StoneState(dc::Vector2(0.f, 0.f), 0.f, dc::Vector2(0.f, 2.f), 0.f);
+    init_stones[1] = dcs::ISimulator::StoneState(dc::Vector2(0.f, 1.f), 0.f, dc::Vector2(), 0.f);
+    simulator->SetStones(init_stones);
+
+    std::vector<dcs::ISimulator::Collision> collisions;
+    while (!simulator->AreAllStonesStopped()) {
+        simulator->Step();
+        auto const& c = simulator->GetCollisions();
+        collisions.insert(collisions.end(), c.begin(), c.end());
+    }
+
+    ASSERT_EQ(collisions.size(), 1u);
+    EXPECT_EQ(collisions[0].a.id, 0);
+    EXPECT_EQ(collisions[0].b.id, 1);
+    EXPECT_GT(collisions[0].normal_impulse, 0.f);
+    EXPECT_NEAR(collisions[0].b.stone.position.y - collisions[0].a.stone.position.y, 2.f * dc::Stone::kRadius, 1e-4f);
+
+    auto const& stones = simulator->GetStones();
+    EXPECT_NEAR(stones[0]->position.x, 0.f, 1e-4f);
+    EXPECT_NEAR(stones[0]->position.y, 1.f - 2.f * dc::Stone::kRadius, 1e-3f);
+    EXPECT_NEAR(stones[1]->position.x, 0.f, 1e-4f);
+    EXPECT_GT(stones[1]->position.y, 1.f);
+
+    auto const stats = simulator->GetStats();
+    EXPECT_GE(stats.contacts_begun, stats.contacts_solved);
+    EXPECT_EQ(stats.contacts_solved, 1u);
+    EXPECT_GT(stats.frames, 0u);
+}
+
+TEST(SimulatorFCV1Fast, SaveLoad)
+{
+    dcs::SimulatorFCV1FastFactory factory;
+    auto simulator = factory.CreateSimulator();
+
+    dcs::ISimulator::AllStones init_stones;
+    init_stones[0] = dcs::ISimulator::StoneState(dc::Vector2(0.1f, 2.f), 0.5f, dc::Vector2(-0.1f, -2.f), 1.f);
+    init_stones[15] = dcs::ISimulator::StoneState(dc::Vector2(0.f, 1.f), 0.5f, dc::Vector2(), 0.f);
+    simulator->SetStones(init_stones);
+
+    // 1
+    auto storage = simulator->CreateStorage();
+    std::vector<std::uint8_t> binary;
+    dynamic_cast<dcs::SimulatorFCV1FastStorage &>(*storage).ToBinary(binary);
+    for (int i = 0; i < 10; ++i) { simulator->Step(); }
+    auto const stones1 = simulator->GetStones();
+
+    // 2
+    simulator->Load(*storage);
+    for (int i = 0; i < 10; ++i) { simulator->Step(); }
+    EXPECT_TRUE(dct::EqualsSimulatorStones(stones1, simulator->GetStones()));
+
+    // 3
+    dcs::SimulatorFCV1FastStorage storage2;
+    ASSERT_NO_THROW(storage2.FromBinary(binary.data(), binary.size()));
+    auto simulator_copy = storage2.CreateSimulator();
+    for (int i = 0; i < 10; ++i) { simulator_copy->Step(); }
+    EXPECT_TRUE(dct::EqualsSimulatorStones(stones1, simulator_copy->GetStones()));
+
+    EXPECT_THROW(storage2.FromBinary(binary.data(), binary.size() - 1), std::invalid_argument);
+}
+
+TEST(SimulatorFCV1Fast, CalculateShot)
+{
+    dcs::SimulatorFCV1FastFactory factory;
+    dcs::SimulatorFCV1Fast simulator(factory);
+
+    dc::Vector2 const target(0.5f, 38.405f);
+    for (float const angular_velocity : { 1.57f, -1.57f }) {
+        auto const shot = simulator.CalculateShot(target, 0.f, angular_velocity);
+        auto const position = RunUntilStopped(simulator, dcs::ISimulator::StoneState(dc::Vector2(), 0.f, shot.ToVector2(), shot.angular_velocity));
+        EXPECT_LT((position - target).Length(), 0.01f) << angular_velocity;
+    }
+
+    EXPECT_THROW(simulator.CalculateShot(target, -1.f, 1.f), std::invalid_argument);
+    EXPECT_THROW(simulator.CalculateShot(dc::Vector2(), 0.f, 1.f), std::invalid_argument);
+}
+
+TEST(SimulatorFCV1Fast, FactoryJson)
+{
+    dcs::SimulatorFCV1FastFactory factory;
+    factory.seconds_per_frame = 0.02f;
+
+    nlohmann::json const j = factory;
+    EXPECT_EQ(j.at("type").get<std::string>(), "fcv1_fast");
+    EXPECT_EQ(j.at("seconds_per_frame").get<float>(), 0.02f);
+
+    // fcv1 と同じ形式の設定を読み込める. seconds_per_frame は省略できる
+    nlohmann::json const j_default = { { "type", "fcv1_fast" } };
+    EXPECT_EQ(j_default.get<dcs::SimulatorFCV1FastFactory>().seconds_per_frame, dcs::SimulatorFCV1FastFactory().seconds_per_frame);
+    EXPECT_EQ(j.get<dcs::SimulatorFCV1FastFactory>().seconds_per_frame, 0.02f);
+}
@@ -0,0 +1,171 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: MIT
+
+// シミュレーター FCV1 の精度検証ツール
+//
+// 基準ショット集 (ゴールデンコーパス) の全ショットを検証対象の設定でシミュレーションし,
+// 基準の結果に対するストーンの位置の誤差, 得点の変化, 衝突の発生順序の食い違い, 速度向上率を出力します。
+//
+// 使い方:
+//   digitalcurling_golden_fcv1 --corpus <file> [options]
+//
+//   --factory <json|file>   検証対象の Factory の設定 (省略時は既定の設定)
+//                           "type" が "fcv1_fast" の場合は近似シミュレーター FCV1 Fast を検証する
+//   --baseline <json|file>  速度の比較に使用する Factory の設定 (省略時は既定の設定)
+//   --allow-missing-reference  基準の結果を持たないショットを baseline の結果と比較する
+//                           (省略時は基準の結果を持たないショットがあるとエラーになる)
+//   --tolerance <m>         ストーンの位置の誤差の許容値 (既定値: 0.01)
+//   --allow-score-change    得点の変化を許容する
+//   --allow-collision-mismatch  衝突の発生順序の食い違いを許容する
+//   --repeat <n>            実行時間の計測の繰り返し回数 (既定値: 3)
+//   --report <file>         結果を JSON 形式で書き出す
+//   --update                baseline の結果で基準の結果を生成し直し, コーパスに書き戻す
+//
+// 終了コードは, すべてのショットが判定基準を満たした場合 0, 満たさないショットがある場合 1, エラーの場合 2 です。
+
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <nlohmann/json.hpp>
+#include "digitalcurling/simulators/golden_trajectory.hpp"
+#include "../src/fcv1/simulator_fcv1_factory.hpp"
+#ifdef DIGITALCURLING_GOLDEN_WITH_FCV1_FAST
+    #include "../src/fcv1_fast/simulator_fcv1_fast_factory.hpp"
+#endif
+
+namespace {
+
+using namespace digitalcurling;
+using namespace digitalcurling::simulators;
+
+struct Options {
+    std::filesystem::path corpus;
+    std::string factory;
+    std::string baseline;
+    GoldenTolerance tolerance;
+    unsigned int repeat = 3;
+    std::filesystem::path report;
+    bool allow_missing_reference = false;
+    bool update = false;
+};
+
+nlohmann::json ReadJsonFile(std::filesystem::path const& path)
+{
+    std::ifstream file(path);
+    if (!file) throw std::runtime_error("cannot open \"" + path.string() + "\"");
+    return nlohmann::json::parse(file);
+}
+
+void WriteJsonFile(std::filesystem::path const& path, nlohmann::json const& json)
+{
+    std::ofstream file(path);
+    if (!file) throw std::runtime_error("cannot write \"" + path.string() + "\"");
+    file << json.dump(2) << '\n';
+}
+
+// 引数が JSON ならそのまま, そうでなければファイルパスとして読み込む
+std::unique_ptr<ISimulatorFactory> ParseFactory(std::string const& arg)
+{
+    if (arg.empty()) return std::make_unique<SimulatorFCV1Factory>();
+    auto const json = arg.front() == '{' ? nlohmann::json::parse(arg) : ReadJsonFile(arg);
+    auto const type = json.value("type", std::string("fcv1"));
+    if (type == "fcv1") return std::make_unique<SimulatorFCV1Factory>(json.get<SimulatorFCV1Factory>());
+#ifdef DIGITALCURLING_GOLDEN_WITH_FCV1_FAST
+    if (type == "fcv1_fast") return std::make_unique<SimulatorFCV1FastFactory>(json.get<SimulatorFCV1FastFactory>());
+#endif
+    throw std::invalid_argument("unsupported factory type: " + type);
+}
+
+Options ParseOptions(int argc, char* argv[])
+{
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view const arg = argv[i];
+        auto const value = [&]() -> std::string {
+            if (i + 1 >= argc) throw std::invalid_argument(std::string(arg) + " requires a value");
+            return argv[++i];
+        };
+
+        if (arg == "--corpus") options.corpus = value();
+        else if (arg == "--factory") options.factory = value();
+        else if (arg == "--baseline") options.baseline = value();
+        else if (arg == "--tolerance") options.tolerance.max_position_error = std::stof(value());
+        else if (arg == "--allow-score-change") options.tolerance.allow_score_change = true;
+        else if (arg == "--allow-collision-mismatch") options.tolerance.allow_collision_mismatch = true;
+        else if (arg == "--repeat") options.repeat = static_cast<unsigned int>(std::stoul(value()));
+        else if (arg == "--report") options.report = value();
+        else if (arg == "--allow-missing-reference") options.allow_missing_reference = true;
+        else if (arg == "--update") options.update = true;
+        else throw std::invalid_argument("unknown option: " + std::string(arg));
+    }
+    if (options.corpus.empty()) throw std::invalid_argument("--corpus is required");
+    return options;
+}
+
+void PrintReport(GoldenReport const& report, GoldenTolerance const& tolerance)
+{
+    std::printf("%-28s %-15s %10s %10s %7s %9s %10s %10s  %s\n",
+        "shot", "category", "max[m]", "mean[m]", "score", "collision", "base[ms]", "cand[ms]", "result");
+    for (auto const& r : report.shots) {
+        std::string const collision = r.collision_mismatch_index
+            ? "#" + std::to_string(*r.collision_mismatch_index)
+            : std::to_string(r.candidate_collisions);
+        std::string const score = r.reference_score == r.candidate_score
+            ? std::to_string(r.candidate_score)
+            : std::to_string(r.reference_score) + ">" + std::to_string(r.candidate_score);
+        std::printf("%-28s %-15s %10.5f %10.5f %7s %9s %10.3f %10.3f  %s\n",
+            r.name.c_str(), r.category.c_str(), r.max_position_error, r.mean_position_error,
+            score.c_str(), collision.c_str(), r.reference_seconds * 1e3, r.candidate_seconds * 1e3,
+            r.passed ? "ok" : (r.presence_mismatches > 0 ? "FAIL (stone count)" : "FAIL"));
+    }
+
+    std::size_t failed = 0;
+    for (auto const& r : report.shots) failed += r.passed ? 0 : 1;
+    std::printf("\n%zu shots, %zu failed (tolerance %.4f m), speedup x%.3f\n",
+        report.shots.size(), failed, tolerance.max_position_error, report.GetSpeedup());
+}
+
+} // unnamed namespace
+
+int main(int argc, char* argv[])
+{
+    try {
+        auto const options = ParseOptions(argc, argv);
+        auto corpus = ReadJsonFile(options.corpus).get<GoldenCorpus>();
+        if (corpus.version != kGoldenCorpusVersion)
+            throw std::runtime_error("unsupported corpus version: " + std::to_string(corpus.version));
+
+        auto const baseline = ParseFactory(options.baseline);
+        if (options.update) {
+            UpdateGoldenReferences(corpus, *baseline);
+            WriteJsonFile(options.corpus, corpus);
+            std::printf("updated %zu references in %s\n", corpus.shots.size(), options.corpus.string().c_str());
+            return EXIT_SUCCESS;
+        }
+
+        // 基準の結果が無いショットを baseline と比較すると, 検証対象と baseline が同じ場合は必ず一致してしまう
+        std::size_t missing = 0;
+        for (auto const& shot : corpus.shots) missing += shot.reference ? 0 : 1;
+        if (missing > 0 && !options.allow_missing_reference)
+            throw std::runtime_error(std::to_string(missing) + " of " + std::to_string(corpus.shots.size())
+                + " shots have no reference; generate them with the digitalcurling_golden_fcv1_update target");
+        if (missing > 0) std::printf("note: %zu shots have no reference and are compared with the baseline\n\n", missing);
+
+        auto const candidate = ParseFactory(options.factory);
+        auto const report = RunGoldenCorpus(corpus, *candidate, baseline.get(), options.tolerance, options.repeat);
+        PrintReport(report, options.tolerance);
+        if (!options.report.empty()) WriteJsonFile(options.report, report);
+
+        return report.Passed() ? EXIT_SUCCESS : EXIT_FAILURE;
+    } catch (std::exception const& e) {
+        std::cerr << "error: " << e.what() << std::endl;
+        return 2;
+    }
+}